@@ -40,6 +40,7 @@
 #include <px4_arch/dshot.h>
 #include <px4_arch/io_timer.h>
 #include <drivers/drv_dshot.h>
+#include <lib/bdshot/bdshot_decode.h>
 #include <stdio.h>
 #include "barriers.h"
 
@@ -50,22 +51,12 @@
 #define DSHOT_TIMERS			FLEXIO_SHIFTBUFNIS_COUNT
 #define DSHOT_THROTTLE_POSITION		5u
 #define DSHOT_TELEMETRY_POSITION	4u
-#define NIBBLES_SIZE 			4u
 #define DSHOT_NUMBER_OF_NIBBLES		3u
 
 #if defined(IOMUX_PULL_UP_47K)
 #define IOMUX_PULL_UP IOMUX_PULL_UP_47K
 #endif
 
-static const uint32_t gcr_decode[32] = {
-	0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-	0x0, 0x9, 0xA, 0xB, 0x0, 0xD, 0xE, 0xF,
-	0x0, 0x0, 0x2, 0x3, 0x0, 0x5, 0x6, 0x7,
-	0x0, 0x0, 0x8, 0x1, 0x0, 0x4, 0xC, 0x0
-};
-
-uint32_t erpms[DSHOT_TIMERS];
-
 typedef enum {
 	DSHOT_START = 0,
 	DSHOT_12BIT_FIFO,
@@ -81,10 +72,6 @@ typedef struct dshot_handler_t {
 	uint32_t 		irq_data;
 	dshot_state             state;
 	bool			bdshot;
-	uint32_t                raw_response;
-	uint16_t                erpm;
-	uint32_t		crc_error_cnt;
-	uint32_t		frame_error_cnt;
 	uint32_t		no_response_cnt;
 	uint32_t		last_no_response_cnt;
 } dshot_handler_t;
@@ -93,6 +80,11 @@ typedef struct dshot_handler_t {
 
 static dshot_handler_t dshot_inst[DSHOT_TIMERS] = {};
 
+// bdshot responses and decoding results, kept in separate arrays so all channels get decoded in one batch
+static uint32_t bdshot_raw_response[DSHOT_TIMERS];
+static uint16_t bdshot_erpm[DSHOT_TIMERS];
+static bdshot_decode_stats_t bdshot_stats[DSHOT_TIMERS];
+
 static uint32_t dshot_tcmp;
 static uint32_t bdshot_tcmp;
 static uint32_t dshot_mask;
@@ -216,7 +208,7 @@ static int flexio_irq_handler(int irq, void *context, void *arg)
 
 			} else if (dshot_inst[channel].state == BDSHOT_RECEIVE) {
 				dshot_inst[channel].state = BDSHOT_RECEIVE_COMPLETE;
-				dshot_inst[channel].raw_response = flexio_getreg32(IMXRT_FLEXIO_SHIFTBUFBIS0_OFFSET + channel * 0x4);
+				bdshot_raw_response[channel] = flexio_getreg32(IMXRT_FLEXIO_SHIFTBUFBIS0_OFFSET + channel * 0x4);
 
 				bdshot_recv_mask |= (1 << channel);
 
@@ -360,74 +352,30 @@ int up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq, bool enable_bi
 
 void up_bdshot_erpm(void)
 {
-	uint32_t value;
-	uint32_t data;
-	uint32_t csum_data;
-	uint8_t exponent;
-	uint16_t period;
-	uint16_t erpm;
+	bdshot_parsed_recv_mask = bdshot_decode_erpm_batch(bdshot_raw_response, bdshot_recv_mask, DSHOT_TIMERS,
+				  bdshot_erpm, bdshot_stats);
 
-	bdshot_parsed_recv_mask = 0;
-
-	// Decode each individual channel
 	for (uint8_t channel = 0; (channel < DSHOT_TIMERS); channel++) {
-		if (bdshot_recv_mask & (1 << channel)) {
-			value = ~dshot_inst[channel].raw_response & 0xFFFFF;
-
-			/* if lowest significant isn't 1 we've got a framing error */
-			if (value & 0x1) {
-				/* Decode RLL */
-				value = (value ^ (value >> 1));
-
-				/* Decode GCR */
-				data = gcr_decode[value & 0x1fU];
-				data |= gcr_decode[(value >> 5U) & 0x1fU] << 4U;
-				data |= gcr_decode[(value >> 10U) & 0x1fU] << 8U;
-				data |= gcr_decode[(value >> 15U) & 0x1fU] << 12U;
-
-				/* Calculate checksum */
-				csum_data = data;
-				csum_data = csum_data ^ (csum_data >> 8U);
-				csum_data = csum_data ^ (csum_data >> NIBBLES_SIZE);
-
-				if ((csum_data & 0xFU) != 0xFU) {
-					dshot_inst[channel].crc_error_cnt++;
-
-				} else {
-					data = (data >> 4) & 0xFFF;
-
-					if (data == 0xFFF) {
-						erpm = 0;
-
-					} else {
-						exponent = ((data >> 9U) & 0x7U); /* 3 bit: exponent */
-						period = (data & 0x1ffU); /* 9 bit: period base */
-						period = period << exponent; /* Period in usec */
-						erpm = ((1000000U * 60U / 100U + period / 2U) / period);
-					}
-
-					dshot_inst[channel].erpm = erpm;
-					bdshot_parsed_recv_mask |= (1 << channel);
-					dshot_inst[channel].last_no_response_cnt = dshot_inst[channel].no_response_cnt;
-				}
-
-			} else {
-				dshot_inst[channel].frame_error_cnt++;
-			}
+		if (bdshot_parsed_recv_mask & (1 << channel)) {
+			dshot_inst[channel].last_no_response_cnt = dshot_inst[channel].no_response_cnt;
 		}
 	}
 }
 
+uint32_t up_bdshot_get_erpms(uint16_t erpm[], uint32_t error_count[], unsigned num_channels)
+{
+	uint32_t mask = 0;
 
+	for (unsigned channel = 0; channel < num_channels && channel < DSHOT_TIMERS; channel++) {
+		if (bdshot_parsed_recv_mask & (1 << channel)) {
+			erpm[channel] = bdshot_erpm[channel];
+			mask |= 1 << channel;
+		}
 
-int up_bdshot_get_erpm(uint8_t channel, int *erpm)
-{
-	if (bdshot_parsed_recv_mask & (1 << channel)) {
-		*erpm = (int)dshot_inst[channel].erpm;
-		return 0;
+		error_count[channel] = bdshot_decode_error_count(&bdshot_stats[channel]);
 	}
 
-	return -1;
+	return mask;
 }
 
 int up_bdshot_channel_status(uint8_t channel)
@@ -446,10 +394,10 @@ void up_bdshot_status(void)
 
 		if (dshot_inst[channel].init) {
 			PX4_INFO("Channel %i %s Last erpm %i value", channel, up_bdshot_channel_status(channel) ? "online" : "offline",
-				 dshot_inst[channel].erpm);
-			PX4_INFO("CRC errors Frame error No response");
-			PX4_INFO("%10lu %11lu %11lu", dshot_inst[channel].crc_error_cnt, dshot_inst[channel].frame_error_cnt,
-				 dshot_inst[channel].no_response_cnt);
+				 bdshot_erpm[channel]);
+			PX4_INFO("    Frames CRC errors GCR errors Frame error No response");
+			PX4_INFO("%10lu %10lu %10lu %11lu %11lu", bdshot_stats[channel].frames, bdshot_stats[channel].crc_errors,
+				 bdshot_stats[channel].gcr_errors, bdshot_stats[channel].frame_errors, dshot_inst[channel].no_response_cnt);
 		}
 	}
 }
@@ -58,6 +58,17 @@ public:
 	virtual int	read(unsigned offset, void *data, unsigned count = 1);
 	virtual int	write(unsigned address, void *data, unsigned count = 1);
 
+	/**
+	 * Exchange a multi-page transaction (PKT_CODE_MULTI) with IO.
+	 *
+	 * @param request	Encoded register operations, see protocol.h.
+	 * @param request_count	Number of registers in request.
+	 * @param reply		Receives the values of all reads, in request order.
+	 * @param reply_count	Total number of registers read.
+	 * @return		OK on success, negative errno otherwise.
+	 */
+	int		transfer(const uint16_t *request, unsigned request_count, uint16_t *reply, unsigned reply_count);
+
 protected:
 	/**
 	 * Does the PX4IO_serial instance initialization.
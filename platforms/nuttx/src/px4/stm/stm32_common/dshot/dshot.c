@@ -152,10 +152,10 @@ int up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq, bool enable_bi
 	return ret_val == OK ? channels_init_mask : ret_val;
 }
 
-int up_bdshot_get_erpm(uint8_t channel, int *erpm)
+uint32_t up_bdshot_get_erpms(uint16_t erpm[], uint32_t error_count[], unsigned num_channels)
 {
 	// Not implemented
-	return -1;
+	return 0;
 }
 
 int up_bdshot_channel_status(uint8_t channel)
@@ -101,6 +101,38 @@ set_tests_properties(sitl-imu_filtering PROPERTIES PASS_REGULAR_EXPRESSION "ALL
 sanitizer_fail_test_on_error(sitl-imu_filtering)
 
 
+# microbenchmarks compared against the recorded baseline
+if(CONFIG_SYSTEMCMDS_MICROBENCH)
+	# timings are only advisory (-w in the script), regressions are reported as warnings.
+	# Coverage and sanitizer builds are not representative, so the test is not run there.
+	if(NOT CMAKE_BUILD_TYPE MATCHES "Coverage|Sanitizer")
+		add_test(NAME sitl-microbench
+			COMMAND $<TARGET_FILE:px4>
+				-s ${PX4_SOURCE_DIR}/posix-configs/SITL/init/test/test_microbench
+				-t ${PX4_SOURCE_DIR}/test_data
+				${PX4_SOURCE_DIR}/ROMFS/px4fmu_test
+			WORKING_DIRECTORY ${SITL_WORKING_DIR}
+		)
+
+		set_tests_properties(sitl-microbench PROPERTIES FAIL_REGULAR_EXPRESSION "all FAILED")
+		set_tests_properties(sitl-microbench PROPERTIES PASS_REGULAR_EXPRESSION "all PASSED")
+	endif()
+
+	# record a new baseline with this (non-lockstep) test build: make px4_sitl_test microbench_baseline
+	add_custom_target(microbench_baseline
+		COMMAND $<TARGET_FILE:px4>
+			-s ${PX4_SOURCE_DIR}/posix-configs/SITL/init/test/test_microbench
+			-t ${PX4_SOURCE_DIR}/test_data
+			${PX4_SOURCE_DIR}/ROMFS/px4fmu_test
+		COMMAND ${CMAKE_COMMAND} -E copy microbench.json ${PX4_SOURCE_DIR}/test_data/microbench_posix.json
+		WORKING_DIRECTORY ${SITL_WORKING_DIR}
+		DEPENDS px4
+		COMMENT "Recording microbenchmark baseline test_data/microbench_posix.json"
+		USES_TERMINAL
+	)
+endif()
+
+
 
 # # Shutdown test
 # add_test(NAME sitl-shutdown
@@ -48,6 +48,7 @@
 #include <semaphore.h>
 #include <time.h>
 #include <string.h>
+#include <stdlib.h>
 #include <errno.h>
 #include "hrt_work.h"
 
@@ -67,8 +68,24 @@ static constexpr unsigned HRT_INTERVAL_MAX = 50000000;
 
 /*
  * Queue of callout entries.
+ *
+ * Binary min-heap ordered by deadline, with an insertion sequence number
+ * to keep entries with equal deadlines in FIFO order. Each queued entry
+ * stores its heap position (hrt_call::heap_index), so enter, cancel and
+ * pop are all O(log n).
  */
-static struct sq_queue_s	callout_queue;
+struct callout_node {
+	hrt_abstime	deadline;
+	uint64_t	sequence;
+	struct hrt_call	*call;
+};
+
+static callout_node	*callout_heap;
+static unsigned		callout_heap_size;
+static unsigned		callout_heap_capacity;
+static uint64_t		callout_sequence;
+
+static constexpr unsigned CALLOUT_HEAP_INITIAL_CAPACITY = 64;
 
 /* latency baseline (last compare value applied) */
 static uint64_t			latency_baseline;
@@ -100,6 +117,99 @@ static void hrt_unlock()
 	px4_sem_post(&_hrt_lock);
 }
 
+static inline bool callout_before(const callout_node &a, const callout_node &b)
+{
+	return (a.deadline < b.deadline) || ((a.deadline == b.deadline) && (a.sequence < b.sequence));
+}
+
+static inline void callout_heap_set(unsigned index, const callout_node &node)
+{
+	callout_heap[index] = node;
+	node.call->heap_index = index;
+}
+
+static void callout_heap_sift_up(unsigned index)
+{
+	const callout_node node = callout_heap[index];
+
+	while (index > 0) {
+		const unsigned parent = (index - 1) / 2;
+
+		if (!callout_before(node, callout_heap[parent])) {
+			break;
+		}
+
+		callout_heap_set(index, callout_heap[parent]);
+		index = parent;
+	}
+
+	callout_heap_set(index, node);
+}
+
+static void callout_heap_sift_down(unsigned index)
+{
+	const callout_node node = callout_heap[index];
+
+	while (true) {
+		unsigned child = 2 * index + 1;
+
+		if (child >= callout_heap_size) {
+			break;
+		}
+
+		if ((child + 1 < callout_heap_size) && callout_before(callout_heap[child + 1], callout_heap[child])) {
+			child++;
+		}
+
+		if (!callout_before(callout_heap[child], node)) {
+			break;
+		}
+
+		callout_heap_set(index, callout_heap[child]);
+		index = child;
+	}
+
+	callout_heap_set(index, node);
+}
+
+/*
+ * Check whether the entry is currently queued. The entry may be
+ * uninitialised, so heap_index is only trusted if it points back at it.
+ */
+static inline bool callout_queued(const struct hrt_call *entry)
+{
+	return (entry->heap_index < callout_heap_size) && (callout_heap[entry->heap_index].call == entry);
+}
+
+static inline struct hrt_call *callout_peek()
+{
+	return (callout_heap_size > 0) ? callout_heap[0].call : nullptr;
+}
+
+static void callout_remove(struct hrt_call *entry)
+{
+	if (!callout_queued(entry)) {
+		return;
+	}
+
+	const unsigned index = entry->heap_index;
+	callout_heap_size--;
+
+	if (index != callout_heap_size) {
+		// move the last node into the hole and restore the heap property in whichever direction it is violated
+		const callout_node last = callout_heap[callout_heap_size];
+		const bool up = (index > 0) && callout_before(last, callout_heap[(index - 1) / 2]);
+		callout_heap_set(index, last);
+
+		if (up) {
+			callout_heap_sift_up(index);
+
+		} else {
+			callout_heap_sift_down(index);
+		}
+	}
+}
+
 /*
  * Get absolute time.
  */
@@ -166,7 +276,7 @@ bool	hrt_called(struct hrt_call *entry)
 void	hrt_cancel(struct hrt_call *entry)
 {
 	hrt_lock();
-	sq_rem(&entry->link, &callout_queue);
+	callout_remove(entry);
 	entry->deadline = 0;
 
 	/* if this is a periodic call being removed by the callout, prevent it from
@@ -219,7 +329,16 @@ void	hrt_call_delay(struct hrt_call *entry, hrt_abstime delay)
  */
 void	hrt_init()
 {
-	sq_init(&callout_queue);
+	callout_heap = (callout_node *)malloc(CALLOUT_HEAP_INITIAL_CAPACITY * sizeof(callout_node));
+
+	if (callout_heap != nullptr) {
+		callout_heap_capacity = CALLOUT_HEAP_INITIAL_CAPACITY;
+
+	} else {
+		PX4_ERR("callout heap alloc failed");
+	}
+
+	callout_heap_size = 0;
 
 	int sem_ret = px4_sem_init(&_hrt_lock, 0, 1);
 
@@ -233,26 +352,33 @@ void	hrt_init()
 static void
 hrt_call_enter(struct hrt_call *entry)
 {
-	struct hrt_call	*call, *next;
+	// a periodic callout may have re-armed itself from within the callback
+	callout_remove(entry);
 
-	call = (struct hrt_call *)sq_peek(&callout_queue);
+	if (callout_heap_size == callout_heap_capacity) {
+		const unsigned capacity = (callout_heap_capacity > 0) ? 2 * callout_heap_capacity : CALLOUT_HEAP_INITIAL_CAPACITY;
+		callout_node *heap = (callout_node *)realloc(callout_heap, capacity * sizeof(callout_node));
 
-	if ((call == nullptr) || (entry->deadline < call->deadline)) {
-		sq_addfirst(&entry->link, &callout_queue);
-		//if (call != nullptr) PX4_INFO("call enter at head, reschedule (%lu %lu)", entry->deadline, call->deadline);
-		/* we changed the next deadline, reschedule the timer event */
-		hrt_call_reschedule();
+		if (heap == nullptr) {
+			PX4_ERR("callout heap alloc failed, dropping call");
+			entry->deadline = 0;
+			return;
+		}
 
-	} else {
-		do {
-			next = (struct hrt_call *)sq_next(&call->link);
+		callout_heap = heap;
+		callout_heap_capacity = capacity;
+	}
 
-			if ((next == nullptr) || (entry->deadline < next->deadline)) {
-				//lldbg("call enter after head\n");
-				sq_addafter(&call->link, &entry->link, &callout_queue);
-				break;
-			}
-		} while ((call = next) != nullptr);
+	const struct hrt_call *head = callout_peek();
+
+	callout_heap[callout_heap_size] = callout_node{entry->deadline, callout_sequence++, entry};
+	callout_heap_size++;
+	callout_heap_sift_up(callout_heap_size - 1);
+
+	if ((head == nullptr) || (entry->deadline < head->deadline)) {
+		//if (head != nullptr) PX4_INFO("call enter at head, reschedule (%lu %lu)", entry->deadline, head->deadline);
+		/* we changed the next deadline, reschedule the timer event */
+		hrt_call_reschedule();
 	}
 }
 
@@ -291,7 +417,7 @@ hrt_call_reschedule()
 {
 	hrt_abstime	now = hrt_absolute_time();
 	hrt_abstime	delay = HRT_INTERVAL_MAX;
-	struct hrt_call	*next = (struct hrt_call *)sq_peek(&callout_queue);
+	struct hrt_call	*next = callout_peek();
 	hrt_abstime	deadline = now + HRT_INTERVAL_MAX;
 
 	/*
@@ -340,14 +466,12 @@ hrt_call_internal(struct hrt_call *entry, hrt_abstime deadline, hrt_abstime inte
 	//PX4_INFO("hrt_call_internal after lock");
 	/* if the entry is currently queued, remove it */
 	/* note that we are using a potentially uninitialised
-	   entry->link here, but it is safe as sq_rem() doesn't
-	   dereference the passed node unless it is found in the
-	   list. So we potentially waste a bit of time searching the
-	   queue for the uninitialised entry->link but we don't do
-	   anything actually unsafe.
+	   entry->heap_index here, but it is safe as callout_remove()
+	   only trusts it if it is in range and the heap node at that
+	   position points back at the entry.
 	*/
 	if (entry->deadline != 0) {
-		sq_rem(&entry->link, &callout_queue);
+		callout_remove(entry);
 	}
 
 #if 1
@@ -419,7 +543,7 @@ hrt_call_invoke()
 		/* get the current time */
 		hrt_abstime now = hrt_absolute_time();
 
-		call = (struct hrt_call *)sq_peek(&callout_queue);
+		call = callout_peek();
 
 		if (call == nullptr) {
 			break;
@@ -429,7 +553,7 @@ hrt_call_invoke()
 			break;
 		}
 
-		sq_rem(&call->link, &callout_queue);
+		callout_remove(call);
 		//PX4_INFO("call pop");
 
 		/* save the intended deadline for periodic calls */
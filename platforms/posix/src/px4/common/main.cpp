@@ -43,6 +43,9 @@
  * with 'px4-' such as 'px4-navigator', it will start as a client and try to
  * connect to the server.
  *
+ * With 'px4 -c', a list of commands is read from a file or stdin and executed
+ * on the running server over a single connection.
+ *
  * The symlinks for all modules are created using the build system.
  *
  * @author Mark Charlebois <charlebm@gmail.com>
@@ -103,6 +106,7 @@ static void set_cpu_scaling();
 static int create_symlinks_if_needed(std::string &data_path);
 static int create_dirs();
 static int run_startup_script(const std::string &commands_file, const std::string &absolute_binary_path, int instance);
+static int run_client_batch(const std::string &commands_file, int instance);
 static std::string get_absolute_binary_path(const std::string &argv0);
 static void wait_to_exit();
 static int get_server_running(int instance, bool *is_running);
@@ -208,16 +212,22 @@ int main(int argc, char **argv)
 
 		bool instance_provided = false;
 
+		bool client_batch = false;
+
 		int myoptind = 1;
 		int ch;
 		const char *myoptarg = nullptr;
 
-		while ((ch = px4_getopt(argc, argv, "hdt:s:i:w:", &myoptind, &myoptarg)) != EOF) {
+		while ((ch = px4_getopt(argc, argv, "hcdt:s:i:w:", &myoptind, &myoptarg)) != EOF) {
 			switch (ch) {
 			case 'h':
 				print_usage();
 				return 0;
 
+			case 'c':
+				client_batch = true;
+				break;
+
 			case 'd':
 				pxh_off = true;
 				break;
@@ -254,6 +264,11 @@ int main(int argc, char **argv)
 			} // else: ROS argument (in the form __<name>:=<value>)
 		}
 
+		if (client_batch) {
+			// data_path is the optional commands file in client batch mode
+			return run_client_batch(data_path, instance);
+		}
+
 		if (instance_provided) {
 			PX4_INFO("instance: %i", instance);
 		}
@@ -341,6 +356,9 @@ int main(int argc, char **argv)
 		register_sig_handler();
 		set_cpu_scaling();
 
+		// make the instance available to modules that expose per-instance host resources (e.g. shared memory)
+		setenv("PX4_INSTANCE", std::to_string(instance).c_str(), 1);
+
 		px4_daemon::Server server(instance);
 		server.start();
 
@@ -607,6 +625,42 @@ int run_startup_script(const std::string &commands_file, const std::string &abso
 	return ret;
 }
 
+int run_client_batch(const std::string &commands_file, int instance)
+{
+	bool server_is_running = false;
+	int ret = get_server_running(instance, &server_is_running);
+
+	if (ret != PX4_OK) {
+		PX4_ERR("PX4 client failed to get server status");
+		return ret;
+	}
+
+	if (!server_is_running) {
+		PX4_ERR("PX4 server not running");
+		return PX4_ERROR;
+	}
+
+	FILE *commands = stdin;
+
+	if (!commands_file.empty()) {
+		commands = fopen(commands_file.c_str(), "r");
+
+		if (commands == nullptr) {
+			PX4_ERR("failed to open %s: %s", commands_file.c_str(), strerror(errno));
+			return PX4_ERROR;
+		}
+	}
+
+	px4_daemon::Client client(instance);
+	ret = client.process_batch(commands);
+
+	if (commands != stdin) {
+		fclose(commands);
+	}
+
+	return ret;
+}
+
 void wait_to_exit()
 {
 	while (!_exit_requested) {
@@ -633,6 +687,9 @@ void print_usage()
 	printf("\n");
 	printf("    px4-MODULE [--instance <instance>] command using symlink.\n");
 	printf("        e.g.: px4-commander status\n");
+	printf("\n");
+	printf("    px4 -c [-i <instance>] [<commands_file>]\n");
+	printf("        run commands (one per line, from stdin if no file given) over a single connection\n");
 }
 
 int get_server_running(int instance, bool *is_server_running)
@@ -62,7 +62,7 @@ Client::Client(int instance_id) :
 {}
 
 int
-Client::process_args(const int argc, const char **argv)
+Client::_connect()
 {
 	std::string sock_path = get_socket_path(_instance_id);
 
@@ -82,6 +82,16 @@ Client::process_args(const int argc, const char **argv)
 		return -1;
 	}
 
+	return 0;
+}
+
+int
+Client::process_args(const int argc, const char **argv)
+{
+	if (_connect() != 0) {
+		return -1;
+	}
+
 	int ret = _send_cmds(argc, argv);
 
 	if (ret != 0) {
@@ -107,8 +117,22 @@ Client::_send_cmds(const int argc, const char **argv)
 		}
 	}
 
-	// Last byte is 'isatty'.
-	cmd_buf.push_back(isatty(STDOUT_FILENO));
+	return _send_cmd(cmd_buf, false);
+}
+
+int
+Client::_send_cmd(const std::string &cmd, bool persistent)
+{
+	std::string cmd_buf = cmd;
+
+	// Last byte holds the flags.
+	char flags = isatty(STDOUT_FILENO) ? CMD_FLAG_ISATTY : 0;
+
+	if (persistent) {
+		flags |= CMD_FLAG_PERSISTENT;
+	}
+
+	cmd_buf.push_back(flags);
 
 	size_t n = cmd_buf.size();
 	const char *buf = cmd_buf.data();
@@ -177,6 +201,92 @@ Client::_listen()
 	}
 }
 
+int
+Client::process_batch(FILE *commands)
+{
+	if (_connect() != 0) {
+		return -1;
+	}
+
+	int ret = 0;
+	char line[1024];
+
+	while (fgets(line, sizeof(line), commands) != nullptr) {
+		std::string cmd = line;
+
+		// strip trailing newline and leading whitespace
+		while (!cmd.empty() && (cmd.back() == '\n' || cmd.back() == '\r')) {
+			cmd.pop_back();
+		}
+
+		const size_t start = cmd.find_first_not_of(" \t");
+
+		if (start == std::string::npos || cmd[start] == '#') {
+			continue;
+		}
+
+		cmd.erase(0, start);
+
+		if (_send_cmd(cmd, true) != 0) {
+			PX4_ERR("Could not send command");
+			return -3;
+		}
+
+		int retval = 0;
+
+		if (_listen_persistent(retval) != 0) {
+			return -1;
+		}
+
+		if (retval != 0) {
+			PX4_ERR("command '%s' failed (%i)", cmd.c_str(), retval);
+			ret = 1;
+		}
+	}
+
+	return ret;
+}
+
+int
+Client::_listen_persistent(int &retval)
+{
+	// The connection stays open, so the end of the output can't be detected by the
+	// end of the stream. Command output is text, so the first 0 byte marks the end
+	// and is followed by the return value.
+	char buffer[1024];
+	bool end_marker_received = false;
+
+	while (true) {
+		int n_read = read(_fd, buffer, sizeof buffer);
+
+		if (n_read <= 0) {
+			PX4_ERR("unable to read from socket");
+			return -1;
+		}
+
+		if (end_marker_received) {
+			retval = buffer[0];
+			return 0;
+		}
+
+		const char *end_marker = (const char *)memchr(buffer, 0, n_read);
+
+		if (end_marker == nullptr) {
+			fwrite(buffer, n_read, 1, stdout);
+			continue;
+		}
+
+		fwrite(buffer, end_marker - buffer, 1, stdout);
+
+		if (end_marker + 1 < buffer + n_read) {
+			retval = end_marker[1];
+			return 0;
+		}
+
+		end_marker_received = true;
+	}
+}
+
 Client::~Client()
 {
 	if (_fd >= 0) {
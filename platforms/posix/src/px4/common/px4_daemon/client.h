@@ -40,6 +40,9 @@
  * It the client dies, the connection gets closed automatically and the corresponding
  * thread in the server gets cancelled.
  *
+ * In batch mode, the client sends a list of commands over a single persistent
+ * connection, one after the other.
+ *
  * @author Julian Oes <julian@oes.ch>
  * @author Beat Küng <beat-kueng@gmx.net>
  * @author Mara Bos <m-ou.se@m-ou.se>
@@ -47,6 +50,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdio.h>
 
 #include "sock_protocol.h"
 
@@ -76,9 +80,21 @@ public:
 	 */
 	int process_args(const int argc, const char **argv);
 
+	/**
+	 * Read commands line by line and execute them one after the other over a
+	 * single connection. Empty lines and lines starting with '#' are skipped.
+	 *
+	 * @param commands: stream to read the commands from
+	 * @return 0 if all commands succeeded, 1 if any failed, negative on connection errors
+	 */
+	int process_batch(FILE *commands);
+
 private:
+	int _connect();
+	int _send_cmd(const std::string &cmd, bool persistent);
 	int _send_cmds(const int argc, const char **argv);
 	int _listen();
+	int _listen_persistent(int &retval);
 
 	int _fd;
 	int _instance_id; ///< instance ID for running multiple instances of the px4 server
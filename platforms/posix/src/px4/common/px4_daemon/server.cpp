@@ -64,6 +64,7 @@ Server *Server::_instance = nullptr;
 
 Server::Server(int instance_id)
 	: _mutex(PTHREAD_MUTEX_INITIALIZER),
+	  _pending_cond(PTHREAD_COND_INITIALIZER),
 	  _instance_id(instance_id)
 {
 	_instance = this;
@@ -136,6 +137,12 @@ Server::_server_main()
 		return;
 	}
 
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		if (!_start_worker()) {
+			break;
+		}
+	}
+
 	// The list of file descriptors to watch.
 	std::vector<pollfd> poll_fds;
 
@@ -181,19 +188,30 @@ Server::_server_main()
 				// Set stream to line buffered.
 				setvbuf(thread_stdout, nullptr, _IOLBF, BUFSIZ);
 
-				// Start a new thread to handle the client.
-				pthread_t *thread = &_fd_to_thread[client];
-				ret = pthread_create(thread, nullptr, Server::_handle_client, thread_stdout);
-
-				if (ret != 0) {
-					PX4_ERR("could not start pthread (%i)", ret);
-					_fd_to_thread.erase(client);
-					fclose(thread_stdout);
+				if (_idle_workers > (int)_pending_clients.size()) {
+					// Hand the client over to an idle worker.
+					_pending_clients.push_back(thread_stdout);
+					pthread_cond_signal(&_pending_cond);
+					ret = 0;
 
 				} else {
-					// We won't join the thread, so detach to automatically release resources at its end
-					pthread_detach(*thread);
+					// All workers are busy, start a new thread to handle the client.
+					ClientThread *thread = &_fd_to_thread[client];
+					thread->pooled = false;
+					ret = pthread_create(&thread->thread, nullptr, Server::_handle_client, thread_stdout);
+
+					if (ret != 0) {
+						PX4_ERR("could not start pthread (%i)", ret);
+						_fd_to_thread.erase(client);
+						fclose(thread_stdout);
+
+					} else {
+						// We won't join the thread, so detach to automatically release resources at its end
+						pthread_detach(thread->thread);
+					}
+				}
 
+				if (ret == 0) {
 					// Start listening for the client hanging up.
 					poll_fds.push_back(pollfd {client, POLLHUP, 0});
 
@@ -212,8 +230,22 @@ Server::_server_main()
 				if (thread != _fd_to_thread.end()) {
 					// Thread is still running, so we cancel it.
 					// TODO: use a more graceful exit method to avoid resource leaks
-					pthread_cancel(thread->second);
+					pthread_cancel(thread->second.thread);
+
+					if (thread->second.pooled) {
+						_start_worker();
+					}
+
 					_fd_to_thread.erase(thread);
+
+				} else {
+					// The client might still be waiting for a worker.
+					for (auto it = _pending_clients.begin(); it != _pending_clients.end(); ++it) {
+						if (*it == stdouts[i - 1]) {
+							_pending_clients.erase(it);
+							break;
+						}
+					}
 				}
 
 				fclose(stdouts[i - 1]);
@@ -233,84 +265,164 @@ Server::_server_main()
 	close(_fd);
 }
 
-void
-*Server::_handle_client(void *arg)
+bool
+Server::_start_worker()
 {
-	FILE *out = (FILE *)arg;
-	int fd = fileno(out);
+	pthread_t thread;
+	int ret = pthread_create(&thread, nullptr, Server::_worker_main, nullptr);
+
+	if (ret != 0) {
+		PX4_ERR("could not start worker pthread (%i)", ret);
+		return false;
+	}
 
-	// Read until the end of the incoming stream.
-	std::string cmd;
+	pthread_detach(thread);
+	return true;
+}
+
+void
+*Server::_worker_main(void *arg)
+{
+	// Only allow cancellation while a command is running, so that we never
+	// get cancelled while holding the mutex (pthread_cond_wait() is a cancellation point).
+	pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, nullptr);
 
 	while (true) {
-		size_t n = cmd.size();
-		cmd.resize(n + 1024);
-		ssize_t n_read = read(fd, &cmd[n], cmd.size() - n);
+		_instance->_lock();
 
-		if (n_read <= 0) {
-			_cleanup(fd);
-			return nullptr;
+		while (_instance->_pending_clients.empty()) {
+			++_instance->_idle_workers;
+			pthread_cond_wait(&_instance->_pending_cond, &_instance->_mutex);
+			--_instance->_idle_workers;
 		}
 
-		cmd.resize(n + n_read);
+		FILE *out = _instance->_pending_clients.front();
+		_instance->_pending_clients.pop_front();
 
-		// Command ends in 0x00 (no tty) or 0x01 (tty).
-		if (!cmd.empty() && cmd.back() < 2) {
-			break;
+		ClientThread &thread = _instance->_fd_to_thread[fileno(out)];
+		thread.thread = pthread_self();
+		thread.pooled = true;
+
+		_instance->_unlock();
+
+		pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, nullptr);
+		const bool still_registered = _serve_client(out);
+		pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, nullptr);
+
+		if (!still_registered) {
+			// The main thread tried to cancel us and has already started a replacement worker.
+			return nullptr;
 		}
 	}
+}
 
-	if (cmd.size() < 2) {
-		_cleanup(fd);
-		return nullptr;
-	}
+void
+*Server::_handle_client(void *arg)
+{
+	_serve_client((FILE *)arg);
+	return nullptr;
+}
 
-	// Last byte is 'isatty'.
-	uint8_t isatty = cmd.back();
-	cmd.pop_back();
+bool
+Server::_serve_client(FILE *out)
+{
+	int fd = fileno(out);
 
 	// We register thread specific data. This is used for PX4_INFO (etc.) log calls.
 	CmdThreadSpecificData *thread_data_ptr;
 
 	if ((thread_data_ptr = (CmdThreadSpecificData *)pthread_getspecific(_instance->_key)) == nullptr) {
 		thread_data_ptr = new CmdThreadSpecificData;
-		thread_data_ptr->thread_stdout = out;
-		thread_data_ptr->is_atty = isatty;
+		thread_data_ptr->thread_stdout = nullptr;
+		thread_data_ptr->is_atty = false;
 
 		(void)pthread_setspecific(_instance->_key, (void *)thread_data_ptr);
 	}
 
-	// Run the actual command.
-	int retval = Pxh::process_line(cmd, true);
+	bool persistent = true;
 
-	// Report return value.
-	char buf[2] = {0, (char)retval};
+	while (persistent) {
+		// Read until the end of the incoming command.
+		std::string cmd;
 
-	if (fwrite(buf, sizeof buf, 1, out) != 1) {
-		// Don't care it went wrong, as we're cleaning up anyway.
-	}
+		while (true) {
+			size_t n = cmd.size();
+			cmd.resize(n + 1024);
+			ssize_t n_read = read(fd, &cmd[n], cmd.size() - n);
+
+			if (n_read <= 0) {
+				thread_data_ptr->thread_stdout = nullptr;
+				return _cleanup(fd);
+			}
 
-	// Flush the FILE*'s buffer before we shut down the connection.
-	fflush(out);
+			cmd.resize(n + n_read);
 
-	_cleanup(fd);
-	return nullptr;
+			// Command ends in the flags byte.
+			if (!cmd.empty() && cmd.back() <= CMD_FLAGS_MAX) {
+				break;
+			}
+		}
+
+		if (cmd.size() < 2) {
+			break;
+		}
+
+		// Last byte holds the flags.
+		const char flags = cmd.back();
+		cmd.pop_back();
+
+		persistent = flags & CMD_FLAG_PERSISTENT;
+
+		thread_data_ptr->thread_stdout = out;
+		thread_data_ptr->is_atty = flags & CMD_FLAG_ISATTY;
+
+		// Run the actual command.
+		int retval = Pxh::process_line(cmd, true);
+
+		// Report return value.
+		char buf[2] = {0, (char)retval};
+
+		if (fwrite(buf, sizeof buf, 1, out) != 1) {
+			// Don't care it went wrong, as we're cleaning up anyway.
+		}
+
+		// Flush the FILE*'s buffer before we shut down the connection or wait for the next command.
+		fflush(out);
+	}
+
+	thread_data_ptr->thread_stdout = nullptr;
+	return _cleanup(fd);
 }
 
-void
+bool
 Server::_cleanup(int fd)
 {
 	_instance->_lock();
-	_instance->_fd_to_thread.erase(fd);
+
+	// Only remove the entry if it still belongs to this thread. If it doesn't,
+	// the main thread has already cancelled us (the cancellation might not have
+	// been acted upon yet) and the fd might be in use by another client.
+	auto thread = _instance->_fd_to_thread.find(fd);
+	const bool registered = (thread != _instance->_fd_to_thread.end())
+				&& pthread_equal(thread->second.thread, pthread_self());
+
+	if (registered) {
+		_instance->_fd_to_thread.erase(thread);
+	}
+
 	_instance->_unlock();
 
-	// We can't close() the fd here, since the main thread is probably
-	// polling for it: close()ing it causes a race condition.
-	// So, we only call shutdown(), which causes the main thread to register a
-	// 'POLLHUP', such that the main thread can close() it for us.
-	// We already removed this thread from _fd_to_thread, so there is no risk
-	// of the main thread trying to cancel this thread after it already exited.
-	shutdown(fd, SHUT_RDWR);
+	if (registered) {
+		// We can't close() the fd here, since the main thread is probably
+		// polling for it: close()ing it causes a race condition.
+		// So, we only call shutdown(), which causes the main thread to register a
+		// 'POLLHUP', such that the main thread can close() it for us.
+		// We already removed this thread from _fd_to_thread, so there is no risk
+		// of the main thread trying to cancel this thread after it already exited.
+		shutdown(fd, SHUT_RDWR);
+	}
+
+	return registered;
 }
 
 } //namespace px4_daemon
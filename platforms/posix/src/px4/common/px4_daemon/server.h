@@ -37,7 +37,12 @@
  *
  * Once a client connects it will send a command and close its side of the connection.
  * The server will return the stdout of the executing command, as well as the return
- * value to the client.
+ * value to the client. A client can also flag a command as persistent, in which case
+ * the connection stays open and further commands are executed on it.
+ *
+ * Clients are handled by a small pool of worker threads, so that the common case of
+ * many short commands does not create a thread per command. If all workers are busy
+ * (e.g. with long running commands), a dedicated thread is started for the client.
  *
  * There should only every be one server running, therefore the static instance.
  * The Singleton implementation is not complete, but it should be obvious not
@@ -53,6 +58,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <pthread.h>
+#include <deque>
 #include <map>
 
 #include "sock_protocol.h"
@@ -104,12 +110,26 @@ private:
 	}
 
 	static void *_handle_client(void *arg);
-	static void _cleanup(int fd);
+	static void *_worker_main(void *arg);
+	static bool _serve_client(FILE *out);
+	static bool _cleanup(int fd);
+
+	bool _start_worker();
+
+	static constexpr int NUM_WORKERS = 4;
 
 	pthread_t _server_main_pthread;
 
-	std::map<int, pthread_t> _fd_to_thread;
-	pthread_mutex_t _mutex; ///< Protects _fd_to_thread.
+	struct ClientThread {
+		pthread_t thread;
+		bool pooled; ///< thread is a pool worker and needs to be replaced if cancelled
+	};
+
+	std::map<int, ClientThread> _fd_to_thread;
+	std::deque<FILE *> _pending_clients; ///< Accepted clients waiting for a worker.
+	int _idle_workers{0};
+	pthread_mutex_t _mutex; ///< Protects _fd_to_thread, _pending_clients and _idle_workers.
+	pthread_cond_t _pending_cond;
 
 	pthread_key_t _key;
 
@@ -44,5 +44,10 @@ namespace px4_daemon
 
 std::string get_socket_path(int instance_id);
 
+// The last byte of each command sent to the server is a set of flags.
+static constexpr char CMD_FLAG_ISATTY = 0x01;     ///< stdout of the client is a terminal
+static constexpr char CMD_FLAG_PERSISTENT = 0x02; ///< keep the connection open for further commands
+static constexpr char CMD_FLAGS_MAX = CMD_FLAG_ISATTY | CMD_FLAG_PERSISTENT;
+
 } // namespace px4_daemon
 
@@ -33,11 +33,14 @@
 
 #include "CanardHandle.hpp"
 
+#include <errno.h>
+#include <malloc.h>
 #include <net/if.h>
 #include <sys/ioctl.h>
 #include <string.h>
 
 #include <px4_platform_common/log.h>
+#include <mathlib/mathlib.h>
 
 #include "o1heap/o1heap.h"
 
@@ -60,7 +63,27 @@ static void *memAllocate(CanardInstance *const ins, const size_t amount) { retur
 static void memFree(CanardInstance *const ins, void *const pointer) { o1heapFree(cyphal_allocator, pointer); }
 
 
-CanardHandle::CanardHandle(uint32_t node_id, const size_t capacity, const size_t mtu_bytes)
+static CanardInterface *createCanInterface()
+{
+#if defined(__PX4_NUTTX)
+# if defined(CONFIG_NET_CAN)
+	return new CanardSocketCAN();
+# elif defined(CONFIG_CAN)
+	return new CanardNuttXCDev();
+# endif // CONFIG_CAN
+#else
+	return nullptr;
+#endif // NuttX
+}
+
+CanardHandle::CanardHandle(uint32_t node_id, const size_t capacity, const size_t mtu_bytes) :
+	CanardHandle(node_id, capacity, mtu_bytes, createCanInterface())
+{
+}
+
+CanardHandle::CanardHandle(uint32_t node_id, const size_t capacity, const size_t mtu_bytes,
+			   CanardInterface *can_interface) :
+	_can_interface(can_interface)
 {
 	_cyphal_heap = memalign(O1HEAP_ALIGNMENT, HeapSize);
 	cyphal_allocator = o1heapInit(_cyphal_heap, HeapSize, nullptr, nullptr);
@@ -74,22 +97,27 @@ CanardHandle::CanardHandle(uint32_t node_id, const size_t capacity, const size_t
 	_canard_instance.node_id = node_id; // Defaults to anonymous; can be set up later at any point.
 
 	_queue = canardTxInit(capacity, mtu_bytes);
-
-#if defined(__PX4_NUTTX)
-# if defined(CONFIG_NET_CAN)
-	_can_interface = new CanardSocketCAN();
-# elif defined(CONFIG_CAN)
-	_can_interface = new CanardNuttXCDev();
-# endif // CONFIG_CAN
-#endif // NuttX
-
 }
 
 CanardHandle::~CanardHandle()
 {
-	_can_interface->close();
-	delete _can_interface;
-	_can_interface = nullptr;
+	for (size_t i = 0; i < _tx_pending_count; i++) {
+		_canard_instance.memory_free(&_canard_instance, _tx_pending[i]);
+	}
+
+	_tx_pending_count = 0;
+
+	perf_free(_tx_frames_perf);
+	perf_free(_tx_batch_perf);
+	perf_free(_tx_stale_perf);
+	perf_free(_tx_error_perf);
+	perf_free(_tx_latency_perf);
+
+	if (_can_interface) {
+		_can_interface->close();
+		delete _can_interface;
+		_can_interface = nullptr;
+	}
 
 	delete static_cast<uint8_t *>(_cyphal_heap);
 	_cyphal_heap = nullptr;
@@ -153,24 +181,79 @@ void CanardHandle::receive()
 
 void CanardHandle::transmit()
 {
-	// Look at the top of the TX queue.
-	for (const CanardTxQueueItem *ti = NULL; (ti = canardTxPeek(&_queue)) != NULL;) { // Peek at the top of the queue.
-		if ((0U == ti->tx_deadline_usec) || (ti->tx_deadline_usec > hrt_absolute_time())) { // Check the deadline.
-			// Send the frame. Redundant interfaces may be used here.
-			const int tx_res = _can_interface->transmit(*ti);
+	for (;;) {
+		const hrt_abstime now = hrt_absolute_time();
+
+		// Drop frames that expired while the interface was busy instead of sending them late
+		size_t kept = 0;
+
+		for (size_t i = 0; i < _tx_pending_count; i++) {
+			CanardTxQueueItem *item = _tx_pending[i];
 
-			if (tx_res < 0) {
-				PX4_ERR("Transmit error %d, frame dropped, errno '%s'", tx_res, strerror(errno));
+			if ((0U != item->tx_deadline_usec) && (item->tx_deadline_usec <= now)) {
+				_canard_instance.memory_free(&_canard_instance, item);
+				perf_count(_tx_stale_perf);
 
-			} else if (tx_res == 0) {
-				// Timeout - just exit and try again later
-				break;
+			} else {
+				_tx_pending[kept++] = item;
 			}
+		}
+
+		_tx_pending_count = kept;
 
+		// Fill the batch from the top of the TX queue, the queue is ordered by priority and then by transfer order
+		for (const CanardTxQueueItem *ti = NULL; (_tx_pending_count < TxBatchSize) && (ti = canardTxPeek(&_queue)) != NULL;) {
+			CanardTxQueueItem *item = canardTxPop(&_queue, ti);
+
+			if ((0U == item->tx_deadline_usec) || (item->tx_deadline_usec > now)) { // Check the deadline.
+				_tx_pending[_tx_pending_count++] = item;
+
+			} else {
+				_canard_instance.memory_free(&_canard_instance, item);
+				perf_count(_tx_stale_perf);
+			}
+		}
+
+		if (_tx_pending_count == 0) {
+			// Queue drained, record how long the backlog has been waiting
+			if (_tx_backlog_since != 0) {
+				perf_set_elapsed(_tx_latency_perf, now - _tx_backlog_since);
+				_tx_backlog_since = 0;
+			}
+
+			break;
+		}
+
+		// Send the frames. Redundant interfaces may be used here.
+		const int tx_res = _can_interface->transmit_batch(_tx_pending, _tx_pending_count);
+		size_t done = 0;
+
+		if (tx_res < 0) {
+			// Drop the offending frame, the rest of the batch is retried
+			PX4_ERR("Transmit error %d, frame dropped, errno '%s'", tx_res, strerror(errno));
+			perf_count(_tx_error_perf);
+			done = 1;
+
+		} else if (tx_res == 0) {
+			// Timeout - just exit and try again later
+			break;
+
+		} else {
+			done = math::min(static_cast<size_t>(tx_res), _tx_pending_count);
+			perf_count(_tx_batch_perf);
+			perf_set_count(_tx_frames_perf, perf_event_count(_tx_frames_perf) + done);
 		}
 
-		// After the frame is transmitted or if it has timed out while waiting, pop it from the queue and deallocate:
-		_canard_instance.memory_free(&_canard_instance, canardTxPop(&_queue, ti));
+		// After the frames are transmitted, deallocate them and keep the remainder in order
+		for (size_t i = 0; i < done; i++) {
+			_canard_instance.memory_free(&_canard_instance, _tx_pending[i]);
+		}
+
+		for (size_t i = done; i < _tx_pending_count; i++) {
+			_tx_pending[i - done] = _tx_pending[i];
+		}
+
+		_tx_pending_count -= done;
 	}
 }
 
@@ -179,7 +262,19 @@ int32_t CanardHandle::TxPush(const CanardMicrosecond             tx_deadline_use
 			     const size_t                        payload_size,
 			     const void *const                   payload)
 {
-	return canardTxPush(&_queue, &_canard_instance, tx_deadline_usec, metadata, payload_size, payload);
+	const bool was_idle = (_queue.size == 0) && (_tx_pending_count == 0);
+
+	const int32_t result = canardTxPush(&_queue, &_canard_instance, tx_deadline_usec, metadata, payload_size, payload);
+
+	if (result > 0) {
+		if (was_idle) {
+			_tx_backlog_since = hrt_absolute_time();
+		}
+
+		_tx_queue_peak = math::max(_tx_queue_peak, _queue.size + _tx_pending_count);
+	}
+
+	return result;
 }
 
 int8_t CanardHandle::RxSubscribe(const CanardTransferKind    transfer_kind,
@@ -221,3 +316,14 @@ void CanardHandle::set_node_id(CanardNodeID id)
 {
 	_canard_instance.node_id = id;
 }
+
+void CanardHandle::printInfo()
+{
+	PX4_INFO("TX queue %zu/%zu (pending %zu) Peak %zu", _queue.size, _queue.capacity, _tx_pending_count, _tx_queue_peak);
+
+	perf_print_counter(_tx_frames_perf);
+	perf_print_counter(_tx_batch_perf);
+	perf_print_counter(_tx_stale_perf);
+	perf_print_counter(_tx_error_perf);
+	perf_print_counter(_tx_latency_perf);
+}
@@ -34,6 +34,8 @@
 #pragma once
 
 #include <canard.h>
+#include <drivers/drv_hrt.h>
+#include <lib/perf/perf_counter.h>
 #include "o1heap/o1heap.h"
 #include "CanardInterface.hpp"
 
@@ -47,8 +49,16 @@ class CanardHandle
 	*/
 	static constexpr unsigned HeapSize = 8192;
 
+	/*
+	* Maximum number of frames handed to the CAN interface per transmit_batch() call
+	*/
+	static constexpr size_t TxBatchSize = 8;
+
 public:
 	CanardHandle(uint32_t node_id, const size_t capacity, const size_t mtu_bytes);
+
+	/// Use the given CAN interface instead of the platform one, the handle takes ownership of it
+	CanardHandle(uint32_t node_id, const size_t capacity, const size_t mtu_bytes, CanardInterface *can_interface);
 	~CanardHandle();
 
 	bool init();
@@ -71,12 +81,14 @@ public:
 	CanardTreeNode *getRxSubscriptions(CanardTransferKind kind);
 	O1HeapDiagnostics getO1HeapDiagnostics();
 
+	void printInfo();
+
 	int32_t mtu();
 	CanardNodeID node_id();
 	void set_node_id(CanardNodeID id);
 
 private:
-	CanardInterface *_can_interface;
+	CanardInterface *_can_interface{nullptr};
 
 	CanardInstance _canard_instance;
 
@@ -84,4 +96,17 @@ private:
 
 	void *_cyphal_heap{nullptr};
 
+	// Frames popped from the TX queue that the interface has not accepted yet, in queue order
+	CanardTxQueueItem *_tx_pending[TxBatchSize] {};
+	size_t _tx_pending_count{0};
+
+	size_t _tx_queue_peak{0};
+	hrt_abstime _tx_backlog_since{0};
+
+	perf_counter_t _tx_frames_perf{perf_alloc(PC_COUNT, MODULE_NAME": tx frames")};
+	perf_counter_t _tx_batch_perf{perf_alloc(PC_COUNT, MODULE_NAME": tx batches")};
+	perf_counter_t _tx_stale_perf{perf_alloc(PC_COUNT, MODULE_NAME": tx stale dropped")};
+	perf_counter_t _tx_error_perf{perf_alloc(PC_COUNT, MODULE_NAME": tx errors")};
+	perf_counter_t _tx_latency_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": tx queue latency")};
+
 };
@@ -0,0 +1,320 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the CanardHandle TX queue drain
+ * Run this test only using make tests TESTFILTER=CanardHandle
+ *
+ * The libcanard TX queue is replaced by a fake which emits one frame per transfer,
+ * ordered by priority and then by push order like the libcanard queue.
+ */
+
+#include <gtest/gtest.h>
+
+#include <px4_platform_common/time.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "CanardHandle.hpp"
+
+static std::vector<CanardTxQueueItem *> fake_tx_queue;
+
+static uint32_t frameId(CanardPriority priority, CanardTransferID transfer_id)
+{
+	return (static_cast<uint32_t>(priority) << 26) | transfer_id;
+}
+
+extern "C" {
+
+	CanardInstance canardInit(const CanardMemoryAllocate memory_allocate, const CanardMemoryFree memory_free)
+	{
+		CanardInstance ins{};
+		ins.node_id = CANARD_NODE_ID_UNSET;
+		ins.memory_allocate = memory_allocate;
+		ins.memory_free = memory_free;
+		return ins;
+	}
+
+	CanardTxQueue canardTxInit(const size_t capacity, const size_t mtu_bytes)
+	{
+		CanardTxQueue que{};
+		que.capacity = capacity;
+		que.mtu_bytes = mtu_bytes;
+		return que;
+	}
+
+	int32_t canardTxPush(CanardTxQueue *const que, CanardInstance *const ins, const CanardMicrosecond tx_deadline_usec,
+			     const CanardTransferMetadata *const metadata, const size_t payload_size, const void *const payload)
+	{
+		if (que->size >= que->capacity) {
+			return -CANARD_ERROR_OUT_OF_MEMORY;
+		}
+
+		CanardTxQueueItem *item = static_cast<CanardTxQueueItem *>(ins->memory_allocate(ins, sizeof(CanardTxQueueItem)));
+
+		if (item == nullptr) {
+			return -CANARD_ERROR_OUT_OF_MEMORY;
+		}
+
+		*item = {};
+		item->tx_deadline_usec = tx_deadline_usec;
+		item->frame.extended_can_id = frameId(metadata->priority, metadata->transfer_id);
+
+		// after all frames of the same or higher priority (lower value)
+		auto it = std::find_if(fake_tx_queue.begin(), fake_tx_queue.end(), [item](const CanardTxQueueItem * queued) {
+			return (queued->frame.extended_can_id >> 26) > (item->frame.extended_can_id >> 26);
+		});
+
+		fake_tx_queue.insert(it, item);
+		que->size++;
+		return 1;
+	}
+
+	const CanardTxQueueItem *canardTxPeek(const CanardTxQueue *const que)
+	{
+		return fake_tx_queue.empty() ? nullptr : fake_tx_queue.front();
+	}
+
+	CanardTxQueueItem *canardTxPop(CanardTxQueue *const que, const CanardTxQueueItem *const item)
+	{
+		if (fake_tx_queue.empty() || (fake_tx_queue.front() != item)) {
+			return nullptr;
+		}
+
+		fake_tx_queue.erase(fake_tx_queue.begin());
+		que->size--;
+		return const_cast<CanardTxQueueItem *>(item);
+	}
+
+	int8_t canardRxAccept(CanardInstance *const ins, const CanardMicrosecond timestamp_usec, const CanardFrame *const frame,
+			      const uint8_t redundant_iface_index, CanardRxTransfer *const out_transfer,
+			      CanardRxSubscription **const out_subscription)
+	{
+		return 0;
+	}
+
+	int8_t canardRxSubscribe(CanardInstance *const ins, const CanardTransferKind transfer_kind, const CanardPortID port_id,
+				 const size_t extent, const CanardMicrosecond transfer_id_timeout_usec,
+				 CanardRxSubscription *const out_subscription)
+	{
+		return 0;
+	}
+
+	int8_t canardRxUnsubscribe(CanardInstance *const ins, const CanardTransferKind transfer_kind,
+				   const CanardPortID port_id)
+	{
+		return 0;
+	}
+
+} // extern "C"
+
+// CAN interface accepting a limited number of frames, like a driver with a full TX mailbox
+class FakeCanInterface : public CanardInterface
+{
+public:
+	int16_t transmit(const CanardTxQueueItem &txframe, int timeout_ms = 0) override { return 0; }
+	int16_t receive(CanardRxFrame *rxf) override { return 0; }
+
+	int transmit_batch(const CanardTxQueueItem *const txframes[], size_t count) override
+	{
+		batches++;
+
+		if (fail_next) {
+			fail_next = false;
+			return -1;
+		}
+
+		const size_t accepted = std::min(count, budget);
+
+		for (size_t i = 0; i < accepted; i++) {
+			sent.push_back(txframes[i]->frame.extended_can_id);
+		}
+
+		budget -= accepted;
+		return static_cast<int>(accepted);
+	}
+
+	std::vector<uint32_t> sent;
+	size_t budget{SIZE_MAX};
+	int batches{0};
+	bool fail_next{false};
+};
+
+class CanardHandleTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		fake_tx_queue.clear();
+		_can_interface = new FakeCanInterface();
+		_handle = new CanardHandle(1, QUEUE_CAPACITY, CANARD_MTU_CAN_CLASSIC, _can_interface);
+	}
+
+	void TearDown() override
+	{
+		delete _handle;
+		fake_tx_queue.clear();
+	}
+
+	void push(CanardPriority priority, CanardTransferID transfer_id, CanardMicrosecond deadline)
+	{
+		CanardTransferMetadata metadata{};
+		metadata.priority = priority;
+		metadata.transfer_kind = CanardTransferKindMessage;
+		metadata.port_id = 100;
+		metadata.remote_node_id = CANARD_NODE_ID_UNSET;
+		metadata.transfer_id = transfer_id;
+
+		ASSERT_EQ(_handle->TxPush(deadline, &metadata, 0, nullptr), 1);
+	}
+
+	size_t heapAllocated() { return _handle->getO1HeapDiagnostics().allocated; }
+
+	static constexpr size_t QUEUE_CAPACITY = 64;
+	static constexpr CanardMicrosecond DEADLINE_US = 1000000;
+
+	FakeCanInterface *_can_interface{nullptr}; // owned by _handle
+	CanardHandle *_handle{nullptr};
+};
+
+TEST_F(CanardHandleTest, partialBatchesKeepQueueOrder)
+{
+	// GIVEN: 20 frames in the queue and an interface that takes 5 frames before its mailbox is full
+	const hrt_abstime now = hrt_absolute_time();
+
+	for (CanardTransferID i = 0; i < 20; i++) {
+		push(CanardPriorityNominal, i, now + DEADLINE_US);
+	}
+
+	_can_interface->budget = 5;
+
+	// WHEN: the queue is drained
+	_handle->transmit();
+
+	// THEN: the first 5 frames are sent and the next full batch (frames 5 to 12) stays pending
+	ASSERT_EQ(_can_interface->sent.size(), 5u);
+
+	// WHEN: a higher priority frame is queued while frames are pending and the mailbox frees up
+	push(CanardPriorityHigh, 31, now + DEADLINE_US);
+	_can_interface->budget = SIZE_MAX;
+	_handle->transmit();
+
+	// THEN: the pending frames go first, in order, then the queue in priority order
+	std::vector<uint32_t> expected;
+
+	for (CanardTransferID i = 0; i < 13; i++) {
+		expected.push_back(frameId(CanardPriorityNominal, i));
+	}
+
+	expected.push_back(frameId(CanardPriorityHigh, 31));
+
+	for (CanardTransferID i = 13; i < 20; i++) {
+		expected.push_back(frameId(CanardPriorityNominal, i));
+	}
+
+	EXPECT_EQ(_can_interface->sent, expected);
+	EXPECT_TRUE(fake_tx_queue.empty());
+	EXPECT_EQ(heapAllocated(), 0u);
+}
+
+TEST_F(CanardHandleTest, staleFramesAreDropped)
+{
+	// GIVEN: every third frame in the queue has expired
+	const hrt_abstime now = hrt_absolute_time();
+	std::vector<uint32_t> expected;
+
+	for (CanardTransferID i = 0; i < 12; i++) {
+		if (i % 3 == 0) {
+			push(CanardPriorityNominal, i, now - 1);
+
+		} else {
+			push(CanardPriorityNominal, i, now + DEADLINE_US);
+			expected.push_back(frameId(CanardPriorityNominal, i));
+		}
+	}
+
+	// WHEN: the queue is drained
+	_handle->transmit();
+
+	// THEN: only the live frames are sent and the stale ones are freed
+	EXPECT_EQ(_can_interface->sent, expected);
+	EXPECT_EQ(heapAllocated(), 0u);
+}
+
+TEST_F(CanardHandleTest, framesExpiringWhilePendingAreDropped)
+{
+	// GIVEN: 4 frames with a short deadline and 4 with a long one, the interface is busy
+	const hrt_abstime now = hrt_absolute_time();
+
+	for (CanardTransferID i = 0; i < 8; i++) {
+		push(CanardPriorityNominal, i, now + ((i < 4) ? 20000 : DEADLINE_US));
+	}
+
+	_can_interface->budget = 0;
+	_handle->transmit();
+	ASSERT_TRUE(_can_interface->sent.empty());
+
+	// WHEN: the interface frees up after the short deadline has passed
+	px4_usleep(30000);
+	_can_interface->budget = SIZE_MAX;
+	_handle->transmit();
+
+	// THEN: the pending frames that expired are not sent late
+	const std::vector<uint32_t> expected{
+		frameId(CanardPriorityNominal, 4), frameId(CanardPriorityNominal, 5),
+		frameId(CanardPriorityNominal, 6), frameId(CanardPriorityNominal, 7)};
+	EXPECT_EQ(_can_interface->sent, expected);
+	EXPECT_EQ(heapAllocated(), 0u);
+}
+
+TEST_F(CanardHandleTest, transmitErrorDropsOneFrame)
+{
+	// GIVEN: 3 frames in the queue
+	const hrt_abstime now = hrt_absolute_time();
+
+	for (CanardTransferID i = 0; i < 3; i++) {
+		push(CanardPriorityNominal, i, now + DEADLINE_US);
+	}
+
+	// WHEN: the interface fails the first batch
+	_can_interface->fail_next = true;
+	_handle->transmit();
+
+	// THEN: only the offending frame is dropped, the others are sent in order
+	const std::vector<uint32_t> expected{frameId(CanardPriorityNominal, 1), frameId(CanardPriorityNominal, 2)};
+	EXPECT_EQ(_can_interface->sent, expected);
+	EXPECT_EQ(_can_interface->batches, 2);
+	EXPECT_EQ(heapAllocated(), 0u);
+}
@@ -35,6 +35,9 @@
 
 #include <canard.h>
 
+static constexpr uint16_t CANARD_PORT_ID_UNSET = 65535U;
+static constexpr uint16_t CANARD_PORT_ID_MAX   = 32767U;
+
 /// One frame stored in the transmission queue along with its metadata.
 struct CanardRxFrame {
 	CanardMicrosecond timestamp_usec;
@@ -58,6 +61,22 @@ public:
 	/// The return value is number of bytes transferred, negative value on error.
 	virtual int16_t transmit(const CanardTxQueueItem &txframe, int timeout_ms = 0) = 0;
 
+	/// Send up to count CanardFrames in order
+	/// Drivers that can hand several frames to the kernel at once should override this
+	/// The return value is number of frames transferred, negative value if the first frame failed.
+	virtual int transmit_batch(const CanardTxQueueItem *const txframes[], size_t count)
+	{
+		for (size_t i = 0; i < count; i++) {
+			const int16_t result = transmit(*txframes[i]);
+
+			if (result <= 0) {
+				return (i == 0) ? result : static_cast<int>(i);
+			}
+		}
+
+		return static_cast<int>(count);
+	}
+
 	/// Receive a CanardFrame
 	/// This function is blocking
 	/// The return value is number of bytes received, negative value on error.
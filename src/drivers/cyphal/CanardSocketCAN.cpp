@@ -108,28 +108,33 @@ int CanardSocketCAN::init()
 		return -1;
 	}
 
-	// Setup TX msg
-	_send_iov.iov_base = &_send_frame;
+	// Setup TX msgs
+	for (size_t i = 0; i < TxBatchSize; i++) {
+		SendSlot &slot = _send_slots[i];
+		struct msghdr &send_msg = sendMsg(i);
 
-	if (_can_fd) {
-		_send_iov.iov_len = sizeof(struct canfd_frame);
+		slot.iov.iov_base = &slot.frame;
 
-	} else {
-		_send_iov.iov_len = sizeof(struct can_frame);
-	}
+		if (_can_fd) {
+			slot.iov.iov_len = sizeof(struct canfd_frame);
 
-	memset(&_send_control, 0x00, sizeof(_send_control));
+		} else {
+			slot.iov.iov_len = sizeof(struct can_frame);
+		}
+
+		memset(&slot.control, 0x00, sizeof(slot.control));
 
-	_send_msg.msg_iov    = &_send_iov;
-	_send_msg.msg_iovlen = 1;
-	_send_msg.msg_control = &_send_control;
-	_send_msg.msg_controllen = sizeof(_send_control);
+		send_msg.msg_iov    = &slot.iov;
+		send_msg.msg_iovlen = 1;
+		send_msg.msg_control = &slot.control;
+		send_msg.msg_controllen = sizeof(slot.control);
 
-	_send_cmsg = CMSG_FIRSTHDR(&_send_msg);
-	_send_cmsg->cmsg_level = SOL_CAN_RAW;
-	_send_cmsg->cmsg_type = CAN_RAW_TX_DEADLINE;
-	_send_cmsg->cmsg_len = sizeof(struct timeval);
-	_send_tv = (struct timeval *)CMSG_DATA(_send_cmsg);
+		struct cmsghdr *send_cmsg = CMSG_FIRSTHDR(&send_msg);
+		send_cmsg->cmsg_level = SOL_CAN_RAW;
+		send_cmsg->cmsg_type = CAN_RAW_TX_DEADLINE;
+		send_cmsg->cmsg_len = sizeof(struct timeval);
+		slot.tv = (struct timeval *)CMSG_DATA(send_cmsg);
+	}
 
 	// Setup RX msg
 	_recv_iov.iov_base = &_recv_frame;
@@ -152,29 +157,64 @@ int CanardSocketCAN::init()
 	return 0;
 }
 
-int16_t CanardSocketCAN::transmit(const CanardTxQueueItem &txf, int timeout_ms)
+void CanardSocketCAN::fillSendSlot(size_t index, const CanardTxQueueItem &txf, int64_t monotonic_offset_usec)
 {
+	SendSlot &slot = _send_slots[index];
+
 	/* Copy CanardFrame to can_frame/canfd_frame */
 	if (_can_fd) {
-		_send_frame.can_id = txf.frame.extended_can_id | CAN_EFF_FLAG;
-		_send_frame.len = txf.frame.payload_size;
-		memcpy(&_send_frame.data, txf.frame.payload, txf.frame.payload_size);
+		slot.frame.can_id = txf.frame.extended_can_id | CAN_EFF_FLAG;
+		slot.frame.len = txf.frame.payload_size;
+		memcpy(&slot.frame.data, txf.frame.payload, txf.frame.payload_size);
 
 	} else {
-		struct can_frame *frame = (struct can_frame *)&_send_frame;
+		struct can_frame *frame = (struct can_frame *)&slot.frame;
 		frame->can_id = txf.frame.extended_can_id | CAN_EFF_FLAG;
 		frame->can_dlc = txf.frame.payload_size;
 		memcpy(&frame->data, txf.frame.payload, txf.frame.payload_size);
 	}
 
-	uint64_t deadline_systick = getMonotonicTimestampUSec() + (txf.tx_deadline_usec - hrt_absolute_time()) +
+	uint64_t deadline_systick = txf.tx_deadline_usec + monotonic_offset_usec +
 				    CONFIG_USEC_PER_TICK; // Compensate for precision loss when converting hrt to systick
 
 	/* Set CAN_RAW_TX_DEADLINE timestamp  */
-	_send_tv->tv_usec = deadline_systick % 1000000ULL;
-	_send_tv->tv_sec = (deadline_systick - _send_tv->tv_usec) / 1000000ULL;
+	slot.tv->tv_usec = deadline_systick % 1000000ULL;
+	slot.tv->tv_sec = (deadline_systick - slot.tv->tv_usec) / 1000000ULL;
+}
+
+int16_t CanardSocketCAN::transmit(const CanardTxQueueItem &txf, int timeout_ms)
+{
+	fillSendSlot(0, txf, getMonotonicTimestampUSec() - hrt_absolute_time());
+
+	return sendmsg(_fd, &sendMsg(0), 0);
+}
+
+int CanardSocketCAN::transmit_batch(const CanardTxQueueItem *const txframes[], size_t count)
+{
+	if (count > TxBatchSize) {
+		count = TxBatchSize;
+	}
+
+	// hrt and the systick based deadline clock only need to be related once per batch
+	const int64_t monotonic_offset_usec = getMonotonicTimestampUSec() - hrt_absolute_time();
+
+	for (size_t i = 0; i < count; i++) {
+		fillSendSlot(i, *txframes[i], monotonic_offset_usec);
+	}
+
+#if defined(CONFIG_CYPHAL_SOCKETCAN_SENDMMSG)
+	// A partial send returns the number of frames transferred, the remaining frames are retried by the caller
+	return sendmmsg(_fd, _send_msgs, count, 0);
+#else
+
+	for (size_t i = 0; i < count; i++) {
+		if (sendmsg(_fd, &sendMsg(i), 0) <= 0) {
+			return (i == 0) ? -1 : static_cast<int>(i);
+		}
+	}
 
-	return sendmsg(_fd, &_send_msg, 0);
+	return static_cast<int>(count);
+#endif
 }
 
 int16_t CanardSocketCAN::receive(CanardRxFrame *rxf)
@@ -73,6 +73,11 @@ public:
 	/// The return value is number of bytes transferred, negative value on error.
 	int16_t transmit(const CanardTxQueueItem &txframe, int timeout_ms = 0);
 
+	/// Send up to TxBatchSize CanardFrames to the CanardSocketInstance socket
+	/// Uses a single sendmmsg call when CONFIG_CYPHAL_SOCKETCAN_SENDMMSG is enabled
+	/// The return value is number of frames transferred, negative value if the first frame failed.
+	int transmit_batch(const CanardTxQueueItem *const txframes[], size_t count) override;
+
 	/// Receive a CanardFrame from the CanardSocketInstance socket
 	/// This function is blocking
 	/// The return value is number of bytes received, negative value on error.
@@ -81,18 +86,39 @@ public:
 	// TODO implement ioctl for CAN filter
 	//int16_t socketcanConfigureFilter(const fd_t fd, const size_t num_filters, const struct can_filter *filters);
 
+	static constexpr size_t TxBatchSize = 8;
+
 private:
 
+	/// Copy a CanardFrame and its TX deadline into send slot index
+	void fillSendSlot(size_t index, const CanardTxQueueItem &txf, int64_t monotonic_offset_usec);
+
+	struct msghdr &sendMsg(size_t index)
+	{
+#if defined(CONFIG_CYPHAL_SOCKETCAN_SENDMMSG)
+		return _send_msgs[index].msg_hdr;
+#else
+		return _send_msgs[index];
+#endif
+	}
+
 	int               _fd{-1};
 	bool              _can_fd{false};
 
-	//// Send msg structure
-	struct iovec       _send_iov {};
-	struct canfd_frame _send_frame {};
-	struct msghdr      _send_msg {};
-	struct cmsghdr     *_send_cmsg {};
-	struct timeval     *_send_tv {};  /* TX deadline timestamp */
-	uint8_t            _send_control[sizeof(struct cmsghdr) + sizeof(struct timeval)] {};
+	//// Send msg structures, one per frame of a batch
+	struct SendSlot {
+		struct iovec       iov {};
+		struct canfd_frame frame {};
+		struct timeval     *tv {};  /* TX deadline timestamp */
+		uint8_t            control[sizeof(struct cmsghdr) + sizeof(struct timeval)] {};
+	};
+
+	SendSlot           _send_slots[TxBatchSize] {};
+#if defined(CONFIG_CYPHAL_SOCKETCAN_SENDMMSG)
+	struct mmsghdr     _send_msgs[TxBatchSize] {};
+#else
+	struct msghdr      _send_msgs[TxBatchSize] {};
+#endif
 
 	//// Receive msg structure
 	struct iovec       _recv_iov {};
@@ -255,6 +255,8 @@ void CyphalNode::print_info()
 		 heap_diagnostics.peak_allocated, heap_diagnostics.peak_request_size,
 		 heap_diagnostics.oom_count);
 
+	_canard_handle.printInfo();
+
 	_pub_manager.printInfo();
 
 	PX4_INFO("Message subscriptions:");
@@ -47,8 +47,7 @@
 #include <uavcan/_register/Name_1_0.h>
 #include <uavcan/_register/Value_1_0.h>
 
-static constexpr uint16_t CANARD_PORT_ID_UNSET = 65535U;
-static constexpr uint16_t CANARD_PORT_ID_MAX   = 32767U;
+#include "CanardInterface.hpp"
 
 static bool px4_param_to_uavcan_port_id(param_t &in, uavcan_register_Value_1_0 &out)
 {
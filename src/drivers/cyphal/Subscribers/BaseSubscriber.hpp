@@ -48,7 +48,6 @@
 
 #include "../CanardHandle.hpp"
 #include "../CanardInterface.hpp"
-#include "../ParamManager.hpp"
 
 class UavcanBaseSubscriber
 {
@@ -144,12 +144,13 @@ __EXPORT extern void up_bdshot_status(void);
 
 
 /**
- * Get bidrectional dshot erpm for a channel
- * @param channel	Dshot channel
- * @param erpm		pointer to write the erpm value
- * @return <0 on error, OK on succes
+ * Get the bidrectional dshot erpm of all channels decoded in the last cycle
+ * @param erpm		array of num_channels to write the erpm values to (only set for the channels in the returned mask)
+ * @param error_count	array of num_channels to write the total number of decoding errors to
+ * @param num_channels	number of channels
+ * @return mask of the channels with a new erpm value
  */
-__EXPORT extern int up_bdshot_get_erpm(uint8_t channel, int *erpm);
+__EXPORT extern uint32_t up_bdshot_get_erpms(uint16_t erpm[], uint32_t error_count[], unsigned num_channels);
 
 
 /**
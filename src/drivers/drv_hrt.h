@@ -84,6 +84,9 @@ typedef struct hrt_call {
 	hrt_callout		usr_callout;
 	void			*usr_arg;
 #endif
+#if defined(__PX4_POSIX)
+	unsigned		heap_index;	// position in the callout heap, only valid while queued
+#endif
 } *hrt_call_t;
 
 
@@ -49,6 +49,8 @@ DShot::DShot() :
 
 	// Avoid using the PWM failsafe params
 	_mixing_output.setAllFailsafeValues(UINT16_MAX);
+
+	_mixing_output.setOutputContinuationAllowed(true);
 }
 
 DShot::~DShot()
@@ -299,30 +301,40 @@ void DShot::publish_esc_status(void)
 
 int DShot::handle_new_bdshot_erpm(void)
 {
+	// get the responses of all channels decoded in the last cycle at once
+	uint16_t erpms[DIRECT_PWM_OUTPUT_CHANNELS] {};
+	uint32_t error_counts[DIRECT_PWM_OUTPUT_CHANNELS] {};
+	const uint32_t erpm_mask = up_bdshot_get_erpms(erpms, error_counts, _num_outputs);
+
+	if (erpm_mask == 0) {
+		return 0;
+	}
+
 	int num_erpms = 0;
 	int telemetry_index = 0;
-	int erpm;
+	const hrt_abstime now = hrt_absolute_time();
+	const int pole_pairs = _param_mot_pole_count.get() / 2;
 	esc_status_s &esc_status = _telemetry->esc_status_pub.get();
 
-	esc_status.timestamp = hrt_absolute_time();
+	esc_status.timestamp = now;
 	esc_status.counter = _esc_status_counter++;
 	esc_status.esc_connectiontype = esc_status_s::ESC_CONNECTION_TYPE_DSHOT;
 	esc_status.esc_armed_flags = _outputs_on;
 
-	for (unsigned i = 0; i < _num_outputs; i++) {
+	for (unsigned i = 0; i < _num_outputs && telemetry_index < esc_status_s::CONNECTED_ESC_MAX; i++) {
 		if (_mixing_output.isFunctionSet(i)) {
-			if (up_bdshot_get_erpm(i, &erpm) == 0) {
+			if (erpm_mask & (1u << i)) {
 				num_erpms++;
 				esc_status.esc_online_flags |= 1 << telemetry_index;
-				esc_status.esc[telemetry_index].timestamp = hrt_absolute_time();
-				esc_status.esc[telemetry_index].esc_rpm = (erpm * 100) / (_param_mot_pole_count.get() / 2);
+				esc_status.esc[telemetry_index].timestamp = now;
+				esc_status.esc[telemetry_index].esc_rpm = (erpms[i] * 100) / pole_pairs;
 				esc_status.esc[telemetry_index].actuator_function = _telemetry->actuator_functions[telemetry_index];
 			}
 
+			esc_status.esc[telemetry_index].esc_errorcount = error_counts[i];
+
 			++telemetry_index;
 		}
-
-
 	}
 
 	return num_erpms;
@@ -40,6 +40,7 @@ PWMOut::PWMOut() :
 {
 	_pwm_mask = ((1u << DIRECT_PWM_OUTPUT_CHANNELS) - 1);
 	_mixing_output.setMaxNumOutputs(DIRECT_PWM_OUTPUT_CHANNELS);
+	_mixing_output.setOutputContinuationAllowed(true);
 
 	// Getting initial parameter values
 	update_params();
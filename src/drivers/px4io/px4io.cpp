@@ -79,6 +79,7 @@
 #include <debug.h>
 
 #include <modules/px4iofirmware/protocol.h>
+#include <lib/px4io_transaction/PX4IOTransaction.hpp>
 
 #include "uploader.h"
 
@@ -108,7 +109,7 @@ public:
 	 * Initialize all class variables.
 	 */
 	PX4IO() = delete;
-	explicit PX4IO(device::Device *interface);
+	explicit PX4IO(PX4IO_serial *interface);
 
 	~PX4IO() override;
 
@@ -168,7 +169,11 @@ private:
 
 	static constexpr int PX4IO_MAX_ACTUATORS = 8;
 
-	device::Device *const _interface;
+	static constexpr unsigned IO_STATUS_REGS = PX4IO_P_STATUS_VRSSI - PX4IO_P_STATUS_FLAGS + 1;
+	static constexpr unsigned RC_PROLOG = PX4IO_P_RAW_RC_BASE - PX4IO_P_RAW_RC_COUNT;
+	static constexpr unsigned RC_POLL_CHANNELS = 9; ///< channels read every poll (9 channel R/C control being a reasonable upper bound)
+
+	PX4IO_serial *const _interface;
 
 	unsigned		_hardware{0};		///< Hardware revision
 	unsigned		_max_actuators{0};		///< Maximum # of actuators supported by PX4IO
@@ -187,6 +192,15 @@ private:
 	perf_counter_t	_interval_perf{perf_alloc(PC_INTERVAL, MODULE_NAME": interval")};
 	perf_counter_t	_interface_read_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": interface read")};
 	perf_counter_t	_interface_write_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": interface write")};
+	perf_counter_t	_interface_transfer_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": interface transfer")};
+
+	/* queued multi-page transaction, see io_transfer() */
+	px4io::Transaction	_transaction{};
+
+	/* outputs from the last mixer update, sent with the next transfer */
+	uint16_t		_outputs[PX4IO_MAX_ACTUATORS] {};
+	unsigned		_num_outputs{0};
+	bool			_outputs_pending{false};
 
 	/* cached IO state */
 	uint16_t		_status{0};		///< Various IO status flags
@@ -238,19 +252,24 @@ private:
 	int			io_set_arming_state();
 
 	/**
-	 * Fetch status and alarms from IO
+	 * Handle status and alarms read from IO
 	 *
 	 * Also publishes battery voltage/current.
+	 *
+	 * @param status_regs	IO_STATUS_REGS registers starting at PX4IO_P_STATUS_FLAGS.
+	 * @param setup_arming	The PX4IO_P_SETUP_ARMING register.
 	 */
-	int			io_get_status();
+	int			io_get_status(const uint16_t status_regs[IO_STATUS_REGS], uint16_t setup_arming);
 
 	/**
-	 * Fetch RC inputs from IO.
+	 * Publish RC inputs read from IO.
 	 *
-	 * @param input_rc	Input structure to populate.
+	 * @param regs		Raw R/C input page starting at PX4IO_P_RAW_RC_COUNT, with the prolog and
+	 *			the first RC_POLL_CHANNELS channels filled in. Further channels are read
+	 *			into it if required.
 	 * @return		OK if data was returned.
 	 */
-	int			io_publish_raw_rc();
+	int			io_publish_raw_rc(uint16_t regs[RC_PROLOG + input_rc_s::RC_INPUT_MAX_CHANNELS]);
 
 	/**
 	 * write register(s)
@@ -304,6 +323,35 @@ private:
 	 */
 	int			io_reg_modify(uint8_t page, uint8_t offset, uint16_t clearbits, uint16_t setbits);
 
+	/**
+	 * queue a register read for the next io_transfer()
+	 *
+	 * @param page		Register page to read from.
+	 * @param offset	Register offset to start reading from.
+	 * @param values	Pointer to array where values are stored once the transfer completes.
+	 * @param num_values	The number of values to read.
+	 * @return		false if the transaction has no room left.
+	 */
+	bool			io_queue_get(uint8_t page, uint8_t offset, uint16_t *values, unsigned num_values);
+
+	/**
+	 * queue a register write for the next io_transfer()
+	 *
+	 * @param page		Register page to write to.
+	 * @param offset	Register offset to start writing at.
+	 * @param values	Pointer to array of values to write, copied into the transaction.
+	 * @param num_values	The number of values to write.
+	 * @return		false if the transaction has no room left.
+	 */
+	bool			io_queue_set(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values);
+
+	/**
+	 * exchange all queued register operations with IO in a single transaction
+	 *
+	 * @return		OK if all operations succeeded.
+	 */
+	int			io_transfer();
+
 	/**
 	 * Handle a status update from IO.
 	 *
@@ -341,7 +389,7 @@ private:
 
 #define PX4IO_DEVICE_PATH	"/dev/px4io"
 
-PX4IO::PX4IO(device::Device *interface) :
+PX4IO::PX4IO(PX4IO_serial *interface) :
 	CDev(PX4IO_DEVICE_PATH),
 	OutputModuleInterface(MODULE_NAME, px4::serial_port_to_wq(PX4IO_SERIAL_DEVICE)),
 	_interface(interface)
@@ -358,6 +406,7 @@ PX4IO::~PX4IO()
 	perf_free(_interval_perf);
 	perf_free(_interface_read_perf);
 	perf_free(_interface_write_perf);
+	perf_free(_interface_transfer_perf);
 }
 
 bool PX4IO::updateOutputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS],
@@ -371,8 +420,10 @@ bool PX4IO::updateOutputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS],
 	}
 
 	if (!_test_fmu_fail) {
-		/* output to the servos */
-		io_reg_set(PX4IO_PAGE_DIRECT_PWM, 0, outputs, num_outputs);
+		/* output to the servos with the next transfer, see Run() */
+		_num_outputs = math::min(num_outputs, (unsigned)PX4IO_MAX_ACTUATORS);
+		memcpy(_outputs, outputs, _num_outputs * sizeof(outputs[0]));
+		_outputs_pending = true;
 	}
 
 	return true;
@@ -524,15 +575,37 @@ void PX4IO::Run()
 	/* if we have new control data from the ORB, handle it */
 	_mixing_output.update();
 
-	if (hrt_elapsed_time(&_poll_last) >= 20_ms) {
+	/* outputs, status, alarms and raw R/C input are exchanged with IO in a single transaction */
+	if (_outputs_pending) {
+		io_queue_set(PX4IO_PAGE_DIRECT_PWM, 0, _outputs, _num_outputs);
+		_outputs_pending = false;
+	}
+
+	uint16_t status_regs[IO_STATUS_REGS] {};
+	uint16_t setup_arming = 0;
+	uint16_t rc_regs[RC_PROLOG + input_rc_s::RC_INPUT_MAX_CHANNELS] {};
+
+	const bool poll = (hrt_elapsed_time(&_poll_last) >= 20_ms);
+
+	if (poll) {
 		/* run at 50 */
 		_poll_last = hrt_absolute_time();
 
-		/* pull status and alarms from IO */
-		io_get_status();
+		io_queue_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, status_regs, IO_STATUS_REGS);
+		io_queue_get(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING, &setup_arming, 1);
+		io_queue_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, rc_regs, RC_PROLOG + RC_POLL_CHANNELS);
+	}
+
+	if (!_transaction.empty()) {
+		const int transfer_ret = io_transfer();
+
+		if (poll && (transfer_ret == OK)) {
+			/* handle status and alarms from IO */
+			io_get_status(status_regs, setup_arming);
 
-		/* get raw R/C input from IO */
-		io_publish_raw_rc();
+			/* publish raw R/C input from IO */
+			io_publish_raw_rc(rc_regs);
+		}
 	}
 
 	/* check updates on uORB topics and handle it */
@@ -915,23 +988,18 @@ int PX4IO::dsm_bind_ioctl(int dsmMode)
 	return ret;
 }
 
-int PX4IO::io_get_status()
+int PX4IO::io_get_status(const uint16_t status_regs[IO_STATUS_REGS], uint16_t setup_arming)
 {
-	/* get
+	/* status_regs holds
 	 * STATUS_FLAGS, STATUS_ALARMS, STATUS_VBATT, STATUS_IBATT,
 	 * STATUS_VSERVO, STATUS_VRSSI
 	 * in that order */
-	uint16_t regs[6] {};
-	int ret = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, &regs[0], sizeof(regs) / sizeof(regs[0]));
-
-	if (ret != OK) {
-		return ret;
-	}
+	int ret = OK;
 
-	const uint16_t STATUS_FLAGS  = regs[0];
-	const uint16_t STATUS_ALARMS = regs[1];
-	const uint16_t STATUS_VSERVO = regs[4];
-	const uint16_t STATUS_VRSSI  = regs[5];
+	const uint16_t STATUS_FLAGS  = status_regs[0];
+	const uint16_t STATUS_ALARMS = status_regs[1];
+	const uint16_t STATUS_VSERVO = status_regs[4];
+	const uint16_t STATUS_VRSSI  = status_regs[5];
 
 	io_handle_status(STATUS_FLAGS);
 
@@ -947,7 +1015,7 @@ int PX4IO::io_get_status()
 		_analog_rc_rssi_stable = true;
 	}
 
-	const uint16_t SETUP_ARMING = io_reg_get(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING);
+	const uint16_t SETUP_ARMING = setup_arming;
 
 	if ((hrt_elapsed_time(&_last_status_publish) >= 1_s)
 	    || (_status != STATUS_FLAGS)
@@ -960,7 +1028,20 @@ int PX4IO::io_get_status()
 		status.voltage_v = STATUS_VSERVO * 0.001f; // voltage is scaled to mV
 		status.rssi_v = rssi_v;
 
-		status.free_memory_bytes = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FREEMEM);
+		/* fetch the remaining status details in one transaction */
+		uint16_t free_memory = 0;
+		uint16_t raw_inputs = 0;
+		io_queue_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FREEMEM, &free_memory, 1);
+		io_queue_get(PX4IO_PAGE_SERVOS, 0, status.pwm, _max_actuators);
+		io_queue_get(PX4IO_PAGE_DISARMED_PWM, 0, status.pwm_disarmed, _max_actuators);
+		io_queue_get(PX4IO_PAGE_FAILSAFE_PWM, 0, status.pwm_failsafe, _max_actuators);
+		// This is a bit different than below, setting the groups, not the channels
+		io_queue_get(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_PWM_RATE_GROUP0, status.pwm_rate_hz,
+			     PX4IO_P_SETUP_PWM_RATE_GROUP3 - PX4IO_P_SETUP_PWM_RATE_GROUP0 + 1);
+		io_queue_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, &raw_inputs, 1);
+		io_transfer();
+
+		status.free_memory_bytes = free_memory;
 
 		// PX4IO_P_STATUS_FLAGS
 		status.status_outputs_armed   = STATUS_FLAGS & PX4IO_P_STATUS_FLAGS_OUTPUTS_ARMED;
@@ -991,25 +1072,10 @@ int PX4IO::io_get_status()
 		status.arming_force_failsafe       = SETUP_ARMING & PX4IO_P_SETUP_ARMING_FORCE_FAILSAFE;
 		status.arming_termination_failsafe = SETUP_ARMING & PX4IO_P_SETUP_ARMING_TERMINATION_FAILSAFE;
 
-		for (unsigned i = 0; i < _max_actuators; i++) {
-			status.pwm[i] = io_reg_get(PX4IO_PAGE_SERVOS, i);
-			status.pwm_disarmed[i] = io_reg_get(PX4IO_PAGE_DISARMED_PWM, i);
-			status.pwm_failsafe[i] = io_reg_get(PX4IO_PAGE_FAILSAFE_PWM, i);
-		}
-
-		{
-			int i = 0;
-
-			for (uint8_t offset = PX4IO_P_SETUP_PWM_RATE_GROUP0; offset <= PX4IO_P_SETUP_PWM_RATE_GROUP3; ++offset) {
-				// This is a bit different than below, setting the groups, not the channels
-				status.pwm_rate_hz[i++] = io_reg_get(PX4IO_PAGE_SETUP, offset);
-			}
-		}
-
-		uint16_t raw_inputs = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT);
+		raw_inputs = math::min((unsigned)raw_inputs, _max_rc_input);
 
-		for (unsigned i = 0; (i < raw_inputs) && (i < _max_rc_input); i++) {
-			status.raw_inputs[i] = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_BASE + i);
+		if (raw_inputs > 0) {
+			io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_BASE, status.raw_inputs, raw_inputs);
 		}
 
 		status.timestamp = hrt_absolute_time();
@@ -1024,9 +1090,9 @@ int PX4IO::io_get_status()
 	return ret;
 }
 
-int PX4IO::io_publish_raw_rc()
+int PX4IO::io_publish_raw_rc(uint16_t regs[RC_PROLOG + input_rc_s::RC_INPUT_MAX_CHANNELS])
 {
-	const uint16_t rc_valid_update_count = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_FRAME_COUNT);
+	const uint16_t rc_valid_update_count = regs[PX4IO_P_RAW_FRAME_COUNT];
 	const bool rc_updated = (rc_valid_update_count != _rc_valid_update_count);
 	_rc_valid_update_count = rc_valid_update_count;
 
@@ -1043,23 +1109,11 @@ int PX4IO::io_publish_raw_rc()
 	/* we don't have the status bits, so input_source has to be set elsewhere */
 	input_rc.input_source = input_rc_s::RC_INPUT_SOURCE_UNKNOWN;
 
-	const unsigned prolog = (PX4IO_P_RAW_RC_BASE - PX4IO_P_RAW_RC_COUNT);
-	uint16_t regs[input_rc_s::RC_INPUT_MAX_CHANNELS + prolog];
-
-	/*
-	 * Read the channel count and the first 9 channels.
-	 *
-	 * This should be the common case (9 channel R/C control being a reasonable upper bound).
-	 */
-	int ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, &regs[0], prolog + 9);
-
-	if (ret != OK) {
-		return ret;
-	}
+	const unsigned prolog = RC_PROLOG;
+	int ret = OK;
 
 	/*
-	 * Get the channel count any any extra channels. This is no more expensive than reading the
-	 * channel count once.
+	 * The channel count and the first RC_POLL_CHANNELS channels were read with the poll transfer.
 	 */
 	uint32_t channel_count = regs[PX4IO_P_RAW_RC_COUNT];
 
@@ -1099,8 +1153,9 @@ int PX4IO::io_publish_raw_rc()
 	/* FIELDS NOT SET HERE */
 	/* input_rc.input_source is set after this call XXX we might want to mirror the flags in the RC struct */
 
-	if (channel_count > 9) {
-		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_BASE + 9, &regs[prolog + 9], channel_count - 9);
+	if (channel_count > RC_POLL_CHANNELS) {
+		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_BASE + RC_POLL_CHANNELS, &regs[prolog + RC_POLL_CHANNELS],
+				 channel_count - RC_POLL_CHANNELS);
 
 		if (ret != OK) {
 			return ret;
@@ -1224,6 +1279,57 @@ int PX4IO::io_reg_modify(uint8_t page, uint8_t offset, uint16_t clearbits, uint1
 	return io_reg_set(page, offset, value);
 }
 
+bool PX4IO::io_queue_get(uint8_t page, uint8_t offset, uint16_t *values, unsigned num_values)
+{
+	if (!_transaction.queue_get(page, offset, values, num_values, _max_transfer / 2)) {
+		PX4_DEBUG("io_queue_get(%" PRIu8 ",%" PRIu8 ",%u): transaction full", page, offset, num_values);
+		return false;
+	}
+
+	return true;
+}
+
+bool PX4IO::io_queue_set(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values)
+{
+	if (!_transaction.queue_set(page, offset, values, num_values, _max_transfer / 2)) {
+		PX4_DEBUG("io_queue_set(%" PRIu8 ",%" PRIu8 ",%u): transaction full", page, offset, num_values);
+		return false;
+	}
+
+	return true;
+}
+
+int PX4IO::io_transfer()
+{
+	uint16_t reply[PKT_MAX_REGS];
+	int ret;
+
+	if (_transaction.single_write()) {
+		/* a lone write is cheaper as a plain write transaction */
+		const uint16_t *request = _transaction.request();
+		ret = io_reg_set(request[0] >> 8, request[0] & 0xff, &request[2], request[1] & PKT_MULTI_COUNT_MASK);
+
+	} else {
+		perf_begin(_interface_transfer_perf);
+		ret = _interface->transfer(_transaction.request(), _transaction.request_count(), reply,
+					   _transaction.reply_count());
+		perf_end(_interface_transfer_perf);
+
+		if (ret == OK) {
+			/* scatter the read registers to their destinations */
+			_transaction.set_reply(reply);
+		}
+	}
+
+	if (ret != OK) {
+		PX4_DEBUG("io_transfer(%u,%u): error %d", _transaction.request_count(), _transaction.reply_count(), ret);
+	}
+
+	_transaction.clear();
+
+	return ret;
+}
+
 int PX4IO::print_status()
 {
 	/* basic configuration */
@@ -1399,9 +1505,9 @@ int PX4IO::ioctl(file *filep, int cmd, unsigned long arg)
 	return ret;
 }
 
-static device::Device *get_interface()
+static PX4IO_serial *get_interface()
 {
-	device::Device *interface = PX4IO_serial_interface();
+	PX4IO_serial *interface = PX4IO_serial_interface();
 
 	if (interface != nullptr) {
 		if (interface->init() != OK) {
@@ -1424,7 +1530,7 @@ int PX4IO::checkcrc(int argc, char *argv[])
 		return 1;
 	}
 
-	device::Device *interface = get_interface();
+	PX4IO_serial *interface = get_interface();
 
 	if (interface == nullptr) {
 		PX4_ERR("interface allocation failed");
@@ -1516,7 +1622,7 @@ int PX4IO::bind(int argc, char *argv[])
 
 int PX4IO::task_spawn(int argc, char *argv[])
 {
-	device::Device *interface = get_interface();
+	PX4IO_serial *interface = get_interface();
 
 	if (interface == nullptr) {
 		PX4_ERR("Failed to create interface");
@@ -1574,7 +1680,7 @@ int PX4IO::custom_command(int argc, char *argv[])
 
 		while (ret != OK && retries < MAX_RETRIES) {
 
-			device::Device *interface = get_interface();
+			PX4IO_serial *interface = get_interface();
 
 			if (interface == nullptr) {
 				PX4_ERR("interface allocation failed");
@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include "bdshot_decode.h"
+
+// encode a 12 bit value the way an ESC sends it (checksum, GCR, RLL), as captured by the receiver (inverted)
+static uint32_t encode(uint16_t value)
+{
+	static constexpr uint8_t gcr_encode[16] = {
+		0x19, 0x1B, 0x12, 0x13, 0x1D, 0x15, 0x16, 0x17, 0x1A, 0x09, 0x0A, 0x0B, 0x1E, 0x0D, 0x0E, 0x0F
+	};
+
+	const uint32_t csum = ~(value ^ (value >> 4) ^ (value >> 8)) & 0xF;
+	const uint32_t data = (value << 4) | csum;
+	uint32_t gcr = 0;
+
+	for (int i = 0; i < 4; ++i) {
+		gcr |= (uint32_t)gcr_encode[(data >> (4 * i)) & 0xF] << (5 * i);
+	}
+
+	uint32_t level = 0;
+	uint32_t previous = 0;
+
+	for (int i = 19; i >= 0; --i) {
+		previous ^= (gcr >> i) & 1;
+		level |= previous << i;
+	}
+
+	return ~level & 0xFFFFF;
+}
+
+TEST(BDShotDecodeTest, ReferenceResponses)
+{
+	// response words generated with encode() above, with the expected eRPM / 100
+	EXPECT_EQ(bdshot_decode_frame(0xad6ae), 0xFFF);
+	EXPECT_EQ(bdshot_value_to_erpm(0xFFF), 0);
+
+	EXPECT_EQ(bdshot_decode_frame(0x22994), 0x6FA); // 250us << 3
+	EXPECT_EQ(bdshot_value_to_erpm(0x6FA), 300);
+
+	EXPECT_EQ(bdshot_decode_frame(0x1729c), 0x32C); // 300us << 1
+	EXPECT_EQ(bdshot_value_to_erpm(0x32C), 1000);
+
+	EXPECT_EQ(bdshot_decode_frame(0x75272), 0x0C8); // 200us
+	EXPECT_EQ(bdshot_value_to_erpm(0x0C8), 3000);
+
+	// only the lower 20 bits are relevant
+	EXPECT_EQ(bdshot_decode_frame(0xfff75272), 0x0C8);
+}
+
+TEST(BDShotDecodeTest, AllValues)
+{
+	for (uint16_t value = 0; value < 4096; ++value) {
+		EXPECT_EQ(bdshot_decode_frame(encode(value)), value);
+	}
+
+	// zero period must not divide by zero
+	EXPECT_EQ(bdshot_value_to_erpm(0), 0);
+}
+
+TEST(BDShotDecodeTest, BitErrors)
+{
+	int frame_errors = 0;
+	int gcr_errors = 0;
+	int crc_errors = 0;
+	int undetected = 0;
+
+	for (uint16_t value = 0; value < 4096; ++value) {
+		const uint32_t raw = encode(value);
+
+		for (int bit = 0; bit < 20; ++bit) {
+			const int decoded = bdshot_decode_frame(raw ^ (1u << bit));
+			EXPECT_NE(decoded, value);
+
+			switch (decoded) {
+			case BDSHOT_DECODE_FRAME_ERROR:
+				++frame_errors;
+				break;
+
+			case BDSHOT_DECODE_GCR_ERROR:
+				++gcr_errors;
+				break;
+
+			case BDSHOT_DECODE_CRC_ERROR:
+				++crc_errors;
+				break;
+
+			default:
+				++undetected;
+				break;
+			}
+		}
+	}
+
+	// every flip of the first bit is a framing error, GCR symbol checks catch errors the checksum does not
+	EXPECT_EQ(frame_errors, 4096);
+	EXPECT_GT(gcr_errors, 0);
+	EXPECT_GT(crc_errors, 0);
+	EXPECT_LT(undetected, 4096 * 20 / 100);
+}
+
+TEST(BDShotDecodeTest, Batch)
+{
+	uint32_t raw[8] {};
+	uint16_t erpm[8] {};
+	bdshot_decode_stats_t stats[8] {};
+
+	raw[0] = encode(0x6FA);
+	raw[1] = encode(0x32C) ^ (1u << 7); // corrupted
+	raw[2] = encode(0x0C8);
+	raw[3] = encode(0xFFF);
+	raw[5] = encode(0x32C) | 1u; // framing error
+	raw[6] = encode(0x0C8);
+	erpm[6] = 1234;
+
+	// channel 6 did not respond, 7 is not enabled
+	const uint32_t recv_mask = 0b0010'1111;
+	const uint32_t decoded = bdshot_decode_erpm_batch(raw, recv_mask, 8, erpm, stats);
+
+	EXPECT_EQ(decoded, 0b1101u);
+	EXPECT_EQ(erpm[0], 300);
+	EXPECT_EQ(erpm[2], 3000);
+	EXPECT_EQ(erpm[3], 0);
+	EXPECT_EQ(erpm[6], 1234);
+
+	EXPECT_EQ(stats[0].frames, 1u);
+	EXPECT_EQ(bdshot_decode_error_count(&stats[0]), 0u);
+	EXPECT_EQ(stats[1].frames, 0u);
+	EXPECT_EQ(bdshot_decode_error_count(&stats[1]), 1u);
+	EXPECT_EQ(stats[5].frame_errors, 1u);
+	EXPECT_EQ(stats[6].frames + bdshot_decode_error_count(&stats[6]), 0u);
+}
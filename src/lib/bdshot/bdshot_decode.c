@@ -0,0 +1,138 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "bdshot_decode.h"
+
+#define GCR_INVALID	0x10u
+
+// GCR quintet -> nibble, GCR_INVALID for symbols that cannot occur
+static const uint8_t gcr_decode[32] = {
+	GCR_INVALID, GCR_INVALID, GCR_INVALID, GCR_INVALID, GCR_INVALID, GCR_INVALID, GCR_INVALID, GCR_INVALID,
+	GCR_INVALID, 0x9, 0xA, 0xB, GCR_INVALID, 0xD, 0xE, 0xF,
+	GCR_INVALID, GCR_INVALID, 0x2, 0x3, GCR_INVALID, 0x5, 0x6, 0x7,
+	GCR_INVALID, 0x0, 0x8, 0x1, GCR_INVALID, 0x4, 0xC, GCR_INVALID
+};
+
+static inline int decode_frame(uint32_t raw)
+{
+	uint32_t value = ~raw & 0xFFFFFu;
+
+	// if the lowest significant bit isn't 1 we've got a framing error
+	if ((value & 0x1u) == 0) {
+		return BDSHOT_DECODE_FRAME_ERROR;
+	}
+
+	// RLL
+	value = value ^ (value >> 1);
+
+	// GCR: the invalid marker of any symbol ends up in the OR of all 4 nibbles
+	const uint32_t n0 = gcr_decode[value & 0x1fu];
+	const uint32_t n1 = gcr_decode[(value >> 5) & 0x1fu];
+	const uint32_t n2 = gcr_decode[(value >> 10) & 0x1fu];
+	const uint32_t n3 = gcr_decode[(value >> 15) & 0x1fu];
+
+	if ((n0 | n1 | n2 | n3) & GCR_INVALID) {
+		return BDSHOT_DECODE_GCR_ERROR;
+	}
+
+	const uint32_t data = n0 | (n1 << 4) | (n2 << 8) | (n3 << 12);
+
+	// checksum: xor of all nibbles is 0xF
+	uint32_t csum = data ^ (data >> 8);
+	csum = csum ^ (csum >> 4);
+
+	if ((csum & 0xFu) != 0xFu) {
+		return BDSHOT_DECODE_CRC_ERROR;
+	}
+
+	return (int)(data >> 4);
+}
+
+static inline uint16_t value_to_erpm(uint16_t value)
+{
+	if (value == 0xFFF) {
+		// motor stopped
+		return 0;
+	}
+
+	const uint32_t exponent = (value >> 9) & 0x7u;
+	const uint32_t period = (uint32_t)(value & 0x1ffu) << exponent; // period in usec
+
+	if (period == 0) {
+		return 0;
+	}
+
+	return (uint16_t)((1000000u * 60u / 100u + period / 2u) / period);
+}
+
+int bdshot_decode_frame(uint32_t raw)
+{
+	return decode_frame(raw);
+}
+
+uint16_t bdshot_value_to_erpm(uint16_t value)
+{
+	return value_to_erpm(value);
+}
+
+uint32_t bdshot_decode_erpm_batch(const uint32_t raw[], uint32_t recv_mask, unsigned num_channels,
+				  uint16_t erpm[], bdshot_decode_stats_t stats[])
+{
+	uint32_t decoded_mask = 0;
+
+	for (unsigned channel = 0; channel < num_channels && recv_mask != 0; channel++, recv_mask >>= 1) {
+		if ((recv_mask & 1u) == 0) {
+			continue;
+		}
+
+		const int value = decode_frame(raw[channel]);
+
+		if (value >= 0) {
+			erpm[channel] = value_to_erpm((uint16_t)value);
+			stats[channel].frames++;
+			decoded_mask |= 1u << channel;
+
+		} else if (value == BDSHOT_DECODE_CRC_ERROR) {
+			stats[channel].crc_errors++;
+
+		} else if (value == BDSHOT_DECODE_GCR_ERROR) {
+			stats[channel].gcr_errors++;
+
+		} else {
+			stats[channel].frame_errors++;
+		}
+	}
+
+	return decoded_mask;
+}
@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file bdshot_decode.h
+ *
+ * Decoder for bidirectional DShot (eRPM) responses.
+ *
+ * A response is 20 bits on the wire: the 16 bit payload (12 bit eRPM period value + 4 bit checksum)
+ * is GCR encoded (4 -> 5 bits) and then run length limited encoded (a 1 is a level transition).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define BDSHOT_DECODE_FRAME_ERROR	-1	///< invalid frame (start level)
+#define BDSHOT_DECODE_GCR_ERROR		-2	///< invalid GCR symbol
+#define BDSHOT_DECODE_CRC_ERROR		-3	///< checksum mismatch
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+typedef struct bdshot_decode_stats_t {
+	uint32_t frames;		///< successfully decoded frames
+	uint32_t frame_errors;
+	uint32_t gcr_errors;
+	uint32_t crc_errors;
+} bdshot_decode_stats_t;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/**
+ * Decode a single response.
+ * @param raw captured (inverted) response, the lower 20 bits are used
+ * @return the 12 bit value (>= 0) or BDSHOT_DECODE_*_ERROR
+ */
+int bdshot_decode_frame(uint32_t raw);
+
+/**
+ * Convert a decoded 12 bit value (3 bit exponent, 9 bit period base) into eRPM / 100.
+ */
+uint16_t bdshot_value_to_erpm(uint16_t value);
+
+/**
+ * Decode the responses of all channels of an output cycle in one pass.
+ * @param raw captured responses, one per channel
+ * @param recv_mask channels for which a response got captured
+ * @param num_channels number of entries in raw, erpm and stats (<= 32)
+ * @param erpm output eRPM / 100 for each decoded channel (other entries are left untouched)
+ * @param stats per channel statistics to update
+ * @return mask of the successfully decoded channels
+ */
+uint32_t bdshot_decode_erpm_batch(const uint32_t raw[], uint32_t recv_mask, unsigned num_channels,
+				  uint16_t erpm[], bdshot_decode_stats_t stats[]);
+
+/**
+ * Sum of all decoding errors
+ */
+static inline uint32_t bdshot_decode_error_count(const bdshot_decode_stats_t *stats)
+{
+	return stats->frame_errors + stats->gcr_errors + stats->crc_errors;
+}
+
+#ifdef __cplusplus
+}
+#endif
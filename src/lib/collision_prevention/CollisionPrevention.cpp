@@ -88,6 +88,12 @@ CollisionPrevention::CollisionPrevention(ModuleParams *parent) :
 		_data_fov[i] = 0;
 		_obstacle_map_body_frame.distances[i] = UINT16_MAX;
 	}
+
+	// bin directions in body frame, rotated by the vehicle yaw instead of evaluating trig per bin and cycle
+	for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) {
+		const float angle = math::radians((float)i * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset);
+		_bin_direction_body[i] = Vector2f{cosf(angle), sinf(angle)};
+	}
 }
 
 hrt_abstime CollisionPrevention::getTime()
@@ -115,53 +121,42 @@ bool CollisionPrevention::is_active()
 void
 CollisionPrevention::_addObstacleSensorData(const obstacle_distance_s &obstacle, const matrix::Quatf &vehicle_attitude)
 {
-	int msg_index = 0;
-	float vehicle_orientation_deg = math::degrees(Eulerf(vehicle_attitude).psi());
-	float increment_factor = 1.f / obstacle.increment;
+	float heading_offset_deg = 0.f;
 
 	if (obstacle.frame == obstacle.MAV_FRAME_GLOBAL || obstacle.frame == obstacle.MAV_FRAME_LOCAL_NED) {
 		// Obstacle message arrives in local_origin frame (north aligned)
 		// corresponding data index (convert to world frame and shift by msg offset)
-		for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) {
-			float bin_angle_deg = (float)i * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset;
-			msg_index = ceil(wrap_360(vehicle_orientation_deg + bin_angle_deg - obstacle.angle_offset) * increment_factor);
-
-			//add all data points inside to FOV
-			if (obstacle.distances[msg_index] != UINT16_MAX) {
-				if (_enterData(i, obstacle.max_distance * 0.01f, obstacle.distances[msg_index] * 0.01f)) {
-					_obstacle_map_body_frame.distances[i] = obstacle.distances[msg_index];
-					_data_timestamps[i] = _obstacle_map_body_frame.timestamp;
-					_data_maxranges[i] = obstacle.max_distance;
-					_data_fov[i] = 1;
-				}
-			}
-		}
+		heading_offset_deg = math::degrees(Eulerf(vehicle_attitude).psi());
 
 	} else if (obstacle.frame == obstacle.MAV_FRAME_BODY_FRD) {
 		// Obstacle message arrives in body frame (front aligned)
 		// corresponding data index (shift by msg offset)
-		for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) {
-			float bin_angle_deg = (float)i * INTERNAL_MAP_INCREMENT_DEG +
-					      _obstacle_map_body_frame.angle_offset;
-			msg_index = ceil(wrap_360(bin_angle_deg - obstacle.angle_offset) * increment_factor);
-
-			//add all data points inside to FOV
-			if (obstacle.distances[msg_index] != UINT16_MAX) {
-
-				if (_enterData(i, obstacle.max_distance * 0.01f, obstacle.distances[msg_index] * 0.01f)) {
-					_obstacle_map_body_frame.distances[i] = obstacle.distances[msg_index];
-					_data_timestamps[i] = _obstacle_map_body_frame.timestamp;
-					_data_maxranges[i] = obstacle.max_distance;
-					_data_fov[i] = 1;
-				}
-			}
-		}
+		heading_offset_deg = 0.f;
 
 	} else {
 		mavlink_log_critical(&_mavlink_log_pub, "Obstacle message received in unsupported frame %i\t",
 				     obstacle.frame);
 		events::send<uint8_t>(events::ID("col_prev_unsup_frame"), events::Log::Error,
 				      "Obstacle message received in unsupported frame {1}", obstacle.frame);
+		return;
+	}
+
+	const float increment_factor = 1.f / obstacle.increment;
+	const float max_distance = obstacle.max_distance * 0.01f;
+
+	for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) {
+		const float bin_angle_deg = (float)i * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset;
+		const int msg_index = ceil(wrap_360(heading_offset_deg + bin_angle_deg - obstacle.angle_offset) * increment_factor);
+
+		//add all data points inside to FOV
+		if (obstacle.distances[msg_index] != UINT16_MAX) {
+			if (_enterData(i, max_distance, obstacle.distances[msg_index] * 0.01f)) {
+				_obstacle_map_body_frame.distances[i] = obstacle.distances[msg_index];
+				_data_timestamps[i] = _obstacle_map_body_frame.timestamp;
+				_data_maxranges[i] = obstacle.max_distance;
+				_data_fov[i] = 1;
+			}
+		}
 	}
 }
 
@@ -201,6 +196,7 @@ void
 CollisionPrevention::_updateObstacleMap()
 {
 	_sub_vehicle_attitude.update();
+	const Quatf vehicle_attitude{_sub_vehicle_attitude.get().q};
 
 	// add distance sensor data
 	for (auto &dist_sens_sub : _distance_sensor_subs) {
@@ -219,24 +215,26 @@ CollisionPrevention::_updateObstacleMap()
 				_obstacle_map_body_frame.min_distance = math::min(_obstacle_map_body_frame.min_distance,
 									(uint16_t)(distance_sensor.min_distance * 100.0f));
 
-				_addDistanceSensorData(distance_sensor, Quatf(_sub_vehicle_attitude.get().q));
+				_addDistanceSensorData(distance_sensor, vehicle_attitude);
 			}
 		}
 	}
 
-	// add obstacle distance data
-	if (_sub_obstacle_distance.update()) {
-		const obstacle_distance_s &obstacle_distance = _sub_obstacle_distance.get();
-
-		// Update map with obstacle data if the data is not stale
-		if (getElapsedTime(&obstacle_distance.timestamp) < RANGE_STREAM_TIMEOUT_US && obstacle_distance.increment > 0.f) {
-			//update message description
-			_obstacle_map_body_frame.timestamp = math::max(_obstacle_map_body_frame.timestamp, obstacle_distance.timestamp);
-			_obstacle_map_body_frame.max_distance = math::max(_obstacle_map_body_frame.max_distance,
-								obstacle_distance.max_distance);
-			_obstacle_map_body_frame.min_distance = math::min(_obstacle_map_body_frame.min_distance,
-								obstacle_distance.min_distance);
-			_addObstacleSensorData(obstacle_distance, Quatf(_sub_vehicle_attitude.get().q));
+	// add obstacle distance data of all instances that published since the last update
+	for (auto &obstacle_distance_sub : _obstacle_distance_subs) {
+		obstacle_distance_s obstacle_distance;
+
+		if (obstacle_distance_sub.update(&obstacle_distance)) {
+			// Update map with obstacle data if the data is not stale
+			if (getElapsedTime(&obstacle_distance.timestamp) < RANGE_STREAM_TIMEOUT_US && obstacle_distance.increment > 0.f) {
+				//update message description
+				_obstacle_map_body_frame.timestamp = math::max(_obstacle_map_body_frame.timestamp, obstacle_distance.timestamp);
+				_obstacle_map_body_frame.max_distance = math::max(_obstacle_map_body_frame.max_distance,
+									obstacle_distance.max_distance);
+				_obstacle_map_body_frame.min_distance = math::min(_obstacle_map_body_frame.min_distance,
+									obstacle_distance.min_distance);
+				_addObstacleSensorData(obstacle_distance, vehicle_attitude);
+			}
 		}
 	}
 
@@ -330,9 +328,7 @@ CollisionPrevention::_adaptSetpointDirection(Vector2f &setpoint_dir, int &setpoi
 
 	//only change setpoint direction if it was moved to a different bin
 	if (new_sp_index != setpoint_index) {
-		float angle = math::radians((float)new_sp_index * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset);
-		angle = wrap_2pi(vehicle_yaw_angle_rad + angle);
-		setpoint_dir = {cosf(angle), sinf(angle)};
+		setpoint_dir = Dcm2f(vehicle_yaw_angle_rad) * _bin_direction_body[new_sp_index];
 		setpoint_index = new_sp_index;
 	}
 }
@@ -419,6 +415,12 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 			// change setpoint direction slightly (max by _param_cp_guide_ang degrees) to help guide through narrow gaps
 			_adaptSetpointDirection(setpoint_dir, sp_index, vehicle_yaw_angle_rad);
 
+			// rotate setpoint direction and velocity into the body frame once, so that the per bin projections
+			// only need the precomputed bin directions
+			const Dcm2f R_body_to_local(vehicle_yaw_angle_rad);
+			const Vector2f setpoint_dir_body = R_body_to_local.transpose() * setpoint_dir;
+			const Vector2f curr_vel_body = R_body_to_local.transpose() * curr_vel;
+
 			// limit speed for safe flight
 			for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) { // disregard unused bins at the end of the message
 
@@ -431,13 +433,9 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 
 				const float distance = _obstacle_map_body_frame.distances[i] * 0.01f; // convert to meters
 				const float max_range = _data_maxranges[i] * 0.01f; // convert to meters
-				float angle = math::radians((float)i * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset);
-
-				// convert from body to local frame in the range [0, 2*pi]
-				angle = wrap_2pi(vehicle_yaw_angle_rad + angle);
 
 				// get direction of current bin
-				const Vector2f bin_direction = {cosf(angle), sinf(angle)};
+				const Vector2f &bin_direction = _bin_direction_body[i];
 
 				//count number of bins in the field of valid_new
 				if (_obstacle_map_body_frame.distances[i] < UINT16_MAX) {
@@ -447,9 +445,11 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 				if (_obstacle_map_body_frame.distances[i] > _obstacle_map_body_frame.min_distance
 				    && _obstacle_map_body_frame.distances[i] < UINT16_MAX) {
 
-					if (setpoint_dir.dot(bin_direction) > 0) {
+					const float projection = bin_direction.dot(setpoint_dir_body);
+
+					if (projection > 0) {
 						// calculate max allowed velocity with a P-controller (same gain as in the position controller)
-						const float curr_vel_parallel = math::max(0.f, curr_vel.dot(bin_direction));
+						const float curr_vel_parallel = math::max(0.f, curr_vel_body.dot(bin_direction));
 						float delay_distance = curr_vel_parallel * col_prev_dly;
 
 						if (distance < max_range) {
@@ -460,7 +460,6 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 						const float vel_max_posctrl = xy_p * stop_distance;
 
 						const float vel_max_smooth = math::trajectory::computeMaxSpeedFromDistance(max_jerk, max_accel, stop_distance, 0.f);
-						const float projection = bin_direction.dot(setpoint_dir);
 						float vel_max_bin = vel_max;
 
 						if (projection > 0.01f) {
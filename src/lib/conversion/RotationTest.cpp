@@ -37,6 +37,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <string.h>
 
 #include "rotation.h"
 
@@ -103,3 +104,39 @@ TEST(Rotations, duplicates)
 		}
 	}
 }
+
+TEST(Rotations, block_vs_3i)
+{
+	static constexpr int N = 32;
+
+	// iterate through all defined rotations
+	for (size_t i = 0; i < (size_t)Rotation::ROTATION_MAX; i++) {
+
+		// GIVEN: a block of raw samples including the int16 limits
+		const enum Rotation rotation = static_cast<Rotation>(i);
+
+		int16_t x[N], y[N], z[N];
+
+		for (int n = 0; n < N; n++) {
+			x[n] = (n == 0) ? INT16_MIN : (int16_t)(n * 997 - 16000);
+			y[n] = (n == 1) ? INT16_MAX : (int16_t)(12000 - n * 731);
+			z[n] = (int16_t)((n % 7) * 4099 - 14000);
+		}
+
+		// WHEN: we rotate each sample with rotate_3i and the whole block at once
+		int16_t x_block[N], y_block[N], z_block[N];
+		memcpy(x_block, x, sizeof(x));
+		memcpy(y_block, y, sizeof(y));
+		memcpy(z_block, z, sizeof(z));
+		rotate_3i(rotation, x_block, y_block, z_block, N);
+
+		for (int n = 0; n < N; n++) {
+			rotate_3i(rotation, x[n], y[n], z[n]);
+
+			// THEN: the results should be identical
+			EXPECT_EQ(x[n], x_block[n]) << "Rotation " << i << " sample " << n;
+			EXPECT_EQ(y[n], y_block[n]) << "Rotation " << i << " sample " << n;
+			EXPECT_EQ(z[n], z_block[n]) << "Rotation " << i << " sample " << n;
+		}
+	}
+}
@@ -388,6 +388,36 @@ __EXPORT inline void rotate_3i(enum Rotation rot, int16_t &x, int16_t &y, int16_
 	}
 }
 
+/**
+ * rotate a block of 3 element int16_t vectors (eg raw FIFO samples) in-place
+ *
+ * Same result as rotate_3i() for every sample, but the rotation is only resolved once per block
+ * (in particular the rotation matrix for rotations without a simple axis swap).
+ */
+__EXPORT inline void rotate_3i(enum Rotation rot, int16_t x[], int16_t y[], int16_t z[], int len)
+{
+	if ((rot == ROTATION_NONE) || (len <= 0)) {
+		return;
+	}
+
+	if (rotate_3(rot, x[0], y[0], z[0])) {
+		for (int n = 1; n < len; n++) {
+			rotate_3(rot, x[n], y[n], z[n]);
+		}
+
+	} else if (rot < ROTATION_MAX) {
+		// otherwise use full rotation matrix for valid rotations
+		const matrix::Dcmf R{get_rot_matrix(rot)};
+
+		for (int n = 0; n < len; n++) {
+			const matrix::Vector3f r{R *matrix::Vector3f{(float)x[n], (float)y[n], (float)z[n]}};
+			x[n] = math::constrain(roundf(r(0)), (float)INT16_MIN, (float)INT16_MAX);
+			y[n] = math::constrain(roundf(r(1)), (float)INT16_MIN, (float)INT16_MAX);
+			z[n] = math::constrain(roundf(r(2)), (float)INT16_MIN, (float)INT16_MAX);
+		}
+	}
+}
+
 /**
  * rotate a 3 element float vector in-place
  */
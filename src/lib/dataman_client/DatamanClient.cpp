@@ -284,6 +284,48 @@ bool DatamanClient::readAsync(dm_item_t item, uint32_t index, uint8_t *buffer, u
 	return success;
 }
 
+bool DatamanClient::readBatchAsync(dm_item_t item, uint32_t index, uint32_t count, uint8_t *const buffers[],
+				   uint32_t length)
+{
+	if (length > g_per_item_size[item]) {
+		PX4_ERR("Length  %" PRIu32 " can't fit in data size for item  %" PRIi8, length, static_cast<uint8_t>(item));
+		return false;
+	}
+
+	if (count == 0 || count > DM_READ_BATCH_MAX_ITEMS) {
+		PX4_ERR("Invalid batch size %" PRIu32, count);
+		return false;
+	}
+
+	bool success = false;
+
+	if (_state == State::Idle) {
+
+		_active_request.timestamp = hrt_absolute_time();
+		_active_request.request_type = DM_READ_BATCH;
+		_active_request.item = item;
+		_active_request.index = index;
+		_active_request.buffer = nullptr;
+		_active_request.length = length;
+		_active_request.count = count;
+		_active_request.received_mask = 0;
+		_active_request.failed_mask = 0;
+
+		for (uint32_t i = 0; i < count; ++i) {
+			_active_request.batch_buffers[i] = buffers[i];
+		}
+
+		_response_status = dataman_response_s::STATUS_SUCCESS;
+		_state = State::RequestSent;
+
+		publishActiveRequest();
+
+		success = true;
+	}
+
+	return success;
+}
+
 bool DatamanClient::writeAsync(dm_item_t item, uint32_t index, uint8_t *buffer, uint32_t length)
 {
 	if (length > g_per_item_size[item]) {
@@ -353,11 +395,42 @@ bool DatamanClient::clearAsync(dm_item_t item)
 	return success;
 }
 
+void DatamanClient::publishActiveRequest()
+{
+	dataman_request_s request;
+	request.timestamp = _active_request.timestamp;
+	request.index = _active_request.index;
+	request.count = 1;
+	request.data_length = _active_request.length;
+	request.client_id = _client_id;
+	request.request_type = static_cast<uint8_t>(_active_request.request_type);
+	request.item = static_cast<uint8_t>(_active_request.item);
+
+	if (_active_request.request_type == DM_WRITE) {
+		memcpy(request.data, _active_request.buffer, _active_request.length);
+
+	} else if (_active_request.request_type == DM_READ_BATCH) {
+		// only request what is still missing, starting at the first index not yet received
+		uint32_t first_missing = 0;
+
+		while (_active_request.received_mask & (1u << first_missing)) {
+			++first_missing;
+		}
+
+		request.index = _active_request.index + first_missing;
+		request.count = _active_request.count - first_missing;
+	}
+
+	_dataman_request_pub.publish(request);
+}
+
 void DatamanClient::update()
 {
-	if (_state == State::RequestSent) {
+	bool updated = true;
+
+	// batched reads are answered with multiple queued responses, process all of them
+	while (_state == State::RequestSent && updated) {
 
-		bool updated = false;
 		orb_check(_dataman_response_sub, &updated);
 
 		dataman_response_s response;
@@ -366,9 +439,34 @@ void DatamanClient::update()
 			orb_copy(ORB_ID(dataman_response), _dataman_response_sub, &response);
 
 			if ((response.client_id == _client_id) &&
-			    (response.request_type == _active_request.request_type) &&
+			    (response.request_type == DM_READ_BATCH) &&
+			    (_active_request.request_type == DM_READ_BATCH) &&
 			    (response.item == _active_request.item) &&
-			    (response.index == _active_request.index)) {
+			    (response.index >= _active_request.index) &&
+			    (response.index < _active_request.index + _active_request.count)) {
+
+				const uint32_t offset = response.index - _active_request.index;
+
+				if (!(_active_request.received_mask & (1u << offset))) {
+					memcpy(_active_request.batch_buffers[offset], response.data, _active_request.length);
+					_active_request.received_mask |= (1u << offset);
+
+					if (response.status != dataman_response_s::STATUS_SUCCESS) {
+						_active_request.failed_mask |= (1u << offset);
+						_response_status = response.status;
+						PX4_ERR("Async batch read failed! status=%" PRIu8 " item=%" PRIu8 " index=%" PRIu32,
+							response.status, static_cast<uint8_t>(_active_request.item), response.index);
+					}
+				}
+
+				if (_active_request.received_mask == (1u << _active_request.count) - 1) {
+					_state = State::ResponseReceived;
+				}
+
+			} else if ((response.client_id == _client_id) &&
+				   (response.request_type == _active_request.request_type) &&
+				   (response.item == _active_request.item) &&
+				   (response.index == _active_request.index)) {
 
 				if (response.request_type == DM_READ) {
 					memcpy(_active_request.buffer, response.data, _active_request.length);
@@ -385,34 +483,18 @@ void DatamanClient::update()
 				_state = State::ResponseReceived;
 			}
 		}
+	}
 
-		if (_state == State::RequestSent) {
-
-			/* Retry the request if there is no answer */
-			if (((_active_request.request_type != DM_CLEAR) && (hrt_elapsed_time(&_active_request.timestamp) > 100_ms)) ||
-			    (hrt_elapsed_time(&_active_request.timestamp) > 1000_ms)
-			   ) {
-
-				hrt_abstime timestamp = hrt_absolute_time();
-
-				_active_request.timestamp = timestamp;
-
-				dataman_request_s request;
-				request.timestamp = timestamp;
-				request.index = _active_request.index;
-				request.data_length = _active_request.length;
-				request.client_id = _client_id;
-				request.request_type = static_cast<uint8_t>(_active_request.request_type);
-				request.item = static_cast<uint8_t>(_active_request.item);
+	if (_state == State::RequestSent) {
 
-				if (_active_request.request_type == DM_WRITE) {
-					memcpy(request.data, _active_request.buffer, _active_request.length);
-				}
+		/* Retry the request if there is no answer */
+		if (((_active_request.request_type != DM_CLEAR) && (hrt_elapsed_time(&_active_request.timestamp) > 100_ms)) ||
+		    (hrt_elapsed_time(&_active_request.timestamp) > 1000_ms)
+		   ) {
 
-				_dataman_request_pub.publish(request);
+			_active_request.timestamp = hrt_absolute_time();
 
-				_state = State::RequestSent;
-			}
+			publishActiveRequest();
 		}
 	}
 }
@@ -595,7 +677,6 @@ void DatamanCache::update()
 
 		_client.update();
 
-		bool success = false;
 		bool response_success = false;
 
 		switch (_items[_update_index].cache_state) {
@@ -608,19 +689,7 @@ void DatamanCache::update()
 			break;
 
 		case State::RequestPrepared:
-
-			success = _client.readAsync(static_cast<dm_item_t>(_items[_update_index].response.item),
-						    _items[_update_index].response.index,
-						    _items[_update_index].response.data,
-						    g_per_item_size[_items[_update_index].response.item]);
-
-			if (success) {
-				_items[_update_index].cache_state = State::RequestSent;
-
-			} else {
-				_items[_update_index].cache_state = State::Error;
-			}
-
+			requestItems();
 			break;
 
 		case State::RequestSent:
@@ -629,11 +698,26 @@ void DatamanCache::update()
 
 				if (response_success) {
 
-					_items[_update_index].cache_state = State::ResponseReceived;
-					changeUpdateIndex();
+					for (uint32_t i = 0; i < _request_count; ++i) {
+						_items[_update_index].cache_state = State::ResponseReceived;
+						changeUpdateIndex();
+					}
 
 				} else {
-					_items[_update_index].cache_state = State::Error;
+					// keep the items of a batch that could be read, the others are reported and skipped below
+					const uint32_t read_mask = (_request_count > 1) ? _client.lastBatchReadMask() : 0;
+
+					for (uint32_t i = 0; i < _request_count; ++i) {
+						Item &item = _items[(_update_index + i) % _num_items];
+
+						if (read_mask & (1u << i)) {
+							item.cache_state = State::ResponseReceived;
+
+						} else {
+							item.cache_state = State::Error;
+							item.response.status = dataman_response_s::STATUS_FAILURE_READ_FAILED;
+						}
+					}
 				}
 			}
 
@@ -644,7 +728,7 @@ void DatamanCache::update()
 			break;
 		}
 
-		if (_items[_update_index].cache_state == State::Error) {
+		while (_item_counter > 0 && _items[_update_index].cache_state == State::Error) {
 			PX4_ERR("Caching: item %" PRIu8 ", index %" PRIu32", status %" PRIu8,
 				_items[_update_index].response.item, _items[_update_index].response.index,
 				_items[_update_index].response.status);
@@ -667,6 +751,44 @@ void DatamanCache::invalidate()
 	_client.abortCurrentOperation();
 }
 
+void DatamanCache::requestItems()
+{
+	const Item &first = _items[_update_index];
+	const dm_item_t item = static_cast<dm_item_t>(first.response.item);
+
+	// Mission items are usually loaded in order, which allows to fetch several of them with one round trip
+	uint8_t *buffers[DM_READ_BATCH_MAX_ITEMS];
+	buffers[0] = _items[_update_index].response.data;
+	uint32_t count = 1;
+
+	while (count < DM_READ_BATCH_MAX_ITEMS && count < _item_counter) {
+		Item &next = _items[(_update_index + count) % _num_items];
+
+		if (next.cache_state != State::RequestPrepared ||
+		    next.response.item != first.response.item ||
+		    next.response.index != first.response.index + count) {
+			break;
+		}
+
+		buffers[count++] = next.response.data;
+	}
+
+	bool success;
+
+	if (count > 1) {
+		success = _client.readBatchAsync(item, first.response.index, count, buffers, g_per_item_size[item]);
+
+	} else {
+		success = _client.readAsync(item, first.response.index, buffers[0], g_per_item_size[item]);
+	}
+
+	_request_count = success ? count : 1;
+
+	for (uint32_t i = 0; i < _request_count; ++i) {
+		_items[(_update_index + i) % _num_items].cache_state = success ? State::RequestSent : State::Error;
+	}
+}
+
 inline void DatamanCache::changeUpdateIndex()
 {
 	_update_index = (_update_index + 1) % _num_items;
@@ -103,6 +103,31 @@ public:
 	 */
 	bool readAsync(dm_item_t item, uint32_t index, uint8_t *buffer, uint32_t length);
 
+	/**
+	 * @brief Initiates an asynchronous request to read consecutive indices of an item with a single request.
+	 *
+	 * @param[in] item The item to read from.
+	 * @param[in] index The first index to read.
+	 * @param[in] count The number of consecutive indices to read, at most DM_READ_BATCH_MAX_ITEMS.
+	 * @param[out] buffers The buffers to store the read data in, one for each index.
+	 * @param[in] length The length of the data to read per index.
+	 *
+	 * @return True if the read request was successfully queued, false otherwise.
+	 *
+	 * @note The buffers must be kept alive as long as the request did not finish.
+	 *       The operation completes once all indices have been received, and only
+	 *       succeeds if all of them could be read. Which indices were read is
+	 *       available from lastBatchReadMask().
+	 */
+	bool readBatchAsync(dm_item_t item, uint32_t index, uint32_t count, uint8_t *const buffers[], uint32_t length);
+
+	/**
+	 * @brief Get the indices successfully read by the last batch read.
+	 *
+	 * @return Bit i is set if index + i of the last readBatchAsync() request was read.
+	 */
+	uint32_t lastBatchReadMask() const { return _active_request.received_mask & ~_active_request.failed_mask; }
+
 	/**
 	 * @brief Initiates an asynchronous request to write the data to dataman for a specific item and index.
 	 *
@@ -168,8 +193,14 @@ private:
 		uint32_t index;
 		uint8_t *buffer;
 		uint32_t length;
+		uint8_t *batch_buffers[DM_READ_BATCH_MAX_ITEMS];
+		uint32_t count;
+		uint32_t received_mask;
+		uint32_t failed_mask;
 	};
 
+	void publishActiveRequest();
+
 	/* Synchronous response/request handler */
 	bool syncHandler(const dataman_request_s &request, dataman_response_s &response,
 			 const hrt_abstime &start_time, hrt_abstime timeout);
@@ -294,11 +325,18 @@ private:
 
 	inline void changeUpdateIndex();
 
+	/**
+	 * @brief Request the item at the update index, together with the directly following
+	 * items of consecutive indices in a single batch request.
+	 */
+	void requestItems();
+
 	Item *_items{nullptr};
 	uint32_t _load_index{0};	///< index for tracking last index used by load function
 	uint32_t _update_index{0};	///< index for tracking last index used by update function
 	uint32_t _item_counter{0};	///< number of items to process with update function
 	uint32_t _num_items{0};		///< number of items that cache can store
+	uint32_t _request_count{0};	///< number of items requested by the active request, starting at the update index
 
 	DatamanClient _client{};
 
@@ -39,30 +39,25 @@
 
 using namespace time_literals;
 
-static constexpr int32_t sum(const int16_t samples[], uint8_t len)
-{
-	int32_t sum = 0;
-
-	for (int n = 0; n < len; n++) {
-		sum += samples[n];
-	}
-
-	return sum;
-}
-
-static constexpr uint8_t clipping(const int16_t samples[], uint8_t len)
+// single pass over a block of raw samples: sum of the first len - 1 samples (for the trapezoidal integration)
+// and the number of clipped samples
+static inline uint8_t sum_and_clipping(const int16_t samples[], uint8_t len, int32_t &sum)
 {
+	int32_t total = 0;
 	unsigned clip_count = 0;
 
 	for (int n = 0; n < len; n++) {
+		const int16_t sample = samples[n];
+		total += sample;
+
 		// - consider data clipped/saturated if it's INT16_MIN/INT16_MAX or within 1
 		// - this accommodates rotated data (|INT16_MIN| = INT16_MAX + 1)
 		//   and sensors that may re-use the lowest bit for other purposes (sync indicator, etc)
-		if ((samples[n] <= INT16_MIN + 1) || (samples[n] >= INT16_MAX - 1)) {
-			clip_count++;
-		}
+		clip_count += (sample <= INT16_MIN + 1) | (sample >= INT16_MAX - 1);
 	}
 
+	sum = total - samples[len - 1];
+
 	return clip_count;
 }
 
@@ -139,9 +134,7 @@ void PX4Gyroscope::updateFIFO(sensor_gyro_fifo_s &sample)
 	// rotate all raw samples and publish fifo
 	const uint8_t N = sample.samples;
 
-	for (int n = 0; n < N; n++) {
-		rotate_3i(_rotation, sample.x[n], sample.y[n], sample.z[n]);
-	}
+	rotate_3i(_rotation, sample.x, sample.y, sample.z, N);
 
 	sample.device_id = _device_id;
 	sample.scale = _scale;
@@ -156,19 +149,21 @@ void PX4Gyroscope::updateFIFO(sensor_gyro_fifo_s &sample)
 	report.temperature = _temperature;
 	report.error_count = _error_count;
 
+	int32_t sum[3];
+	report.clip_counter[0] = sum_and_clipping(sample.x, N, sum[0]);
+	report.clip_counter[1] = sum_and_clipping(sample.y, N, sum[1]);
+	report.clip_counter[2] = sum_and_clipping(sample.z, N, sum[2]);
+
 	// trapezoidal integration (equally spaced)
 	const float scale = _scale / (float)N;
-	report.x = (0.5f * (_last_sample[0] + sample.x[N - 1]) + sum(sample.x, N - 1)) * scale;
-	report.y = (0.5f * (_last_sample[1] + sample.y[N - 1]) + sum(sample.y, N - 1)) * scale;
-	report.z = (0.5f * (_last_sample[2] + sample.z[N - 1]) + sum(sample.z, N - 1)) * scale;
+	report.x = (0.5f * (_last_sample[0] + sample.x[N - 1]) + sum[0]) * scale;
+	report.y = (0.5f * (_last_sample[1] + sample.y[N - 1]) + sum[1]) * scale;
+	report.z = (0.5f * (_last_sample[2] + sample.z[N - 1]) + sum[2]) * scale;
 
 	_last_sample[0] = sample.x[N - 1];
 	_last_sample[1] = sample.y[N - 1];
 	_last_sample[2] = sample.z[N - 1];
 
-	report.clip_counter[0] = clipping(sample.x, N);
-	report.clip_counter[1] = clipping(sample.y, N);
-	report.clip_counter[2] = clipping(sample.z, N);
 	report.samples = N;
 	report.timestamp = hrt_absolute_time();
 
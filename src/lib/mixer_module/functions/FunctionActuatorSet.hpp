@@ -78,6 +78,7 @@ public:
 	}
 
 	float value(OutputFunction func) override { return _data[(int)func - (int)OutputFunction::Peripheral_via_Actuator_Set1]; }
+	const float *values(OutputFunction &first) const override { first = OutputFunction::Peripheral_via_Actuator_Set1; return _data; }
 
 private:
 	static constexpr int max_num_actuators = 6;
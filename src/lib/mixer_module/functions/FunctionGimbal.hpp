@@ -58,6 +58,7 @@ public:
 	}
 
 	float value(OutputFunction func) override { return _data[(int)func - (int)OutputFunction::Gimbal_Roll]; }
+	const float *values(OutputFunction &first) const override { first = OutputFunction::Gimbal_Roll; return _data; }
 
 private:
 	uORB::Subscription _topic{ORB_ID(gimbal_controls)};
@@ -62,6 +62,7 @@ public:
 	}
 
 	float value(OutputFunction func) override { return _data; }
+	const float *values(OutputFunction &first) const override { first = OutputFunction::Gripper; return &_data; }
 
 private:
 	uORB::Subscription _gripper_sub{ORB_ID(gripper)};
@@ -56,6 +56,7 @@ public:
 	}
 
 	float value(OutputFunction func) override { return _data; }
+	const float *values(OutputFunction &first) const override { first = OutputFunction::Landing_Gear_Wheel; return &_data; }
 
 private:
 	uORB::Subscription _topic{ORB_ID(landing_gear_wheel)};
@@ -72,6 +72,7 @@ public:
 	}
 
 	float value(OutputFunction func) override { return _data[(int)func - (int)OutputFunction::RC_Roll]; }
+	const float *values(OutputFunction &first) const override { first = OutputFunction::RC_Roll; return _data; }
 
 private:
 	static constexpr int num_data_points = 11;
@@ -67,6 +67,7 @@ public:
 	}
 
 	float value(OutputFunction func) override { return _data.control[(int)func - (int)OutputFunction::Motor1]; }
+	const float *values(OutputFunction &first) const override { first = OutputFunction::Motor1; return _data.control; }
 
 	bool allowPrearmControl() const override { return false; }
 
@@ -74,6 +75,8 @@ public:
 
 	bool getLatestSampleTimestamp(hrt_abstime &t) const override { t = _data.timestamp_sample; return t != 0; }
 
+	bool getLatestTimestamp(hrt_abstime &t) const override { t = _data.timestamp; return t != 0; }
+
 	static inline void updateValues(uint32_t reversible, float thrust_factor, float *values, int num_values)
 	{
 		if (thrust_factor > 0.f && thrust_factor <= 1.f) {
@@ -115,6 +118,7 @@ public:
 	}
 
 	bool reversible(OutputFunction func) const override { return _data.reversible_flags & (1u << ((int)func - (int)OutputFunction::Motor1)); }
+	uint32_t reversibleFlags() const override { return _data.reversible_flags; }
 
 private:
 	uORB::SubscriptionCallbackWorkItem _topic;
@@ -61,6 +61,15 @@ public:
 	 */
 	virtual float value(OutputFunction func) = 0;
 
+	/**
+	 * Get the array holding the current values of all functions of this provider, which
+	 * is queried once when the outputs get configured. The output loop then reads the values
+	 * directly instead of calling value() per output.
+	 * @param first set to the function corresponding to index 0 of the returned array
+	 * @return nullptr if value() needs to be called instead
+	 */
+	virtual const float *values(OutputFunction &first) const { return nullptr; }
+
 	virtual float defaultFailsafeValue(OutputFunction func) const { return NAN; }
 	virtual bool allowPrearmControl() const { return true; }
 
@@ -68,8 +77,18 @@ public:
 
 	virtual bool getLatestSampleTimestamp(hrt_abstime &t) const { return false; }
 
+	/**
+	 * Get the publication timestamp of the latest setpoint
+	 */
+	virtual bool getLatestTimestamp(hrt_abstime &t) const { return false; }
+
 	/**
 	 * Check whether the output (motor) is configured to be reversible
 	 */
 	virtual bool reversible(OutputFunction func) const { return false; }
+
+	/**
+	 * Get the reversible outputs as bitmask, indexed like values()
+	 */
+	virtual uint32_t reversibleFlags() const { return 0; }
 };
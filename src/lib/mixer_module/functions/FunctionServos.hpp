@@ -58,6 +58,7 @@ public:
 
 	void update() override { _topic.update(&_data); }
 	float value(OutputFunction func) override { return _data.control[(int)func - (int)OutputFunction::Servo1]; }
+	const float *values(OutputFunction &first) const override { first = OutputFunction::Servo1; return _data.control; }
 
 	uORB::SubscriptionCallbackWorkItem *subscriptionCallback() override { return &_topic; }
 
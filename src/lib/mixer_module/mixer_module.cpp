@@ -32,6 +32,7 @@
  ****************************************************************************/
 
 #include "mixer_module.hpp"
+#include "output_continuation.hpp"
 
 #include <uORB/Publication.hpp>
 #include <px4_platform_common/log.h>
@@ -100,6 +101,7 @@ MixingOutput::MixingOutput(const char *param_prefix, uint8_t max_num_outputs, Ou
 
 MixingOutput::~MixingOutput()
 {
+	removeOutputContinuation();
 	perf_free(_control_latency_perf);
 	px4_sem_destroy(&_lock);
 
@@ -138,6 +140,10 @@ void MixingOutput::printStatus() const
 		PX4_INFO("Switched to rate_ctrl work queue");
 	}
 
+	if (_output_continuation) {
+		PX4_INFO("Outputs updated by control allocator");
+	}
+
 	PX4_INFO_RAW("Channel Configuration:\n");
 
 	for (unsigned i = 0; i < _max_num_outputs; i++) {
@@ -211,6 +217,83 @@ void MixingOutput::cleanupFunctions()
 		_function_allocated[i] = nullptr;
 		_functions[i] = nullptr;
 	}
+
+	_num_output_groups = 0;
+}
+
+void MixingOutput::compileOutputPlan()
+{
+	_num_output_groups = 0;
+	int num_channels = 0;
+
+	for (int f = 0; f < MAX_ACTUATORS && _function_allocated[f]; ++f) {
+		OutputGroup &group = _output_groups[_num_output_groups];
+		group.function = _function_allocated[f];
+		group.allow_prearm_control = group.function->allowPrearmControl();
+		group.first = num_channels;
+		group.count = 0;
+
+		OutputFunction first_function{OutputFunction::Disabled};
+		group.values = group.function->values(first_function);
+
+		for (int i = 0; i < _max_num_outputs; ++i) {
+			if (_functions[i] == group.function) {
+				_plan_channel[num_channels] = i;
+				_plan_value_index[num_channels] = group.values ? (int)_function_assignment[i] - (int)first_function : 0;
+				++num_channels;
+				++group.count;
+			}
+		}
+
+		if (group.count > 0) {
+			++_num_output_groups;
+		}
+	}
+}
+
+void MixingOutput::updateOutputValues(float outputs[MAX_ACTUATORS])
+{
+	for (int i = 0; i < MAX_ACTUATORS; ++i) {
+		outputs[i] = NAN;
+	}
+
+	uint32_t reversible_mask = 0;
+
+	for (int g = 0; g < _num_output_groups; ++g) {
+		const OutputGroup &group = _output_groups[g];
+		const uint8_t *channel = &_plan_channel[group.first];
+		const uint8_t *value_index = &_plan_value_index[group.first];
+		const bool enabled = _armed.armed || (_armed.prearmed && group.allow_prearm_control);
+
+		if (group.values) {
+			if (enabled) {
+				for (int k = 0; k < group.count; ++k) {
+					outputs[channel[k]] = group.values[value_index[k]];
+				}
+			}
+
+			const uint32_t reversible_flags = group.function->reversibleFlags();
+
+			if (reversible_flags != 0) {
+				for (int k = 0; k < group.count; ++k) {
+					reversible_mask |= ((reversible_flags >> value_index[k]) & 1u) << channel[k];
+				}
+			}
+
+		} else {
+			for (int k = 0; k < group.count; ++k) {
+				const OutputFunction function = _function_assignment[channel[k]];
+
+				if (enabled) {
+					outputs[channel[k]] = group.function->value(function);
+				}
+
+				reversible_mask |= (uint32_t)group.function->reversible(function) << channel[k];
+			}
+		}
+	}
+
+	_reversible_mask = reversible_mask;
 }
 
 bool MixingOutput::updateSubscriptions(bool allow_wq_switch)
@@ -314,6 +397,8 @@ bool MixingOutput::updateSubscriptions(bool allow_wq_switch)
 		}
 	}
 
+	compileOutputPlan();
+
 	hrt_abstime fixed_rate_scheduling_interval = 4_ms; // schedule at 250Hz
 
 	if (_max_topic_update_interval_us > fixed_rate_scheduling_interval) {
@@ -327,6 +412,15 @@ bool MixingOutput::updateSubscriptions(bool allow_wq_switch)
 				_has_backup_schedule = true;
 				_interface.ScheduleDelayed(50_ms);
 
+				// the control allocator runs on rate_ctrl as well, let it update the outputs right after publishing
+				if (_output_continuation_allowed && _wq_switched && _param_mix_out_cont.get()) {
+					_output_continuation = output_continuation::add(this);
+
+					if (!_output_continuation) {
+						PX4_WARN("no free output continuation slot");
+					}
+				}
+
 			} else {
 				PX4_ERR("registerCallback failed, scheduling at fixed rate");
 				_interface.ScheduleOnInterval(fixed_rate_scheduling_interval);
@@ -397,11 +491,31 @@ void MixingOutput::setAllDisarmedValues(uint16_t value)
 
 void MixingOutput::unregister()
 {
+	removeOutputContinuation();
+
 	if (_subscription_callback) {
 		_subscription_callback->unregisterCallback();
 	}
 }
 
+void MixingOutput::removeOutputContinuation()
+{
+	if (_output_continuation) {
+		output_continuation::remove(this);
+		_output_continuation = false;
+	}
+}
+
+void MixingOutput::updateFromContinuation()
+{
+	if (_subscription_callback && _subscription_callback->updated()) {
+		_in_continuation = true;
+		_last_continuation_update = hrt_absolute_time();
+		update();
+		_in_continuation = false;
+	}
+}
+
 bool MixingOutput::update()
 {
 	// check arming state
@@ -420,6 +534,12 @@ bool MixingOutput::update()
 	// only used for sitl with lockstep
 	bool has_updates = _subscription_callback && _subscription_callback->updated();
 
+	if (_output_continuation && !has_updates && hrt_elapsed_time(&_last_continuation_update) < 50_ms) {
+		// the outputs were already updated by the control allocator (updateFromContinuation()),
+		// only fall through if it stopped publishing
+		return false;
+	}
+
 	// update topics
 	for (int i = 0; i < MAX_ACTUATORS && _function_allocated[i]; ++i) {
 		_function_allocated[i]->update();
@@ -434,26 +554,8 @@ bool MixingOutput::update()
 
 	// get output values
 	float outputs[MAX_ACTUATORS];
-	bool all_disabled = true;
-	_reversible_mask = 0;
-
-	for (int i = 0; i < _max_num_outputs; ++i) {
-		if (_functions[i]) {
-			all_disabled = false;
-
-			if (_armed.armed || (_armed.prearmed && _functions[i]->allowPrearmControl())) {
-				outputs[i] = _functions[i]->value(_function_assignment[i]);
-
-			} else {
-				outputs[i] = NAN;
-			}
-
-			_reversible_mask |= (uint32_t)_functions[i]->reversible(_function_assignment[i]) << i;
-
-		} else {
-			outputs[i] = NAN;
-		}
-	}
+	const bool all_disabled = (_num_output_groups == 0);
+	updateOutputValues(outputs);
 
 	// Send output if any function mapped or one last disabling sample
 	if (!all_disabled || !_was_all_disabled) {
@@ -516,7 +618,7 @@ MixingOutput::limitAndUpdateOutputs(float outputs[MAX_ACTUATORS], bool has_updat
 		actuator_outputs_s actuator_outputs{};
 		setAndPublishActuatorOutputs(_max_num_outputs, actuator_outputs);
 
-		updateLatencyPerfCounter(actuator_outputs);
+		updateLatencyPerfCounter(actuator_outputs, has_updates);
 	}
 }
 
@@ -640,7 +742,7 @@ MixingOutput::setAndPublishActuatorOutputs(unsigned num_outputs, actuator_output
 }
 
 void
-MixingOutput::updateLatencyPerfCounter(const actuator_outputs_s &actuator_outputs)
+MixingOutput::updateLatencyPerfCounter(const actuator_outputs_s &actuator_outputs, bool has_updates)
 {
 	// Just check the first function. It means we only get the latency if motors are assigned first, which is the default
 	if (_function_allocated[0]) {
@@ -648,6 +750,23 @@ MixingOutput::updateLatencyPerfCounter(const actuator_outputs_s &actuator_output
 
 		if (_function_allocated[0]->getLatestSampleTimestamp(timestamp_sample)) {
 			perf_set_elapsed(_control_latency_perf, actuator_outputs.timestamp - timestamp_sample);
+
+			// only publish for outputs based on a new setpoint, not for repeated ones (backup schedule)
+			if (has_updates) {
+				actuator_output_latency_s output_latency{};
+				output_latency.timestamp_sample = timestamp_sample;
+				output_latency.latency = actuator_outputs.timestamp - timestamp_sample;
+
+				hrt_abstime timestamp_setpoint;
+
+				if (_function_allocated[0]->getLatestTimestamp(timestamp_setpoint)) {
+					output_latency.allocation_latency = actuator_outputs.timestamp - timestamp_setpoint;
+				}
+
+				output_latency.continuation = _in_continuation;
+				output_latency.timestamp = hrt_absolute_time();
+				_output_latency_pub.publish(output_latency);
+			}
 		}
 	}
 }
@@ -57,6 +57,7 @@
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/actuator_armed.h>
+#include <uORB/topics/actuator_output_latency.h>
 #include <uORB/topics/actuator_outputs.h>
 #include <uORB/topics/parameter_update.h>
 
@@ -148,6 +149,12 @@ public:
 	 */
 	bool update();
 
+	/**
+	 * Update the outputs if new actuator setpoints got published. This is called by the control allocator
+	 * (see output_continuation.hpp) and must not be called by the output module itself.
+	 */
+	void updateFromContinuation();
+
 	/**
 	 * Check for subscription updates.
 	 * Call this at the very end of Run() if allow_wq_switch
@@ -192,12 +199,26 @@ public:
 	/**
 	 * Set the maximum number of outputs. This can only be used to reduce the maximum.
 	 */
-	void setMaxNumOutputs(uint8_t max_num_outputs) { if (max_num_outputs < _max_num_outputs) { _max_num_outputs = max_num_outputs; } }
+	void setMaxNumOutputs(uint8_t max_num_outputs)
+	{
+		if (max_num_outputs < _max_num_outputs) {
+			_max_num_outputs = max_num_outputs;
+			compileOutputPlan();
+		}
+	}
 
 	const char *paramPrefix() const { return _param_prefix; }
 
 	void setLowrateSchedulingInterval(hrt_abstime interval) { _lowrate_schedule_interval = interval; }
 
+	/**
+	 * Allow outputs to be updated directly by the control allocator (if enabled via MIX_OUT_CONT).
+	 * This requires that updateOutputs() can run from within the control allocator, i.e. the output module
+	 * does not take any locks there and completes the output write in that call.
+	 * It only takes effect once the module switched to the rate_ctrl work queue.
+	 */
+	void setOutputContinuationAllowed(bool allowed) { _output_continuation_allowed = allowed; }
+
 	/**
 	 * Get the bitmask of reversible outputs (motors only).
 	 * This might change at any time (while disarmed), so output drivers requiring this should query this regularly.
@@ -217,10 +238,20 @@ private:
 
 	void setAndPublishActuatorOutputs(unsigned num_outputs, actuator_outputs_s &actuator_outputs);
 	void publishMixerStatus(const actuator_outputs_s &actuator_outputs);
-	void updateLatencyPerfCounter(const actuator_outputs_s &actuator_outputs);
+	void updateLatencyPerfCounter(const actuator_outputs_s &actuator_outputs, bool has_updates);
 
 	void cleanupFunctions();
 
+	/**
+	 * Group the configured outputs by function provider, so that update() can read the
+	 * values without virtual calls. Call whenever _functions or _max_num_outputs change.
+	 */
+	void compileOutputPlan();
+
+	void updateOutputValues(float outputs[MAX_ACTUATORS]);
+
+	void removeOutputContinuation();
+
 	void initParamHandles();
 
 	void limitAndUpdateOutputs(float outputs[MAX_ACTUATORS], bool has_updates);
@@ -259,6 +290,7 @@ private:
 	uORB::Subscription _armed_sub{ORB_ID(actuator_armed)};
 
 	uORB::PublicationMulti<actuator_outputs_s> _outputs_pub{ORB_ID(actuator_outputs)};
+	uORB::PublicationMulti<actuator_output_latency_s> _output_latency_pub{ORB_ID(actuator_output_latency)};
 
 	actuator_armed_s _armed{};
 
@@ -280,6 +312,20 @@ private:
 	FunctionProviderBase *_function_allocated[MAX_ACTUATORS] {}; ///< unique allocated functions
 	FunctionProviderBase *_functions[MAX_ACTUATORS] {}; ///< currently assigned functions
 	OutputFunction _function_assignment[MAX_ACTUATORS] {};
+
+	struct OutputGroup {
+		FunctionProviderBase *function{nullptr};
+		const float *values{nullptr}; ///< value array of the function, nullptr if value() needs to be called
+		bool allow_prearm_control{true};
+		uint8_t first{0}; ///< first entry in _plan_channel
+		uint8_t count{0};
+	};
+
+	OutputGroup _output_groups[MAX_ACTUATORS] {}; ///< compiled output plan, one group per allocated function
+	uint8_t _num_output_groups{0};
+	uint8_t _plan_channel[MAX_ACTUATORS] {}; ///< output channels, ordered by group
+	uint8_t _plan_value_index[MAX_ACTUATORS] {}; ///< index into OutputGroup::values, or reversibleFlags() bit
+
 	bool _need_function_update{true};
 	bool _has_backup_schedule{false};
 	const char *const _param_prefix;
@@ -290,11 +336,17 @@ private:
 	uint32_t _reversible_mask{0}; ///< per-output bits. If set, the output is configured to be reversible (motors only)
 	bool _was_all_disabled{false};
 
+	bool _output_continuation_allowed{false};
+	bool _output_continuation{false}; ///< registered to be updated by the control allocator
+	bool _in_continuation{false};
+	hrt_abstime _last_continuation_update{0};
+
 	uORB::SubscriptionCallbackWorkItem *_subscription_callback{nullptr}; ///< current scheduling callback
 
 
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::MC_AIRMODE>) _param_mc_airmode,   ///< multicopter air-mode
+		(ParamBool<px4::params::MIX_OUT_CONT>) _param_mix_out_cont,
 		(ParamFloat<px4::params::MOT_SLEW_MAX>) _param_mot_slew_max,
 		(ParamFloat<px4::params::THR_MDL_FAC>) _param_thr_mdl_fac ///< thrust to motor control signal modelling factor
 	)
@@ -469,6 +469,56 @@ TEST_F(MixerModuleTest, prearm)
 	EXPECT_FALSE(test_module.was_scheduled);
 }
 
+TEST_F(MixerModuleTest, functionGroups)
+{
+	OutputModuleTest test_module;
+	// interleave the functions, and assign a motor twice
+	test_module.configureFunctions({
+		(int)OutputFunction::Servo2,
+		(int)OutputFunction::Motor2,
+		(int)OutputFunction::Servo1,
+		0,
+		(int)OutputFunction::Motor1,
+		(int)OutputFunction::Motor2,
+		(int)OutputFunction::Constant_Max});
+	MixingOutput mixing_output{PARAM_PREFIX, MAX_NUM_OUTPUTS, test_module, MixingOutput::SchedulingPolicy::Disabled, false, false};
+	mixing_output.setAllDisarmedValues(DISARMED_VALUE);
+	mixing_output.setAllFailsafeValues(FAILSAFE_VALUE);
+	mixing_output.setAllMinValues(MIN_VALUE);
+	mixing_output.setAllMaxValues(MAX_VALUE);
+
+	// motor 1 reversible: expect output to be in center when commanding to 0
+	test_module.sendMotors({0.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f}, 1u << 0);
+	test_module.sendServos({-1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f});
+	test_module.sendActuatorArmed(true);
+
+	mixing_output.updateSubscriptions(false);
+	EXPECT_EQ(test_module.num_updates, update(mixing_output));
+	EXPECT_EQ(test_module.num_outputs, MAX_NUM_OUTPUTS);
+	EXPECT_EQ(mixing_output.reversibleOutputs(), 1u << 4);
+
+	const uint16_t expected[MAX_NUM_OUTPUTS] {MAX_VALUE, MAX_VALUE, MIN_VALUE, DISARMED_VALUE,
+						   (MAX_VALUE - MIN_VALUE) / 2 + MIN_VALUE, MAX_VALUE, MAX_VALUE, DISARMED_VALUE};
+
+	for (int i = 0; i < MAX_NUM_OUTPUTS; ++i) {
+		EXPECT_EQ(test_module.outputs[i], expected[i]);
+	}
+
+	test_module.reset();
+
+	// disarm
+	test_module.sendActuatorArmed(false);
+	mixing_output.update();
+
+	for (int i = 0; i < MAX_NUM_OUTPUTS; ++i) {
+		EXPECT_EQ(test_module.outputs[i], DISARMED_VALUE);
+	}
+
+	test_module.reset();
+
+	EXPECT_FALSE(test_module.was_scheduled);
+}
+
 class TestMixingOutput : public MixingOutput
 {
 public:
@@ -0,0 +1,91 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "output_continuation.hpp"
+#include "mixer_module.hpp"
+
+#include <pthread.h>
+
+static pthread_mutex_t continuation_mutex = PTHREAD_MUTEX_INITIALIZER;
+static MixingOutput *continuation_outputs[output_continuation::MAX_OUTPUTS] {};
+static int num_continuation_outputs{0};
+
+namespace output_continuation
+{
+
+bool add(MixingOutput *output)
+{
+	bool ret = false;
+	pthread_mutex_lock(&continuation_mutex);
+
+	if (num_continuation_outputs < MAX_OUTPUTS) {
+		continuation_outputs[num_continuation_outputs++] = output;
+		ret = true;
+	}
+
+	pthread_mutex_unlock(&continuation_mutex);
+	return ret;
+}
+
+void remove(MixingOutput *output)
+{
+	pthread_mutex_lock(&continuation_mutex);
+
+	for (int i = 0; i < num_continuation_outputs; ++i) {
+		if (continuation_outputs[i] == output) {
+			continuation_outputs[i] = continuation_outputs[--num_continuation_outputs];
+			continuation_outputs[num_continuation_outputs] = nullptr;
+			break;
+		}
+	}
+
+	pthread_mutex_unlock(&continuation_mutex);
+}
+
+void run()
+{
+	if (num_continuation_outputs == 0) {
+		return;
+	}
+
+	pthread_mutex_lock(&continuation_mutex);
+
+	for (int i = 0; i < num_continuation_outputs; ++i) {
+		continuation_outputs[i]->updateFromContinuation();
+	}
+
+	pthread_mutex_unlock(&continuation_mutex);
+}
+
+} // namespace output_continuation
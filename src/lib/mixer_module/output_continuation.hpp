@@ -0,0 +1,70 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file output_continuation.hpp
+ *
+ * Registry of output modules that are updated directly by the control allocator, right after it
+ * published the actuator setpoints, instead of being scheduled separately via uORB callback.
+ * This is only valid for output modules running on the same work queue as the control allocator
+ * (rate_ctrl), as the output update then runs in the context of the control allocator.
+ */
+
+#pragma once
+
+class MixingOutput;
+
+namespace output_continuation
+{
+
+static constexpr int MAX_OUTPUTS = 4;
+
+/**
+ * Register an output to be updated by run()
+ * @return true on success, false if there are no free slots
+ */
+bool add(MixingOutput *output);
+
+/**
+ * Unregister an output. Once this returns, run() no longer accesses it.
+ */
+void remove(MixingOutput *output);
+
+/**
+ * Update all registered outputs with the newly published actuator setpoints.
+ * Called by the control allocator on the rate_ctrl work queue.
+ */
+void run();
+
+} // namespace output_continuation
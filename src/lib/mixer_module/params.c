@@ -16,3 +16,18 @@
  * @group Mixer Output
  */
 PARAM_DEFINE_INT32(MC_AIRMODE, 0);
+
+/**
+ * Update actuator outputs as a continuation of the control allocator
+ *
+ * If enabled, output drivers running on the rate controller work queue
+ * (e.g. pwm_out, dshot) write their outputs directly after the control allocator
+ * published actuator_motors/actuator_servos, within the same work queue cycle,
+ * instead of being scheduled separately via uORB callback.
+ * This reduces the gyro sample to actuator output latency (see actuator_output_latency).
+ *
+ * @boolean
+ * @reboot_required true
+ * @group Mixer Output
+ */
+PARAM_DEFINE_INT32(MIX_OUT_CONT, 0);
@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "PX4IOTransaction.hpp"
+
+#include <string.h>
+
+namespace px4io
+{
+
+bool Transaction::queue_get(uint8_t page, uint8_t offset, uint16_t *values, unsigned num_values, unsigned max_regs)
+{
+	if ((_reads >= MAX_READS)
+	    || (_request_count + 2 > max_regs)
+	    || (_reply_count + num_values > max_regs)) {
+		return false;
+	}
+
+	_request[_request_count++] = PKT_MULTI_ADDRESS(page, offset);
+	_request[_request_count++] = num_values;
+
+	_read_values[_reads] = values;
+	_read_count[_reads] = num_values;
+	_reads++;
+	_reply_count += num_values;
+
+	return true;
+}
+
+bool Transaction::queue_set(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values,
+			    unsigned max_regs)
+{
+	if (_request_count + 2 + num_values > max_regs) {
+		return false;
+	}
+
+	_request[_request_count++] = PKT_MULTI_ADDRESS(page, offset);
+	_request[_request_count++] = num_values | PKT_MULTI_WRITE;
+	memcpy(&_request[_request_count], values, num_values * sizeof(values[0]));
+	_request_count += num_values;
+
+	return true;
+}
+
+bool Transaction::single_write() const
+{
+	return (_reads == 0) && (_request_count > 0)
+	       && (_request_count == 2u + (_request[1] & PKT_MULTI_COUNT_MASK));
+}
+
+void Transaction::set_reply(const uint16_t *reply)
+{
+	const uint16_t *value = reply;
+
+	for (unsigned i = 0; i < _reads; i++) {
+		memcpy(_read_values[i], value, _read_count[i] * sizeof(reply[0]));
+		value += _read_count[i];
+	}
+}
+
+void Transaction::clear()
+{
+	_request_count = 0;
+	_reads = 0;
+	_reply_count = 0;
+}
+
+int apply(const uint16_t *request, unsigned request_count, uint16_t *reply, unsigned reply_max,
+	  registers_get_t get, registers_set_t set)
+{
+	unsigned index = 0;
+	unsigned reply_count = 0;
+
+	while (index + 2 <= request_count) {
+		const uint8_t page = request[index] >> 8;
+		const uint8_t offset = request[index] & 0xff;
+		const unsigned count = request[index + 1] & PKT_MULTI_COUNT_MASK;
+		const bool write = request[index + 1] & PKT_MULTI_WRITE;
+		index += 2;
+
+		if (write) {
+			if ((index + count > request_count)
+			    || set(page, offset, &request[index], count)) {
+				return -1;
+			}
+
+			index += count;
+
+		} else {
+			unsigned available;
+			uint16_t *registers;
+
+			if ((reply_count + count > reply_max)
+			    || (get(page, offset, &registers, &available) < 0)
+			    || (available < count)) {
+				return -1;
+			}
+
+			memcpy(&reply[reply_count], registers, count * sizeof(reply[0]));
+			reply_count += count;
+		}
+	}
+
+	if (index != request_count) {
+		/* trailing partial operation header */
+		return -1;
+	}
+
+	return reply_count;
+}
+
+} // namespace px4io
@@ -0,0 +1,130 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file PX4IOTransaction.hpp
+ *
+ * Multi-page register transactions (PKT_CODE_MULTI) between FMU and IO.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <modules/px4iofirmware/protocol.h>
+
+namespace px4io
+{
+
+/**
+ * FMU side of a multi-page transaction.
+ *
+ * Register reads and writes are queued and sent to IO as one request, the
+ * values in the reply are then copied to the destinations of the reads.
+ */
+class Transaction
+{
+public:
+	static constexpr unsigned MAX_READS = 6;
+
+	/**
+	 * queue a register read
+	 *
+	 * @param page		Register page to read from.
+	 * @param offset	Register offset to start reading from.
+	 * @param values	Pointer to array where values are stored by set_reply().
+	 * @param num_values	The number of values to read.
+	 * @param max_regs	Maximum number of registers in request and reply.
+	 * @return		false if the transaction has no room left.
+	 */
+	bool queue_get(uint8_t page, uint8_t offset, uint16_t *values, unsigned num_values, unsigned max_regs);
+
+	/**
+	 * queue a register write
+	 *
+	 * @param page		Register page to write to.
+	 * @param offset	Register offset to start writing at.
+	 * @param values	Pointer to array of values to write, copied into the transaction.
+	 * @param num_values	The number of values to write.
+	 * @param max_regs	Maximum number of registers in the request.
+	 * @return		false if the transaction has no room left.
+	 */
+	bool queue_set(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values, unsigned max_regs);
+
+	bool empty() const { return _request_count == 0; }
+
+	/**
+	 * A transaction with just one write, which is cheaper as a plain write transaction.
+	 */
+	bool single_write() const;
+
+	const uint16_t *request() const { return _request; }
+	unsigned request_count() const { return _request_count; }
+	unsigned reply_count() const { return _reply_count; }
+
+	/**
+	 * copy the values of a successful reply to the destinations of the queued reads
+	 *
+	 * @param reply		reply_count() registers, in request order.
+	 */
+	void set_reply(const uint16_t *reply);
+
+	void clear();
+
+private:
+	uint16_t	_request[PKT_MAX_REGS] {};
+	unsigned	_request_count{0};
+	uint16_t	*_read_values[MAX_READS] {};
+	uint8_t		_read_count[MAX_READS] {};
+	unsigned	_reads{0};
+	unsigned	_reply_count{0};
+};
+
+typedef int (*registers_get_t)(uint8_t page, uint8_t offset, uint16_t **values, unsigned *num_values);
+typedef int (*registers_set_t)(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values);
+
+/**
+ * IO side of a multi-page transaction: apply the operations of a request in order.
+ *
+ * @param request	Encoded register operations, must not overlap reply.
+ * @param request_count	Number of registers in request.
+ * @param reply		Receives the values of all reads, in request order.
+ * @param reply_max	Maximum number of registers in reply.
+ * @param get		Register page accessor for reads.
+ * @param set		Register page accessor for writes.
+ * @return		Number of registers in reply, -1 at the first failing operation.
+ */
+int apply(const uint16_t *request, unsigned request_count, uint16_t *reply, unsigned reply_max,
+	  registers_get_t get, registers_set_t set);
+
+} // namespace px4io
@@ -0,0 +1,330 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Tests for the FMU/IO multi-page transactions, looped back through the IO side
+ * handler, and the link time of a poll cycle with and without batching.
+ */
+
+#include <gtest/gtest.h>
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "PX4IOTransaction.hpp"
+
+namespace
+{
+
+static constexpr unsigned MAX_REGS = (PX4IO_MAX_TRANSFER_LEN - 2) / 2;
+static constexpr unsigned STATUS_REGS = PX4IO_P_STATUS_VRSSI - PX4IO_P_STATUS_FLAGS + 1;
+static constexpr unsigned RC_PROLOG = PX4IO_P_RAW_RC_BASE - PX4IO_P_RAW_RC_COUNT;
+static constexpr unsigned RC_POLL_CHANNELS = 9;
+static constexpr unsigned NUM_OUTPUTS = 8;
+
+// IO register pages, page * 100 + offset as initial value
+static constexpr unsigned PAGE_SIZE = 32;
+uint16_t status_page[PAGE_SIZE];
+uint16_t setup_page[PAGE_SIZE];
+uint16_t rc_page[PAGE_SIZE];
+uint16_t pwm_page[NUM_OUTPUTS];
+
+uint16_t *find_page(uint8_t page, unsigned &size)
+{
+	switch (page) {
+	case PX4IO_PAGE_STATUS: size = PAGE_SIZE; return status_page;
+
+	case PX4IO_PAGE_SETUP: size = PAGE_SIZE; return setup_page;
+
+	case PX4IO_PAGE_RAW_RC_INPUT: size = PAGE_SIZE; return rc_page;
+
+	case PX4IO_PAGE_DIRECT_PWM: size = NUM_OUTPUTS; return pwm_page;
+
+	default: size = 0; return nullptr;
+	}
+}
+
+int registers_get(uint8_t page, uint8_t offset, uint16_t **values, unsigned *num_values)
+{
+	unsigned size;
+	uint16_t *registers = find_page(page, size);
+
+	if ((registers == nullptr) || (offset >= size)) {
+		return -1;
+	}
+
+	*values = &registers[offset];
+	*num_values = size - offset;
+	return 0;
+}
+
+int registers_set(uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values)
+{
+	unsigned size;
+	uint16_t *registers = find_page(page, size);
+
+	if ((registers == nullptr) || (offset + num_values > size)) {
+		return -1;
+	}
+
+	memcpy(&registers[offset], values, num_values * sizeof(values[0]));
+	return 0;
+}
+
+void reset_pages()
+{
+	for (unsigned i = 0; i < PAGE_SIZE; i++) {
+		status_page[i] = PX4IO_PAGE_STATUS * 100 + i;
+		setup_page[i] = PX4IO_PAGE_SETUP * 100 + i;
+		rc_page[i] = PX4IO_PAGE_RAW_RC_INPUT * 100 + i;
+	}
+
+	memset(pwm_page, 0, sizeof(pwm_page));
+}
+
+/**
+ * FMU <-> IO serial link: 1.5 Mbit/s, 8N1 and a fixed turnaround per exchange
+ * (IO packet handling and the FMU DMA completion).
+ */
+class Link
+{
+public:
+	static constexpr double BITRATE = 1.5e6;
+	static constexpr double BITS_PER_BYTE = 10.;
+	static constexpr double TURNAROUND_US = 40.;
+
+	static unsigned packet_bytes(unsigned regs) { return offsetof(IOPacket, regs) + regs * sizeof(uint16_t); }
+
+	/**
+	 * @return the time at which IO received the complete request
+	 */
+	double exchange(unsigned request_regs, unsigned reply_regs)
+	{
+		const unsigned request_bytes = packet_bytes(request_regs);
+		const unsigned reply_bytes = packet_bytes(reply_regs);
+
+		const double request_received = time_us + wire_us(request_bytes);
+		time_us = request_received + wire_us(reply_bytes) + TURNAROUND_US;
+		bytes += request_bytes + reply_bytes;
+		exchanges++;
+
+		return request_received;
+	}
+
+	double time_us{0.};
+	unsigned bytes{0};
+	unsigned exchanges{0};
+
+private:
+	static double wire_us(unsigned num_bytes) { return num_bytes * BITS_PER_BYTE / BITRATE * 1e6; }
+};
+
+// a plain read request carries as many registers as it reads
+double plain_read(Link &link, uint8_t page, uint8_t offset, uint16_t *values, unsigned num_values)
+{
+	uint16_t *registers;
+	unsigned available;
+	EXPECT_EQ(registers_get(page, offset, &registers, &available), 0);
+	memcpy(values, registers, num_values * sizeof(values[0]));
+	return link.exchange(num_values, num_values);
+}
+
+double plain_write(Link &link, uint8_t page, uint8_t offset, const uint16_t *values, unsigned num_values)
+{
+	EXPECT_EQ(registers_set(page, offset, values, num_values), 0);
+	return link.exchange(num_values, 0);
+}
+
+double multi_transfer(Link &link, px4io::Transaction &transaction)
+{
+	uint16_t reply[PKT_MAX_REGS];
+	const int reply_count = px4io::apply(transaction.request(), transaction.request_count(), reply, PKT_MAX_REGS,
+					     registers_get, registers_set);
+	EXPECT_EQ(reply_count, (int)transaction.reply_count());
+	transaction.set_reply(reply);
+
+	const double request_received = link.exchange(transaction.request_count(), transaction.reply_count());
+	transaction.clear();
+	return request_received;
+}
+
+} // namespace
+
+TEST(PX4IOTransactionTest, PollCycleLoopback)
+{
+	reset_pages();
+
+	uint16_t outputs[NUM_OUTPUTS];
+
+	for (unsigned i = 0; i < NUM_OUTPUTS; i++) {
+		outputs[i] = 1000 + i;
+	}
+
+	uint16_t status_regs[STATUS_REGS] {};
+	uint16_t setup_arming = 0;
+	uint16_t rc_regs[RC_PROLOG + RC_POLL_CHANNELS] {};
+
+	px4io::Transaction transaction;
+	EXPECT_TRUE(transaction.queue_set(PX4IO_PAGE_DIRECT_PWM, 0, outputs, NUM_OUTPUTS, MAX_REGS));
+	EXPECT_TRUE(transaction.queue_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, status_regs, STATUS_REGS, MAX_REGS));
+	EXPECT_TRUE(transaction.queue_get(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING, &setup_arming, 1, MAX_REGS));
+	EXPECT_TRUE(transaction.queue_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, rc_regs,
+					  RC_PROLOG + RC_POLL_CHANNELS, MAX_REGS));
+	EXPECT_FALSE(transaction.single_write());
+
+	Link link;
+	multi_transfer(link, transaction);
+	EXPECT_TRUE(transaction.empty());
+
+	EXPECT_EQ(memcmp(pwm_page, outputs, sizeof(outputs)), 0);
+
+	for (unsigned i = 0; i < STATUS_REGS; i++) {
+		EXPECT_EQ(status_regs[i], PX4IO_PAGE_STATUS * 100 + PX4IO_P_STATUS_FLAGS + i);
+	}
+
+	EXPECT_EQ(setup_arming, PX4IO_PAGE_SETUP * 100 + PX4IO_P_SETUP_ARMING);
+
+	for (unsigned i = 0; i < RC_PROLOG + RC_POLL_CHANNELS; i++) {
+		EXPECT_EQ(rc_regs[i], PX4IO_PAGE_RAW_RC_INPUT * 100 + PX4IO_P_RAW_RC_COUNT + i);
+	}
+}
+
+TEST(PX4IOTransactionTest, PollCycleLinkTime)
+{
+	reset_pages();
+
+	uint16_t outputs[NUM_OUTPUTS] {};
+	uint16_t status_regs[STATUS_REGS] {};
+	uint16_t setup_arming = 0;
+	uint16_t frame_count = 0;
+	uint16_t rc_regs[RC_PROLOG + RC_POLL_CHANNELS] {};
+
+	// one exchange per register block, as before multi-page transactions
+	Link separate;
+	const double separate_pwm_us = plain_write(separate, PX4IO_PAGE_DIRECT_PWM, 0, outputs, NUM_OUTPUTS);
+	plain_read(separate, PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, status_regs, STATUS_REGS);
+	plain_read(separate, PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING, &setup_arming, 1);
+	plain_read(separate, PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_FRAME_COUNT, &frame_count, 1);
+	plain_read(separate, PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, rc_regs, RC_PROLOG + RC_POLL_CHANNELS);
+
+	// everything in one multi-page transaction
+	px4io::Transaction transaction;
+	transaction.queue_set(PX4IO_PAGE_DIRECT_PWM, 0, outputs, NUM_OUTPUTS, MAX_REGS);
+	transaction.queue_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, status_regs, STATUS_REGS, MAX_REGS);
+	transaction.queue_get(PX4IO_PAGE_SETUP, PX4IO_P_SETUP_ARMING, &setup_arming, 1, MAX_REGS);
+	transaction.queue_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, rc_regs, RC_PROLOG + RC_POLL_CHANNELS,
+			      MAX_REGS);
+
+	Link batched;
+	const double batched_pwm_us = multi_transfer(batched, transaction);
+
+	// cycles without a poll only write the outputs, as a plain write
+	transaction.queue_set(PX4IO_PAGE_DIRECT_PWM, 0, outputs, NUM_OUTPUTS, MAX_REGS);
+	EXPECT_TRUE(transaction.single_write());
+	transaction.clear();
+
+	Link output_only;
+	plain_write(output_only, PX4IO_PAGE_DIRECT_PWM, 0, outputs, NUM_OUTPUTS);
+
+	printf("poll cycle, separate  %u exchanges %3u bytes %4.0f us, PWM applied at %3.0f us\n",
+	       separate.exchanges, separate.bytes, separate.time_us, separate_pwm_us);
+	printf("poll cycle, batched   %u exchange  %3u bytes %4.0f us, PWM applied at %3.0f us\n",
+	       batched.exchanges, batched.bytes, batched.time_us, batched_pwm_us);
+	printf("output-only cycle     %u exchange  %3u bytes %4.0f us\n",
+	       output_only.exchanges, output_only.bytes, output_only.time_us);
+
+	EXPECT_EQ(separate.exchanges, 5u);
+	EXPECT_EQ(batched.exchanges, 1u);
+	EXPECT_LT(batched.bytes, separate.bytes);
+	EXPECT_LT(batched.time_us, 0.6 * separate.time_us);
+
+	// the outputs share the larger request, but stay within a few packet headers of a plain write
+	EXPECT_GT(batched_pwm_us, separate_pwm_us);
+	EXPECT_LT(batched_pwm_us, separate_pwm_us + 150.);
+}
+
+TEST(PX4IOTransactionTest, QueueLimits)
+{
+	uint16_t values[PKT_MAX_REGS] {};
+	px4io::Transaction transaction;
+
+	// request and reply are limited to max_regs
+	EXPECT_FALSE(transaction.queue_set(PX4IO_PAGE_DIRECT_PWM, 0, values, MAX_REGS - 1, MAX_REGS));
+	EXPECT_TRUE(transaction.queue_set(PX4IO_PAGE_DIRECT_PWM, 0, values, MAX_REGS - 2, MAX_REGS));
+	EXPECT_TRUE(transaction.single_write());
+	EXPECT_FALSE(transaction.queue_get(PX4IO_PAGE_STATUS, 0, values, 1, MAX_REGS));
+	transaction.clear();
+
+	EXPECT_FALSE(transaction.queue_get(PX4IO_PAGE_STATUS, 0, values, MAX_REGS + 1, MAX_REGS));
+
+	for (unsigned i = 0; i < px4io::Transaction::MAX_READS; i++) {
+		EXPECT_TRUE(transaction.queue_get(PX4IO_PAGE_STATUS, i, &values[i], 1, MAX_REGS));
+	}
+
+	EXPECT_FALSE(transaction.queue_get(PX4IO_PAGE_STATUS, 0, values, 1, MAX_REGS));
+	EXPECT_EQ(transaction.reply_count(), px4io::Transaction::MAX_READS);
+}
+
+TEST(PX4IOTransactionTest, ApplyStopsAtFirstError)
+{
+	reset_pages();
+
+	uint16_t reply[PKT_MAX_REGS];
+
+	// the write is applied, then the read of an unknown page fails
+	const uint16_t unknown_page[] = {
+		PKT_MULTI_ADDRESS(PX4IO_PAGE_DIRECT_PWM, 0), 1 | PKT_MULTI_WRITE, 1500,
+		PKT_MULTI_ADDRESS(PX4IO_PAGE_TEST, 0), 1,
+		PKT_MULTI_ADDRESS(PX4IO_PAGE_DIRECT_PWM, 1), 1 | PKT_MULTI_WRITE, 1600,
+	};
+	EXPECT_EQ(px4io::apply(unknown_page, sizeof(unknown_page) / 2, reply, PKT_MAX_REGS, registers_get, registers_set), -1);
+	EXPECT_EQ(pwm_page[0], 1500);
+	EXPECT_EQ(pwm_page[1], 0);
+
+	// reading past the end of a page
+	const uint16_t past_end[] = {PKT_MULTI_ADDRESS(PX4IO_PAGE_DIRECT_PWM, 4), NUM_OUTPUTS};
+	EXPECT_EQ(px4io::apply(past_end, 2, reply, PKT_MAX_REGS, registers_get, registers_set), -1);
+
+	// write values missing from the request
+	const uint16_t short_write[] = {PKT_MULTI_ADDRESS(PX4IO_PAGE_DIRECT_PWM, 0), 2 | PKT_MULTI_WRITE, 1500};
+	EXPECT_EQ(px4io::apply(short_write, 3, reply, PKT_MAX_REGS, registers_get, registers_set), -1);
+
+	// trailing partial operation header
+	const uint16_t trailing[] = {PKT_MULTI_ADDRESS(PX4IO_PAGE_STATUS, 0), 1, PKT_MULTI_ADDRESS(PX4IO_PAGE_STATUS, 1)};
+	EXPECT_EQ(px4io::apply(trailing, 3, reply, PKT_MAX_REGS, registers_get, registers_set), -1);
+
+	// reply larger than the packet
+	const uint16_t too_large[] = {PKT_MULTI_ADDRESS(PX4IO_PAGE_STATUS, 0), PAGE_SIZE};
+	EXPECT_EQ(px4io::apply(too_large, 2, reply, PAGE_SIZE - 1, registers_get, registers_set), -1);
+}
@@ -79,6 +79,9 @@ void Accelerometer::SensorCorrectionsUpdate(bool force)
 			return;
 		}
 
+		// zero thermal offset if not found
+		Vector3f thermal_offset{};
+
 		sensor_correction_s corrections;
 
 		if (_sensor_correction_sub.copy(&corrections)) {
@@ -87,24 +90,26 @@ void Accelerometer::SensorCorrectionsUpdate(bool force)
 				if (corrections.accel_device_ids[i] == _device_id) {
 					switch (i) {
 					case 0:
-						_thermal_offset = Vector3f{corrections.accel_offset_0};
-						return;
+						thermal_offset = Vector3f{corrections.accel_offset_0};
+						break;
 					case 1:
-						_thermal_offset = Vector3f{corrections.accel_offset_1};
-						return;
+						thermal_offset = Vector3f{corrections.accel_offset_1};
+						break;
 					case 2:
-						_thermal_offset = Vector3f{corrections.accel_offset_2};
-						return;
+						thermal_offset = Vector3f{corrections.accel_offset_2};
+						break;
 					case 3:
-						_thermal_offset = Vector3f{corrections.accel_offset_3};
-						return;
+						thermal_offset = Vector3f{corrections.accel_offset_3};
+						break;
 					}
+
+					break;
 				}
 			}
 		}
 
-		// zero thermal offset if not found
-		_thermal_offset.zero();
+		_thermal_offset = thermal_offset;
+		_combined_offset = _offset + _thermal_offset;
 	}
 }
 
@@ -113,6 +118,7 @@ bool Accelerometer::set_offset(const Vector3f &offset)
 	if (Vector3f(_offset - offset).longerThan(0.01f)) {
 		if (offset.isAllFinite()) {
 			_offset = offset;
+			_combined_offset = _offset + _thermal_offset;
 			_calibration_count++;
 			return true;
 		}
@@ -126,6 +132,7 @@ bool Accelerometer::set_scale(const Vector3f &scale)
 	if (Vector3f(_scale - scale).longerThan(0.01f)) {
 		if (scale.isAllFinite() && (scale(0) > 0.f) && (scale(1) > 0.f) && (scale(2) > 0.f)) {
 			_scale = scale;
+			_rotation_scale = _rotation * diag(_scale);
 			_calibration_count++;
 			return true;
 		}
@@ -140,6 +147,7 @@ void Accelerometer::set_rotation(Rotation rotation)
 
 	// always apply board level adjustments
 	_rotation = Dcmf(GetSensorLevelAdjustment()) * get_rot_matrix(rotation);
+	_rotation_scale = _rotation * diag(_scale);
 }
 
 bool Accelerometer::set_calibration_index(int calibration_index)
@@ -229,9 +237,12 @@ void Accelerometer::Reset()
 
 	_offset.zero();
 	_scale = Vector3f{1.f, 1.f, 1.f};
+	_rotation_scale = _rotation;
 
 	_thermal_offset.zero();
 
+	_combined_offset.zero();
+
 	_priority = _external ? DEFAULT_EXTERNAL_PRIORITY : DEFAULT_PRIORITY;
 
 	_calibration_index = -1;
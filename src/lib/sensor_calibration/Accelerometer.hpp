@@ -81,7 +81,7 @@ public:
 	// rotate corrected measurements from sensor to body frame
 	inline matrix::Vector3f Correct(const matrix::Vector3f &data) const
 	{
-		return _rotation * matrix::Vector3f{(data - _thermal_offset - _offset).emult(_scale)};
+		return _rotation_scale * matrix::Vector3f{data - _combined_offset};
 	}
 
 	// Compute sensor offset from bias (board frame)
@@ -109,6 +109,10 @@ private:
 	matrix::Vector3f _scale;
 	matrix::Vector3f _thermal_offset;
 
+	// calibration and thermal offsets and rotation with scale folded in, precomputed for Correct()
+	matrix::Matrix3f _rotation_scale;
+	matrix::Vector3f _combined_offset;
+
 	int8_t _calibration_index{-1};
 	uint32_t _device_id{0};
 	int32_t _priority{-1};
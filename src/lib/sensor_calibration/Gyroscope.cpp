@@ -79,6 +79,9 @@ void Gyroscope::SensorCorrectionsUpdate(bool force)
 			return;
 		}
 
+		// zero thermal offset if not found
+		Vector3f thermal_offset{};
+
 		sensor_correction_s corrections;
 
 		if (_sensor_correction_sub.copy(&corrections)) {
@@ -87,24 +90,26 @@ void Gyroscope::SensorCorrectionsUpdate(bool force)
 				if (corrections.gyro_device_ids[i] == _device_id) {
 					switch (i) {
 					case 0:
-						_thermal_offset = Vector3f{corrections.gyro_offset_0};
-						return;
+						thermal_offset = Vector3f{corrections.gyro_offset_0};
+						break;
 					case 1:
-						_thermal_offset = Vector3f{corrections.gyro_offset_1};
-						return;
+						thermal_offset = Vector3f{corrections.gyro_offset_1};
+						break;
 					case 2:
-						_thermal_offset = Vector3f{corrections.gyro_offset_2};
-						return;
+						thermal_offset = Vector3f{corrections.gyro_offset_2};
+						break;
 					case 3:
-						_thermal_offset = Vector3f{corrections.gyro_offset_3};
-						return;
+						thermal_offset = Vector3f{corrections.gyro_offset_3};
+						break;
 					}
+
+					break;
 				}
 			}
 		}
 
-		// zero thermal offset if not found
-		_thermal_offset.zero();
+		_thermal_offset = thermal_offset;
+		_combined_offset = _offset + _thermal_offset;
 	}
 }
 
@@ -113,6 +118,7 @@ bool Gyroscope::set_offset(const Vector3f &offset)
 	if (Vector3f(_offset - offset).longerThan(0.01f) || (_calibration_count == 0)) {
 		if (offset.isAllFinite()) {
 			_offset = offset;
+			_combined_offset = _offset + _thermal_offset;
 			_calibration_count++;
 			return true;
 		}
@@ -215,6 +221,8 @@ void Gyroscope::Reset()
 
 	_thermal_offset.zero();
 
+	_combined_offset.zero();
+
 	_priority = _external ? DEFAULT_EXTERNAL_PRIORITY : DEFAULT_PRIORITY;
 
 	_calibration_index = -1;
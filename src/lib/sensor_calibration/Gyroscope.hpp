@@ -80,7 +80,7 @@ public:
 	// rotate corrected measurements from sensor to body frame
 	inline matrix::Vector3f Correct(const matrix::Vector3f &data) const
 	{
-		return _rotation * matrix::Vector3f{data - _thermal_offset - _offset};
+		return _rotation * matrix::Vector3f{data - _combined_offset};
 	}
 
 	inline matrix::Vector3f Uncorrect(const matrix::Vector3f &corrected_data) const
@@ -112,6 +112,9 @@ private:
 	matrix::Vector3f _offset;
 	matrix::Vector3f _thermal_offset;
 
+	// calibration and thermal offset combined, precomputed for Correct()
+	matrix::Vector3f _combined_offset;
+
 	int8_t _calibration_index{-1};
 	uint32_t _device_id{0};
 	int32_t _priority{-1};
@@ -0,0 +1,315 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ShmRingBuffer.hpp
+ *
+ * Single-writer, multi-reader ring buffer of fixed size slots, laid out so
+ * that it can live in a memory region shared between processes.
+ *
+ * Each slot is guarded by a sequence number (seqlock), so readers never
+ * block the writer. A reader that falls more than one lap behind detects
+ * the overrun and skips ahead to the oldest slot that is still valid.
+ *
+ * The header has no dependency on PX4, so that host-side consumers can
+ * include it directly.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "atomic must not add state");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory atomics must be lock free");
+
+class ShmRingBuffer
+{
+public:
+	static constexpr uint32_t MAGIC = 0x50583453; // 'PX4S'
+	static constexpr uint16_t VERSION = 2;
+	static constexpr size_t NAME_LEN = 48;
+
+	struct Header {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t reserved;
+		uint32_t slot_count;
+		uint32_t slot_size;                 ///< payload bytes per slot
+		int32_t writer_pid;                 ///< process id of the writer, to detect stale segments
+		char name[NAME_LEN];                ///< topic name, informational
+		alignas(64) std::atomic<uint64_t> write_count; ///< number of completed writes
+	};
+
+	struct Slot {
+		std::atomic<uint64_t> seq;          ///< write index + 1 once complete, 0 while being written
+		uint64_t timestamp;                 ///< writer timestamp [us]
+		uint32_t size;                      ///< valid payload bytes
+		uint32_t reserved;
+		// payload follows
+	};
+
+	/**
+	 * @return number of bytes needed to hold a ring buffer with the given geometry
+	 */
+	static constexpr size_t required_size(uint32_t slot_count, uint32_t slot_size)
+	{
+		return sizeof(Header) + static_cast<size_t>(slot_count) * slot_stride(slot_size);
+	}
+
+	/**
+	 * Format a memory region as empty ring buffer (writer side).
+	 * @param writer_pid process id of the writer, stored in the header
+	 * @return false if the region is too small or the geometry invalid
+	 */
+	bool init(void *mem, size_t mem_size, uint32_t slot_count, uint32_t slot_size, const char *name,
+		  int32_t writer_pid = 0)
+	{
+		if (mem == nullptr || slot_count == 0 || slot_size == 0 || mem_size < required_size(slot_count, slot_size)) {
+			return false;
+		}
+
+		_header = static_cast<Header *>(mem);
+		_slots = reinterpret_cast<uint8_t *>(_header + 1);
+
+		_header->magic = 0;
+		_header->version = VERSION;
+		_header->reserved = 0;
+		_header->slot_count = slot_count;
+		_header->slot_size = slot_size;
+		_header->writer_pid = writer_pid;
+		memset(_header->name, 0, sizeof(_header->name));
+
+		if (name) {
+			strncpy(_header->name, name, sizeof(_header->name) - 1);
+		}
+
+		_header->write_count.store(0, std::memory_order_relaxed);
+
+		for (uint32_t i = 0; i < slot_count; i++) {
+			Slot *s = slot(i);
+			s->seq.store(0, std::memory_order_relaxed);
+			s->timestamp = 0;
+			s->size = 0;
+			s->reserved = 0;
+		}
+
+		// publish the magic last so that readers never attach to a half initialized buffer
+		std::atomic_thread_fence(std::memory_order_release);
+		_header->magic = MAGIC;
+
+		return true;
+	}
+
+	/**
+	 * Attach to an already formatted memory region (reader side).
+	 * @return false if the region does not contain a valid ring buffer
+	 */
+	bool attach(const void *mem, size_t mem_size)
+	{
+		if (mem == nullptr || mem_size < sizeof(Header)) {
+			return false;
+		}
+
+		Header *header = static_cast<Header *>(const_cast<void *>(mem));
+
+		if (header->magic != MAGIC || header->version != VERSION
+		    || mem_size < required_size(header->slot_count, header->slot_size)) {
+			return false;
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		_header = header;
+		_slots = reinterpret_cast<uint8_t *>(_header + 1);
+		return true;
+	}
+
+	bool valid() const { return _header != nullptr; }
+
+	uint32_t slot_count() const { return _header ? _header->slot_count : 0; }
+	uint32_t slot_size() const { return _header ? _header->slot_size : 0; }
+	const char *name() const { return _header ? _header->name : ""; }
+	int32_t writer_pid() const { return _header ? _header->writer_pid : 0; }
+
+	uint64_t write_count() const { return _header ? _header->write_count.load(std::memory_order_acquire) : 0; }
+
+	/**
+	 * Write one message. Only a single writer is allowed.
+	 * @return false if the message does not fit into a slot
+	 */
+	bool write(const void *data, uint32_t size, uint64_t timestamp = 0)
+	{
+		if (!_header || size > _header->slot_size) {
+			return false;
+		}
+
+		const uint64_t index = _header->write_count.load(std::memory_order_relaxed);
+		Slot *s = slot(index % _header->slot_count);
+
+		// mark the slot as being written, readers copying it concurrently will detect the change
+		s->seq.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		s->timestamp = timestamp;
+		s->size = size;
+		memcpy(payload(s), data, size);
+
+		s->seq.store(index + 1, std::memory_order_release);
+		_header->write_count.store(index + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/**
+	 * Read the next message after @p cursor.
+	 *
+	 * @param cursor number of messages consumed so far, advanced on success. Start with 0 to
+	 *               read from the oldest available message, or with write_count() to only get new ones.
+	 * @param dst destination buffer
+	 * @param dst_size size of @p dst, the message is truncated if it is too small
+	 * @param timestamp optional, set to the writer timestamp
+	 * @param lost optional, incremented by the number of messages that were overwritten before they could be read
+	 * @return number of payload bytes copied, 0 if there is no new message
+	 */
+	uint32_t read(uint64_t &cursor, void *dst, uint32_t dst_size, uint64_t *timestamp = nullptr, uint32_t *lost = nullptr) const
+	{
+		if (!_header) {
+			return 0;
+		}
+
+		const uint32_t slot_count = _header->slot_count;
+
+		for (int attempt = 0; attempt < 4; attempt++) {
+			const uint64_t written = _header->write_count.load(std::memory_order_acquire);
+
+			if (cursor >= written) {
+				return 0;
+			}
+
+			if (written - cursor > slot_count) {
+				// overrun: skip to the oldest message still in the buffer
+				if (lost) {
+					*lost += static_cast<uint32_t>(written - slot_count - cursor);
+				}
+
+				cursor = written - slot_count;
+			}
+
+			const uint32_t copied = copy_slot(cursor, dst, dst_size, timestamp);
+
+			if (copied > 0) {
+				cursor++;
+				return copied;
+			}
+
+			// slot got overwritten while copying, retry from the new position
+		}
+
+		return 0;
+	}
+
+	/**
+	 * Read the most recent message, skipping anything older.
+	 * @return number of payload bytes copied, 0 if no message is available
+	 */
+	uint32_t read_latest(void *dst, uint32_t dst_size, uint64_t *timestamp = nullptr) const
+	{
+		for (int attempt = 0; attempt < 4; attempt++) {
+			const uint64_t written = write_count();
+
+			if (written == 0) {
+				return 0;
+			}
+
+			const uint32_t copied = copy_slot(written - 1, dst, dst_size, timestamp);
+
+			if (copied > 0) {
+				return copied;
+			}
+		}
+
+		return 0;
+	}
+
+private:
+	static constexpr size_t slot_stride(uint32_t slot_size)
+	{
+		// keep every slot 8 byte aligned
+		return (sizeof(Slot) + slot_size + 7u) & ~static_cast<size_t>(7u);
+	}
+
+	Slot *slot(uint64_t i) const { return reinterpret_cast<Slot *>(_slots + (i % _header->slot_count) * slot_stride(_header->slot_size)); }
+	static uint8_t *payload(Slot *s) { return reinterpret_cast<uint8_t *>(s + 1); }
+
+	uint32_t copy_slot(uint64_t index, void *dst, uint32_t dst_size, uint64_t *timestamp) const
+	{
+		Slot *s = slot(index);
+
+		if (s->seq.load(std::memory_order_acquire) != index + 1) {
+			return 0;
+		}
+
+		uint32_t size = s->size;
+
+		if (size > _header->slot_size) {
+			return 0;
+		}
+
+		if (size > dst_size) {
+			size = dst_size;
+		}
+
+		const uint64_t ts = s->timestamp;
+		memcpy(dst, payload(s), size);
+
+		// make sure the copy completed before checking that the slot is unchanged
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (s->seq.load(std::memory_order_relaxed) != index + 1) {
+			return 0;
+		}
+
+		if (timestamp) {
+			*timestamp = ts;
+		}
+
+		return size;
+	}
+
+	Header *_header{nullptr};
+	uint8_t *_slots{nullptr};
+};
@@ -0,0 +1,206 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "ShmTransport.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+void ShmSegment::segment_name(char *buf, size_t len, int px4_instance, const char *bridge, const char *topic,
+			      int instance)
+{
+	if (instance > 0) {
+		snprintf(buf, len, "/px4_%i_%s_%s%i", px4_instance, bridge, topic, instance);
+
+	} else {
+		snprintf(buf, len, "/px4_%i_%s_%s", px4_instance, bridge, topic);
+	}
+
+	// topic names of a bridge can contain '/', which is not allowed in a segment name
+	for (char *c = buf + 1; *c != '\0'; c++) {
+		if (*c == '/') {
+			*c = '_';
+		}
+	}
+}
+
+bool ShmSegment::in_use(const char *segment)
+{
+	ShmSegment existing;
+
+	if (!existing.open(segment)) {
+		// not a ring buffer (of this version)
+		return false;
+	}
+
+	const pid_t pid = existing.ring().writer_pid();
+
+	if (pid <= 0) {
+		return false;
+	}
+
+	// another writer in this process (e.g. the same topic mapped twice), or a running process
+	return (pid == getpid()) || (kill(pid, 0) == 0) || (errno == EPERM);
+}
+
+bool ShmSegment::create(const char *segment, const char *topic, uint32_t slot_count, uint32_t slot_size)
+{
+	close();
+
+	const size_t size = ShmRingBuffer::required_size(slot_count, slot_size);
+
+	int fd = shm_open(segment, O_CREAT | O_EXCL | O_RDWR, 0644);
+
+	if ((fd < 0) && (errno == EEXIST)) {
+		if (in_use(segment)) {
+			errno = EBUSY;
+			return false;
+		}
+
+		// stale segment left over by a writer that exited, readers still mapping it keep their copy
+		shm_unlink(segment);
+		fd = shm_open(segment, O_CREAT | O_EXCL | O_RDWR, 0644);
+	}
+
+	if (fd < 0) {
+		return false;
+	}
+
+	if (ftruncate(fd, size) != 0) {
+		::close(fd);
+		shm_unlink(segment);
+		return false;
+	}
+
+	void *mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (mem == MAP_FAILED) {
+		shm_unlink(segment);
+		return false;
+	}
+
+	_mem = mem;
+	_mem_size = size;
+	_owner = true;
+	strncpy(_segment, segment, sizeof(_segment) - 1);
+
+	if (!_ring.init(_mem, _mem_size, slot_count, slot_size, topic, getpid())) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+bool ShmSegment::open(const char *segment)
+{
+	close();
+
+	int fd = shm_open(segment, O_RDONLY, 0);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat st {};
+
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
+
+	void *mem = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (mem == MAP_FAILED) {
+		return false;
+	}
+
+	_mem = mem;
+	_mem_size = st.st_size;
+	_owner = false;
+	strncpy(_segment, segment, sizeof(_segment) - 1);
+
+	if (!_ring.attach(_mem, _mem_size)) {
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void ShmSegment::close()
+{
+	if (_mem) {
+		munmap(_mem, _mem_size);
+		_mem = nullptr;
+		_mem_size = 0;
+	}
+
+	if (_owner) {
+		shm_unlink(_segment);
+		_owner = false;
+	}
+
+	_ring = ShmRingBuffer{};
+	_segment[0] = '\0';
+}
+
+bool ShmTopicWriter::init(int px4_instance, const char *bridge, const char *topic, uint32_t message_size, int instance,
+			  uint32_t slot_count)
+{
+	char segment[64];
+	ShmSegment::segment_name(segment, sizeof(segment), px4_instance, bridge, topic, instance);
+	return _segment.create(segment, topic, slot_count, message_size);
+}
+
+bool ShmTopicReader::init(int px4_instance, const char *bridge, const char *topic, int instance, bool latest_only)
+{
+	char segment[64];
+	ShmSegment::segment_name(segment, sizeof(segment), px4_instance, bridge, topic, instance);
+
+	if (!_segment.open(segment)) {
+		return false;
+	}
+
+	_cursor = latest_only ? _segment.ring().write_count() : 0;
+	_lost = 0;
+	return true;
+}
@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ShmTransport.hpp
+ *
+ * POSIX shared memory segments holding one ShmRingBuffer per topic.
+ *
+ * The writer (PX4 side) creates the segment "/px4_<px4 instance>_<bridge>_<topic>"
+ * and publishes every message once. Any number of processes on the same host can map the
+ * segment read-only and consume the messages directly, without
+ * serialization or a socket round trip.
+ */
+
+#pragma once
+
+#include "ShmRingBuffer.hpp"
+
+class ShmSegment
+{
+public:
+	ShmSegment() = default;
+	~ShmSegment() { close(); }
+
+	ShmSegment(const ShmSegment &) = delete;
+	ShmSegment &operator=(const ShmSegment &) = delete;
+
+	/**
+	 * Build the segment name for a topic, e.g. "/px4_0_zenoh_sensor_combined" or
+	 * "/px4_0_zenoh_sensor_combined1" for multi-instance topics. A '/' in the topic name is replaced by '_'.
+	 *
+	 * @param px4_instance PX4 instance (px4 -i), to separate multiple vehicles on the same host
+	 * @param bridge name of the publishing bridge, to separate multiple bridges publishing the same topic
+	 */
+	static void segment_name(char *buf, size_t len, int px4_instance, const char *bridge, const char *topic,
+				 int instance = 0);
+
+	/**
+	 * Create a segment and format it as ring buffer.
+	 *
+	 * A segment left over by a writer process that no longer exists is replaced. If the segment is
+	 * still in use by a running writer this fails with errno set to EBUSY.
+	 */
+	bool create(const char *segment, const char *topic, uint32_t slot_count, uint32_t slot_size);
+
+	/**
+	 * Map an existing segment read-only.
+	 */
+	bool open(const char *segment);
+
+	void close();
+
+	const char *name() const { return _segment; }
+
+	ShmRingBuffer &ring() { return _ring; }
+	const ShmRingBuffer &ring() const { return _ring; }
+
+	bool valid() const { return _ring.valid(); }
+
+private:
+	/**
+	 * @return true if the existing segment is formatted and its writer process is still running
+	 */
+	static bool in_use(const char *segment);
+
+	ShmRingBuffer _ring{};
+
+	void *_mem{nullptr};
+	size_t _mem_size{0};
+
+	char _segment[64] {};
+	bool _owner{false};
+};
+
+/**
+ * Writer side, publishes raw messages of a single topic.
+ */
+class ShmTopicWriter
+{
+public:
+	static constexpr uint32_t DEFAULT_SLOT_COUNT = 16;
+
+	/**
+	 * @return false on error (errno is set), in particular EBUSY if another running writer owns the segment
+	 */
+	bool init(int px4_instance, const char *bridge, const char *topic, uint32_t message_size, int instance = 0,
+		  uint32_t slot_count = DEFAULT_SLOT_COUNT);
+
+	bool publish(const void *data, uint32_t size, uint64_t timestamp)
+	{
+		return _segment.ring().write(data, size, timestamp);
+	}
+
+	bool valid() const { return _segment.valid(); }
+
+	uint64_t published() const { return _segment.ring().write_count(); }
+
+	const char *segment() const { return _segment.name(); }
+
+private:
+	ShmSegment _segment{};
+};
+
+/**
+ * Reader side, consumes the messages of a single topic.
+ */
+class ShmTopicReader
+{
+public:
+	/**
+	 * @param latest_only start with the next published message instead of the oldest one still buffered
+	 */
+	bool init(int px4_instance, const char *bridge, const char *topic, int instance = 0, bool latest_only = true);
+
+	/**
+	 * Copy the next unread message.
+	 * @return number of bytes copied, 0 if there is no new message
+	 */
+	uint32_t read(void *dst, uint32_t dst_size, uint64_t *timestamp = nullptr)
+	{
+		return _segment.ring().read(_cursor, dst, dst_size, timestamp, &_lost);
+	}
+
+	bool updated() const { return _segment.ring().write_count() > _cursor; }
+
+	bool valid() const { return _segment.valid(); }
+
+	uint32_t lost() const { return _lost; }
+
+private:
+	ShmSegment _segment{};
+	uint64_t _cursor{0};
+	uint32_t _lost{0};
+};
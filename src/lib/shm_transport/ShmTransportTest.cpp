@@ -0,0 +1,282 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ShmRingBuffer.hpp"
+#include "ShmTransport.hpp"
+
+namespace
+{
+
+struct TestMessage {
+	uint64_t timestamp;
+	uint32_t counter;
+	float data[9];
+	uint32_t checksum;
+};
+
+TestMessage make_message(uint32_t counter)
+{
+	TestMessage msg{};
+	msg.timestamp = counter * 1000ull;
+	msg.counter = counter;
+	msg.checksum = counter;
+
+	for (int i = 0; i < 9; i++) {
+		msg.data[i] = counter + i;
+		msg.checksum ^= static_cast<uint32_t>(msg.data[i]) << i;
+	}
+
+	return msg;
+}
+
+bool consistent(const TestMessage &msg)
+{
+	uint32_t checksum = msg.counter;
+
+	for (int i = 0; i < 9; i++) {
+		checksum ^= static_cast<uint32_t>(msg.data[i]) << i;
+	}
+
+	return checksum == msg.checksum;
+}
+
+} // namespace
+
+TEST(ShmRingBuffer, InitAndAttach)
+{
+	std::vector<uint8_t> mem(ShmRingBuffer::required_size(4, sizeof(TestMessage)));
+
+	ShmRingBuffer writer;
+	EXPECT_FALSE(writer.init(mem.data(), mem.size() - 1, 4, sizeof(TestMessage), "test"));
+	ASSERT_TRUE(writer.init(mem.data(), mem.size(), 4, sizeof(TestMessage), "test"));
+
+	ShmRingBuffer reader;
+	ASSERT_TRUE(reader.attach(mem.data(), mem.size()));
+	EXPECT_EQ(reader.slot_count(), 4u);
+	EXPECT_EQ(reader.slot_size(), sizeof(TestMessage));
+	EXPECT_STREQ(reader.name(), "test");
+
+	// garbage is rejected
+	std::vector<uint8_t> garbage(mem.size(), 0xAA);
+	EXPECT_FALSE(ShmRingBuffer{}.attach(garbage.data(), garbage.size()));
+}
+
+TEST(ShmRingBuffer, WriteRead)
+{
+	std::vector<uint8_t> mem(ShmRingBuffer::required_size(4, sizeof(TestMessage)));
+	ShmRingBuffer writer;
+	ASSERT_TRUE(writer.init(mem.data(), mem.size(), 4, sizeof(TestMessage), "test"));
+
+	ShmRingBuffer reader;
+	ASSERT_TRUE(reader.attach(mem.data(), mem.size()));
+
+	uint64_t cursor = 0;
+	TestMessage msg{};
+	EXPECT_EQ(reader.read(cursor, &msg, sizeof(msg)), 0u);
+
+	// too large for a slot
+	uint8_t large[sizeof(TestMessage) + 1] {};
+	EXPECT_FALSE(writer.write(large, sizeof(large)));
+
+	for (uint32_t i = 0; i < 3; i++) {
+		TestMessage out = make_message(i);
+		EXPECT_TRUE(writer.write(&out, sizeof(out), out.timestamp));
+	}
+
+	for (uint32_t i = 0; i < 3; i++) {
+		uint64_t timestamp = 0;
+		EXPECT_EQ(reader.read(cursor, &msg, sizeof(msg), &timestamp), sizeof(msg));
+		EXPECT_EQ(msg.counter, i);
+		EXPECT_EQ(timestamp, i * 1000ull);
+		EXPECT_TRUE(consistent(msg));
+	}
+
+	EXPECT_EQ(reader.read(cursor, &msg, sizeof(msg)), 0u);
+	EXPECT_EQ(cursor, 3u);
+}
+
+TEST(ShmRingBuffer, Overrun)
+{
+	std::vector<uint8_t> mem(ShmRingBuffer::required_size(4, sizeof(TestMessage)));
+	ShmRingBuffer ring;
+	ASSERT_TRUE(ring.init(mem.data(), mem.size(), 4, sizeof(TestMessage), "test"));
+
+	for (uint32_t i = 0; i < 10; i++) {
+		TestMessage out = make_message(i);
+		ASSERT_TRUE(ring.write(&out, sizeof(out)));
+	}
+
+	// only the last 4 messages are still available
+	uint64_t cursor = 0;
+	uint32_t lost = 0;
+	TestMessage msg{};
+	EXPECT_EQ(ring.read(cursor, &msg, sizeof(msg), nullptr, &lost), sizeof(msg));
+	EXPECT_EQ(msg.counter, 6u);
+	EXPECT_EQ(lost, 6u);
+
+	EXPECT_EQ(ring.read_latest(&msg, sizeof(msg)), sizeof(msg));
+	EXPECT_EQ(msg.counter, 9u);
+}
+
+TEST(ShmRingBuffer, ConcurrentReader)
+{
+	static constexpr uint32_t NUM_MESSAGES = 200000;
+
+	std::vector<uint8_t> mem(ShmRingBuffer::required_size(8, sizeof(TestMessage)));
+	ShmRingBuffer writer;
+	ASSERT_TRUE(writer.init(mem.data(), mem.size(), 8, sizeof(TestMessage), "test"));
+
+	std::atomic<bool> torn{false};
+	std::atomic<bool> out_of_order{false};
+	uint32_t received = 0;
+	uint32_t lost = 0;
+
+	std::thread reader_thread([&]() {
+		ShmRingBuffer reader;
+		reader.attach(mem.data(), mem.size());
+		uint64_t cursor = 0;
+		int64_t last = -1;
+		TestMessage msg{};
+
+		while (last < NUM_MESSAGES - 1) {
+			if (reader.read(cursor, &msg, sizeof(msg), nullptr, &lost) > 0) {
+				torn = torn || !consistent(msg);
+				out_of_order = out_of_order || (int64_t)msg.counter <= last;
+				last = msg.counter;
+				received++;
+			}
+		}
+	});
+
+	for (uint32_t i = 0; i < NUM_MESSAGES; i++) {
+		TestMessage out = make_message(i);
+		writer.write(&out, sizeof(out));
+	}
+
+	reader_thread.join();
+
+	EXPECT_FALSE(torn);
+	EXPECT_FALSE(out_of_order);
+	EXPECT_EQ(received + lost, NUM_MESSAGES);
+}
+
+TEST(ShmTransport, TopicWriterReader)
+{
+	ShmTopicWriter writer;
+	ASSERT_TRUE(writer.init(0, "test", "shm_transport_test", sizeof(TestMessage), 1));
+	EXPECT_STREQ(writer.segment(), "/px4_0_test_shm_transport_test1");
+
+	ShmTopicReader reader;
+	EXPECT_FALSE(reader.init(0, "test", "shm_transport_test", 2));
+	EXPECT_FALSE(reader.init(1, "test", "shm_transport_test", 1));
+	EXPECT_FALSE(reader.init(0, "other", "shm_transport_test", 1));
+	ASSERT_TRUE(reader.init(0, "test", "shm_transport_test", 1));
+	EXPECT_FALSE(reader.updated());
+
+	TestMessage out = make_message(42);
+	EXPECT_TRUE(writer.publish(&out, sizeof(out), out.timestamp));
+	EXPECT_TRUE(reader.updated());
+
+	TestMessage in{};
+	EXPECT_EQ(reader.read(&in, sizeof(in)), sizeof(in));
+	EXPECT_EQ(in.counter, 42u);
+	EXPECT_FALSE(reader.updated());
+}
+
+TEST(ShmTransport, SegmentInUse)
+{
+	ShmTopicWriter writer;
+	ASSERT_TRUE(writer.init(0, "test", "shm_transport_busy", sizeof(TestMessage)));
+
+	// a second writer must not take over (and unlink) a segment that is still in use
+	ShmTopicWriter second;
+	errno = 0;
+	EXPECT_FALSE(second.init(0, "test", "shm_transport_busy", sizeof(TestMessage)));
+	EXPECT_EQ(errno, EBUSY);
+
+	ShmTopicReader reader;
+	ASSERT_TRUE(reader.init(0, "test", "shm_transport_busy"));
+	TestMessage out = make_message(7);
+	EXPECT_TRUE(writer.publish(&out, sizeof(out), out.timestamp));
+	EXPECT_TRUE(reader.updated());
+
+	// another px4 instance or bridge uses its own segment
+	ShmTopicWriter other_instance;
+	EXPECT_TRUE(other_instance.init(1, "test", "shm_transport_busy", sizeof(TestMessage)));
+	ShmTopicWriter other_bridge;
+	EXPECT_TRUE(other_bridge.init(0, "other", "shm_transport_busy", sizeof(TestMessage)));
+}
+
+TEST(ShmTransport, StaleSegmentReplaced)
+{
+	char segment[64];
+	ShmSegment::segment_name(segment, sizeof(segment), 0, "test", "shm_transport_stale");
+	shm_unlink(segment);
+
+	// leave a segment behind from a writer process that exited without cleaning up
+	pid_t child = fork();
+	ASSERT_GE(child, 0);
+
+	if (child == 0) {
+		ShmSegment stale;
+		_exit(stale.create(segment, "stale", 4, sizeof(TestMessage)) ? 0 : 1);
+	}
+
+	int status = 0;
+	ASSERT_EQ(waitpid(child, &status, 0), child);
+	ASSERT_TRUE(WIFEXITED(status));
+	ASSERT_EQ(WEXITSTATUS(status), 0);
+
+	ShmSegment existing;
+	ASSERT_TRUE(existing.open(segment));
+	EXPECT_EQ(existing.ring().writer_pid(), child);
+	existing.close();
+
+	ShmTopicWriter writer;
+	ASSERT_TRUE(writer.init(0, "test", "shm_transport_stale", sizeof(TestMessage)));
+
+	ASSERT_TRUE(existing.open(segment));
+	EXPECT_EQ(existing.ring().writer_pid(), getpid());
+}
@@ -0,0 +1,151 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "ShmUorbPublisher.hpp"
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/px4_work_queue/WorkQueueManager.hpp>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+ShmUorbPublisher::ShmUorbPublisher(const char *bridge) :
+	WorkItem("shm_publisher", px4::wq_configurations::lp_default)
+{
+	strncpy(_bridge, bridge, sizeof(_bridge) - 1);
+}
+
+ShmUorbPublisher::~ShmUorbPublisher()
+{
+	stop();
+
+	Topic *topic = _topics.getHead();
+
+	while (topic != nullptr) {
+		Topic *next = topic->getSibling();
+		delete topic;
+		topic = next;
+	}
+
+	delete[] _buffer;
+}
+
+int ShmUorbPublisher::px4_instance()
+{
+	const char *instance = getenv("PX4_INSTANCE");
+	return instance ? atoi(instance) : 0;
+}
+
+bool ShmUorbPublisher::add(const orb_metadata *meta, uint32_t interval_ms, uint8_t instance, const char *name)
+{
+	Topic *topic = new Topic(this, meta, instance);
+
+	if (topic == nullptr) {
+		return false;
+	}
+
+	if (name == nullptr) {
+		name = meta->o_name;
+	}
+
+	if (!topic->writer.init(px4_instance(), _bridge, name, meta->o_size, instance)) {
+		char segment[64];
+		ShmSegment::segment_name(segment, sizeof(segment), px4_instance(), _bridge, name, instance);
+		PX4_ERR("shared memory %s: %s", segment, strerror(errno));
+		delete topic;
+		return false;
+	}
+
+	if (meta->o_size > _buffer_size) {
+		delete[] _buffer;
+		_buffer = new uint8_t[meta->o_size];
+		_buffer_size = (_buffer != nullptr) ? meta->o_size : 0;
+	}
+
+	topic->subscription.set_interval_ms(interval_ms);
+	_topics.add(topic);
+	_topic_count++;
+	return true;
+}
+
+bool ShmUorbPublisher::start()
+{
+	bool ret = true;
+
+	for (Topic *topic : _topics) {
+		ret = topic->subscription.registerCallback() && ret;
+	}
+
+	// publish what is already there
+	ScheduleNow();
+
+	return ret;
+}
+
+void ShmUorbPublisher::stop()
+{
+	for (Topic *topic : _topics) {
+		topic->subscription.unregisterCallback();
+	}
+
+	ScheduleClear();
+}
+
+void ShmUorbPublisher::Run()
+{
+	update();
+}
+
+void ShmUorbPublisher::update()
+{
+	for (Topic *topic : _topics) {
+		if ((_buffer != nullptr) && topic->subscription.update(_buffer)) {
+			// every uORB message starts with its uint64_t timestamp
+			uint64_t timestamp;
+			memcpy(&timestamp, _buffer, sizeof(timestamp));
+			topic->writer.publish(_buffer, topic->subscription.get_topic()->o_size, timestamp);
+		}
+	}
+}
+
+void ShmUorbPublisher::print_status()
+{
+	PX4_INFO("shared memory: %u topics", _topic_count);
+
+	for (Topic *topic : _topics) {
+		PX4_INFO_RAW("  %s (%" PRIu64 " msgs)\n", topic->writer.segment(), topic->writer.published());
+	}
+}
@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ShmUorbPublisher.hpp
+ *
+ * Publishes a set of uORB topics into same-host shared memory segments
+ * (see ShmTransport.hpp), independent of any middleware session.
+ */
+
+#pragma once
+
+#include "ShmTransport.hpp"
+
+#include <containers/List.hpp>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+
+class ShmUorbPublisher : public px4::WorkItem
+{
+public:
+	/**
+	 * @param bridge name of the owning bridge, part of the segment names
+	 */
+	explicit ShmUorbPublisher(const char *bridge);
+	~ShmUorbPublisher() override;
+
+	/**
+	 * Add a topic, published to "/px4_<px4 instance>_<bridge>_<name><instance>". Must be called before start().
+	 * @param interval_ms minimum interval between published messages, 0 to publish every update
+	 * @param instance uORB instance to publish
+	 * @param name segment topic name, the uORB topic name by default. Bridges publishing the same
+	 *             uORB topic under several names must pass their own name for each.
+	 * @return false if the segment could not be created (e.g. it is used by another running writer)
+	 */
+	bool add(const orb_metadata *meta, uint32_t interval_ms = 0, uint8_t instance = 0, const char *name = nullptr);
+
+	/**
+	 * Register the uORB callbacks, from then on updates are published from the work queue.
+	 */
+	bool start();
+
+	void stop();
+
+	/**
+	 * Publish all updated topics.
+	 */
+	void update();
+
+	unsigned topic_count() const { return _topic_count; }
+
+	void print_status();
+
+	/**
+	 * @return PX4 instance of this process (px4 -i), 0 if not set
+	 */
+	static int px4_instance();
+
+private:
+	void Run() override;
+
+	struct Topic : public ListNode<Topic *> {
+		Topic(px4::WorkItem *item, const orb_metadata *meta, uint8_t instance) : subscription(item, meta, instance) {}
+
+		uORB::SubscriptionCallbackWorkItem subscription;
+		ShmTopicWriter writer;
+	};
+
+	List<Topic *> _topics;
+	unsigned _topic_count{0};
+
+	uint8_t *_buffer{nullptr};
+	size_t _buffer_size{0};
+
+	char _bridge[16] {};
+};
@@ -0,0 +1,152 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Shared memory publishing of uORB topics without any bridge session (no agent or router running).
+ */
+
+#include <gtest/gtest.h>
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include <uORB/Publication.hpp>
+#include <uORB/topics/orb_test.h>
+
+#include "ShmUorbPublisher.hpp"
+
+TEST(ShmUorbPublisher, PublishWithoutSession)
+{
+	ShmUorbPublisher publisher("gtest");
+	ASSERT_TRUE(publisher.add(ORB_ID(orb_test)));
+	EXPECT_EQ(publisher.topic_count(), 1u);
+	EXPECT_TRUE(publisher.start());
+
+	ShmTopicReader reader;
+	ASSERT_TRUE(reader.init(ShmUorbPublisher::px4_instance(), "gtest", "orb_test"));
+
+	uORB::Publication<orb_test_s> orb_test_pub{ORB_ID(orb_test)};
+
+	for (int32_t i = 1; i <= 3; i++) {
+		orb_test_s orb_test{};
+		orb_test.timestamp = 1000 * i;
+		orb_test.val = i;
+		orb_test_pub.publish(orb_test);
+
+		publisher.update();
+
+		orb_test_s received{};
+		uint64_t timestamp = 0;
+		ASSERT_EQ(reader.read(&received, sizeof(received), &timestamp), sizeof(received));
+		EXPECT_EQ(received.val, i);
+		EXPECT_EQ(timestamp, orb_test.timestamp);
+	}
+
+	// nothing new published
+	publisher.update();
+	EXPECT_FALSE(reader.updated());
+}
+
+TEST(ShmUorbPublisher, Interval)
+{
+	ShmUorbPublisher publisher("gtest");
+	ASSERT_TRUE(publisher.add(ORB_ID(orb_multitest), 100));
+
+	ShmTopicReader reader;
+	ASSERT_TRUE(reader.init(ShmUorbPublisher::px4_instance(), "gtest", "orb_multitest", 0, false));
+
+	uORB::Publication<orb_test_s> orb_test_pub{ORB_ID(orb_multitest)};
+
+	// updates in quick succession are rate limited
+	for (int32_t i = 0; i < 10; i++) {
+		orb_test_s orb_test{};
+		orb_test.val = i;
+		orb_test_pub.publish(orb_test);
+		publisher.update();
+	}
+
+	orb_test_s received{};
+	int num_received = 0;
+
+	while (reader.read(&received, sizeof(received)) > 0) {
+		num_received++;
+	}
+
+	EXPECT_GE(num_received, 1);
+	EXPECT_LT(num_received, 10);
+	EXPECT_EQ(reader.lost(), 0u);
+}
+
+TEST(ShmUorbPublisher, SegmentNames)
+{
+	setenv("PX4_INSTANCE", "3", 1);
+	EXPECT_EQ(ShmUorbPublisher::px4_instance(), 3);
+
+	ShmUorbPublisher publisher("gtest");
+	ASSERT_TRUE(publisher.add(ORB_ID(orb_test)));
+
+	ShmTopicReader reader;
+	EXPECT_TRUE(reader.init(3, "gtest", "orb_test"));
+	EXPECT_FALSE(reader.init(0, "gtest", "orb_test"));
+
+	// the same topic of the same bridge and instance can only be published once
+	ShmUorbPublisher second("gtest");
+	errno = 0;
+	EXPECT_FALSE(second.add(ORB_ID(orb_test)));
+	EXPECT_EQ(errno, EBUSY);
+	EXPECT_EQ(second.topic_count(), 0u);
+
+	// another bridge can
+	ShmUorbPublisher other("other");
+	EXPECT_TRUE(other.add(ORB_ID(orb_test)));
+
+	unsetenv("PX4_INSTANCE");
+}
+
+TEST(ShmUorbPublisher, SameTypeSeveralNames)
+{
+	// a bridge can publish the same message type under several topic names, e.g. several Zenoh mappings
+	ShmUorbPublisher publisher("gtest");
+	ASSERT_TRUE(publisher.add(ORB_ID(orb_test), 0, 0, "fmu/out/orb_test"));
+	ASSERT_TRUE(publisher.add(ORB_ID(orb_test), 0, 0, "fmu/out/orb_test_copy"));
+	EXPECT_EQ(publisher.topic_count(), 2u);
+
+	ShmTopicReader reader;
+	EXPECT_TRUE(reader.init(ShmUorbPublisher::px4_instance(), "gtest", "fmu_out_orb_test"));
+	EXPECT_TRUE(reader.init(ShmUorbPublisher::px4_instance(), "gtest", "fmu/out/orb_test_copy"));
+
+	// and another instance of a topic under the same name
+	EXPECT_TRUE(publisher.add(ORB_ID(orb_multitest), 0, 1, "orb_multitest"));
+	EXPECT_TRUE(reader.init(ShmUorbPublisher::px4_instance(), "gtest", "orb_multitest", 1));
+}
@@ -0,0 +1,257 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file arx_rls_batch.hpp
+ * @brief Recursive least-squares identification of several independent ARX models in lockstep
+ *
+ * Same model structure as ArxRls (see arx_rls.hpp), one model per axis, all axes
+ * updated by a single call per sample.
+ *
+ * The covariance of each axis is kept in factored form P = U * diag(d) * U'
+ * (U unit upper triangular) and updated with Bierman's algorithm. This costs
+ * O(n^2) per sample instead of the O(n^3) of the dense update and keeps P
+ * symmetric and positive definite by construction, which the dense update
+ * cannot guarantee at float precision when the forgetting factor is < 1.
+ *
+ * Forgetting is suspended on an axis while any of its parameter variances is
+ * above the configured maximum, preventing covariance windup when the input
+ * is not exciting.
+ *
+ * References:
+ * - Factorization Methods for Discrete Sequential Estimation, G.J. Bierman, 1977
+ * - Theory and Practice of Recursive Identification, L.Ljung and T.Soderstrom, 1983
+ */
+
+#pragma once
+
+#include <matrix/matrix/math.hpp>
+
+template<size_t N, size_t M, size_t D, size_t AXES>
+class ArxRlsBatch final
+{
+public:
+	static constexpr size_t NB_PARAMS = N + M + 1;
+
+	ArxRlsBatch()
+	{
+		static_assert(N >= M, "The transfer function needs to be proper");
+		static_assert(AXES > 0, "At least one axis is required");
+
+		reset();
+	}
+
+	~ArxRlsBatch() = default;
+
+	void setForgettingFactor(float time_constant, float dt) { _lambda = 1.f - dt / time_constant; }
+	void setForgettingFactor(float lambda) { _lambda = lambda; }
+
+	/*
+	 * forgetting is only applied while all the variances of an axis are below this value
+	 */
+	void setMaxVariance(float max_variance) { _max_variance = max_variance; }
+
+	/*
+	 * return the vector of estimated parameters of an axis
+	 * [a_1 .. a_n b_0 .. b_m]'
+	 */
+	const matrix::Vector<float, NB_PARAMS> &getCoefficients(size_t axis) const { return _axes[axis].theta_hat; }
+	matrix::Vector<float, NB_PARAMS> getVariances(size_t axis) const { return computeVariances(_axes[axis]); }
+	float getInnovation(size_t axis) const { return _axes[axis].innovation; }
+	const matrix::Vector<float, NB_PARAMS> &getDiffEstimate(size_t axis) const { return _axes[axis].diff_theta_hat; }
+
+	void reset(const matrix::Vector<float, NB_PARAMS> &theta_init = {})
+	{
+		for (size_t axis = 0; axis < AXES; axis++) {
+			reset(axis, theta_init);
+		}
+	}
+
+	void reset(size_t axis, const matrix::Vector<float, NB_PARAMS> &theta_init)
+	{
+		AxisState &state = _axes[axis];
+
+		state.U.setIdentity();
+		state.d.setAll(INITIAL_VARIANCE);
+		state.theta_hat = theta_init;
+		state.diff_theta_hat.setZero();
+
+		for (size_t i = 0; i < M + D + 1; i++) {
+			state.u[i] = 0.f;
+		}
+
+		for (size_t i = 0; i < N + 1; i++) {
+			state.y[i] = 0.f;
+		}
+
+		state.nb_samples = 0;
+		state.innovation = 0.f;
+	}
+
+	/*
+	 * add one input-output sample to every axis and update the models
+	 */
+	void update(const matrix::Vector<float, AXES> &u, const matrix::Vector<float, AXES> &y)
+	{
+		for (size_t axis = 0; axis < AXES; axis++) {
+			updateAxis(_axes[axis], u(axis), y(axis));
+		}
+	}
+
+private:
+	static constexpr float INITIAL_VARIANCE = 10e3f;
+
+	struct AxisState {
+		matrix::SquareMatrix<float, NB_PARAMS> U;
+		matrix::Vector<float, NB_PARAMS> d;
+		matrix::Vector<float, NB_PARAMS> theta_hat;
+		matrix::Vector<float, NB_PARAMS> diff_theta_hat;
+		float innovation{};
+		float u[M + D + 1] {};
+		float y[N + 1] {};
+		unsigned nb_samples{0};
+	};
+
+	void updateAxis(AxisState &state, float u, float y)
+	{
+		addInputOutput(state, u, y);
+
+		if (!isBufferFull(state)) {
+			// Do not start to update the RLS algorithm when the
+			// buffer still contains zeros
+			return;
+		}
+
+		const matrix::Vector<float, NB_PARAMS> phi = constructDesignVector(state);
+
+		// covariance windup protection: stop forgetting while the parameters are not sufficiently excited
+		const float lambda = (computeVariances(state).max() < _max_variance) ? _lambda : 1.f;
+
+		// f = U' * phi, g = diag(d) * f
+		matrix::Vector<float, NB_PARAMS> f;
+		matrix::Vector<float, NB_PARAMS> g;
+
+		for (size_t j = 0; j < NB_PARAMS; j++) {
+			f(j) = phi(j);
+
+			for (size_t i = 0; i < j; i++) {
+				f(j) += state.U(i, j) * phi(i);
+			}
+
+			g(j) = state.d(j) * f(j);
+		}
+
+		// Bierman's measurement update of U and d, accumulating the unnormalized gain k
+		matrix::Vector<float, NB_PARAMS> k;
+		float beta = lambda;
+
+		for (size_t j = 0; j < NB_PARAMS; j++) {
+			const float beta_prev = beta;
+			beta += f(j) * g(j);
+			state.d(j) *= beta_prev / (beta * lambda);
+
+			const float mu = -f(j) / beta_prev;
+
+			for (size_t i = 0; i < j; i++) {
+				const float u_ij = state.U(i, j);
+				state.U(i, j) = u_ij + k(i) * mu;
+				k(i) += g(j) * u_ij;
+			}
+
+			k(j) = g(j);
+		}
+
+		state.innovation = state.y[N] - phi.dot(state.theta_hat);
+
+		// K = P * phi / (lambda + phi' * P * phi) = k / beta
+		const matrix::Vector<float, NB_PARAMS> delta_theta = k * (state.innovation / beta);
+		state.theta_hat += delta_theta;
+		state.diff_theta_hat = delta_theta.abs();
+	}
+
+	static matrix::Vector<float, NB_PARAMS> computeVariances(const AxisState &state)
+	{
+		// diag(U * diag(d) * U')
+		matrix::Vector<float, NB_PARAMS> variances;
+
+		for (size_t i = 0; i < NB_PARAMS; i++) {
+			variances(i) = state.d(i);
+
+			for (size_t j = i + 1; j < NB_PARAMS; j++) {
+				variances(i) += state.U(i, j) * state.U(i, j) * state.d(j);
+			}
+		}
+
+		return variances;
+	}
+
+	static void addInputOutput(AxisState &state, float u, float y)
+	{
+		for (size_t i = 0; i < N; i++) {
+			state.y[i] = state.y[i + 1];
+		}
+
+		for (size_t i = 0; i < (M + D); i++) {
+			state.u[i] = state.u[i + 1];
+		}
+
+		state.u[M + D] = u;
+		state.y[N] = y;
+
+		if (!isBufferFull(state)) {
+			state.nb_samples++;
+		}
+	}
+
+	static bool isBufferFull(const AxisState &state) { return state.nb_samples > (M + N + D); }
+
+	static matrix::Vector<float, NB_PARAMS> constructDesignVector(const AxisState &state)
+	{
+		matrix::Vector<float, NB_PARAMS> phi;
+
+		for (size_t i = 0; i < N; i++) {
+			phi(i) = -state.y[N - i - 1];
+		}
+
+		for (size_t i = 0; i < (M + 1); i++) {
+			phi(N + i) = state.u[M - i];
+		}
+
+		return phi;
+	}
+
+	AxisState _axes[AXES] {};
+	float _lambda{1.f};
+	float _max_variance{INITIAL_VARIANCE};
+};
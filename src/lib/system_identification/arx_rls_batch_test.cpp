@@ -0,0 +1,219 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the ArxRlsBatch class
+ * Run this test only using make tests TESTFILTER=arx_rls_batch
+ */
+
+#include <gtest/gtest.h>
+#include <float.h>
+#include <matrix/matrix/math.hpp>
+
+#include "arx_rls.hpp"
+#include "arx_rls_batch.hpp"
+
+using namespace matrix;
+
+class ArxRlsBatchTest : public ::testing::Test
+{
+public:
+	ArxRlsBatchTest() {};
+
+	// deterministic pseudo-random excitation in [-1, 1]
+	float excitation()
+	{
+		_seed = _seed * 1664525u + 1013904223u;
+		return static_cast<float>(_seed >> 8) / static_cast<float>(1u << 23) - 1.f;
+	}
+
+private:
+	uint32_t _seed{42};
+};
+
+TEST_F(ArxRlsBatchTest, matchesArxRls)
+{
+	// GIVEN: one dense filter per axis and a batched filter, both with forgetting
+	ArxRls<2, 2, 1> rls[3];
+	ArxRlsBatch<2, 2, 1, 3> rls_batch;
+	rls_batch.setMaxVariance(FLT_MAX);
+
+	for (int axis = 0; axis < 3; axis++) {
+		rls[axis].setForgettingFactor(0.995f);
+	}
+
+	rls_batch.setForgettingFactor(0.995f);
+
+	// WHEN: feeding the same data
+	Vector3f y_prev{};
+
+	for (int i = 0; i < 200; i++) {
+		Vector3f u;
+		Vector3f y;
+
+		for (int axis = 0; axis < 3; axis++) {
+			u(axis) = excitation();
+			y(axis) = 0.8f * y_prev(axis) + 0.2f * u(axis) + 0.01f * excitation();
+			rls[axis].update(u(axis), y(axis));
+		}
+
+		rls_batch.update(u, y);
+		y_prev = y;
+	}
+
+	// THEN: the factored form gives the same estimates and variances
+	for (int axis = 0; axis < 3; axis++) {
+		const Vector<float, 5> coefficients = rls[axis].getCoefficients();
+		EXPECT_LT((coefficients - rls_batch.getCoefficients(axis)).abs().max(), 1e-3f) << "axis " << axis;
+
+		const Vector<float, 5> variances = rls[axis].getVariances();
+
+		for (int i = 0; i < 5; i++) {
+			EXPECT_NEAR(rls_batch.getVariances(axis)(i), variances(i), 1e-2f * variances(i)) << "axis " << axis;
+		}
+
+		EXPECT_NEAR(rls_batch.getInnovation(axis), rls[axis].getInnovation(), 1e-3f);
+	}
+}
+
+TEST_F(ArxRlsBatchTest, convergence)
+{
+	// GIVEN: a different second order discrete system on each axis
+	// y(k) = -a1 y(k-1) - a2 y(k-2) + b0 u(k-1) + b1 u(k-2) + b2 u(k-3)
+	const float a1[3] = {-1.6f, -1.2f, -0.5f};
+	const float a2[3] = {0.7f, 0.4f, 0.1f};
+	const float b[3][3] = {{0.2f, 0.1f, 0.05f}, {0.5f, -0.2f, 0.f}, {1.f, 0.3f, 0.1f}};
+
+	ArxRlsBatch<2, 2, 1, 3> rls_batch;
+	rls_batch.setForgettingFactor(60.f, 1.f / 400.f);
+
+	float y_hist[3][2] {};
+	float u_hist[3][3] {};
+
+	// WHEN: the system is excited on all the axes simultaneously
+	for (int i = 0; i < 2000; i++) {
+		Vector3f u;
+		Vector3f y;
+
+		for (int axis = 0; axis < 3; axis++) {
+			u(axis) = excitation();
+			y(axis) = -a1[axis] * y_hist[axis][0] - a2[axis] * y_hist[axis][1]
+				  + b[axis][0] * u_hist[axis][0] + b[axis][1] * u_hist[axis][1] + b[axis][2] * u_hist[axis][2];
+
+			y_hist[axis][1] = y_hist[axis][0];
+			y_hist[axis][0] = y(axis);
+			u_hist[axis][2] = u_hist[axis][1];
+			u_hist[axis][1] = u_hist[axis][0];
+			u_hist[axis][0] = u(axis);
+		}
+
+		rls_batch.update(u, y);
+	}
+
+	// THEN: every axis converges to its own model
+	for (int axis = 0; axis < 3; axis++) {
+		const float truth_data[5] = {a1[axis], a2[axis], b[axis][0], b[axis][1], b[axis][2]};
+		const Vector<float, 5> truth(truth_data);
+		EXPECT_LT((rls_batch.getCoefficients(axis) - truth).abs().max(), 1e-3f) << "axis " << axis;
+		EXPECT_LT(rls_batch.getDiffEstimate(axis).max(), 1e-4f) << "axis " << axis;
+	}
+}
+
+TEST_F(ArxRlsBatchTest, covarianceWindup)
+{
+	// GIVEN: a converged model with a short forgetting time constant
+	// y(k) = 1.6 y(k-1) - 0.7 y(k-2) + 0.2 u(k-1) + 0.1 u(k-2) + 0.05 u(k-3)
+	ArxRlsBatch<2, 2, 1, 1> rls_batch;
+	rls_batch.setForgettingFactor(0.95f);
+	rls_batch.setMaxVariance(100.f);
+
+	float y_hist[2] {};
+	float u_hist[3] {};
+
+	auto step = [&](float u) {
+		float y = 1.6f * y_hist[0] - 0.7f * y_hist[1] + 0.2f * u_hist[0] + 0.1f * u_hist[1] + 0.05f * u_hist[2];
+		y_hist[1] = y_hist[0];
+		y_hist[0] = y;
+		u_hist[2] = u_hist[1];
+		u_hist[1] = u_hist[0];
+		u_hist[0] = u;
+		rls_batch.update(Vector<float, 1>(&u), Vector<float, 1>(&y));
+	};
+
+	for (int i = 0; i < 500; i++) {
+		step(excitation());
+	}
+
+	const Vector<float, 5> coefficients = rls_batch.getCoefficients(0);
+	EXPECT_LT(rls_batch.getVariances(0).max(), 100.f);
+
+	// WHEN: the input is not exciting anymore for a long time
+	for (int i = 0; i < 5000; i++) {
+		step(0.f);
+	}
+
+	// THEN: the variances are bounded, finite and positive and the estimates untouched
+	const Vector<float, 5> variances = rls_batch.getVariances(0);
+	EXPECT_TRUE(variances.isAllFinite());
+	EXPECT_GT(variances.min(), 0.f);
+	EXPECT_LT(variances.max(), 100.f / 0.95f);
+	EXPECT_LT((rls_batch.getCoefficients(0) - coefficients).abs().max(), 1e-3f);
+
+	// AND WHEN: the excitation comes back
+	for (int i = 0; i < 500; i++) {
+		step(excitation());
+	}
+
+	// THEN: the model is still correct
+	const float truth_data[5] = {-1.6f, 0.7f, 0.2f, 0.1f, 0.05f};
+	EXPECT_LT((rls_batch.getCoefficients(0) - Vector<float, 5>(truth_data)).abs().max(), 1e-3f);
+}
+
+TEST_F(ArxRlsBatchTest, resetTest)
+{
+	ArxRlsBatch<2, 2, 1, 3> rls_batch;
+
+	for (int i = 0; i < 20; i++) {
+		rls_batch.update(Vector3f(excitation(), excitation(), excitation()), Vector3f(excitation(), excitation(), excitation()));
+	}
+
+	// WHEN: resetting a single axis
+	rls_batch.reset(1, {});
+
+	// THEN: only that axis is reset
+	EXPECT_TRUE(rls_batch.getVariances(1).min() > 5000.f);
+	EXPECT_TRUE(rls_batch.getCoefficients(1).abs().max() < 1e-8f);
+	EXPECT_TRUE(rls_batch.getVariances(0).max() < 5000.f);
+	EXPECT_TRUE(rls_batch.getVariances(2).max() < 5000.f);
+}
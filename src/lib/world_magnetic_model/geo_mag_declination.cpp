@@ -66,7 +66,14 @@ static constexpr unsigned get_lookup_table_index(float *val, float min, float ma
 	return static_cast<unsigned>((-(min) + *val) / SAMPLING_RES);
 }
 
-static constexpr float get_table_data(float lat, float lon, const int16_t table[LAT_DIM][LON_DIM])
+struct TableCell {
+	unsigned lat_index;
+	unsigned lon_index;
+	float lat_scale;
+	float lon_scale;
+};
+
+static constexpr TableCell get_table_cell(float lat, float lon)
 {
 	lat = math::constrain(lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
 
@@ -83,22 +90,35 @@ static constexpr float get_table_data(float lat, float lon, const int16_t table[
 	float min_lon = floorf(lon / SAMPLING_RES) * SAMPLING_RES;
 
 	/* find index of nearest low sampling point */
-	unsigned min_lat_index = get_lookup_table_index(&min_lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
-	unsigned min_lon_index = get_lookup_table_index(&min_lon, SAMPLING_MIN_LON, SAMPLING_MAX_LON);
-
-	const float data_sw = table[min_lat_index][min_lon_index];
-	const float data_se = table[min_lat_index][min_lon_index + 1];
-	const float data_ne = table[min_lat_index + 1][min_lon_index + 1];
-	const float data_nw = table[min_lat_index + 1][min_lon_index];
+	const unsigned min_lat_index = get_lookup_table_index(&min_lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
+	const unsigned min_lon_index = get_lookup_table_index(&min_lon, SAMPLING_MIN_LON, SAMPLING_MAX_LON);
 
-	/* perform bilinear interpolation on the four grid corners */
+	/* position within the grid cell used for bilinear interpolation */
 	const float lat_scale = constrain((lat - min_lat) / SAMPLING_RES, 0.f, 1.f);
 	const float lon_scale = constrain((lon - min_lon) / SAMPLING_RES, 0.f, 1.f);
 
-	const float data_min = lon_scale * (data_se - data_sw) + data_sw;
-	const float data_max = lon_scale * (data_ne - data_nw) + data_nw;
+	return TableCell{min_lat_index, min_lon_index, lat_scale, lon_scale};
+}
+
+static constexpr float interpolate(const TableCell &cell, float data_sw, float data_se, float data_ne, float data_nw)
+{
+	/* perform bilinear interpolation on the four grid corners */
+	const float data_min = cell.lon_scale * (data_se - data_sw) + data_sw;
+	const float data_max = cell.lon_scale * (data_ne - data_nw) + data_nw;
 
-	return lat_scale * (data_max - data_min) + data_min;
+	return cell.lat_scale * (data_max - data_min) + data_min;
+}
+
+static constexpr float get_table_data(float lat, float lon, const int16_t table[LAT_DIM][LON_DIM])
+{
+	const TableCell cell = get_table_cell(lat, lon);
+
+	const float data_sw = table[cell.lat_index][cell.lon_index];
+	const float data_se = table[cell.lat_index][cell.lon_index + 1];
+	const float data_ne = table[cell.lat_index + 1][cell.lon_index + 1];
+	const float data_nw = table[cell.lat_index + 1][cell.lon_index];
+
+	return interpolate(cell, data_sw, data_se, data_ne, data_nw);
 }
 
 float get_mag_declination_radians(float lat, float lon)
@@ -130,3 +150,32 @@ float get_mag_strength_tesla(float lat, float lon)
 {
 	return get_mag_strength_gauss(lat, lon) * 1e-4f; // 1 Gauss == 0.0001 Tesla
 }
+
+MagneticField MagneticFieldTile::lookup(float lat, float lon)
+{
+	const TableCell cell = get_table_cell(lat, lon);
+
+	if (!_valid || (cell.lat_index != _lat_index) || (cell.lon_index != _lon_index)) {
+		// entered a new grid cell, load the corners of all three tables once
+		const int16_t (*tables[3])[LON_DIM] {declination_table, inclination_table, strength_table};
+
+		for (unsigned i = 0; i < 3; i++) {
+			_corners[i][0] = tables[i][cell.lat_index][cell.lon_index];
+			_corners[i][1] = tables[i][cell.lat_index][cell.lon_index + 1];
+			_corners[i][2] = tables[i][cell.lat_index + 1][cell.lon_index + 1];
+			_corners[i][3] = tables[i][cell.lat_index + 1][cell.lon_index];
+		}
+
+		_lat_index = cell.lat_index;
+		_lon_index = cell.lon_index;
+		_valid = true;
+		_loads++;
+	}
+
+	MagneticField field;
+	field.declination = interpolate(cell, _corners[0][0], _corners[0][1], _corners[0][2], _corners[0][3]) * 1e-4f;
+	field.inclination = interpolate(cell, _corners[1][0], _corners[1][1], _corners[1][2], _corners[1][3]) * 1e-4f;
+	field.strength = interpolate(cell, _corners[2][0], _corners[2][1], _corners[2][2], _corners[2][3]) * 1e-4f;
+
+	return field;
+}
@@ -41,6 +41,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 // Return magnetic declination in degrees or radians
 float get_mag_declination_degrees(float lat, float lon);
 float get_mag_declination_radians(float lat, float lon);
@@ -52,3 +54,35 @@ float get_mag_inclination_radians(float lat, float lon);
 // return magnetic field strength in Gauss or Tesla
 float get_mag_strength_gauss(float lat, float lon);
 float get_mag_strength_tesla(float lat, float lon);
+
+// magnetic field declination (rad), inclination (rad) and strength (Gauss)
+struct MagneticField {
+	float declination{0.f};
+	float inclination{0.f};
+	float strength{0.f};
+};
+
+/**
+ * Cached lookup of declination, inclination and strength together.
+ *
+ * The corners of the lookup table cell containing the last queried location are kept for all
+ * three tables, so repeated queries while the vehicle stays within the same cell only perform the
+ * interpolation. Results are identical to the individual get_mag_*() functions.
+ */
+class MagneticFieldTile
+{
+public:
+	MagneticField lookup(float lat, float lon);
+
+	void invalidate() { _valid = false; }
+
+	// number of times a table cell was loaded
+	uint32_t loads() const { return _loads; }
+
+private:
+	float _corners[3][4] {}; // declination, inclination, strength: SW, SE, NE, NW
+	unsigned _lat_index{0};
+	unsigned _lon_index{0};
+	uint32_t _loads{0};
+	bool _valid{false};
+};
@@ -0,0 +1,79 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <math.h>
+
+#include "geo_mag_declination.h"
+
+TEST(MagneticFieldTileTest, matchesLookupGlobally)
+{
+	MagneticFieldTile tile;
+
+	// sweep the globe on a grid that is not aligned with the table resolution, including the table bounds
+	for (float lat = -90.f; lat <= 90.f; lat += 0.7f) {
+		for (float lon = -180.f; lon <= 180.f; lon += 1.3f) {
+			const MagneticField field = tile.lookup(lat, lon);
+
+			EXPECT_FLOAT_EQ(field.declination, get_mag_declination_radians(lat, lon)) << lat << ", " << lon;
+			EXPECT_FLOAT_EQ(field.inclination, get_mag_inclination_radians(lat, lon)) << lat << ", " << lon;
+			EXPECT_FLOAT_EQ(field.strength, get_mag_strength_gauss(lat, lon)) << lat << ", " << lon;
+		}
+	}
+
+	// longitude wrapping
+	EXPECT_FLOAT_EQ(tile.lookup(47.f, 190.f).declination, get_mag_declination_radians(47.f, 190.f));
+	EXPECT_FLOAT_EQ(tile.lookup(47.f, -190.f).declination, get_mag_declination_radians(47.f, -190.f));
+}
+
+TEST(MagneticFieldTileTest, reloadsOnlyWhenLeavingCell)
+{
+	MagneticFieldTile tile;
+
+	// fly 5 km east in 1 m steps around Zurich, staying in the same table cell
+	for (int i = 0; i < 5000; i++) {
+		tile.lookup(47.39f, 8.54f + i * 1.3e-5f);
+	}
+
+	EXPECT_EQ(tile.loads(), 1u);
+
+	// cross into the next cell to the north and back
+	tile.lookup(50.1f, 8.54f);
+	tile.lookup(47.39f, 8.54f);
+	EXPECT_EQ(tile.loads(), 3u);
+
+	tile.invalidate();
+	tile.lookup(47.39f, 8.54f);
+	EXPECT_EQ(tile.loads(), 4u);
+}
@@ -199,6 +199,70 @@ void Report::reset()
 	_results_changed = false;
 }
 
+void Report::beginContribution()
+{
+	// record the check results on their own, the other results are merged back afterwards
+	_contribution_saved_results = _results[_current_result];
+	_results[_current_result].reset();
+	_contribution_buffer_start = _next_buffer_idx;
+}
+
+void Report::endContribution(CachedContribution &contribution)
+{
+	Results &current = _results[_current_result];
+
+	contribution.health = current.health;
+	contribution.arming_error = current.arming_checks.error;
+	contribution.arming_warning = current.arming_checks.warning;
+	contribution.can_arm = current.arming_checks.can_arm;
+	contribution.can_run = current.arming_checks.can_run;
+	contribution.num_events = current.num_events;
+	contribution.event_id_hash = current.event_id_hash;
+
+	const int event_buffer_size = _next_buffer_idx - _contribution_buffer_start;
+	contribution.valid = !_buffer_overflowed && event_buffer_size <= (int)sizeof(contribution.event_buffer);
+
+	if (contribution.valid) {
+		memcpy(contribution.event_buffer, _event_buffer + _contribution_buffer_start, event_buffer_size);
+		contribution.event_buffer_size = event_buffer_size;
+
+	} else {
+		contribution.event_buffer_size = 0;
+	}
+
+	// merge the previous results back (the events are already in the buffer)
+	current = _contribution_saved_results;
+	mergeResults(contribution);
+}
+
+void Report::applyContribution(const CachedContribution &contribution)
+{
+	if (contribution.event_buffer_size > sizeof(_event_buffer) - _next_buffer_idx) {
+		_buffer_overflowed = true;
+
+	} else {
+		memcpy(_event_buffer + _next_buffer_idx, contribution.event_buffer, contribution.event_buffer_size);
+		_next_buffer_idx += contribution.event_buffer_size;
+	}
+
+	mergeResults(contribution);
+}
+
+void Report::mergeResults(const CachedContribution &contribution)
+{
+	Results &current = _results[_current_result];
+
+	current.health.is_present = current.health.is_present | contribution.health.is_present;
+	current.health.error = current.health.error | contribution.health.error;
+	current.health.warning = current.health.warning | contribution.health.warning;
+	current.arming_checks.error = current.arming_checks.error | contribution.arming_error;
+	current.arming_checks.warning = current.arming_checks.warning | contribution.arming_warning;
+	current.arming_checks.can_arm = current.arming_checks.can_arm & contribution.can_arm;
+	current.arming_checks.can_run = current.arming_checks.can_run & contribution.can_run;
+	current.num_events += contribution.num_events;
+	current.event_id_hash ^= contribution.event_id_hash;
+}
+
 void Report::prepare(uint8_t vehicle_type)
 {
 	// Get mode requirements before running any checks (in particular the mode checks require them)
@@ -317,3 +381,53 @@ bool Report::report(bool is_armed, bool force)
 			       current_results.health.error, current_results.health.warning);
 	return true;
 }
+
+void HealthAndArmingCheckBase::enableIncrementalEvaluation(hrt_abstime timeout)
+{
+	if (!_cache) {
+		_cache = new IncrementalState{};
+
+		if (!_cache) {
+			// fall back to evaluating on every update
+			return;
+		}
+	}
+
+	_cache->timeout = timeout;
+}
+
+void HealthAndArmingCheckBase::addInput(uORB::Subscription &subscription)
+{
+	if (!_cache) {
+		enableIncrementalEvaluation();
+
+		if (!_cache) {
+			return;
+		}
+	}
+
+	if (_cache->num_inputs < MAX_INPUTS) {
+		_cache->inputs[_cache->num_inputs++] = &subscription;
+
+	} else {
+		// cannot track all inputs, always evaluate
+		_cache->inputs_overflow = true;
+	}
+}
+
+bool HealthAndArmingCheckBase::canUseCache(hrt_abstime now) const
+{
+	if (!_cache || !_cache->contribution.valid || _cache->inputs_overflow
+	    || now >= _cache->last_evaluation + _cache->timeout
+	    || (_cache->deadline != 0 && now >= _cache->deadline)) {
+		return false;
+	}
+
+	for (int i = 0; i < _cache->num_inputs; ++i) {
+		if (_cache->inputs[i]->updated()) {
+			return false;
+		}
+	}
+
+	return true;
+}
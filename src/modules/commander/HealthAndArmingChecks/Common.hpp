@@ -39,6 +39,8 @@
 #include <uORB/topics/health_report.h>
 #include <uORB/topics/vehicle_status.h>
 #include <uORB/topics/failsafe_flags.h>
+#include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionMultiArray.hpp>
 #include <systemlib/mavlink_log.h>
 #include <drivers/drv_hrt.h>
 
@@ -189,6 +191,23 @@ public:
 		}
 	};
 
+	/**
+	 * Contribution of a single check to the results (health and arming bits and events),
+	 * stored to be merged again in later runs without re-evaluating the check.
+	 */
+	struct CachedContribution {
+		HealthResults health;
+		health_component_t arming_error;
+		health_component_t arming_warning;
+		NavModes can_arm;
+		NavModes can_run;
+		int num_events;
+		uint32_t event_id_hash;
+		uint8_t event_buffer_size;
+		uint8_t event_buffer[64];
+		bool valid;
+	};
+
 	Report(failsafe_flags_s &failsafe_flags, hrt_abstime min_reporting_interval = 2_s)
 		: _min_reporting_interval(min_reporting_interval), _failsafe_flags(failsafe_flags) { }
 	~Report() = default;
@@ -316,6 +335,8 @@ private:
 	FRIEND_TEST(ReporterTest, arming_checks_mode_category2);
 	FRIEND_TEST(ReporterTest, reporting);
 	FRIEND_TEST(ReporterTest, reporting_multiple);
+	FRIEND_TEST(ReporterTest, cached_contribution);
+	FRIEND_TEST(ReporterTest, cached_check_data_timeout);
 
 	/**
 	 * Reset current results.
@@ -334,6 +355,19 @@ private:
 
 	bool report(bool is_armed, bool force);
 
+	/**
+	 * Record the contribution of a single check: call beginContribution() before running the check
+	 * and endContribution() afterwards. The results are the same as without recording.
+	 */
+	void beginContribution();
+	void endContribution(CachedContribution &contribution);
+
+	/**
+	 * Merge a previously recorded contribution into the current results
+	 */
+	void applyContribution(const CachedContribution &contribution);
+	void mergeResults(const CachedContribution &contribution);
+
 	const hrt_abstime _min_reporting_interval;
 
 	/// event buffer: stores current events + arguments.
@@ -350,6 +384,9 @@ private:
 	Results _results[2]; ///< Previous and current results to check for changes
 	int _current_result{0};
 
+	Results _contribution_saved_results; ///< results of the other checks while recording a contribution
+	int _contribution_buffer_start{0};
+
 	failsafe_flags_s &_failsafe_flags;
 
 	orb_advert_t *_mavlink_log_pub{nullptr}; ///< mavlink log publication for legacy reporting
@@ -404,9 +441,72 @@ class HealthAndArmingCheckBase : public ModuleParams
 {
 public:
 	HealthAndArmingCheckBase() : ModuleParams(nullptr) {};
-	~HealthAndArmingCheckBase() = default;
+	~HealthAndArmingCheckBase() { delete _cache; }
 
 	virtual void checkAndReport(const Context &context, Report &reporter) = 0;
 
-	void updateParams() override { ModuleParams::updateParams(); }
+	void updateParams() override
+	{
+		ModuleParams::updateParams();
+
+		if (_cache) {
+			_cache->contribution.valid = false;
+		}
+	}
+
+protected:
+	/**
+	 * Enable incremental evaluation: the check is then only re-evaluated if one of the inputs declared
+	 * with addInput() got updated, the vehicle status or parameters changed, or if @p timeout passed since
+	 * the last evaluation. Otherwise the contribution of the previous evaluation is reused.
+	 * The check must read all its declared inputs on every evaluation, only depend on them,
+	 * the context and parameters, and not modify failsafe flags that other checks depend on.
+	 * Time-dependent logic (e.g. data timeouts) must be announced with reevaluateAt().
+	 * @param timeout maximum time between evaluations
+	 */
+	void enableIncrementalEvaluation(hrt_abstime timeout = 300_ms);
+
+	void addInput(uORB::Subscription &subscription);
+
+	template<typename T, uint8_t SIZE>
+	void addInput(uORB::SubscriptionMultiArray<T, SIZE> &subscriptions)
+	{
+		for (auto &subscription : subscriptions) {
+			addInput(subscription);
+		}
+	}
+
+	/**
+	 * Request a re-evaluation at @p time at the latest, e.g. when a data timeout expires.
+	 * Called from checkAndReport(), applies to the current evaluation only.
+	 * Pass the current time if the result may change on any update (e.g. while a hysteresis is pending).
+	 */
+	void reevaluateAt(hrt_abstime time)
+	{
+		if (_cache && (_cache->deadline == 0 || time < _cache->deadline)) {
+			_cache->deadline = time;
+		}
+	}
+
+private:
+	friend class HealthAndArmingChecks;
+
+	static constexpr int MAX_INPUTS = 8;
+
+	struct IncrementalState {
+		uORB::Subscription *inputs[MAX_INPUTS];
+		uint8_t num_inputs;
+		bool inputs_overflow;
+		hrt_abstime timeout;
+		hrt_abstime last_evaluation;
+		hrt_abstime deadline; ///< re-evaluate at this time, 0 if not set
+		Report::CachedContribution contribution;
+	};
+
+	/**
+	 * @return true if the cached contribution can be used instead of running the check
+	 */
+	bool canUseCache(hrt_abstime now) const;
+
+	IncrementalState *_cache{nullptr}; ///< only allocated for checks with incremental evaluation
 };
@@ -50,8 +50,38 @@ HealthAndArmingChecks::HealthAndArmingChecks(ModuleParams *parent, vehicle_statu
 	_failsafe_flags.home_position_invalid = true;
 }
 
+void HealthAndArmingChecks::runCheck(HealthAndArmingCheckBase &check, hrt_abstime now, bool force_evaluation)
+{
+	HealthAndArmingCheckBase::IncrementalState *cache = check._cache;
+
+	if (!cache) {
+		check.checkAndReport(_context, _reporter);
+		return;
+	}
+
+	if (!force_evaluation && check.canUseCache(now)) {
+		_reporter.applyContribution(cache->contribution);
+		return;
+	}
+
+	cache->deadline = 0;
+	_reporter.beginContribution();
+	check.checkAndReport(_context, _reporter);
+	_reporter.endContribution(cache->contribution);
+	cache->last_evaluation = now;
+}
+
 bool HealthAndArmingChecks::update(bool force_reporting)
 {
+	const hrt_abstime now = hrt_absolute_time();
+
+	// Any change of the vehicle status (except for the timestamp) requires all checks to be re-evaluated
+	vehicle_status_s status;
+	memcpy(&status, &_context.status(), sizeof(status));
+	status.timestamp = 0;
+	const bool status_changed = memcmp(&status, &_last_status, sizeof(status)) != 0;
+	memcpy(&_last_status, &status, sizeof(status));
+
 	_reporter.reset();
 
 	_reporter.prepare(_context.status().vehicle_type);
@@ -61,7 +91,7 @@ bool HealthAndArmingChecks::update(bool force_reporting)
 			break;
 		}
 
-		_checks[i]->checkAndReport(_context, _reporter);
+		runCheck(*_checks[i], now, force_reporting || status_changed);
 	}
 
 	const bool results_changed = _reporter.finalize();
@@ -98,8 +128,6 @@ bool HealthAndArmingChecks::update(bool force_reporting)
 	}
 
 	// Check if we need to publish the failsafe flags
-	const hrt_abstime now = hrt_absolute_time();
-
 	if ((now > _failsafe_flags.timestamp + 500_ms) || results_changed) {
 		_failsafe_flags.timestamp = hrt_absolute_time();
 		_failsafe_flags_pub.publish(_failsafe_flags);
@@ -110,7 +110,16 @@ public:
 protected:
 	void updateParams() override;
 private:
+	FRIEND_TEST(ReporterTest, cached_check_data_timeout);
+
+	/**
+	 * Run a single check, or reuse its previous contribution if it supports incremental evaluation
+	 * and none of its inputs changed.
+	 */
+	void runCheck(HealthAndArmingCheckBase &check, hrt_abstime now, bool force_evaluation);
+
 	failsafe_flags_s _failsafe_flags{};
+	vehicle_status_s _last_status{};
 
 	Context _context;
 	Report _reporter{_failsafe_flags};
@@ -34,7 +34,11 @@
 #include <gtest/gtest.h>
 
 #include "Common.hpp"
+#include "HealthAndArmingChecks.hpp"
+#include <px4_platform_common/time.h>
+#include <uORB/topics/esc_status.h>
 #include <uORB/topics/event.h>
+#include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
 
 #include <stdint.h>
@@ -286,3 +290,104 @@ TEST_F(ReporterTest, reporting_multiple)
 	}
 }
 
+TEST_F(ReporterTest, cached_contribution)
+{
+	failsafe_flags_s failsafe_flags{};
+	Report reporter{failsafe_flags, 0_s};
+
+	uORB::Subscription event_sub{ORB_ID(event)};
+	event_sub.subscribe();
+	event_s event;
+
+	Report::CachedContribution contribution{};
+
+	// first run: record the contribution of the second check
+	reporter.reset();
+	reporter.setIsPresent(health_component_t::battery);
+	reporter.armingCheckFailure<uint8_t>(NavModes::Mission, health_component_t::remote_control,
+					     events::ID("arming_test_cached_contribution_fail1"), events::Log::Warning, "", 1);
+	reporter.beginContribution();
+	reporter.healthFailure<float>(NavModes::PositionControl, health_component_t::remote_control,
+				      events::ID("arming_test_cached_contribution_fail2"), events::Log::Error, "", 2.f);
+	reporter.setIsPresent(health_component_t::remote_control);
+	reporter.clearCanRunBits(NavModes::Stabilized);
+	reporter.endContribution(contribution);
+	reporter.finalize();
+	reporter.report(false, false);
+
+	ASSERT_TRUE(contribution.valid);
+	ASSERT_EQ(contribution.num_events, 1);
+	ASSERT_EQ(contribution.health.error, events::px4::enums::health_component_t::remote_control);
+	ASSERT_EQ(contribution.health.is_present, events::px4::enums::health_component_t::remote_control);
+
+	const Report::HealthResults health = reporter.healthResults();
+	const Report::ArmingCheckResults arming_checks = reporter.armingCheckResults();
+	ASSERT_EQ(health.is_present, events::px4::enums::health_component_t::battery
+		  | events::px4::enums::health_component_t::remote_control);
+	ASSERT_EQ((uint8_t)arming_checks.can_arm, (uint8_t)~(NavModes::Mission | NavModes::PositionControl));
+	ASSERT_EQ((uint8_t)arming_checks.can_run, (uint8_t)~(NavModes::Stabilized));
+
+	ASSERT_TRUE(event_sub.update(&event));
+	ASSERT_EQ(event.id, events::ID("commander_arming_check_summary"));
+	ASSERT_TRUE(event_sub.update(&event));
+	ASSERT_EQ(event.id, events::ID("arming_test_cached_contribution_fail1"));
+	ASSERT_TRUE(event_sub.update(&event));
+	ASSERT_EQ(event.id, events::ID("arming_test_cached_contribution_fail2"));
+	ASSERT_TRUE(event_sub.update(&event));
+	ASSERT_EQ(event.id, events::ID("commander_health_summary"));
+
+	// second run: reusing the contribution must give identical results and no new report
+	reporter.reset();
+	reporter.setIsPresent(health_component_t::battery);
+	reporter.armingCheckFailure<uint8_t>(NavModes::Mission, health_component_t::remote_control,
+					     events::ID("arming_test_cached_contribution_fail1"), events::Log::Warning, "", 1);
+	reporter.applyContribution(contribution);
+	ASSERT_FALSE(reporter.finalize());
+	reporter.report(false, false);
+
+	ASSERT_EQ(reporter.healthResults().is_present, health.is_present);
+	ASSERT_EQ(reporter.healthResults().error, health.error);
+	ASSERT_EQ(reporter.healthResults().warning, health.warning);
+	ASSERT_EQ(reporter.armingCheckResults().can_arm, arming_checks.can_arm);
+	ASSERT_EQ(reporter.armingCheckResults().can_run, arming_checks.can_run);
+	ASSERT_EQ(reporter.armingCheckResults().error, arming_checks.error);
+	ASSERT_EQ(reporter.armingCheckResults().warning, arming_checks.warning);
+	ASSERT_FALSE(event_sub.updated());
+
+	// forced report must contain the cached event
+	reporter.report(false, true);
+	ASSERT_TRUE(event_sub.update(&event));
+	ASSERT_EQ(event.id, events::ID("commander_arming_check_summary"));
+	ASSERT_TRUE(event_sub.update(&event));
+	ASSERT_EQ(event.id, events::ID("arming_test_cached_contribution_fail1"));
+	ASSERT_TRUE(event_sub.update(&event));
+	ASSERT_EQ(event.id, events::ID("arming_test_cached_contribution_fail2"));
+	ASSERT_TRUE(event_sub.update(&event));
+	ASSERT_EQ(event.id, events::ID("commander_health_summary"));
+}
+
+TEST_F(ReporterTest, cached_check_data_timeout)
+{
+	// A check that is not re-evaluated because its inputs did not change must still react to its data
+	// timing out at that time, not only once the cache timeout (300 ms) expires.
+	vehicle_status_s status{};
+	HealthAndArmingChecks checks{nullptr, status};
+
+	auto escs_present = [&checks]() {
+		return ((uint64_t)checks._reporter.healthResults().is_present & (uint64_t)health_component_t::motors_escs) != 0;
+	};
+
+	// ESC telemetry that times out (after 700 ms) 50 ms from now
+	esc_status_s esc_status{};
+	esc_status.timestamp = hrt_absolute_time() - 650_ms;
+	uORB::Publication<esc_status_s> esc_status_pub{ORB_ID(esc_status)};
+	esc_status_pub.publish(esc_status);
+
+	checks.update();
+	EXPECT_TRUE(escs_present());
+
+	// without new telemetry the ESCs are missing on the first update after the timeout
+	px4_usleep(100_ms);
+	checks.update();
+	EXPECT_FALSE(escs_present());
+}
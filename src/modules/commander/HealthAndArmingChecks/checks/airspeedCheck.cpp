@@ -39,6 +39,7 @@ using namespace time_literals;
 AirspeedChecks::AirspeedChecks()
 	: _param_fw_airspd_max_handle(param_find("FW_AIRSPD_MAX"))
 {
+	addInput(_airspeed_validated_sub);
 }
 
 void AirspeedChecks::checkAndReport(const Context &context, Report &reporter)
@@ -53,6 +54,7 @@ void AirspeedChecks::checkAndReport(const Context &context, Report &reporter)
 	if (_airspeed_validated_sub.copy(&airspeed_validated) && hrt_elapsed_time(&airspeed_validated.timestamp) < 2_s) {
 
 		reporter.setIsPresent(health_component_t::differential_pressure);
+		reevaluateAt(airspeed_validated.timestamp + 2_s);
 
 		// Maximally allow the airspeed reading to be at FW_AIRSPD_MAX when arming. This is to catch very badly calibrated
 		// airspeed sensors, but also high wind conditions that prevent a forward flight of the vehicle.
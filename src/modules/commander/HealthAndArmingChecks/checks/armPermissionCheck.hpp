@@ -38,7 +38,7 @@
 class ArmPermissionChecks : public HealthAndArmingCheckBase
 {
 public:
-	ArmPermissionChecks() = default;
+	ArmPermissionChecks() { enableIncrementalEvaluation(); }
 	~ArmPermissionChecks() = default;
 
 	void checkAndReport(const Context &context, Report &reporter) override;
@@ -39,6 +39,7 @@ CpuResourceChecks::CpuResourceChecks()
 {
 	_high_cpu_load_hysteresis.set_hysteresis_time_from(false, 2_s);
 	_high_cpu_load_hysteresis.set_hysteresis_time_from(true, 2_s);
+	addInput(_cpuload_sub);
 }
 
 void CpuResourceChecks::checkAndReport(const Context &context, Report &reporter)
@@ -68,7 +69,15 @@ void CpuResourceChecks::checkAndReport(const Context &context, Report &reporter)
 	} else {
 		const float cpuload_percent = cpuload.load * 100.f;
 		const bool high_cpu_load = cpuload_percent > _param_com_cpu_max.get();
-		_high_cpu_load_hysteresis.set_state_and_update(high_cpu_load, hrt_absolute_time());
+		const hrt_abstime now = hrt_absolute_time();
+		_high_cpu_load_hysteresis.set_state_and_update(high_cpu_load, now);
+
+		// re-evaluate on every update while the hysteresis is pending, and when the data times out
+		if (high_cpu_load != _high_cpu_load_hysteresis.get_state()) {
+			reevaluateAt(now);
+		}
+
+		reevaluateAt(cpuload.timestamp + 2_s + 1);
 
 		// fail check if CPU load is above the threshold for 2 seconds
 		if (_high_cpu_load_hysteresis.get_state()) {
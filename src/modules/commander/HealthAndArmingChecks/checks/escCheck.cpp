@@ -81,9 +81,13 @@ void EscChecks::checkAndReport(const Context &context, Report &reporter)
 
 		checkEscStatus(context, reporter, esc_status);
 		reporter.setIsPresent(health_component_t::motors_escs);
+		reevaluateAt(esc_status.timestamp + esc_telemetry_timeout);
 
-	} else if (_param_escs_checks_required.get()
-		   && now - _start_time > 5_s) { // Wait a bit after startup to allow esc's to init
+	} else if (_param_escs_checks_required.get() && now - _start_time <= 5_s) {
+		// Wait a bit after startup to allow esc's to init
+		reevaluateAt(_start_time + 5_s + 1);
+
+	} else if (_param_escs_checks_required.get()) {
 
 		/* EVENT
 		 * @description
@@ -41,7 +41,7 @@
 class EscChecks : public HealthAndArmingCheckBase
 {
 public:
-	EscChecks() = default;
+	EscChecks() { addInput(_esc_status_sub); }
 	~EscChecks() = default;
 
 	void checkAndReport(const Context &context, Report &reporter) override;
@@ -41,7 +41,7 @@
 class ImuConsistencyChecks : public HealthAndArmingCheckBase
 {
 public:
-	ImuConsistencyChecks() = default;
+	ImuConsistencyChecks() { addInput(_sensors_status_imu_sub); }
 	~ImuConsistencyChecks() = default;
 
 	void checkAndReport(const Context &context, Report &reporter) override;
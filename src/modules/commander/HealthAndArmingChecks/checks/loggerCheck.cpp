@@ -39,6 +39,7 @@ LoggerChecks::LoggerChecks()
 	: _param_sdlog_mode_handle(param_find("SDLOG_MODE"))
 {
 	param_get(_param_sdlog_mode_handle, &_sdlog_mode);
+	addInput(_logger_status_sub);
 }
 
 void LoggerChecks::checkAndReport(const Context &context, Report &reporter)
@@ -52,6 +53,7 @@ void LoggerChecks::checkAndReport(const Context &context, Report &reporter)
 
 			if (hrt_elapsed_time(&status.timestamp) < 3_s && status.is_logging) {
 				active = true;
+				reevaluateAt(status.timestamp + 3_s);
 			}
 		}
 	}
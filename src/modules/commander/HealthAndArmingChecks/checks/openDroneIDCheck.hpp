@@ -38,7 +38,7 @@
 class OpenDroneIDChecks : public HealthAndArmingCheckBase
 {
 public:
-	OpenDroneIDChecks() = default;
+	OpenDroneIDChecks() { enableIncrementalEvaluation(); }
 	~OpenDroneIDChecks() = default;
 
 	void checkAndReport(const Context &context, Report &reporter) override;
@@ -38,7 +38,7 @@
 class ParachuteChecks : public HealthAndArmingCheckBase
 {
 public:
-	ParachuteChecks() = default;
+	ParachuteChecks() { enableIncrementalEvaluation(); }
 	~ParachuteChecks() = default;
 
 	void checkAndReport(const Context &context, Report &reporter) override;
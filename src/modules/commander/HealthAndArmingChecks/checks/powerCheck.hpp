@@ -41,7 +41,7 @@
 class PowerChecks : public HealthAndArmingCheckBase
 {
 public:
-	PowerChecks() = default;
+	PowerChecks() { addInput(_system_power_sub); }
 	~PowerChecks() = default;
 
 	void checkAndReport(const Context &context, Report &reporter) override;
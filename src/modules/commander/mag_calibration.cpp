@@ -40,7 +40,7 @@
 #include "mag_calibration.h"
 #include "commander_helper.h"
 #include "calibration_routines.h"
-#include "lm_fit.hpp"
+#include "mag_streaming_fit.hpp"
 #include "calibration_messages.h"
 #include "factory_calibration_storage.h"
 
@@ -74,9 +74,17 @@ static constexpr int MAX_MAGS = 4;
 static constexpr float MAG_SPHERE_RADIUS_DEFAULT = 0.2f;
 static constexpr unsigned int calibration_total_points = 240;	///< The total points per magnetometer
 static constexpr unsigned int calibraton_duration_s = 42; 	///< The total duration the routine is allowed to take
+static constexpr unsigned int reject_history_size = 20;		///< Recent samples per magnetometer checked for duplicates
 
 calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_mask);
 
+/// Streaming calibration state of a single magnetometer
+struct mag_fit_data_t {
+	MagStreamingFit	fit;
+	Vector3f	recent[reject_history_size];	///< Most recently accepted samples (ring buffer)
+	Matrix3f	cross_sum;			///< sum((p - origin) * (p_internal - origin_internal)^T) for rotation detection
+};
+
 /// Data passed to calibration worker routine
 struct mag_worker_data_t {
 	orb_advert_t	*mavlink_log_pub;
@@ -89,10 +97,11 @@ struct mag_worker_data_t {
 	unsigned int	calibration_points_perside;
 	uint64_t	calibration_interval_perside_us;
 	unsigned int	calibration_counter_total[MAX_MAGS];
+	bool		full_ellipsoid;						///< Fit scales in addition to the offsets
+	bool		fit_converged_reported;
+	int		internal_index;						///< First internal mag, reference for rotation detection
 
-	float		*x[MAX_MAGS];
-	float		*y[MAX_MAGS];
-	float		*z[MAX_MAGS];
+	mag_fit_data_t	*fit_data[MAX_MAGS];
 
 	calibration::Magnetometer calibration[MAX_MAGS] {};
 };
@@ -139,20 +148,20 @@ int do_mag_calibration(orb_advert_t *mavlink_log_pub)
 	return result;
 }
 
-static bool reject_sample(float sx, float sy, float sz, float x[], float y[], float z[], unsigned count,
-			  unsigned max_count, float mag_sphere_radius)
+static bool reject_sample(const Vector3f &sample, const Vector3f recent[], unsigned count, unsigned max_count,
+			  float mag_sphere_radius)
 {
 	float min_sample_dist = fabsf(5.4f * mag_sphere_radius / sqrtf(max_count)) / 3.0f;
 
-	for (size_t i = 0; i < count; i++) {
-		float dx = sx - x[i];
-		float dy = sy - y[i];
-		float dz = sz - z[i];
-		float dist = sqrtf(dx * dx + dy * dy + dz * dz);
+	// only the most recent samples are kept, this rejects the vehicle being held still
+	const unsigned history = math::min(count, reject_history_size);
+
+	for (size_t i = 0; i < history; i++) {
+		float dist = (sample - recent[i]).norm();
 
 		if (dist < min_sample_dist) {
-			PX4_DEBUG("rejected X: %.3f Y: %.3f Z: %.3f (%.3f < %.3f) (%u/%u) ", (double)sx, (double)sy, (double)sz, (double)dist,
-				  (double)min_sample_dist, count, max_count);
+			PX4_DEBUG("rejected X: %.3f Y: %.3f Z: %.3f (%.3f < %.3f) (%u/%u) ", (double)sample(0), (double)sample(1),
+				  (double)sample(2), (double)dist, (double)min_sample_dist, count, max_count);
 
 			return true;
 		}
@@ -161,6 +170,11 @@ static bool reject_sample(float sx, float sy, float sz, float x[], float y[], fl
 	return false;
 }
 
+static Matrix3f outer_product(const Vector3f &a, const Vector3f &b)
+{
+	return Matrix<float, 3, 1>(a) * b.transpose();
+}
+
 static unsigned progress_percentage(mag_worker_data_t *worker_data)
 {
 	return 100 * ((float)worker_data->done_count) / worker_data->calibration_sides;
@@ -360,8 +374,7 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 						}
 
 						// Check if this measurement is good to go in
-						bool reject = reject_sample(mag.x, mag.y, mag.z,
-									    worker_data->x[cur_mag], worker_data->y[cur_mag], worker_data->z[cur_mag],
+						bool reject = reject_sample(Vector3f{mag.x, mag.y, mag.z}, worker_data->fit_data[cur_mag]->recent,
 									    worker_data->calibration_counter_total[cur_mag],
 									    worker_data->calibration_sides * worker_data->calibration_points_perside,
 									    mag_sphere_radius);
@@ -382,16 +395,44 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 
 			// Keep calibration of all mags in lockstep
 			if (!rejected) {
+				bool fit_converged = true;
+
 				for (uint8_t cur_mag = 0; cur_mag < MAX_MAGS; cur_mag++) {
 					if (worker_data->calibration[cur_mag].device_id() != 0) {
-						worker_data->x[cur_mag][worker_data->calibration_counter_total[cur_mag]] = new_samples[cur_mag](0);
-						worker_data->y[cur_mag][worker_data->calibration_counter_total[cur_mag]] = new_samples[cur_mag](1);
-						worker_data->z[cur_mag][worker_data->calibration_counter_total[cur_mag]] = new_samples[cur_mag](2);
+						mag_fit_data_t &fit_data = *worker_data->fit_data[cur_mag];
+						const unsigned count = worker_data->calibration_counter_total[cur_mag];
+
+						fit_data.recent[count % reject_history_size] = new_samples[cur_mag];
+
+						// update the fit with every sample for live feedback
+						fit_data.fit.update(new_samples[cur_mag]);
+						fit_data.fit.solve(worker_data->full_ellipsoid);
+						fit_converged = fit_converged && fit_data.fit.converged();
+
+#if 0
+						// DO NOT REMOVE! Critical validation data!
+						printf("MAG %" PRIu8 " RAW: [%.3f, %.3f, %.3f]\n", cur_mag,
+						       (double)new_samples[cur_mag](0), (double)new_samples[cur_mag](1), (double)new_samples[cur_mag](2));
+#endif // DO NOT REMOVE! Critical validation data!
 
 						worker_data->calibration_counter_total[cur_mag]++;
 					}
 				}
 
+				// samples paired with the first internal mag for the rotation detection
+				if (worker_data->internal_index >= 0) {
+					const mag_fit_data_t &reference = *worker_data->fit_data[worker_data->internal_index];
+					const Vector3f reference_sample = new_samples[worker_data->internal_index] - reference.fit.origin();
+
+					for (int cur_mag = 0; cur_mag < MAX_MAGS; cur_mag++) {
+						if ((worker_data->calibration[cur_mag].device_id() != 0) && (cur_mag != worker_data->internal_index)) {
+							mag_fit_data_t &fit_data = *worker_data->fit_data[cur_mag];
+							const Vector3f sample = new_samples[cur_mag] - fit_data.fit.origin();
+							fit_data.cross_sum += outer_product(sample, reference_sample);
+						}
+					}
+				}
+
 				hrt_abstime now = hrt_absolute_time();
 				mag_worker_data_s status;
 				status.timestamp = now;
@@ -405,15 +446,23 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 					status.side_data_collected[cur_mag] = worker_data->side_data_collected[cur_mag];
 
 					if (worker_data->calibration[cur_mag].device_id() != 0) {
-						const unsigned int sample = worker_data->calibration_counter_total[cur_mag] - 1;
-						status.x[cur_mag] = worker_data->x[cur_mag][sample];
-						status.y[cur_mag] = worker_data->y[cur_mag][sample];
-						status.z[cur_mag] = worker_data->z[cur_mag][sample];
+						const MagStreamingFit &fit = worker_data->fit_data[cur_mag]->fit;
+						status.x[cur_mag] = new_samples[cur_mag](0);
+						status.y[cur_mag] = new_samples[cur_mag](1);
+						status.z[cur_mag] = new_samples[cur_mag](2);
+						status.fit_radius[cur_mag] = fit.valid() ? fit.params().radius : NAN;
+						status.fit_offset_std[cur_mag] = fit.offset_std();
+						status.fit_coverage[cur_mag] = fit.coverage();
+						status.fit_converged[cur_mag] = fit.converged();
 
 					} else {
 						status.x[cur_mag] = 0.f;
 						status.y[cur_mag] = 0.f;
 						status.z[cur_mag] = 0.f;
+						status.fit_radius[cur_mag] = NAN;
+						status.fit_offset_std[cur_mag] = NAN;
+						status.fit_coverage[cur_mag] = 0.f;
+						status.fit_converged[cur_mag] = false;
 					}
 				}
 
@@ -439,6 +488,17 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 
 					worker_data->last_mag_progress = new_progress;
 				}
+
+				// additional samples won't change the result once the fit of every mag has converged,
+				// still collect at least half of the side to weigh all sides in the fit
+				if (fit_converged && (calibration_counter_side >= worker_data->calibration_points_perside / 2)) {
+					if (!worker_data->fit_converged_reported) {
+						PX4_INFO("mag fit converged after %u samples", worker_data->calibration_counter_total[0]);
+						worker_data->fit_converged_reported = true;
+					}
+
+					break;
+				}
 			}
 
 			PX4_DEBUG("side counter %u / %u", calibration_counter_side, worker_data->calibration_points_perside);
@@ -513,16 +573,19 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 		}
 	}
 
+	// Estimate only the offsets if two-sided calibration is selected, as the problem is not constrained
+	// enough to reliably estimate both scales and offsets with 2 sides only (even if the existing calibration
+	// is already close)
+	worker_data.full_ellipsoid = worker_data.calibration_sides > 2;
+	worker_data.fit_converged_reported = false;
+	worker_data.internal_index = -1;
+
 	for (size_t cur_mag = 0; cur_mag < MAX_MAGS; cur_mag++) {
 		// Initialize to no memory allocated
-		worker_data.x[cur_mag] = nullptr;
-		worker_data.y[cur_mag] = nullptr;
-		worker_data.z[cur_mag] = nullptr;
+		worker_data.fit_data[cur_mag] = nullptr;
 		worker_data.calibration_counter_total[cur_mag] = 0;
 	}
 
-	const unsigned int calibration_points_maxcount = worker_data.calibration_sides * worker_data.calibration_points_perside;
-
 	for (uint8_t cur_mag = 0; cur_mag < MAX_MAGS; cur_mag++) {
 
 		uORB::SubscriptionData<sensor_mag_s> mag_sub{ORB_ID(sensor_mag), cur_mag};
@@ -535,16 +598,19 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 		worker_data.calibration[cur_mag].set_calibration_index(cur_mag);
 
 		if (worker_data.calibration[cur_mag].device_id() != 0) {
-			worker_data.x[cur_mag] = static_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
-			worker_data.y[cur_mag] = static_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
-			worker_data.z[cur_mag] = static_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
+			worker_data.fit_data[cur_mag] = new mag_fit_data_t{};
 
-			if (worker_data.x[cur_mag] == nullptr || worker_data.y[cur_mag] == nullptr || worker_data.z[cur_mag] == nullptr) {
+			if (worker_data.fit_data[cur_mag] == nullptr) {
 				calibration_log_critical(mavlink_log_pub, "ERROR: out of memory");
 				result = calibrate_return_error;
 				break;
 			}
 
+			// first internal mag is the reference for the rotation detection
+			if ((worker_data.internal_index < 0) && !worker_data.calibration[cur_mag].external()) {
+				worker_data.internal_index = cur_mag;
+			}
+
 		} else {
 			break;
 		}
@@ -578,38 +644,10 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 		for (uint8_t cur_mag = 0; cur_mag < MAX_MAGS; cur_mag++) {
 			if (worker_data.calibration[cur_mag].device_id() != 0) {
 				// Mag in this slot is available and we should have values for it to calibrate
+				MagStreamingFit &fit = worker_data.fit_data[cur_mag]->fit;
 
-				// Estimate only the offsets if two-sided calibration is selected, as the problem is not constrained
-				// enough to reliably estimate both scales and offsets with 2 sides only (even if the existing calibration
-				// is already close)
-				bool sphere_fit_only = worker_data.calibration_sides <= 2;
-
-				sphere_params sphere_data;
-				sphere_data.radius = sphere_radius[cur_mag];
-				sphere_data.offset = matrix::Vector3f(sphere[cur_mag](0), sphere[cur_mag](1), sphere[cur_mag](2));
-				sphere_data.diag = matrix::Vector3f(diag[cur_mag](0), diag[cur_mag](1), diag[cur_mag](2));
-				sphere_data.offdiag = matrix::Vector3f(offdiag[cur_mag](0), offdiag[cur_mag](1), offdiag[cur_mag](2));
-
-				bool sphere_fit_success = false;
-				bool ellipsoid_fit_success = false;
-				int ret = lm_mag_fit(worker_data.x[cur_mag], worker_data.y[cur_mag], worker_data.z[cur_mag],
-						     worker_data.calibration_counter_total[cur_mag], sphere_data, false);
-
-				if (ret == PX4_OK) {
-					sphere_fit_success = true;
-					PX4_INFO("Mag: %" PRIu8 " sphere radius: %.4f", cur_mag, (double)sphere_data.radius);
-
-					if (!sphere_fit_only) {
-						int ellipsoid_ret = lm_mag_fit(worker_data.x[cur_mag], worker_data.y[cur_mag], worker_data.z[cur_mag],
-									       worker_data.calibration_counter_total[cur_mag], sphere_data, true);
-
-						if (ellipsoid_ret == PX4_OK) {
-							ellipsoid_fit_success = true;
-						}
-					}
-				}
-
-				if (!sphere_fit_success && !ellipsoid_fit_success) {
+				// the fit has been updated with every sample, solve once more for the final result
+				if (!fit.solve(worker_data.full_ellipsoid)) {
 					if (worker_data.calibration[cur_mag].enabled()) {
 						calibration_log_emergency(mavlink_log_pub, "Retry calibration (unable to fit mag %" PRIu8 ")", cur_mag);
 						result = calibrate_return_error;
@@ -621,6 +659,15 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 					}
 				}
 
+				const sphere_params &sphere_data = fit.params();
+
+				PX4_INFO("Mag: %" PRIu8 " sphere radius: %.4f, offset std: %.4f, coverage: %.2f", cur_mag,
+					 (double)sphere_data.radius, (double)fit.offset_std(), (double)fit.coverage());
+
+				if (worker_data.full_ellipsoid && !fit.ellipsoid_valid()) {
+					PX4_WARN("Mag: %" PRIu8 " ellipsoid fit failed, using sphere", cur_mag);
+				}
+
 				sphere_radius[cur_mag] = sphere_data.radius;
 
 				for (int i = 0; i < 3; i++) {
@@ -654,39 +701,19 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 
 #if 0
 
-	// DO NOT REMOVE! Critical validation data!
+	// DO NOT REMOVE! Critical validation data! (raw samples are printed by the worker)
 	if (result == calibrate_return_ok) {
-		// Print uncalibrated data points
 		for (uint8_t cur_mag = 0; cur_mag < MAX_MAGS; cur_mag++) {
 			if (worker_data.calibration_counter_total[cur_mag] == 0) {
 				continue;
 			}
 
 			printf("MAG %" PRIu8 " with %u samples:\n", cur_mag, worker_data.calibration_counter_total[cur_mag]);
-			printf("RAW -> CALIBRATED\n");
-
-			float scale_data[9] {
-				diag[cur_mag](0),    offdiag[cur_mag](0), offdiag[cur_mag](1),
-				offdiag[cur_mag](0),    diag[cur_mag](1), offdiag[cur_mag](2),
-				offdiag[cur_mag](1), offdiag[cur_mag](2),    diag[cur_mag](2)
-			};
-
-			const Matrix3f scale{scale_data};
-			const Vector3f &offset = sphere[cur_mag];
-
-			for (size_t i = 0; i < worker_data.calibration_counter_total[cur_mag]; i++) {
-				float x = worker_data.x[cur_mag][i];
-				float y = worker_data.y[cur_mag][i];
-				float z = worker_data.z[cur_mag][i];
-
-				// apply calibration
-				const Vector3f cal{scale *(Vector3f{x, y, z} - offset)};
-
-				printf("[%.3f, %.3f, %.3f] -> [%.3f, %.3f, %.3f]\n",
-				       (double)x, (double)y, (double)z,
-				       (double)cal(0), (double)cal(1), (double)cal(2));
-			}
-
+			printf("OFFSET: [%.3f, %.3f, %.3f]\n", (double)sphere[cur_mag](0), (double)sphere[cur_mag](1),
+			       (double)sphere[cur_mag](2));
+			printf("DIAG: [%.3f, %.3f, %.3f] OFFDIAG: [%.3f, %.3f, %.3f]\n",
+			       (double)diag[cur_mag](0), (double)diag[cur_mag](1), (double)diag[cur_mag](2),
+			       (double)offdiag[cur_mag](0), (double)offdiag[cur_mag](1), (double)offdiag[cur_mag](2));
 			printf("SPHERE RADIUS: %8.4f\n", (double)sphere_radius[cur_mag]);
 		}
 	}
@@ -701,22 +728,16 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 
 		if ((worker_data.calibration_sides >= 3) && (param_sens_mag_autorot == 1)) {
 
-			// find first internal mag to use as reference
-			int internal_index = -1;
-
-			for (unsigned cur_mag = 0; cur_mag < MAX_MAGS; cur_mag++) {
-				if (!worker_data.calibration[cur_mag].external() && (worker_data.calibration[cur_mag].device_id() != 0)) {
-					internal_index = cur_mag;
-					break;
-				}
-			}
+			const int internal_index = worker_data.internal_index;
 
 			// only proceed if there's a valid internal
 			if (internal_index >= 0) {
 
 				const Dcmf board_rotation = calibration::GetBoardRotationMatrix();
 
-				// apply new calibrations to all raw sensor data before comparison
+				// new calibrations applied to the raw sensor data: m = P * (sample - offset)
+				Matrix3f P[MAX_MAGS];
+
 				for (unsigned cur_mag = 0; cur_mag < MAX_MAGS; cur_mag++) {
 					if (worker_data.calibration[cur_mag].device_id() != 0) {
 
@@ -725,37 +746,47 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 							offdiag[cur_mag](0),    diag[cur_mag](1), offdiag[cur_mag](2),
 							offdiag[cur_mag](1), offdiag[cur_mag](2),    diag[cur_mag](2)
 						};
-						const Matrix3f scale{scale_data};
-
-						const Vector3f &offset{sphere[cur_mag]};
-
-						for (unsigned i = 0; i < worker_data.calibration_counter_total[cur_mag]; i++) {
-
-							const Vector3f sample{worker_data.x[cur_mag][i], worker_data.y[cur_mag][i], worker_data.z[cur_mag][i]};
+						P[cur_mag] = Matrix3f{scale_data};
 
-							// apply calibration
-							Vector3f m{scale *(sample - offset)};
-
-							if (!worker_data.calibration[cur_mag].external()) {
-								// rotate internal mag data to board
-								m = board_rotation * m;
-							}
-
-							// store back in worker_data
-							worker_data.x[cur_mag][i] = m(0);
-							worker_data.y[cur_mag][i] = m(1);
-							worker_data.z[cur_mag][i] = m(2);
+						if (!worker_data.calibration[cur_mag].external()) {
+							// rotate internal mag data to board
+							P[cur_mag] = board_rotation * P[cur_mag];
 						}
 					}
 				}
 
+				const MagStreamingFit &reference_fit = worker_data.fit_data[internal_index]->fit;
+				const Vector3f &reference_offset = sphere[internal_index];
+
+				// sum(|m_internal|^2)
+				const Matrix3f reference_scatter = P[internal_index] * reference_fit.scatter(reference_offset) *
+								   P[internal_index].transpose();
+				const float reference_sum_squares = reference_scatter.trace();
+
 				// external mags try all rotations and compute mean square error (MSE) compared with first internal mag
 				for (int cur_mag = 0; cur_mag < MAX_MAGS; cur_mag++) {
 					if ((worker_data.calibration[cur_mag].device_id() != 0) && (cur_mag != internal_index)) {
 
+						// all mags are sampled in lockstep
 						const int last_sample_index = math::min(worker_data.calibration_counter_total[internal_index],
 											worker_data.calibration_counter_total[cur_mag]);
 
+						const MagStreamingFit &fit = worker_data.fit_data[cur_mag]->fit;
+						const Vector3f &offset = sphere[cur_mag];
+
+						// sum(|m|^2)
+						const Matrix3f scatter = P[cur_mag] * fit.scatter(offset) * P[cur_mag].transpose();
+						const float sum_squares = scatter.trace();
+
+						// sum(m * m_internal^T) from the paired sums relative to the first samples
+						const Vector3f q = offset - fit.origin();
+						const Vector3f q_reference = reference_offset - reference_fit.origin();
+						const Matrix3f cross = worker_data.fit_data[cur_mag]->cross_sum
+								       - outer_product(q, reference_fit.sum(reference_offset))
+								       - outer_product(fit.sum(offset), q_reference)
+								       - outer_product(q, q_reference) * (float)last_sample_index;
+						const Matrix3f cross_calibrated = P[cur_mag] * cross * P[internal_index].transpose();
+
 						float MSE[ROTATION_MAX] {}; // mean square error for each rotation
 
 						float min_mse = FLT_MAX;
@@ -779,21 +810,12 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 								break;
 
 							default:
-								float diff_sum = 0.f;
-
-								for (int i = 0; i < last_sample_index; i++) {
-									float x = worker_data.x[cur_mag][i];
-									float y = worker_data.y[cur_mag][i];
-									float z = worker_data.z[cur_mag][i];
-									rotate_3f((enum Rotation)r, x, y, z);
-
-									Vector3f diff = Vector3f{x, y, z} - Vector3f{worker_data.x[internal_index][i], worker_data.y[internal_index][i], worker_data.z[internal_index][i]};
-
-									diff_sum += diff.norm_squared();
-								}
+								// sum(|R m - m_internal|^2) = sum(|m|^2) + sum(|m_internal|^2) - 2 trace(R sum(m m_internal^T))
+								const float diff_sum = sum_squares + reference_sum_squares
+										       - 2.f * Matrix3f{get_rot_matrix((enum Rotation)r) * cross_calibrated}.trace();
 
 								// compute mean squared error
-								MSE[r] = diff_sum / last_sample_index;
+								MSE[r] = math::max(diff_sum, 0.f) / last_sample_index;
 
 								if (MSE[r] < min_mse) {
 									min_mse = MSE[r];
@@ -888,11 +910,10 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub, int32_t cal_ma
 	}
 
 
-	// Data points are no longer needed
+	// Fit data is no longer needed
 	for (size_t cur_mag = 0; cur_mag < MAX_MAGS; cur_mag++) {
-		free(worker_data.x[cur_mag]);
-		free(worker_data.y[cur_mag]);
-		free(worker_data.z[cur_mag]);
+		delete worker_data.fit_data[cur_mag];
+		worker_data.fit_data[cur_mag] = nullptr;
 	}
 
 	FactoryCalibrationStorage factory_storage;
@@ -43,6 +43,7 @@
 #include <px4_platform_common/defines.h>
 
 #include "lm_fit.hpp"
+#include "mag_streaming_fit.hpp"
 #include "mag_calibration_test_data.h"
 
 using matrix::Vector3f;
@@ -236,3 +237,136 @@ TEST_F(MagCalTest, replayTestData)
 	EXPECT_NEAR(ellipsoid.diag(1), scale_true(1), 0.01f) << "scale Y: " << ellipsoid.diag(1);
 	EXPECT_NEAR(ellipsoid.diag(2), scale_true(2), 0.01f) << "scale Z: " << ellipsoid.diag(2);
 }
+
+TEST_F(MagCalTest, streamingSphereRegularlySpaced)
+{
+	// GIVEN: a dataset of regularly spaced points
+	// on a perfect sphere but not centered on the origin
+	static constexpr unsigned int N_SAMPLES = 240;
+
+	const float mag_str_true = 0.4f;
+	const Vector3f offset_true = {-1.07f, 0.35f, -0.78f};
+	const Vector3f scale_true = {1.f, 1.f, 1.f};
+
+	float x[N_SAMPLES];
+	float y[N_SAMPLES];
+	float z[N_SAMPLES];
+	generateRegularData(x, y, z, N_SAMPLES, mag_str_true);
+	modifyOffsetScale(x, y, z, N_SAMPLES, offset_true, scale_true);
+
+	// WHEN: streaming the data through the sphere and the ellipsoid fit
+	MagStreamingFit fit;
+
+	for (unsigned int i = 0; i < N_SAMPLES; i++) {
+		fit.update(Vector3f{x[i], y[i], z[i]});
+	}
+
+	const bool sphere_success = fit.solve(false);
+	const sphere_params sphere = fit.params();
+
+	const bool ellipsoid_success = fit.solve(true);
+	const sphere_params ellipsoid = fit.params();
+
+	// THEN: both fits should find the correct parameters
+	EXPECT_TRUE(sphere_success);
+	EXPECT_NEAR(sphere.radius, mag_str_true, 0.001f) << "radius: " << sphere.radius;
+	EXPECT_NEAR(sphere.offset(0), offset_true(0), 0.001f) << "offset X: " << sphere.offset(0);
+	EXPECT_NEAR(sphere.offset(1), offset_true(1), 0.001f) << "offset Y: " << sphere.offset(1);
+	EXPECT_NEAR(sphere.offset(2), offset_true(2), 0.001f) << "offset Z: " << sphere.offset(2);
+
+	EXPECT_TRUE(ellipsoid_success);
+	EXPECT_TRUE(fit.ellipsoid_valid());
+	EXPECT_NEAR(ellipsoid.offset(0), offset_true(0), 0.001f) << "offset X: " << ellipsoid.offset(0);
+	EXPECT_NEAR(ellipsoid.offset(1), offset_true(1), 0.001f) << "offset Y: " << ellipsoid.offset(1);
+	EXPECT_NEAR(ellipsoid.offset(2), offset_true(2), 0.001f) << "offset Z: " << ellipsoid.offset(2);
+	EXPECT_NEAR(ellipsoid.diag(0), scale_true(0), 0.001f) << "scale X: " << ellipsoid.diag(0);
+	EXPECT_NEAR(ellipsoid.diag(1), scale_true(1), 0.001f) << "scale Y: " << ellipsoid.diag(1);
+	EXPECT_NEAR(ellipsoid.diag(2), scale_true(2), 0.001f) << "scale Z: " << ellipsoid.diag(2);
+}
+
+TEST_F(MagCalTest, streamingCoverage)
+{
+	// GIVEN: a dataset of points located on two orthogonal circles
+	static constexpr unsigned int N_SAMPLES = 240;
+
+	const float mag_str_true = 0.4f;
+
+	float x[N_SAMPLES];
+	float y[N_SAMPLES];
+	float z[N_SAMPLES];
+
+	generate2SidesMagData(x, y, z, N_SAMPLES, mag_str_true);
+
+	// WHEN: only the first circle has been collected
+	MagStreamingFit fit;
+
+	for (unsigned int i = 0; i < N_SAMPLES / 2; i++) {
+		fit.update(Vector3f{x[i], y[i], z[i]});
+		fit.solve(false);
+	}
+
+	// THEN: the fit is under-constrained and must not be reported as converged
+	EXPECT_FALSE(fit.converged());
+
+	// WHEN: the second circle is added
+	for (unsigned int i = N_SAMPLES / 2; i < N_SAMPLES; i++) {
+		fit.update(Vector3f{x[i], y[i], z[i]});
+		fit.solve(false);
+	}
+
+	// THEN: the sphere is fully determined
+	EXPECT_TRUE(fit.converged());
+	EXPECT_NEAR(fit.params().radius, mag_str_true, 0.001f) << "radius: " << fit.params().radius;
+	EXPECT_NEAR(fit.params().offset.norm(), 0.f, 0.001f) << "offset: " << fit.params().offset.norm();
+}
+
+TEST_F(MagCalTest, streamingReplayTestData)
+{
+	// GIVEN: the real test dataset with large offsets
+	constexpr unsigned int N_SAMPLES = 231;
+
+	const float mag_str_true = 0.4f;
+	const Vector3f offset_true = {-0.18f, 0.05f, -0.58f};
+	const Vector3f scale_true = {1.f, 1.06f, 0.94f};
+
+	// WHEN: streaming the samples through the fit, solving after every sample
+	MagStreamingFit fit;
+	unsigned int converged_samples = 0;
+
+	for (unsigned int i = 0; i < N_SAMPLES; i++) {
+		fit.update(Vector3f{mag_data1_x[i], mag_data1_y[i], mag_data1_z[i]});
+		fit.solve(true);
+
+		if ((converged_samples == 0) && fit.converged()) {
+			converged_samples = fit.sample_count();
+		}
+	}
+
+	// THEN: the fit converges before all the samples are collected
+	EXPECT_GT(converged_samples, 0u);
+	EXPECT_LT(converged_samples, N_SAMPLES);
+
+	// AND: the final ellipsoid matches the batch LM result
+	const sphere_params ellipsoid = fit.params();
+	EXPECT_TRUE(fit.ellipsoid_valid());
+	EXPECT_NEAR(ellipsoid.radius, mag_str_true, 0.1f) << "radius: " << ellipsoid.radius;
+	EXPECT_NEAR(ellipsoid.offset(0), offset_true(0), 0.01f) << "offset X: " << ellipsoid.offset(0);
+	EXPECT_NEAR(ellipsoid.offset(1), offset_true(1), 0.01f) << "offset Y: " << ellipsoid.offset(1);
+	EXPECT_NEAR(ellipsoid.offset(2), offset_true(2), 0.01f) << "offset Z: " << ellipsoid.offset(2);
+	EXPECT_NEAR(ellipsoid.diag(0), scale_true(0), 0.01f) << "scale X: " << ellipsoid.diag(0);
+	EXPECT_NEAR(ellipsoid.diag(1), scale_true(1), 0.01f) << "scale Y: " << ellipsoid.diag(1);
+	EXPECT_NEAR(ellipsoid.diag(2), scale_true(2), 0.01f) << "scale Z: " << ellipsoid.diag(2);
+
+	sphere_params lm;
+	lm.radius = 0.2f;
+	EXPECT_EQ(lm_mag_fit(mag_data1_x, mag_data1_y, mag_data1_z, N_SAMPLES, lm, false), PX4_OK);
+	EXPECT_EQ(lm_mag_fit(mag_data1_x, mag_data1_y, mag_data1_z, N_SAMPLES, lm, true), PX4_OK);
+
+	for (int i = 0; i < 3; i++) {
+		EXPECT_NEAR(ellipsoid.offset(i), lm.offset(i), 0.005f);
+		EXPECT_NEAR(ellipsoid.diag(i), lm.diag(i), 0.005f);
+		EXPECT_NEAR(ellipsoid.offdiag(i), lm.offdiag(i), 0.005f);
+	}
+
+	EXPECT_NEAR(ellipsoid.radius, lm.radius, 0.005f);
+}
@@ -0,0 +1,481 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "mag_streaming_fit.hpp"
+
+#include <float.h>
+#include <math.h>
+#include <mathlib/mathlib.h>
+
+using namespace matrix;
+
+namespace
+{
+
+// index of the power sum x^i * y^j * z^k in the moment array
+struct MomentIndex {
+	uint8_t index[5][5][5] {};
+
+	constexpr MomentIndex()
+	{
+		uint8_t n = 0;
+
+		for (int i = 0; i <= 4; i++) {
+			for (int j = 0; j <= 4 - i; j++) {
+				for (int k = 0; k <= 4 - i - j; k++) {
+					index[i][j][k] = n++;
+				}
+			}
+		}
+	}
+};
+
+static constexpr MomentIndex moment_index{};
+
+static constexpr double binomial[5][5] {
+	{1., 0., 0., 0., 0.},
+	{1., 1., 0., 0., 0.},
+	{1., 2., 1., 0., 0.},
+	{1., 3., 3., 1., 0.},
+	{1., 4., 6., 4., 1.},
+};
+
+// index of element (i, j), j <= i, of a symmetric matrix stored as packed lower triangle
+static constexpr int packed(int i, int j) { return i * (i + 1) / 2 + j; }
+
+// Solve A x = b in place for a symmetric positive definite A (packed lower triangle) using a Cholesky decomposition
+template<int N>
+static bool cholesky_solve(double A[N * (N + 1) / 2], double b[N])
+{
+	for (int i = 0; i < N; i++) {
+		for (int j = 0; j <= i; j++) {
+			double sum = A[packed(i, j)];
+
+			for (int k = 0; k < j; k++) {
+				sum -= A[packed(i, k)] * A[packed(j, k)];
+			}
+
+			if (i == j) {
+				if (!(sum > 0.)) {
+					return false;
+				}
+
+				A[packed(i, i)] = sqrt(sum);
+
+			} else {
+				A[packed(i, j)] = sum / A[packed(j, j)];
+			}
+		}
+	}
+
+	// forward substitution L y = b
+	for (int i = 0; i < N; i++) {
+		for (int k = 0; k < i; k++) {
+			b[i] -= A[packed(i, k)] * b[k];
+		}
+
+		b[i] /= A[packed(i, i)];
+	}
+
+	// back substitution L^T x = y
+	for (int i = N - 1; i >= 0; i--) {
+		for (int k = i + 1; k < N; k++) {
+			b[i] -= A[packed(k, i)] * b[k];
+		}
+
+		b[i] /= A[packed(i, i)];
+	}
+
+	return true;
+}
+
+// Principal square root of a symmetric positive definite matrix (Denman-Beavers iteration)
+static bool sqrtm(const SquareMatrix<double, 3> &A, SquareMatrix<double, 3> &sqrt_A)
+{
+	SquareMatrix<double, 3> Y = A;
+	SquareMatrix<double, 3> Z = eye<double, 3>();
+
+	for (int n = 0; n < 20; n++) {
+		SquareMatrix<double, 3> Y_inv;
+		SquareMatrix<double, 3> Z_inv;
+
+		if (!inv(Y, Y_inv) || !inv(Z, Z_inv)) {
+			return false;
+		}
+
+		const SquareMatrix<double, 3> Y_next = (Y + Z_inv) * 0.5;
+		Z = (Z + Y_inv) * 0.5;
+
+		const double change = (Y_next - Y).abs().max();
+		Y = Y_next;
+
+		if (change < 1e-12) {
+			break;
+		}
+	}
+
+	// enforce symmetry
+	sqrt_A = (Y + Y.transpose()) * 0.5;
+	return true;
+}
+
+template<typename Type>
+static Type determinant(const SquareMatrix<Type, 3> &A)
+{
+	return A(0, 0) * (A(1, 1) * A(2, 2) - A(2, 1) * A(1, 2))
+	       - A(0, 1) * (A(1, 0) * A(2, 2) - A(2, 0) * A(1, 2))
+	       + A(0, 2) * (A(1, 0) * A(2, 1) - A(2, 0) * A(1, 1));
+}
+
+} // namespace
+
+void MagStreamingFit::reset()
+{
+	*this = MagStreamingFit{};
+}
+
+double MagStreamingFit::moment(int i, int j, int k) const
+{
+	return _moments[moment_index.index[i][j][k]];
+}
+
+void MagStreamingFit::shiftedMoments(const Vector3f &center, double shifted[NUM_MOMENTS]) const
+{
+	// sum((x - cx)^i * (y - cy)^j * (z - cz)^k) from the power sums using the binomial expansion
+	const Vector3f q = center - _origin;
+
+	double qx[MAX_ORDER + 1] {1.};
+	double qy[MAX_ORDER + 1] {1.};
+	double qz[MAX_ORDER + 1] {1.};
+
+	for (int n = 1; n <= MAX_ORDER; n++) {
+		qx[n] = -qx[n - 1] * (double)q(0);
+		qy[n] = -qy[n - 1] * (double)q(1);
+		qz[n] = -qz[n - 1] * (double)q(2);
+	}
+
+	for (int i = 0; i <= MAX_ORDER; i++) {
+		for (int j = 0; j <= MAX_ORDER - i; j++) {
+			for (int k = 0; k <= MAX_ORDER - i - j; k++) {
+				double sum = 0.;
+
+				for (int a = 0; a <= i; a++) {
+					for (int b = 0; b <= j; b++) {
+						const double cab = binomial[i][a] * qx[i - a] * binomial[j][b] * qy[j - b];
+
+						for (int c = 0; c <= k; c++) {
+							sum += cab * binomial[k][c] * qz[k - c] * moment(a, b, c);
+						}
+					}
+				}
+
+				shifted[moment_index.index[i][j][k]] = sum;
+			}
+		}
+	}
+}
+
+void MagStreamingFit::update(const Vector3f &sample)
+{
+	if (_sample_count == 0) {
+		// accumulate relative to the first sample to keep the power sums well conditioned with large offsets
+		_origin = sample;
+	}
+
+	const Vector3f p = sample - _origin;
+
+	double px[MAX_ORDER + 1] {1.};
+	double py[MAX_ORDER + 1] {1.};
+	double pz[MAX_ORDER + 1] {1.};
+
+	for (int n = 1; n <= MAX_ORDER; n++) {
+		px[n] = px[n - 1] * (double)p(0);
+		py[n] = py[n - 1] * (double)p(1);
+		pz[n] = pz[n - 1] * (double)p(2);
+	}
+
+	int n = 0;
+
+	for (int i = 0; i <= MAX_ORDER; i++) {
+		for (int j = 0; j <= MAX_ORDER - i; j++) {
+			const double pxy = px[i] * py[j];
+
+			for (int k = 0; k <= MAX_ORDER - i - j; k++) {
+				_moments[n++] += pxy * pz[k];
+			}
+		}
+	}
+
+	_sample_count++;
+}
+
+Vector3f MagStreamingFit::sum(const Vector3f &center) const
+{
+	const Vector3f q = center - _origin;
+	const double n = _sample_count;
+
+	return Vector3f{(float)(moment(1, 0, 0) - n * (double)q(0)),
+			(float)(moment(0, 1, 0) - n * (double)q(1)),
+			(float)(moment(0, 0, 1) - n * (double)q(2))};
+}
+
+Matrix3f MagStreamingFit::scatter(const Vector3f &center) const
+{
+	const Vector3f q = center - _origin;
+	const double c[3] {(double)q(0), (double)q(1), (double)q(2)};
+	const double sum[3] {moment(1, 0, 0), moment(0, 1, 0), moment(0, 0, 1)};
+	const double n = _sample_count;
+
+	Matrix3f S;
+
+	for (int a = 0; a < 3; a++) {
+		for (int b = 0; b < 3; b++) {
+			int e[3] {};
+			e[a]++;
+			e[b]++;
+
+			S(a, b) = (float)(moment(e[0], e[1], e[2]) - c[a] * sum[b] - sum[a] * c[b] + n * c[a] * c[b]);
+		}
+	}
+
+	return S;
+}
+
+bool MagStreamingFit::solve(bool full_ellipsoid)
+{
+	_valid = solveSphere();
+	_ellipsoid_valid = _valid && full_ellipsoid && solveEllipsoid();
+
+	if (!_valid) {
+		_offset_std = INFINITY;
+		_coverage = 0.f;
+		return false;
+	}
+
+	const float variance = _ellipsoid_valid ? _ellipsoid_residual_variance : _sphere_residual_variance;
+	const float max_offset_variance = math::max(_offset_covariance_unscaled(0, 0),
+					  math::max(_offset_covariance_unscaled(1, 1), _offset_covariance_unscaled(2, 2)));
+	_offset_std = sqrtf(math::max(max_offset_variance * variance, 0.f));
+
+	// sphericity of the sample distribution around the fitted center
+	Matrix3f C = scatter(_params.offset);
+	C /= (float)_sample_count;
+
+	const float mean_eigenvalue = C.trace() / 3.f;
+
+	if (mean_eigenvalue > FLT_EPSILON) {
+		_coverage = math::constrain(determinant(C) / (mean_eigenvalue * mean_eigenvalue * mean_eigenvalue), 0.f, 1.f);
+
+	} else {
+		_coverage = 0.f;
+	}
+
+	return true;
+}
+
+bool MagStreamingFit::converged() const
+{
+	return _valid
+	       && (_sample_count >= MIN_SAMPLES_CONVERGED)
+	       && (_offset_std < OFFSET_STD_CONVERGED)
+	       && (_coverage > COVERAGE_CONVERGED);
+}
+
+bool MagStreamingFit::solveSphere()
+{
+	// |p|^2 = 2 * c.p + d, parameters [c, d], with d = r^2 - |c|^2
+	static constexpr int NUM_PARAMS = 4;
+	static constexpr int exponent[NUM_PARAMS][3] {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {0, 0, 0}};
+	static constexpr double coefficient[NUM_PARAMS] {2., 2., 2., 1.};
+
+	if (_sample_count <= NUM_PARAMS) {
+		return false;
+	}
+
+	SquareMatrix<double, NUM_PARAMS> AtA;
+	Vector<double, NUM_PARAMS> Atb;
+
+	for (int a = 0; a < NUM_PARAMS; a++) {
+		const int *ea = exponent[a];
+
+		for (int b = 0; b < NUM_PARAMS; b++) {
+			const int *eb = exponent[b];
+			AtA(a, b) = coefficient[a] * coefficient[b] * moment(ea[0] + eb[0], ea[1] + eb[1], ea[2] + eb[2]);
+		}
+
+		Atb(a) = coefficient[a] * (moment(ea[0] + 2, ea[1], ea[2])
+					   + moment(ea[0], ea[1] + 2, ea[2])
+					   + moment(ea[0], ea[1], ea[2] + 2));
+	}
+
+	// sum(|p|^4)
+	const double btb = moment(4, 0, 0) + moment(0, 4, 0) + moment(0, 0, 4)
+			   + 2. * (moment(2, 2, 0) + moment(2, 0, 2) + moment(0, 2, 2));
+
+	SquareMatrix<double, NUM_PARAMS> AtA_inv;
+
+	if (!inv(AtA, AtA_inv)) {
+		return false;
+	}
+
+	const Vector<double, NUM_PARAMS> theta = AtA_inv * Atb;
+	const Vector3f center{(float)theta(0), (float)theta(1), (float)theta(2)};
+	const double radius_squared = theta(3) + theta(0) * theta(0) + theta(1) * theta(1) + theta(2) * theta(2);
+
+	if (!(radius_squared > 0.) || !center.isAllFinite()) {
+		return false;
+	}
+
+	const double sse = btb - theta.dot(Atb);
+	_sphere_residual_variance = (float)(math::max(sse, 0.) / (_sample_count - NUM_PARAMS));
+
+	for (int a = 0; a < 3; a++) {
+		for (int b = 0; b < 3; b++) {
+			_offset_covariance_unscaled(a, b) = (float)AtA_inv(a, b);
+		}
+	}
+
+	_params.offset = center + _origin;
+	_params.radius = (float)sqrt(radius_squared);
+	_params.diag = Vector3f{1.f, 1.f, 1.f};
+	_params.offdiag.zero();
+
+	return true;
+}
+
+bool MagStreamingFit::solveEllipsoid()
+{
+	// p^T M p + 2 * v^T p = 1, parameters [M00, M11, M22, M01, M02, M12, v0, v1, v2]
+	static constexpr int NUM_PARAMS = 9;
+	static constexpr int exponent[NUM_PARAMS][3] {
+		{2, 0, 0}, {0, 2, 0}, {0, 0, 2},
+		{1, 1, 0}, {1, 0, 1}, {0, 1, 1},
+		{1, 0, 0}, {0, 1, 0}, {0, 0, 1}
+	};
+	static constexpr double coefficient[NUM_PARAMS] {1., 1., 1., 2., 2., 2., 2., 2., 2.};
+
+	if (_sample_count <= NUM_PARAMS) {
+		return false;
+	}
+
+	// the algebraic fit is not translation invariant, solve it relative to the sphere center
+	// where the constant term of the quadric is well away from zero
+	const Vector3f sphere_center = _params.offset;
+	double m[NUM_MOMENTS];
+	shiftedMoments(sphere_center, m);
+
+	auto moment_centered = [&m](int i, int j, int k) { return m[moment_index.index[i][j][k]]; };
+
+	double AtA[NUM_PARAMS * (NUM_PARAMS + 1) / 2];
+	double theta[NUM_PARAMS];
+	double Atb[NUM_PARAMS];
+
+	for (int a = 0; a < NUM_PARAMS; a++) {
+		const int *ea = exponent[a];
+
+		for (int b = 0; b <= a; b++) {
+			const int *eb = exponent[b];
+			AtA[packed(a, b)] = coefficient[a] * coefficient[b] * moment_centered(ea[0] + eb[0], ea[1] + eb[1], ea[2] + eb[2]);
+		}
+
+		Atb[a] = coefficient[a] * moment_centered(ea[0], ea[1], ea[2]);
+		theta[a] = Atb[a];
+	}
+
+	if (!cholesky_solve<NUM_PARAMS>(AtA, theta)) {
+		return false;
+	}
+
+	SquareMatrix<double, 3> M;
+	M(0, 0) = theta[0];
+	M(1, 1) = theta[1];
+	M(2, 2) = theta[2];
+	M(0, 1) = M(1, 0) = theta[3];
+	M(0, 2) = M(2, 0) = theta[4];
+	M(1, 2) = M(2, 1) = theta[5];
+	const Vector3d v{theta[6], theta[7], theta[8]};
+
+	SquareMatrix<double, 3> M_inv;
+
+	if (!inv(M, M_inv)) {
+		return false;
+	}
+
+	// (p - c)^T M (p - c) = 1 + c^T M c, with c = -M^-1 v
+	const Vector3d center = -(M_inv * v);
+	const double k = 1. + center.dot(M * center);
+
+	if (!(k > 0.)) {
+		return false;
+	}
+
+	// scale the unit ellipsoid to the sphere radius: |W (p - c)| = r with W = sqrt(r^2 * M / k)
+	const double radius = _params.radius;
+	const SquareMatrix<double, 3> A = M * (radius * radius / k);
+
+	// must be positive definite to describe an ellipsoid
+	if (!(A(0, 0) > 0.) || !(A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0) > 0.) || !(determinant(A) > 0.)) {
+		return false;
+	}
+
+	SquareMatrix<double, 3> W;
+
+	if (!sqrtm(A, W)) {
+		return false;
+	}
+
+	const Vector3f offset{(float)center(0), (float)center(1), (float)center(2)};
+	const Vector3f diag{(float)W(0, 0), (float)W(1, 1), (float)W(2, 2)};
+	const Vector3f offdiag{(float)W(0, 1), (float)W(0, 2), (float)W(1, 2)};
+
+	if (!offset.isAllFinite() || !diag.isAllFinite() || !offdiag.isAllFinite()) {
+		return false;
+	}
+
+	double sse = _sample_count;
+
+	for (int a = 0; a < NUM_PARAMS; a++) {
+		sse -= theta[a] * Atb[a];
+	}
+
+	// residual is relative to the unit ellipsoid, scale to the sphere residual |p - c|^2 - r^2
+	_ellipsoid_residual_variance = (float)(math::max(sse, 0.) * radius * radius * radius * radius
+					       / (_sample_count - NUM_PARAMS));
+
+	_params.offset = offset + sphere_center;
+	_params.diag = diag;
+	_params.offdiag = offdiag;
+
+	return true;
+}
@@ -0,0 +1,147 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mag_streaming_fit.hpp
+ *
+ * Streaming sphere/ellipsoid fit for magnetometer calibration.
+ *
+ * Instead of storing every sample and iterating over all of them once
+ * the collection is done, the fitter accumulates the 35 power sums
+ * sum(x^i * y^j * z^k) with i + j + k <= 4. These are sufficient to build
+ * the normal equations of both the algebraic sphere fit
+ *   |p|^2 = 2 * c.p + (r^2 - |c|^2)
+ * and the algebraic ellipsoid fit
+ *   p^T M p + 2 * v^T p = 1
+ * so memory stays constant and the current fit can be solved at any time
+ * while the vehicle is being rotated.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <matrix/matrix/math.hpp>
+
+#include "lm_fit.hpp"
+
+class MagStreamingFit
+{
+public:
+	MagStreamingFit() = default;
+	~MagStreamingFit() = default;
+
+	void reset();
+
+	/**
+	 * Add a sample to the fit. This is O(1) and does not store the sample.
+	 */
+	void update(const matrix::Vector3f &sample);
+
+	/**
+	 * Solve the fit from all the samples accumulated so far.
+	 *
+	 * The sphere fit is always computed and provides the radius. If full_ellipsoid is set,
+	 * the ellipsoid fit provides offset, diagonal and off-diagonal scale and falls back to
+	 * the sphere solution if the samples do not describe an ellipsoid (yet).
+	 *
+	 * @return true if at least the sphere fit succeeded
+	 */
+	bool solve(bool full_ellipsoid);
+
+	const sphere_params &params() const { return _params; }
+	bool valid() const { return _valid; }
+	bool ellipsoid_valid() const { return _ellipsoid_valid; }
+
+	unsigned sample_count() const { return _sample_count; }
+
+	/**
+	 * Estimated standard deviation of the fitted offset (largest axis, Gauss).
+	 */
+	float offset_std() const { return _offset_std; }
+
+	/**
+	 * Sphericity of the sample scatter around the fitted offset, 1 for an evenly covered
+	 * sphere and 0 if all samples lie in a plane (e.g. rotation around a single axis only).
+	 */
+	float coverage() const { return _coverage; }
+
+	/**
+	 * The fit is considered converged once the samples cover the sphere in all directions
+	 * and the offset uncertainty is small, additional samples would not change the result.
+	 */
+	bool converged() const;
+
+	/**
+	 * First accepted sample, all power sums are accumulated relative to it.
+	 */
+	const matrix::Vector3f &origin() const { return _origin; }
+
+	/**
+	 * Sum of (p - center) over all samples.
+	 */
+	matrix::Vector3f sum(const matrix::Vector3f &center) const;
+
+	/**
+	 * Scatter matrix sum((p - center) * (p - center)^T) of all samples.
+	 */
+	matrix::Matrix3f scatter(const matrix::Vector3f &center) const;
+
+	static constexpr unsigned MIN_SAMPLES_CONVERGED = 100;
+	static constexpr float OFFSET_STD_CONVERGED = 0.002f; // Gauss
+	static constexpr float COVERAGE_CONVERGED = 0.2f;
+
+private:
+	static constexpr int MAX_ORDER = 4;
+	static constexpr int NUM_MOMENTS = 35; // monomials x^i * y^j * z^k with i + j + k <= MAX_ORDER
+
+	double moment(int i, int j, int k) const;
+	void shiftedMoments(const matrix::Vector3f &center, double shifted[NUM_MOMENTS]) const;
+
+	bool solveSphere();
+	bool solveEllipsoid();
+
+	double _moments[NUM_MOMENTS] {};
+	matrix::Vector3f _origin{};
+	unsigned _sample_count{0};
+
+	sphere_params _params{};
+	matrix::Matrix3f _offset_covariance_unscaled{}; // offset block of the sphere fit inverse normal matrix
+	float _sphere_residual_variance{0.f};
+	float _ellipsoid_residual_variance{0.f};
+	float _offset_std{INFINITY};
+	float _coverage{0.f};
+	bool _valid{false};
+	bool _ellipsoid_valid{false};
+};
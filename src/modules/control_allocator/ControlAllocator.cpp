@@ -43,6 +43,7 @@
 
 #include <drivers/drv_hrt.h>
 #include <circuit_breaker/circuit_breaker.h>
+#include <lib/mixer_module/output_continuation.hpp>
 #include <mathlib/math/Limits.hpp>
 #include <mathlib/math/Functions.hpp>
 
@@ -712,6 +713,9 @@ ControlAllocator::publish_actuator_controls()
 
 		_actuator_servos_pub.publish(actuator_servos);
 	}
+
+	// let output modules on this work queue write the new setpoints right away (MIX_OUT_CONT)
+	output_continuation::run();
 }
 
 void
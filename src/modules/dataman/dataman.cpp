@@ -774,6 +774,34 @@ task_main(int argc, char *argv[])
 
 					break;
 
+				case DM_READ_BATCH: {
+						const uint32_t count = request.count < DM_READ_BATCH_MAX_ITEMS ? request.count : DM_READ_BATCH_MAX_ITEMS;
+
+						if (count == 0) {
+							// nothing to read, answer the request with an explicit empty result
+							response.status = dataman_response_s::STATUS_FAILURE_NO_DATA;
+							break;
+						}
+
+						// one response with its own status per index, all but the last one are published here
+						for (uint32_t i = 0; i < count; ++i) {
+							g_func_counts[DM_READ_BATCH]++;
+							perf_begin(_dm_read_perf);
+							result = g_dm_ops->read(static_cast<dm_item_t>(request.item), request.index + i,
+										&(response.data), request.data_length);
+							perf_end(_dm_read_perf);
+
+							response.index = request.index + i;
+							response.status = (result >= 0) ? dataman_response_s::STATUS_SUCCESS : dataman_response_s::STATUS_FAILURE_READ_FAILED;
+
+							if (i + 1 < count) {
+								response.timestamp = hrt_absolute_time();
+								dataman_response_pub.publish(response);
+							}
+						}
+					}
+					break;
+
 				case DM_CLEAR:
 
 					g_func_counts[DM_CLEAR]++;
@@ -851,6 +879,7 @@ status()
 	/* display usage statistics */
 	PX4_INFO("Writes   %u", g_func_counts[DM_WRITE]);
 	PX4_INFO("Reads    %u", g_func_counts[DM_READ]);
+	PX4_INFO("Batch reads %u", g_func_counts[DM_READ_BATCH]);
 	PX4_INFO("Clears   %u", g_func_counts[DM_CLEAR]);
 
 	perf_print_counter(_dm_read_perf);
@@ -997,3 +1026,5 @@ static_assert(sizeof(dataman_response_s::data) >= MISSION_ITEM_SIZE, "mission_it
 static_assert(sizeof(dataman_response_s::data) >= MISSION_SIZE, "mission_s can't fit in the response data");
 static_assert(sizeof(dataman_response_s::data) >= DATAMAN_COMPAT_SIZE, "dataman_compat_s can't fit in the response data");
 static_assert(sizeof(dataman_response_s::data) >= sizeof(hrt_abstime), "hrt_abstime can't fit in the response data");
+static_assert(dataman_response_s::ORB_QUEUE_LENGTH >= 2 * DM_READ_BATCH_MAX_ITEMS,
+	      "dataman_response queue too short for batched reads");
@@ -63,9 +63,13 @@ typedef enum {
 	DM_WRITE,			///< Write index for given item
 	DM_READ,			///< Read index for given item
 	DM_CLEAR,			///< Clear all index for given item
+	DM_READ_BATCH,		///< Read consecutive indices for given item, answered with one response per index
 	DM_NUMBER_OF_FUNCS
 } dm_function_t;
 
+/** Maximum number of indices read with a single DM_READ_BATCH request */
+constexpr uint32_t DM_READ_BATCH_MAX_ITEMS = 4;
+
 /** The maximum number of instances for each item type */
 #if defined(MEMORY_CONSTRAINED_SYSTEM)
 enum {
@@ -96,6 +96,14 @@ public:
 			head_new = (_head + 1) % _size;
 		}
 
+		// samples pushed in time order can be searched with a bisection
+		if (_first_write) {
+			_time_ordered = true;
+
+		} else if (sample.time_us < _buffer[_head].time_us) {
+			_time_ordered = false;
+		}
+
 		_buffer[head_new] = sample;
 		_head = head_new;
 
@@ -119,38 +127,28 @@ public:
 
 	bool pop_first_older_than(const uint64_t &timestamp, data_type *sample)
 	{
-		// start looking from newest observation data
-		for (uint8_t i = 0; i < _size; i++) {
-			int index = (_head - i);
-			index = index < 0 ? _size + index : index;
-
-			if (timestamp >= _buffer[index].time_us && timestamp < _buffer[index].time_us + (uint64_t)1e5) {
-				*sample = _buffer[index];
+		const int index = _time_ordered ? find_first_older_than(timestamp) : scan_first_older_than(timestamp);
 
-				// Now we can set the tail to the item which
-				// comes after the one we removed since we don't
-				// want to have any older data in the buffer
-				if (index == _head) {
-					_tail = _head;
-					_first_write = true;
-
-				} else {
-					_tail = (index + 1) % _size;
-				}
+		if (index < 0) {
+			return false;
+		}
 
-				_buffer[index].time_us = 0;
+		*sample = _buffer[index];
 
-				return true;
-			}
+		// Now we can set the tail to the item which
+		// comes after the one we removed since we don't
+		// want to have any older data in the buffer
+		if (index == _head) {
+			_tail = _head;
+			_first_write = true;
 
-			if (index == _tail) {
-				// we have reached the tail and haven't got a
-				// match
-				return false;
-			}
+		} else {
+			_tail = (index + 1) % _size;
 		}
 
-		return false;
+		_buffer[index].time_us = 0;
+
+		return true;
 	}
 
 	int get_used_size() const { return sizeof(*this) + sizeof(data_type) * entries(); }
@@ -179,10 +177,75 @@ public:
 			_head = 0;
 			_tail = 0;
 			_first_write = true;
+			_time_ordered = true;
 		}
 	}
 
 private:
+	static bool is_first_older_than(const uint64_t &timestamp, const uint64_t &time_us)
+	{
+		return (timestamp >= time_us) && (timestamp < time_us + (uint64_t)1e5);
+	}
+
+	// number of samples from the tail to the head (inclusive)
+	uint8_t span() const { return (_head >= _tail) ? (_head - _tail + 1) : (_size - _tail + _head + 1); }
+
+	// buffer index of the n-th sample counted from the tail
+	uint8_t index_from_oldest(uint8_t n) const
+	{
+		const int index = _tail + n;
+		return (index >= _size) ? (index - _size) : index;
+	}
+
+	// O(log n) lookup, only valid while the samples from tail to head are sorted by time
+	int find_first_older_than(const uint64_t &timestamp) const
+	{
+		// bisect for the number of samples not newer than the timestamp
+		uint8_t lower = 0;
+		uint8_t upper = span();
+
+		while (lower < upper) {
+			const uint8_t middle = lower + (upper - lower) / 2;
+
+			if (_buffer[index_from_oldest(middle)].time_us <= timestamp) {
+				lower = middle + 1;
+
+			} else {
+				upper = middle;
+			}
+		}
+
+		if (lower == 0) {
+			return -1;
+		}
+
+		// all older samples are further away from the timestamp than the newest candidate
+		const uint8_t index = index_from_oldest(lower - 1);
+
+		return is_first_older_than(timestamp, _buffer[index].time_us) ? index : -1;
+	}
+
+	// O(n) lookup starting from the newest sample
+	int scan_first_older_than(const uint64_t &timestamp) const
+	{
+		for (uint8_t i = 0; i < _size; i++) {
+			int index = (_head - i);
+			index = index < 0 ? _size + index : index;
+
+			if (is_first_older_than(timestamp, _buffer[index].time_us)) {
+				return index;
+			}
+
+			if (index == _tail) {
+				// we have reached the tail and haven't got a
+				// match
+				return -1;
+			}
+		}
+
+		return -1;
+	}
+
 	data_type *_buffer{nullptr};
 
 	uint8_t _head{0};
@@ -190,6 +253,7 @@ private:
 	uint8_t _size{0};
 
 	bool _first_write{true};
+	bool _time_ordered{true};
 };
 
 #endif // !EKF_RINGBUFFER_H
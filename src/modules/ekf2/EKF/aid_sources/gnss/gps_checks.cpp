@@ -105,9 +105,10 @@ void Ekf::collect_gps(const gnssSample &gps)
 			const double lon = gps.lon;
 
 			// set the magnetic field data returned by the geo library using the current GPS position
-			const float mag_declination_gps = get_mag_declination_radians(lat, lon);
-			const float mag_inclination_gps = get_mag_inclination_radians(lat, lon);
-			const float mag_strength_gps = get_mag_strength_gauss(lat, lon);
+			const MagneticField mag_field_gps = _wmm_tile.lookup(lat, lon);
+			const float mag_declination_gps = mag_field_gps.declination;
+			const float mag_inclination_gps = mag_field_gps.inclination;
+			const float mag_strength_gps = mag_field_gps.strength;
 
 			if (PX4_ISFINITE(mag_declination_gps) && PX4_ISFINITE(mag_inclination_gps) && PX4_ISFINITE(mag_strength_gps)) {
 
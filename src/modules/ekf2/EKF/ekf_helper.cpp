@@ -96,14 +96,13 @@ bool Ekf::setEkfGlobalOrigin(const double latitude, const double longitude, cons
 		_gps_alt_ref = altitude;
 
 #if defined(CONFIG_EKF2_MAGNETOMETER)
-		const float mag_declination_gps = get_mag_declination_radians(latitude, longitude);
-		const float mag_inclination_gps = get_mag_inclination_radians(latitude, longitude);
-		const float mag_strength_gps = get_mag_strength_gauss(latitude, longitude);
-
-		if (PX4_ISFINITE(mag_declination_gps) && PX4_ISFINITE(mag_inclination_gps) && PX4_ISFINITE(mag_strength_gps)) {
-			_mag_declination_gps = mag_declination_gps;
-			_mag_inclination_gps = mag_inclination_gps;
-			_mag_strength_gps = mag_strength_gps;
+		const MagneticField mag_field_gps = _wmm_tile.lookup(latitude, longitude);
+
+		if (PX4_ISFINITE(mag_field_gps.declination) && PX4_ISFINITE(mag_field_gps.inclination)
+		    && PX4_ISFINITE(mag_field_gps.strength)) {
+			_mag_declination_gps = mag_field_gps.declination;
+			_mag_inclination_gps = mag_field_gps.inclination;
+			_mag_strength_gps = mag_field_gps.strength;
 
 			_wmm_gps_time_last_set = _time_delayed_us;
 		}
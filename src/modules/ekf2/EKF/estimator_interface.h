@@ -71,6 +71,10 @@
 # include "aid_sources/range_finder/sensor_range_finder.hpp"
 #endif // CONFIG_EKF2_RANGE_FINDER
 
+#if defined(CONFIG_EKF2_MAGNETOMETER)
+# include <lib/world_magnetic_model/geo_mag_declination.h>
+#endif // CONFIG_EKF2_MAGNETOMETER
+
 #include <lib/atmosphere/atmosphere.h>
 #include <matrix/math.hpp>
 #include <mathlib/mathlib.h>
@@ -462,6 +466,8 @@ protected:
 	float _mag_inclination_gps{NAN};	  // magnetic inclination returned by the geo library using the last valid GPS position (rad)
 	float _mag_strength_gps{NAN};	          // magnetic strength returned by the geo library using the last valid GPS position (T)
 
+	MagneticFieldTile _wmm_tile{};            // geo library lookup table cell around the last GPS position
+
 	float _mag_inclination{NAN};
 	float _mag_strength{NAN};
 #endif // CONFIG_EKF2_MAGNETOMETER
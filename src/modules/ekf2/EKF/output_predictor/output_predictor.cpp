@@ -51,13 +51,13 @@ void OutputPredictor::print_status()
 	       (double)q_att(0), (double)q_att(1), (double)q_att(2), (double)q_att(3),
 	       (double)euler.phi(), (double)euler.theta(), (double)euler.psi());
 
+	const outputSample output_newest = getOutputSample(_output_buffer.get_newest());
+
 	printf("[output predictor] velocity: [%.3f, %.3f, %.3f]\n",
-	       (double)_output_buffer.get_newest().vel(0), (double)_output_buffer.get_newest().vel(1),
-	       (double)_output_buffer.get_newest().vel(2));
+	       (double)output_newest.vel(0), (double)output_newest.vel(1), (double)output_newest.vel(2));
 
 	printf("[output predictor] position: [%.3f, %.3f, %.3f]\n",
-	       (double)_output_buffer.get_newest().pos(0), (double)_output_buffer.get_newest().pos(1),
-	       (double)_output_buffer.get_newest().pos(2));
+	       (double)output_newest.pos(0), (double)output_newest.pos(1), (double)output_newest.pos(2));
 
 	printf("[output predictor] tracking error, angular: %.6f rad, velocity: %.4f m/s, position: %.4f m\n",
 	       (double)_output_tracking_error(0), (double)_output_tracking_error(1), (double)_output_tracking_error(2));
@@ -71,6 +71,8 @@ void OutputPredictor::print_status()
 
 void OutputPredictor::alignOutputFilter(const Quatf &quat_state, const Vector3f &vel_state, const Vector3f &pos_state)
 {
+	foldOutputBufferOffsets();
+
 	const outputSample &output_delayed = _output_buffer.get_oldest();
 
 	// calculate the quaternion rotation delta from the EKF to output observer states at the EKF fusion time horizon
@@ -115,6 +117,10 @@ void OutputPredictor::reset()
 
 	_output_tracking_error.setZero();
 
+	_output_buffer_vel_offset.setZero();
+	_output_buffer_pos_offset.setZero();
+	_output_buffer_offset_count = 0;
+
 	for (uint8_t index = 0; index < _output_buffer.get_length(); index++) {
 		_output_buffer[index] = {};
 	}
@@ -138,17 +144,16 @@ void OutputPredictor::resetQuaternion(const Quatf &quat_change)
 
 void OutputPredictor::resetHorizontalVelocityTo(const Vector2f &delta_horz_vel)
 {
-	for (uint8_t index = 0; index < _output_buffer.get_length(); index++) {
-		_output_buffer[index].vel.xy() += delta_horz_vel;
-	}
+	_output_buffer_vel_offset.xy() += delta_horz_vel;
 
 	_output_new.vel.xy() += delta_horz_vel;
 }
 
 void OutputPredictor::resetVerticalVelocityTo(float delta_vert_vel)
 {
-	for (uint8_t index = 0; index < _output_buffer.get_length(); index++) {
-		_output_buffer[index].vel(2) += delta_vert_vel;
+	_output_buffer_vel_offset(2) += delta_vert_vel;
+
+	for (uint8_t index = 0; index < _output_vert_buffer.get_length(); index++) {
 		_output_vert_buffer[index].vert_vel += delta_vert_vel;
 	}
 
@@ -158,9 +163,7 @@ void OutputPredictor::resetVerticalVelocityTo(float delta_vert_vel)
 
 void OutputPredictor::resetHorizontalPositionTo(const Vector2f &delta_horz_pos)
 {
-	for (uint8_t index = 0; index < _output_buffer.get_length(); index++) {
-		_output_buffer[index].pos.xy() += delta_horz_pos;
-	}
+	_output_buffer_pos_offset.xy() += delta_horz_pos;
 
 	_output_new.pos.xy() += delta_horz_pos;
 }
@@ -172,8 +175,9 @@ void OutputPredictor::resetVerticalPositionTo(const float new_vert_pos, const fl
 	_output_new.pos(2) += vert_pos_change;
 
 	// add the reset amount to the output observer buffered data
-	for (uint8_t i = 0; i < _output_buffer.get_length(); i++) {
-		_output_buffer[i].pos(2) += vert_pos_change;
+	_output_buffer_pos_offset(2) += vert_pos_change;
+
+	for (uint8_t i = 0; i < _output_vert_buffer.get_length(); i++) {
 		_output_vert_buffer[i].vert_vel_integ += vert_pos_change;
 	}
 
@@ -276,14 +280,18 @@ void OutputPredictor::correctOutputStates(const uint64_t time_delayed_us,
 	_accel_bias = accel_bias;
 
 	// store the INS states in a ring buffer with the same length and time coordinates as the IMU data buffer
-	_output_buffer.push(_output_new);
+	// the buffered velocity and position are relative to the pending output buffer offsets
+	outputSample output_buffered{_output_new};
+	output_buffered.vel -= _output_buffer_vel_offset;
+	output_buffered.pos -= _output_buffer_pos_offset;
+	_output_buffer.push(output_buffered);
 	_output_vert_buffer.push(_output_vert_new);
 
 	// get the oldest INS state data from the ring buffer
 	// this data will be at the EKF fusion time horizon
 	// TODO: there is no guarantee that data is at delayed fusion horizon
 	//       Shouldnt we use pop_first_older_than?
-	const outputSample &output_delayed = _output_buffer.get_oldest();
+	const outputSample output_delayed = getOutputSample(_output_buffer.get_oldest());
 	const outputVert &output_vert_delayed = _output_vert_buffer.get_oldest();
 
 	// calculate the quaternion delta between the INS and EKF quaternions at the EKF fusion time horizon
@@ -352,23 +360,22 @@ void OutputPredictor::applyCorrectionToVerticalOutputBuffer(float vert_vel_corre
 
 	const uint8_t size = _output_vert_buffer.get_length();
 
+	// correct the velocity of the oldest state
+	_output_vert_buffer[index].vert_vel += vert_vel_correction;
+
 	for (uint8_t counter = 0; counter < (size - 1); counter++) {
-		const uint8_t index_next = (index + 1) % size;
-		outputVert &current_state = _output_vert_buffer[index];
+		const uint8_t index_next = (index < size - 1) ? (index + 1) : 0;
+		const outputVert &current_state = _output_vert_buffer[index];
 		outputVert &next_state = _output_vert_buffer[index_next];
 
 		// correct the velocity
-		if (counter == 0) {
-			current_state.vert_vel += vert_vel_correction;
-		}
-
 		next_state.vert_vel += vert_vel_correction;
 
 		// position is propagated forward using the corrected velocity and a trapezoidal integrator
 		next_state.vert_vel_integ = current_state.vert_vel_integ + (current_state.vert_vel + next_state.vert_vel) * 0.5f * next_state.dt;
 
 		// advance the index
-		index = (index + 1) % size;
+		index = index_next;
 	}
 
 	// update output state to corrected values
@@ -380,15 +387,28 @@ void OutputPredictor::applyCorrectionToVerticalOutputBuffer(float vert_vel_corre
 
 void OutputPredictor::applyCorrectionToOutputBuffer(const Vector3f &vel_correction, const Vector3f &pos_correction)
 {
-	// loop through the output filter state history and apply the corrections to the velocity and position states
-	for (uint8_t index = 0; index < _output_buffer.get_length(); index++) {
-		// a constant velocity correction is applied
-		_output_buffer[index].vel += vel_correction;
+	// a constant velocity and position correction is applied to the whole output filter state history,
+	// accumulate it and only add it to the buffered states once per buffer cycle
+	_output_buffer_vel_offset += vel_correction;
+	_output_buffer_pos_offset += pos_correction;
 
-		// a constant position correction is applied
-		_output_buffer[index].pos += pos_correction;
+	if (++_output_buffer_offset_count >= _output_buffer.get_length()) {
+		foldOutputBufferOffsets();
 	}
 
 	// update output state to corrected values
-	_output_new = _output_buffer.get_newest();
+	_output_new = getOutputSample(_output_buffer.get_newest());
+}
+
+void OutputPredictor::foldOutputBufferOffsets()
+{
+	// keep the offsets small relative to the buffered states to preserve their precision
+	for (uint8_t index = 0; index < _output_buffer.get_length(); index++) {
+		_output_buffer[index].vel += _output_buffer_vel_offset;
+		_output_buffer[index].pos += _output_buffer_pos_offset;
+	}
+
+	_output_buffer_vel_offset.setZero();
+	_output_buffer_pos_offset.setZero();
+	_output_buffer_offset_count = 0;
 }
@@ -158,9 +158,27 @@ private:
 		float    dt{0.f};             ///< delta time (sec)
 	};
 
+	// output buffer sample with the pending velocity and position offsets applied
+	outputSample getOutputSample(const outputSample &buffered) const
+	{
+		outputSample output{buffered};
+		output.vel += _output_buffer_vel_offset;
+		output.pos += _output_buffer_pos_offset;
+		return output;
+	}
+
+	// add the pending velocity and position offsets to every sample of the output buffer
+	void foldOutputBufferOffsets();
+
 	RingBuffer<outputSample> _output_buffer{12};
 	RingBuffer<outputVert> _output_vert_buffer{12};
 
+	// Constant velocity and position corrections are accumulated here instead of being added to every
+	// output buffer sample, the buffered vel and pos are relative to these offsets.
+	matrix::Vector3f _output_buffer_vel_offset{};
+	matrix::Vector3f _output_buffer_pos_offset{};
+	uint8_t _output_buffer_offset_count{0}; ///< number of corrections accumulated since the last fold
+
 	matrix::Vector3f _accel_bias{};
 	matrix::Vector3f _gyro_bias{};
 
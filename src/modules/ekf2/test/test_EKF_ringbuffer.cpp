@@ -1,6 +1,6 @@
 /****************************************************************************
  *
- *   Copyright (c) 2019-2023 PX4 Development Team. All rights reserved.
+ *   Copyright (c) 2019-2024 PX4 Development Team. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -32,6 +32,7 @@
  ****************************************************************************/
 
 #include <gtest/gtest.h>
+#include <deque>
 #include <math.h>
 #include "EKF/ekf.h"
 
@@ -158,3 +159,104 @@ TEST_F(EkfRingBufferTest, reallocateBuffer)
 	EXPECT_EQ(3, _buffer->get_length());
 
 }
+
+// reference implementation of pop_first_older_than() on a plain list of samples, oldest first
+static bool popFirstOlderThanReference(std::deque<sample> &samples, uint64_t timestamp, sample *pop)
+{
+	for (int i = samples.size() - 1; i >= 0; i--) {
+		if (timestamp >= samples[i].time_us && timestamp < samples[i].time_us + (uint64_t)1e5) {
+			*pop = samples[i];
+			samples.erase(samples.begin(), samples.begin() + i + 1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+TEST_F(EkfRingBufferTest, popSampleMatchesReference)
+{
+	// GIVEN: a buffer receiving samples at irregular intervals and a reference list
+	static constexpr uint8_t kLength = 50;
+	ASSERT_EQ(true, _buffer->allocate(kLength));
+	std::deque<sample> reference;
+
+	srand(1);
+	uint64_t time_us = 1000000;
+
+	for (int i = 0; i < 20000; i++) {
+		sample s{};
+		time_us += 1000 + rand() % 9000;
+		s.time_us = time_us;
+		s.data[0] = (float)i;
+
+		// occasionally push an older sample to fall back to the linear search
+		if (i > 10000 && (rand() % 500) == 0) {
+			s.time_us -= 40000;
+		}
+
+		_buffer->push(s);
+		reference.push_back(s);
+
+		if (reference.size() > kLength) {
+			reference.pop_front();
+		}
+
+		// WHEN: popping samples around the delayed time horizon
+		const uint64_t timestamp = time_us - (rand() % 250000);
+		sample pop{};
+		sample pop_reference{};
+		const bool found = _buffer->pop_first_older_than(timestamp, &pop);
+		const bool found_reference = popFirstOlderThanReference(reference, timestamp, &pop_reference);
+
+		// THEN: the same sample as the newest-first search is returned
+		ASSERT_EQ(found_reference, found) << "sample " << i;
+
+		if (found) {
+			EXPECT_EQ(pop_reference.time_us, pop.time_us);
+			EXPECT_EQ(pop_reference.data[0], pop.data[0]);
+		}
+	}
+}
+
+TEST_F(EkfRingBufferTest, popSampleLongBuffer)
+{
+	// GIVEN: long buffers as used with a large EKF2_DELAY_MAX, one of them with out of order data
+	static constexpr uint8_t kLength = 200;
+	static constexpr int kSamples = 2000;
+	RingBuffer<sample> buffer_sorted(kLength);
+	RingBuffer<sample> buffer_unsorted(kLength);
+
+	sample s{};
+	s.time_us = 2000;
+	buffer_unsorted.push(s);
+	s.time_us = 1000;
+	buffer_unsorted.push(s);
+
+	uint64_t time_us = 1000000;
+
+	for (int i = 0; i < kLength; i++) {
+		time_us += 500;
+		s.time_us = time_us;
+		buffer_sorted.push(s);
+		buffer_unsorted.push(s);
+	}
+
+	// WHEN: pushing a sample and popping the one at the delayed time horizon
+	RingBuffer<sample> *buffers[2] {&buffer_sorted, &buffer_unsorted};
+
+	for (int b = 0; b < 2; b++) {
+		uint64_t time_push_us = time_us;
+
+		for (int i = 0; i < kSamples; i++) {
+			time_push_us += 500;
+			s.time_us = time_push_us;
+			buffers[b]->push(s);
+
+			// THEN: the bisection and the linear search both return the sample at the horizon
+			sample pop{};
+			ASSERT_TRUE(buffers[b]->pop_first_older_than(time_push_us - 90000, &pop)) << "buffer " << b << " sample " << i;
+			EXPECT_EQ(pop.time_us, time_push_us - 90000);
+		}
+	}
+}
@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Standalone test of the EKF-GSF yaw estimator model bank
+ */
+
+#include <gtest/gtest.h>
+
+#include "EKF/yaw_estimator/EKFGSF_yaw.h"
+#include <lib/geo/geo.h>
+
+using matrix::Dcmf;
+using matrix::Eulerf;
+using matrix::Vector2f;
+using matrix::Vector3f;
+
+class EKFGSFYawTest : public ::testing::Test
+{
+public:
+	// Run the estimator on a level vehicle with a constant heading manoeuvring in the horizontal plane
+	void run(EKFGSF_yaw &gsf, float yaw, int imu_samples)
+	{
+		const Dcmf R_to_earth{Eulerf(0.f, 0.f, yaw)};
+		const Vector3f gravity{0.f, 0.f, CONSTANTS_ONE_G};
+		Vector2f vel_NE{};
+		float time_s = 0.f;
+
+		for (int i = 0; i < imu_samples; i++) {
+			time_s += _dt;
+
+			const Vector3f accel_NED{2.f * cosf(2.f * time_s), 2.f * sinf(1.4f * time_s), 0.f};
+			const Vector3f delta_vel = R_to_earth.transpose() * (accel_NED - gravity) * _dt;
+			gsf.predict(Vector3f(), _dt, delta_vel, _dt, true);
+
+			vel_NE += Vector2f(accel_NED(0), accel_NED(1)) * _dt;
+
+			// 5 Hz velocity observations
+			if (i % 50 == 0) {
+				gsf.fuseVelocity(vel_NE, 0.3f, true);
+			}
+		}
+	}
+
+	static constexpr float _dt{0.004f};
+};
+
+TEST_F(EKFGSFYawTest, convergesToTrueYaw)
+{
+	for (float yaw : {-2.5f, -1.f, 0.3f, 1.2f, 3.f}) {
+		EKFGSF_yaw gsf;
+		run(gsf, yaw, 10000);
+
+		EXPECT_TRUE(gsf.isActive());
+		EXPECT_NEAR(matrix::wrap_pi(gsf.getYaw() - yaw), 0.f, 0.1f) << "yaw " << yaw;
+		EXPECT_LT(sqrtf(gsf.getYawVar()), 0.05f);
+
+		float yaw_composite;
+		float yaw_composite_variance;
+		float yaw_models[N_MODELS_EKFGSF];
+		float innov_VN[N_MODELS_EKFGSF];
+		float innov_VE[N_MODELS_EKFGSF];
+		float weight[N_MODELS_EKFGSF];
+		EXPECT_TRUE(gsf.getLogData(&yaw_composite, &yaw_composite_variance, yaw_models, innov_VN, innov_VE, weight));
+
+		float weight_sum = 0.f;
+
+		for (unsigned model_index = 0; model_index < N_MODELS_EKFGSF; model_index++) {
+			weight_sum += weight[model_index];
+		}
+
+		EXPECT_NEAR(weight_sum, 1.f, 1e-4f);
+	}
+}
+
+TEST_F(EKFGSFYawTest, resetRestartsModelBank)
+{
+	EKFGSF_yaw gsf;
+	run(gsf, 1.f, 5000);
+	EXPECT_TRUE(gsf.isActive());
+
+	gsf.reset();
+	EXPECT_FALSE(gsf.isActive());
+
+	// the model bank starts again from evenly spaced yaw hypotheses
+	run(gsf, -2.f, 10000);
+	EXPECT_NEAR(matrix::wrap_pi(gsf.getYaw() + 2.f), 0.f, 0.1f);
+}
@@ -0,0 +1,174 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "log_index.h"
+
+#include <string.h>
+
+namespace px4
+{
+namespace logger
+{
+
+LogIndex::~LogIndex()
+{
+	delete[] _entries;
+	delete[] _next_sample;
+}
+
+bool LogIndex::init(int max_entries)
+{
+	if (max_entries == _max_entries) {
+		return true;
+	}
+
+	delete[] _entries;
+	delete[] _next_sample;
+	_entries = nullptr;
+	_next_sample = nullptr;
+	_max_entries = 0;
+	_active = false;
+
+	if (max_entries <= 0) {
+		return true;
+	}
+
+	_entries = new ulog_index_entry_s[max_entries];
+	_next_sample = new hrt_abstime[NUM_MSG_IDS];
+
+	if (!_entries || !_next_sample) {
+		delete[] _entries;
+		delete[] _next_sample;
+		_entries = nullptr;
+		_next_sample = nullptr;
+		return false;
+	}
+
+	_max_entries = max_entries;
+	return true;
+}
+
+void LogIndex::start()
+{
+	if (_max_entries == 0) {
+		return;
+	}
+
+	_num_entries = 0;
+	_sample_interval = INITIAL_SAMPLE_INTERVAL;
+	memset(_next_sample, 0, NUM_MSG_IDS * sizeof(_next_sample[0]));
+	_overflow = false;
+	_active = true;
+}
+
+void LogIndex::add(const uint8_t *msg, uint64_t offset)
+{
+	ulog_index_entry_s entry;
+	entry.offset = offset;
+	entry.msg_type = msg[2];
+
+	switch (entry.msg_type) {
+	case (int)ULogMessageType::DATA:
+		entry.msg_id = msg[3] | (msg[4] << 8);
+		memcpy(&entry.timestamp, msg + sizeof(ulog_message_data_s), sizeof(entry.timestamp)); // timestamp is the first field
+
+		if (entry.msg_id >= NUM_MSG_IDS || entry.timestamp < _next_sample[entry.msg_id]) {
+			return;
+		}
+
+		_next_sample[entry.msg_id] = entry.timestamp + _sample_interval;
+		break;
+
+	case (int)ULogMessageType::ADD_LOGGED_MSG:
+		entry.msg_id = msg[4] | (msg[5] << 8);
+		entry.timestamp = hrt_absolute_time();
+		break;
+
+	case (int)ULogMessageType::PARAMETER:
+		entry.msg_id = 0;
+		entry.timestamp = hrt_absolute_time();
+		break;
+
+	default:
+		return;
+	}
+
+	if (_num_entries == _max_entries) {
+		compact();
+
+		if (_num_entries == _max_entries) {
+			// not even the non-data messages fit anymore: an incomplete index is useless
+			_overflow = true;
+			_active = false;
+			return;
+		}
+
+		if (entry.msg_type == (int)ULogMessageType::DATA) {
+			if (entry.timestamp < _next_sample[entry.msg_id]) {
+				return;
+			}
+
+			_next_sample[entry.msg_id] = entry.timestamp + _sample_interval;
+		}
+	}
+
+	_entries[_num_entries++] = entry;
+}
+
+void LogIndex::compact()
+{
+	_sample_interval *= 2;
+	memset(_next_sample, 0, NUM_MSG_IDS * sizeof(_next_sample[0]));
+
+	int num_kept = 0;
+
+	for (int i = 0; i < _num_entries; ++i) {
+		const ulog_index_entry_s &entry = _entries[i];
+
+		if (entry.msg_type == (int)ULogMessageType::DATA) {
+			if (entry.timestamp < _next_sample[entry.msg_id]) {
+				continue;
+			}
+
+			_next_sample[entry.msg_id] = entry.timestamp + _sample_interval;
+		}
+
+		_entries[num_kept++] = entry;
+	}
+
+	_num_entries = num_kept;
+}
+
+} //namespace logger
+} //namespace px4
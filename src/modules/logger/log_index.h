@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+
+#include <drivers/drv_hrt.h>
+
+#include "messages.h"
+
+using namespace time_literals;
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class LogIndex
+ * Collects the file offsets of the messages written to the full log, which the logger appends as index
+ * when it stops logging. All ADD_LOGGED_MSG and PARAMETER messages are indexed, DATA messages are sampled
+ * per topic. When the index is full, the sampling interval is doubled and the existing DATA entries are
+ * thinned out accordingly, so the memory is bounded for any log duration.
+ */
+class LogIndex
+{
+public:
+	LogIndex() = default;
+	~LogIndex();
+
+	/**
+	 * Allocate the index
+	 * @param max_entries maximum number of entries, 0 disables the index
+	 * @return false on allocation failure
+	 */
+	bool init(int max_entries);
+
+	/** start indexing a new log file */
+	void start();
+
+	void stop() { _active = false; }
+
+	bool active() const { return _active; }
+
+	/** true if all subscription and parameter messages were indexed */
+	bool complete() const { return !_overflow; }
+
+	/**
+	 * Add a message that was written to the log
+	 * @param msg ULog message, including the header
+	 * @param offset file offset of the message
+	 */
+	void add(const uint8_t *msg, uint64_t offset);
+
+	const ulog_index_entry_s *entries() const { return _entries; }
+	int num_entries() const { return _num_entries; }
+
+private:
+	static constexpr hrt_abstime INITIAL_SAMPLE_INTERVAL{100_ms};
+	static constexpr int NUM_MSG_IDS{256}; ///< the logger uses uint8_t msg ids
+
+	/** double the sampling interval and remove the DATA entries that do not match it anymore */
+	void compact();
+
+	ulog_index_entry_s *_entries{nullptr};
+	hrt_abstime *_next_sample{nullptr}; ///< next sample time for each msg_id
+	int _max_entries{0};
+	int _num_entries{0};
+	hrt_abstime _sample_interval{INITIAL_SAMPLE_INTERVAL};
+	bool _active{false};
+	bool _overflow{false};
+};
+
+} //namespace logger
+} //namespace px4
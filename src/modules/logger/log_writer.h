@@ -140,6 +140,18 @@ public:
 		return 0;
 	}
 
+	size_t get_file_offset(LogType type) const
+	{
+		if (_log_writer_file) { return _log_writer_file->get_file_offset(type); }
+
+		return 0;
+	}
+
+	void set_appended_data_offset_file(LogType type, size_t offset)
+	{
+		if (_log_writer_file) { _log_writer_file->set_appended_data_offset(type, offset); }
+	}
+
 	pthread_t thread_id_file() const
 	{
 		if (_log_writer_file) { return _log_writer_file->thread_id(); }
@@ -35,6 +35,7 @@
 #include "messages.h"
 
 #include <fcntl.h>
+#include <stddef.h>
 #include <string.h>
 #include <errno.h>
 
@@ -700,9 +701,28 @@ ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t s
 	return ret;
 }
 
+void LogWriterFile::LogFileBuffer::write_appended_data_offset()
+{
+	// the FLAG_BITS message directly follows the file header (see Logger::write_header()).
+	// Only the first appended offset is used here, so that the hardfault handler can still append crash logs.
+	const off_t flags_offset = sizeof(ulog_file_header_s) + offsetof(ulog_message_flag_bits_s, incompat_flags);
+	const off_t appended_offset = sizeof(ulog_file_header_s) + offsetof(ulog_message_flag_bits_s, appended_offsets);
+	const uint8_t incompat_flags0 = ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK;
+	const uint64_t offset = _appended_data_offset;
+
+	if (pwrite(_fd, &offset, sizeof(offset), appended_offset) != sizeof(offset) ||
+	    pwrite(_fd, &incompat_flags0, sizeof(incompat_flags0), flags_offset) != sizeof(incompat_flags0)) {
+		PX4_WARN("failed to mark appended data (%i)", errno);
+	}
+}
+
 void LogWriterFile::LogFileBuffer::close_file()
 {
 	if (_fd >= 0) {
+		if (_appended_data_offset > 0 && !_had_write_error.load()) {
+			write_appended_data_offset();
+		}
+
 		int res = close(_fd);
 
 		if (res) {
@@ -719,6 +739,7 @@ void LogWriterFile::LogFileBuffer::reset()
 	_head = 0;
 	_count = 0;
 	_fd = -1;
+	_appended_data_offset = 0;
 }
 
 }
@@ -113,6 +113,30 @@ public:
 		return _buffers[(int)type].buffer_size();
 	}
 
+	/**
+	 * file offset of the next message written to the buffer. Requires lock().
+	 */
+	size_t get_file_offset(LogType type) const
+	{
+		return _buffers[(int)type].file_offset();
+	}
+
+	/**
+	 * Mark the data from the given file offset on as appended data. The FLAG_BITS message in the file header
+	 * is updated when the file is closed. Requires lock().
+	 */
+	void set_appended_data_offset(LogType type, size_t offset)
+	{
+#if defined(PX4_CRYPTO)
+
+		if (_algorithm != CRYPTO_NONE) {
+			return; // the file header is encrypted
+		}
+
+#endif
+		_buffers[(int)type].set_appended_data_offset(offset);
+	}
+
 	size_t get_buffer_fill_count(LogType type) const
 	{
 		return _buffers[(int)type].count();
@@ -177,6 +201,11 @@ private:
 
 		void close_file();
 
+		/**
+		 * Set the appended data flag and offset in the FLAG_BITS message of the file header
+		 */
+		void write_appended_data_offset();
+
 		void reset();
 
 		size_t get_read_ptr(void **ptr, bool *is_part);
@@ -197,6 +226,8 @@ private:
 		void mark_read(size_t n) { _count -= n; _total_written += n; }
 
 		size_t total_written() const { return _total_written; }
+		size_t file_offset() const { return _total_written + _count; }
+		void set_appended_data_offset(size_t offset) { _appended_data_offset = offset; }
 		size_t buffer_size() const { return _buffer_size; }
 		size_t count() const { return _count; }
 
@@ -209,6 +240,7 @@ private:
 		size_t _head = 0; ///< next position to write to
 		size_t _count = 0; ///< number of bytes in _buffer to be written
 		size_t _total_written = 0;
+		size_t _appended_data_offset = 0; ///< if > 0, set in the FLAG_BITS message when closing the file
 		perf_counter_t _perf_write;
 		perf_counter_t _perf_fsync;
 	};
@@ -643,6 +643,10 @@ void Logger::run()
 		return;
 	}
 
+	if (!_log_index.init(_param_sdlog_index.get())) {
+		PX4_ERR("failed to alloc log index");
+	}
+
 	/* debug stats */
 	hrt_abstime	timer_start = 0;
 	uint32_t	total_bytes = 0;
@@ -1202,8 +1206,20 @@ bool Logger::write_message(LogType type, void *ptr, size_t size)
 {
 	Statistics &stats = _statistics[(int)type];
 
+	const bool add_to_index = type == LogType::Full && _log_index.active();
+	const size_t file_offset = add_to_index ? _writer.get_file_offset(LogType::Full) : 0;
+
 	if (_writer.write_message(type, ptr, size, stats.dropout_start) != -1) {
 
+		if (add_to_index) {
+			// the message is at the end, as a dropout message might have been written before it
+			const size_t file_offset_end = _writer.get_file_offset(LogType::Full);
+
+			if (file_offset_end >= file_offset + size) {
+				_log_index.add(static_cast<const uint8_t *>(ptr), file_offset_end - size);
+			}
+		}
+
 		if (stats.dropout_start) {
 			float dropout_duration = (float)(hrt_elapsed_time(&stats.dropout_start) / 1000) / 1.e3f;
 
@@ -1436,6 +1452,7 @@ void Logger::start_log_file(LogType type)
 			write_console_output();
 			write_events_file(LogType::Full);
 			write_excluded_optional_topics(type);
+			_log_index.start();
 		}
 
 		write_all_add_logged_msg(type);
@@ -1462,6 +1479,7 @@ void Logger::stop_log_file(LogType type)
 	if (type == LogType::Full) {
 		_writer.set_need_reliable_transfer(true);
 		write_perf_data(PrintLoadReason::Postflight);
+		write_log_index();
 		_writer.set_need_reliable_transfer(false);
 	}
 
@@ -2354,6 +2372,63 @@ void Logger::write_changed_parameters(LogType type)
 	_writer.notify();
 }
 
+void Logger::write_log_index()
+{
+	if (!_log_index.active()) {
+		if (!_log_index.complete()) {
+			PX4_WARN("log index overflow, increase SDLOG_INDEX");
+		}
+
+		return;
+	}
+
+	_log_index.stop();
+
+	_writer.lock();
+	_writer.select_write_backend(LogWriter::BackendFile);
+
+	const size_t index_offset = _writer.get_file_offset(LogType::Full);
+
+	ulog_message_info_multiple_s msg;
+	uint8_t *buffer = reinterpret_cast<uint8_t *>(&msg);
+	msg.msg_type = static_cast<uint8_t>(ULogMessageType::INFO_MULTIPLE);
+	msg.is_continued = false;
+
+	const int max_format_length = 16; // accounts for "uint8_t[x] "
+	const size_t max_write_length = (sizeof(msg.key_value_str) - strlen(ULOG_INDEX_KEY) - max_format_length)
+					/ sizeof(ulog_index_entry_s) * sizeof(ulog_index_entry_s);
+
+	const uint8_t *data = reinterpret_cast<const uint8_t *>(_log_index.entries());
+	size_t remaining = _log_index.num_entries() * sizeof(ulog_index_entry_s);
+	bool written = remaining > 0;
+
+	while (remaining > 0 && written) {
+		const size_t write_length = math::min(remaining, max_write_length);
+
+		/* construct format key (type and name) */
+		msg.key_len = snprintf(msg.key_value_str, sizeof(msg.key_value_str), "uint8_t[%i] %s", (int)write_length,
+				       ULOG_INDEX_KEY);
+		size_t msg_size = sizeof(msg) - sizeof(msg.key_value_str) + msg.key_len;
+		memcpy(&buffer[msg_size], data, write_length);
+		msg_size += write_length;
+		msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
+
+		written = write_message(LogType::Full, buffer, msg_size);
+
+		data += write_length;
+		remaining -= write_length;
+		msg.is_continued = true;
+	}
+
+	if (written) {
+		_writer.set_appended_data_offset_file(LogType::Full, index_offset);
+	}
+
+	_writer.unselect_write_backend();
+	_writer.unlock();
+	_writer.notify();
+}
+
 void Logger::write_events_file(LogType type)
 {
 	int fd = open(PX4_ROOTFSDIR "/etc/extras/all_events.json.xz", O_RDONLY);
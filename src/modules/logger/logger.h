@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include "log_index.h"
 #include "log_writer.h"
 #include "logged_topics.h"
 #include "messages.h"
@@ -276,6 +277,11 @@ private:
 	void write_parameter_defaults(LogType type);
 
 	void write_changed_parameters(LogType type);
+
+	/**
+	 * write the collected log index as appended data to the full log file
+	 */
+	void write_log_index();
 	void write_events_file(LogType type);
 
 	inline bool copy_if_updated(int sub_idx, void *buffer, bool try_to_subscribe);
@@ -364,6 +370,7 @@ private:
 	int						_num_excluded_optional_topic_ids{0};
 
 	LogWriter					_writer;
+	LogIndex					_log_index;
 	uint32_t					_log_interval{0};
 	float						_rate_factor{1.0f};
 	const orb_metadata				*_polling_topic_meta{nullptr}; ///< if non-null, poll on this topic instead of sleeping
@@ -397,7 +404,8 @@ private:
 		(ParamInt<px4::params::SDLOG_PROFILE>) _param_sdlog_profile,
 		(ParamInt<px4::params::SDLOG_MISSION>) _param_sdlog_mission,
 		(ParamBool<px4::params::SDLOG_BOOT_BAT>) _param_sdlog_boot_bat,
-		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid
+		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid,
+		(ParamInt<px4::params::SDLOG_INDEX>) _param_sdlog_index
 #if defined(PX4_CRYPTO)
 		, (ParamInt<px4::params::SDLOG_ALGORITHM>) _param_sdlog_crypto_algorithm,
 		(ParamInt<px4::params::SDLOG_KEY>) _param_sdlog_crypto_key,
@@ -294,4 +294,21 @@ struct ulog_message_flag_bits_s {
 	uint64_t appended_offsets[3]; ///< file offset(s) for appended data if ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK is set
 };
 
+/**
+ * @brief Index Entry
+ *
+ * The logger can append an index to the log when it stops logging, as appended data (@see ulog_message_flag_bits_s).
+ * The index consists of INFO_MULTIPLE messages with the key "uint8_t[n] ulog_index", holding an array of these entries
+ * in file order: all ADD_LOGGED_MSG and PARAMETER messages of the data section, and the DATA messages of each topic
+ * sampled over time (including the first message of each topic).
+ */
+struct ulog_index_entry_s {
+	uint64_t timestamp; ///< timestamp of the DATA message, or time when the message was written [us]
+	uint64_t offset; ///< file offset of the message
+	uint16_t msg_id; ///< msg_id of DATA and ADD_LOGGED_MSG messages
+	uint8_t msg_type; ///< ULogMessageType of the message
+};
+
+#define ULOG_INDEX_KEY "ulog_index"
+
 #pragma pack(pop)
@@ -177,6 +177,24 @@ PARAM_DEFINE_INT32(SDLOG_DIRS_MAX, 0);
  */
 PARAM_DEFINE_INT32(SDLOG_UUID, 1);
 
+/**
+ * Log index size
+ *
+ * Maximum number of entries of the index that is appended to the log file when
+ * logging stops. It contains the file offsets of the topic data sampled over time,
+ * so that a time range of a topic can be read without parsing the whole log.
+ * The sampling interval is increased when the index is full, so any log duration
+ * is covered. Each entry requires 19 bytes of RAM while logging.
+ *
+ * Set to 0 to disable the index.
+ *
+ * @min 0
+ * @max 100000
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_INDEX, 0);
+
 /**
  * Logfile Encryption algorithm
  *
@@ -64,6 +64,9 @@ bool MavlinkMissionManager::_dataman_init = false;
 uint16_t MavlinkMissionManager::_count[3] = { 0, 0, 0 };
 uint32_t MavlinkMissionManager::_crc32[3] = { 0, 0, 0 };
 int32_t MavlinkMissionManager::_current_seq = 0;
+uint32_t MavlinkMissionManager::_changed_from_crc32 = 0;
+uint16_t MavlinkMissionManager::_changed_start = 0;
+uint16_t MavlinkMissionManager::_changed_end = 0;
 bool MavlinkMissionManager::_transfer_in_progress = false;
 constexpr uint16_t MavlinkMissionManager::MAX_COUNT[];
 
@@ -110,6 +113,9 @@ MavlinkMissionManager::init_offboard_mission(const mission_s &mission_state)
 	_current_seq = mission_state.current_seq;
 	_land_start_marker = mission_state.land_start_index;
 	_land_marker = mission_state.land_index;
+	_changed_from_crc32 = mission_state.changed_from_mission_id;
+	_changed_start = mission_state.changed_start_index;
+	_changed_end = mission_state.changed_end_index;
 }
 
 bool
@@ -174,6 +180,9 @@ MavlinkMissionManager::update_active_mission(dm_item_t mission_dataman_id, uint1
 	mission.safe_points_id = _crc32[MAV_MISSION_TYPE_RALLY];
 	mission.land_start_index = _land_start_marker;
 	mission.land_index = _land_marker;
+	mission.changed_from_mission_id = _changed_from_crc32;
+	mission.changed_start_index = _changed_start;
+	mission.changed_end_index = _changed_end;
 
 	if (write_to_dataman) {
 		bool success = _dataman_client.writeSync(DM_KEY_MISSION_STATE, 0, reinterpret_cast<uint8_t *>(&mission),
@@ -989,6 +998,8 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			_transfer_current_seq = -1;
 			_transfer_land_start_marker = -1;
 			_transfer_land_marker = -1;
+			_transfer_changed_start = wpc.count;
+			_transfer_changed_end = 0;
 
 		} else if (_state == MAVLINK_WPM_STATE_GETLIST) {
 			_time_last_recv = hrt_absolute_time();
@@ -1022,6 +1033,23 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 	}
 }
 
+bool
+MavlinkMissionManager::mission_item_changed(uint16_t seq, const mission_item_s &mission_item)
+{
+	if (seq >= _count[MAV_MISSION_TYPE_MISSION]) {
+		return true;
+	}
+
+	mission_item_s active_item{};
+
+	if (!_dataman_client.readSync(_mission_dataman_id, seq, reinterpret_cast<uint8_t *>(&active_item),
+				      sizeof(mission_item_s))) {
+		return true;
+	}
+
+	return memcmp(&active_item, &mission_item, sizeof(mission_item_s)) != 0;
+}
+
 void
 MavlinkMissionManager::switch_to_idle_state()
 {
@@ -1166,6 +1194,12 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 						if (wp.current) {
 							_transfer_current_seq = wp.seq;
 						}
+
+						// the range of changed items lets the navigator only re-check those
+						if (mission_item_changed(wp.seq, mission_item)) {
+							_transfer_changed_start = math::min(_transfer_changed_start, wp.seq);
+							_transfer_changed_end = math::max(_transfer_changed_end, (uint16_t)(wp.seq + 1));
+						}
 					}
 				}
 			}
@@ -1253,6 +1287,9 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 
 				// Only need to update if the mission actually changed
 				if (_transfer_current_crc32 != _crc32[MAV_MISSION_TYPE_MISSION]) {
+					_changed_from_crc32 = _crc32[MAV_MISSION_TYPE_MISSION];
+					_changed_start = _transfer_changed_start;
+					_changed_end = _transfer_changed_end;
 					update_active_mission(_transfer_dataman_id, _transfer_count, _transfer_current_seq, _transfer_current_crc32);
 				}
 
@@ -1321,6 +1358,7 @@ MavlinkMissionManager::handle_mission_clear_all(const mavlink_message_t *msg)
 			case MAV_MISSION_TYPE_MISSION:
 				_land_start_marker = -1;
 				_land_marker = -1;
+				_changed_from_crc32 = 0;
 				update_active_mission(_mission_dataman_id == DM_KEY_WAYPOINTS_OFFBOARD_0 ? DM_KEY_WAYPOINTS_OFFBOARD_1 :
 						      DM_KEY_WAYPOINTS_OFFBOARD_0, 0, 0, 0);
 				break;
@@ -1338,6 +1376,7 @@ MavlinkMissionManager::handle_mission_clear_all(const mavlink_message_t *msg)
 			case MAV_MISSION_TYPE_ALL:
 				_land_start_marker = -1;
 				_land_marker = -1;
+				_changed_from_crc32 = 0;
 				update_active_mission(_mission_dataman_id == DM_KEY_WAYPOINTS_OFFBOARD_0 ? DM_KEY_WAYPOINTS_OFFBOARD_1 :
 						      DM_KEY_WAYPOINTS_OFFBOARD_0, 0, 0, 0);
 				ret = update_geofence_count(_fence_dataman_id == DM_KEY_FENCE_POINTS_0 ? DM_KEY_FENCE_POINTS_1 : DM_KEY_FENCE_POINTS_0,
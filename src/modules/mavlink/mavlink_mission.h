@@ -118,6 +118,9 @@ private:
 	static uint16_t		_count[3];				///< Count of items in (active) mission for each MAV_MISSION_TYPE
 	static uint32_t		_crc32[3];				///< Checksum of items in (active) mission for each MAV_MISSION_TYPE
 	static int32_t		_current_seq;				///< Current item sequence in active mission
+	static uint32_t		_changed_from_crc32;			///< Checksum of the mission the active mission was uploaded over (0 if unknown)
+	static uint16_t		_changed_start;				///< First item of the active mission that differs from that mission
+	static uint16_t		_changed_end;				///< One past the last item of the active mission that differs from that mission
 
 	int32_t			_last_reached{-1};			///< Last reached waypoint in active mission (-1 means nothing reached)
 
@@ -133,6 +136,8 @@ private:
 	uint8_t			_transfer_partner_compid{0};		///< Partner component ID for current transmission
 	int32_t 		_transfer_land_start_marker{-1}; 	///< index of land start mission item in current transmission (if unavailable, index of land mission item, -1 otherwise)
 	int32_t 		_transfer_land_marker{-1}; 		///< index of land mission item in current transmission (-1 if unavailable)
+	uint16_t		_transfer_changed_start{0};		///< First item of current transmission that differs from the active mission
+	uint16_t		_transfer_changed_end{0};		///< One past the last item of current transmission that differs from the active mission
 
 	static bool		_transfer_in_progress;			///< Global variable checking for current transmission
 
@@ -256,6 +261,14 @@ private:
 	int format_mavlink_mission_item(const struct mission_item_s *mission_item,
 					mavlink_mission_item_t *mavlink_mission_item);
 
+	/**
+	 * Check if a received mission item differs from the item at the same index of the active mission.
+	 *
+	 * @param seq		index of the mission item
+	 * @param mission_item	the received mission item
+	 */
+	bool mission_item_changed(uint16_t seq, const mission_item_s &mission_item);
+
 	/**
 	 * set _state to idle (and do necessary cleanup)
 	 */
@@ -32,6 +32,7 @@
  ****************************************************************************/
 
 #include "FeasibilityChecker.hpp"
+#include "ItemCheckCache.hpp"
 #include <systemlib/mavlink_log.h>
 #include <px4_platform_common/events.h>
 #include <drivers/drv_pwm_output.h>
@@ -39,35 +40,44 @@
 #include <lib/mathlib/mathlib.h>
 #include <lib/geo/geo.h>
 
+#include <string.h>
+
 FeasibilityChecker::FeasibilityChecker() :
 	ModuleParams(nullptr)
 {
 }
 
+bool FeasibilityChecker::State::operator==(const State &other) const
+{
+	// unset positions are NAN
+	auto same = [](double a, double b) { return (a == b) || (!PX4_ISFINITE(a) && !PX4_ISFINITE(b)); };
+
+	return mission_validity_failed == other.mission_validity_failed
+	       && takeoff_failed == other.takeoff_failed
+	       && land_pattern_validity_failed == other.land_pattern_validity_failed
+	       && distance_first_waypoint_failed == other.distance_first_waypoint_failed
+	       && distance_between_waypoints_failed == other.distance_between_waypoints_failed
+	       && fixed_wing_land_approach_failed == other.fixed_wing_land_approach_failed
+	       && takeoff_land_available_failed == other.takeoff_land_available_failed
+	       && items_fit_to_vehicle_type_failed == other.items_fit_to_vehicle_type_failed
+	       && found_item_with_position == other.found_item_with_position
+	       && has_vtol_takeoff == other.has_vtol_takeoff
+	       && has_takeoff == other.has_takeoff
+	       && landing_valid == other.landing_valid
+	       && do_land_start_index == other.do_land_start_index
+	       && landing_approach_index == other.landing_approach_index
+	       && memcmp(&mission_item_previous, &other.mission_item_previous, sizeof(mission_item_s)) == 0
+	       && first_waypoint_found == other.first_waypoint_found
+	       && same(first_waypoint_lat, other.first_waypoint_lat)
+	       && same(first_waypoint_lon, other.first_waypoint_lon)
+	       && same(last_lat, other.last_lat)
+	       && same(last_lon, other.last_lon)
+	       && last_cmd == other.last_cmd;
+}
+
 void FeasibilityChecker::reset()
 {
-	_mission_validity_failed = false;
-	_takeoff_failed = false;
-	_land_pattern_validity_failed = false;
-	_distance_first_waypoint_failed = false;
-	_distance_between_waypoints_failed = false;
-	_fixed_wing_land_approach_failed = false;
-	_takeoff_land_available_failed = false;
-
-	_found_item_with_position = false;
-	_has_vtol_takeoff = false;
-	_has_takeoff = false;
-
-	_landing_valid = false;
-	_do_land_start_index = -1;
-	_landing_approach_index = -1;
-	_mission_item_previous = {};
-
-	_first_waypoint_found = false;
-
-	_last_lat = (double)NAN;
-	_last_lon = (double)NAN;
-	_last_cmd = -1;
+	_state = {};
 }
 
 void FeasibilityChecker::updateData()
@@ -155,6 +165,29 @@ void FeasibilityChecker::updateData()
 	}
 }
 
+uint32_t FeasibilityChecker::updateContext()
+{
+	updateData();
+
+	// everything the checks use apart from the items, except the current position which is only used
+	// by the final checks
+	const double home_lat = _home_lat_lon(0);
+	const double home_lon = _home_lat_lon(1);
+
+	uint32_t context = ItemCheckCache::hash(&_param_fw_lnd_ang, sizeof(_param_fw_lnd_ang));
+	context = ItemCheckCache::hash(&_param_mis_dist_1wp, sizeof(_param_mis_dist_1wp), context);
+	context = ItemCheckCache::hash(&_param_nav_acc_rad, sizeof(_param_nav_acc_rad), context);
+	context = ItemCheckCache::hash(&_param_mis_takeoff_land_req, sizeof(_param_mis_takeoff_land_req), context);
+	context = ItemCheckCache::hash(&_is_landed, sizeof(_is_landed), context);
+	context = ItemCheckCache::hash(&_home_alt_msl, sizeof(_home_alt_msl), context);
+	context = ItemCheckCache::hash(&_has_vtol_approach, sizeof(_has_vtol_approach), context);
+	context = ItemCheckCache::hash(&home_lat, sizeof(home_lat), context);
+	context = ItemCheckCache::hash(&home_lon, sizeof(home_lon), context);
+	context = ItemCheckCache::hash(&_vehicle_type, sizeof(_vehicle_type), context);
+
+	return context;
+}
+
 bool FeasibilityChecker::processNextItem(mission_item_s &mission_item, const int current_index, const int total_count)
 {
 	if (current_index == 0) {
@@ -162,11 +195,11 @@ bool FeasibilityChecker::processNextItem(mission_item_s &mission_item, const int
 		updateData();
 	}
 
-	if (!_mission_validity_failed) {
-		_mission_validity_failed = !checkMissionItemValidity(mission_item, current_index);
+	if (!_state.mission_validity_failed) {
+		_state.mission_validity_failed = !checkMissionItemValidity(mission_item, current_index);
 	}
 
-	if (_mission_validity_failed) {
+	if (_state.mission_validity_failed) {
 		// if a mission item is not valid then abort the other checks
 		return false;
 	}
@@ -184,10 +217,11 @@ bool FeasibilityChecker::processNextItem(mission_item_s &mission_item, const int
 	}
 
 	if (current_index == total_count - 1) {
-		_takeoff_land_available_failed = !checkTakeoffLandAvailable();
+		_state.distance_first_waypoint_failed = !checkHorizontalDistanceToFirstWaypoint();
+		_state.takeoff_land_available_failed = !checkTakeoffLandAvailable();
 	}
 
-	_mission_item_previous = mission_item;
+	_state.mission_item_previous = mission_item;
 
 	return true;
 }
@@ -195,39 +229,42 @@ bool FeasibilityChecker::processNextItem(mission_item_s &mission_item, const int
 void FeasibilityChecker::doCommonChecks(mission_item_s &mission_item, const int current_index)
 {
 
-	if (!_distance_between_waypoints_failed) {
-		_distance_between_waypoints_failed = !checkDistancesBetweenWaypoints(mission_item);
+	if (!_state.distance_between_waypoints_failed) {
+		_state.distance_between_waypoints_failed = !checkDistancesBetweenWaypoints(mission_item);
 	}
 
-	if (!_distance_first_waypoint_failed) {
-		_distance_first_waypoint_failed = !checkHorizontalDistanceToFirstWaypoint(mission_item);
+	// the distance to the current position is checked at the last item
+	if (!_state.first_waypoint_found && MissionBlock::item_contains_position(mission_item)) {
+		_state.first_waypoint_found = true;
+		_state.first_waypoint_lat = mission_item.lat;
+		_state.first_waypoint_lon = mission_item.lon;
 	}
 
-	if (!_takeoff_failed) {
-		_takeoff_failed = !checkTakeoff(mission_item);
+	if (!_state.takeoff_failed) {
+		_state.takeoff_failed = !checkTakeoff(mission_item);
 	}
 
-	if (!_items_fit_to_vehicle_type_failed) {
-		_items_fit_to_vehicle_type_failed = !checkItemsFitToVehicleType(mission_item);
+	if (!_state.items_fit_to_vehicle_type_failed) {
+		_state.items_fit_to_vehicle_type_failed = !checkItemsFitToVehicleType(mission_item);
 	}
 }
 
 void FeasibilityChecker::doVtolChecks(mission_item_s &mission_item, const int current_index, const int last_index)
 {
-	if (!_land_pattern_validity_failed) {
-		_land_pattern_validity_failed = !checkLandPatternValidity(mission_item, current_index, last_index);
+	if (!_state.land_pattern_validity_failed) {
+		_state.land_pattern_validity_failed = !checkLandPatternValidity(mission_item, current_index, last_index);
 	}
 
 }
 
 void FeasibilityChecker::doFixedWingChecks(mission_item_s &mission_item, const int current_index, const int last_index)
 {
-	if (!_land_pattern_validity_failed) {
-		_land_pattern_validity_failed = !checkLandPatternValidity(mission_item, current_index, last_index);
+	if (!_state.land_pattern_validity_failed) {
+		_state.land_pattern_validity_failed = !checkLandPatternValidity(mission_item, current_index, last_index);
 	}
 
-	if (!_fixed_wing_land_approach_failed) {
-		_fixed_wing_land_approach_failed = !checkFixedWindLandApproach(mission_item, current_index);
+	if (!_state.fixed_wing_land_approach_failed) {
+		_state.fixed_wing_land_approach_failed = !checkFixedWindLandApproach(mission_item, current_index);
 	}
 
 }
@@ -235,7 +272,7 @@ void FeasibilityChecker::doFixedWingChecks(mission_item_s &mission_item, const i
 void FeasibilityChecker::doMulticopterChecks(mission_item_s &mission_item, const int current_index)
 {
 	// this flag is used for the checkTakeoffLandAvailable check at the very end
-	_landing_valid |= mission_item.nav_cmd == NAV_CMD_LAND;
+	_state.landing_valid |= mission_item.nav_cmd == NAV_CMD_LAND;
 }
 
 bool FeasibilityChecker::checkMissionItemValidity(mission_item_s &mission_item, const int current_index)
@@ -335,16 +372,16 @@ bool FeasibilityChecker::checkTakeoff(mission_item_s &mission_item)
 			return false;
 		}
 
-		if (!_has_vtol_takeoff) {
-			_has_vtol_takeoff = mission_item.nav_cmd == NAV_CMD_VTOL_TAKEOFF;
+		if (!_state.has_vtol_takeoff) {
+			_state.has_vtol_takeoff = mission_item.nav_cmd == NAV_CMD_VTOL_TAKEOFF;
 		}
 
-		if (!_has_takeoff) {
-			_has_takeoff = true;
+		if (!_state.has_takeoff) {
+			_state.has_takeoff = true;
 		}
 
 
-		if (_found_item_with_position) {
+		if (_state.found_item_with_position) {
 			mavlink_log_critical(_mavlink_log_pub, "Mission rejected: takeoff not first waypoint item\t");
 			events::send(events::ID("navigator_mis_takeoff_not_first"), {events::Log::Error, events::LogInternal::Info},
 				     "Mission rejected: takeoff is not the first waypoint item");
@@ -352,8 +389,8 @@ bool FeasibilityChecker::checkTakeoff(mission_item_s &mission_item)
 		}
 	}
 
-	if (!_found_item_with_position) {
-		_found_item_with_position = (mission_item.nav_cmd != NAV_CMD_IDLE &&
+	if (!_state.found_item_with_position) {
+		_state.found_item_with_position = (mission_item.nav_cmd != NAV_CMD_IDLE &&
 					     mission_item.nav_cmd != NAV_CMD_DELAY &&
 					     mission_item.nav_cmd != NAV_CMD_DO_JUMP &&
 					     mission_item.nav_cmd != NAV_CMD_DO_CHANGE_SPEED &&
@@ -390,12 +427,12 @@ bool FeasibilityChecker::checkFixedWindLandApproach(mission_item_s &mission_item
 {
 	if (mission_item.nav_cmd == NAV_CMD_LAND && current_index > 0) {
 
-		if (MissionBlock::item_contains_position(_mission_item_previous)) {
+		if (MissionBlock::item_contains_position(_state.mission_item_previous)) {
 
 			const float land_alt_amsl = mission_item.altitude_is_relative ? mission_item.altitude +
 						    _home_alt_msl : mission_item.altitude;
-			const float entrance_alt_amsl = _mission_item_previous.altitude_is_relative ? _mission_item_previous.altitude +
-							_home_alt_msl : _mission_item_previous.altitude;
+			const float entrance_alt_amsl = _state.mission_item_previous.altitude_is_relative ? _state.mission_item_previous.altitude +
+							_home_alt_msl : _state.mission_item_previous.altitude;
 			const float relative_approach_altitude = entrance_alt_amsl - land_alt_amsl;
 
 			if (relative_approach_altitude < FLT_EPSILON) {
@@ -408,13 +445,13 @@ bool FeasibilityChecker::checkFixedWindLandApproach(mission_item_s &mission_item
 
 			float landing_approach_distance;
 
-			if (_mission_item_previous.nav_cmd == NAV_CMD_LOITER_TO_ALT) {
+			if (_state.mission_item_previous.nav_cmd == NAV_CMD_LOITER_TO_ALT) {
 				// assume this is a fixed-wing landing pattern with orbit to alt followed
 				// by tangent exit to landing approach and touchdown at landing waypoint
 
-				const float distance_orbit_center_to_land = get_distance_to_next_waypoint(_mission_item_previous.lat,
-						_mission_item_previous.lon, mission_item.lat, mission_item.lon);
-				const float orbit_radius = fabsf(_mission_item_previous.loiter_radius);
+				const float distance_orbit_center_to_land = get_distance_to_next_waypoint(_state.mission_item_previous.lat,
+						_state.mission_item_previous.lon, mission_item.lat, mission_item.lon);
+				const float orbit_radius = fabsf(_state.mission_item_previous.loiter_radius);
 
 				if (distance_orbit_center_to_land <= orbit_radius) {
 					mavlink_log_critical(_mavlink_log_pub,
@@ -427,10 +464,10 @@ bool FeasibilityChecker::checkFixedWindLandApproach(mission_item_s &mission_item
 				landing_approach_distance = sqrtf(distance_orbit_center_to_land * distance_orbit_center_to_land - orbit_radius *
 								  orbit_radius);
 
-			} else if (_mission_item_previous.nav_cmd == NAV_CMD_WAYPOINT) {
+			} else if (_state.mission_item_previous.nav_cmd == NAV_CMD_WAYPOINT) {
 				// approaching directly from waypoint position
 
-				const float waypoint_distance = get_distance_to_next_waypoint(_mission_item_previous.lat, _mission_item_previous.lon,
+				const float waypoint_distance = get_distance_to_next_waypoint(_state.mission_item_previous.lat, _state.mission_item_previous.lon,
 								mission_item.lat, mission_item.lon);
 				landing_approach_distance = waypoint_distance;
 
@@ -476,7 +513,7 @@ bool FeasibilityChecker::checkFixedWindLandApproach(mission_item_s &mission_item
 				return false;
 			}
 
-			_landing_valid = true;
+			_state.landing_valid = true;
 
 		}
 	}
@@ -490,7 +527,7 @@ bool FeasibilityChecker::checkLandPatternValidity(mission_item_s &mission_item,
 
 	// if DO_LAND_START found then require valid landing AFTER
 	if (mission_item.nav_cmd == NAV_CMD_DO_LAND_START) {
-		if (_do_land_start_index >= 0) {
+		if (_state.do_land_start_index >= 0) {
 			mavlink_log_critical(_mavlink_log_pub, "Mission rejected: more than one land start.\t");
 			events::send(events::ID("navigator_mis_multiple_land"), {events::Log::Error, events::LogInternal::Info},
 				     "Mission rejected: more than one land start commands");
@@ -498,15 +535,15 @@ bool FeasibilityChecker::checkLandPatternValidity(mission_item_s &mission_item,
 
 		}
 
-		_do_land_start_index = current_index;
+		_state.do_land_start_index = current_index;
 	}
 
-	const bool land_start_found = _do_land_start_index >= 0;
+	const bool land_start_found = _state.do_land_start_index >= 0;
 
 	if (mission_item.nav_cmd == NAV_CMD_LAND || mission_item.nav_cmd == NAV_CMD_VTOL_LAND) {
 
 		if (current_index > 0) {
-			_landing_approach_index = current_index - 1;
+			_state.landing_approach_index = current_index - 1;
 
 		} else {
 			mavlink_log_critical(_mavlink_log_pub, "Mission rejected: starts with land waypoint.\t");
@@ -516,7 +553,7 @@ bool FeasibilityChecker::checkLandPatternValidity(mission_item_s &mission_item,
 		}
 
 	} else if (mission_item.nav_cmd == NAV_CMD_RETURN_TO_LAUNCH) {
-		if (land_start_found && _do_land_start_index < current_index) {
+		if (land_start_found && _state.do_land_start_index < current_index) {
 			mavlink_log_critical(_mavlink_log_pub,
 					     "Mission rejected: land start item before RTL item not possible.\t");
 			events::send(events::ID("navigator_mis_land_before_rtl"), {events::Log::Error, events::LogInternal::Info},
@@ -525,14 +562,14 @@ bool FeasibilityChecker::checkLandPatternValidity(mission_item_s &mission_item,
 		}
 	}
 
-	if (current_index == last_index && land_start_found && (_do_land_start_index > _landing_approach_index)) {
+	if (current_index == last_index && land_start_found && (_state.do_land_start_index > _state.landing_approach_index)) {
 		mavlink_log_critical(_mavlink_log_pub, "Mission rejected: invalid land start.\t");
 		events::send(events::ID("navigator_mis_invalid_land"), {events::Log::Error, events::LogInternal::Info},
 			     "Mission rejected: invalid land start");
 		return false;
 	}
 
-	_landing_valid = _landing_approach_index >= 0;
+	_state.landing_valid = _state.landing_approach_index >= 0;
 
 	/* No landing waypoints or no waypoints */
 	return true;
@@ -548,7 +585,7 @@ bool FeasibilityChecker::checkTakeoffLandAvailable()
 		break;
 
 	case 1:
-		result = _has_takeoff;
+		result = _state.has_takeoff;
 
 		if (!result) {
 			mavlink_log_critical(_mavlink_log_pub, "Mission rejected: Takeoff waypoint required.\t");
@@ -560,7 +597,7 @@ bool FeasibilityChecker::checkTakeoffLandAvailable()
 		break;
 
 	case 2:
-		result = _landing_valid;
+		result = _state.landing_valid;
 
 		if (!result) {
 			mavlink_log_critical(_mavlink_log_pub, "Mission rejected: Landing waypoint/pattern required.\t");
@@ -571,7 +608,7 @@ bool FeasibilityChecker::checkTakeoffLandAvailable()
 		break;
 
 	case 3:
-		result = _has_takeoff && _landing_valid;
+		result = _state.has_takeoff && _state.landing_valid;
 
 		if (!result) {
 			mavlink_log_critical(_mavlink_log_pub, "Mission rejected: Takeoff or Landing item missing.\t");
@@ -591,7 +628,7 @@ bool FeasibilityChecker::checkTakeoffLandAvailable()
 			result = hasMissionBothOrNeitherTakeoffAndLanding();
 
 		} else if (!_has_vtol_approach) {
-			result = _landing_valid;
+			result = _state.landing_valid;
 
 			if (!result) {
 				mavlink_log_critical(_mavlink_log_pub, "Mission rejected: Landing waypoint/pattern required.");
@@ -612,14 +649,14 @@ bool FeasibilityChecker::checkTakeoffLandAvailable()
 
 bool FeasibilityChecker::hasMissionBothOrNeitherTakeoffAndLanding()
 {
-	bool result{_has_takeoff == _landing_valid};
+	bool result{_state.has_takeoff == _state.landing_valid};
 
-	if (!result && (_has_takeoff)) {
+	if (!result && (_state.has_takeoff)) {
 		mavlink_log_critical(_mavlink_log_pub, "Mission rejected: Add Landing item or remove Takeoff.\t");
 		events::send(events::ID("navigator_mis_add_land_or_rm_to"), {events::Log::Error, events::LogInternal::Info},
 			     "Mission rejected: Add Landing item or remove Takeoff");
 
-	} else if (!result && (_landing_valid)) {
+	} else if (!result && (_state.landing_valid)) {
 		mavlink_log_critical(_mavlink_log_pub, "Mission rejected: Add Takeoff item or remove Landing.\t");
 		events::send(events::ID("navigator_mis_add_to_or_rm_land"), {events::Log::Error, events::LogInternal::Info},
 			     "Mission rejected: Add Takeoff item or remove Landing");
@@ -628,21 +665,14 @@ bool FeasibilityChecker::hasMissionBothOrNeitherTakeoffAndLanding()
 	return result;
 }
 
-bool FeasibilityChecker::checkHorizontalDistanceToFirstWaypoint(mission_item_s &mission_item)
+bool FeasibilityChecker::checkHorizontalDistanceToFirstWaypoint()
 {
 	if (_param_mis_dist_1wp > FLT_EPSILON &&
-	    (_current_position_lat_lon.isAllFinite()) && !_first_waypoint_found &&
-	    MissionBlock::item_contains_position(mission_item)) {
-
-		_first_waypoint_found = true;
+	    (_current_position_lat_lon.isAllFinite()) && _state.first_waypoint_found) {
 
-		float dist_to_1wp_from_current_pos = 1e6f;
-
-		if (_current_position_lat_lon.isAllFinite()) {
-			dist_to_1wp_from_current_pos = get_distance_to_next_waypoint(
-							       mission_item.lat, mission_item.lon,
-							       _current_position_lat_lon(0), _current_position_lat_lon(1));
-		}
+		const float dist_to_1wp_from_current_pos = get_distance_to_next_waypoint(
+					_state.first_waypoint_lat, _state.first_waypoint_lon,
+					_current_position_lat_lon(0), _current_position_lat_lon(1));
 
 		if (dist_to_1wp_from_current_pos < _param_mis_dist_1wp) {
 
@@ -672,15 +702,15 @@ bool FeasibilityChecker::checkDistancesBetweenWaypoints(const mission_item_s &mi
 	}
 
 	/* Compare it to last waypoint if already available. */
-	if (PX4_ISFINITE(_last_lat) && PX4_ISFINITE(_last_lon)) {
+	if (PX4_ISFINITE(_state.last_lat) && PX4_ISFINITE(_state.last_lon)) {
 		/* check distance from current position to item */
 		const float dist_between_waypoints = get_distance_to_next_waypoint(
 				mission_item.lat, mission_item.lon,
-				_last_lat, _last_lon);
+				_state.last_lat, _state.last_lon);
 
 
 		if (dist_between_waypoints < 0.05f &&
-		    (mission_item.nav_cmd == NAV_CMD_CONDITION_GATE || _last_cmd == NAV_CMD_CONDITION_GATE)) {
+		    (mission_item.nav_cmd == NAV_CMD_CONDITION_GATE || _state.last_cmd == NAV_CMD_CONDITION_GATE)) {
 
 			/* Waypoints and gate are at the exact same position, which indicates an
 			 * invalid mission and makes calculating the direction from one waypoint
@@ -696,9 +726,9 @@ bool FeasibilityChecker::checkDistancesBetweenWaypoints(const mission_item_s &mi
 		}
 	}
 
-	_last_lat = mission_item.lat;
-	_last_lon = mission_item.lon;
-	_last_cmd = mission_item.nav_cmd;
+	_state.last_lat = mission_item.lat;
+	_state.last_lon = mission_item.lon;
+	_state.last_cmd = mission_item.nav_cmd;
 
 	/* We ran through all waypoints and have not found any distances between waypoints that are too far. */
 	return true;
@@ -56,6 +56,56 @@ public:
 		Other
 	};
 
+	/**
+	 * @brief Progress of the checks through a mission
+	 *
+	 * Only depends on the mission items processed so far and on the data hashed by updateContext(),
+	 * so a check can be resumed from a saved state.
+	 */
+	struct State {
+		// flags to keep track of which checks failed
+		bool mission_validity_failed{false};
+		bool takeoff_failed{false};
+		bool land_pattern_validity_failed{false};
+		bool distance_first_waypoint_failed{false};
+		bool distance_between_waypoints_failed{false};
+		bool fixed_wing_land_approach_failed{false};
+		bool takeoff_land_available_failed{false};
+		bool items_fit_to_vehicle_type_failed{false};
+
+		// checkTakeoff related variables
+		bool found_item_with_position{false};
+		bool has_vtol_takeoff{false};
+		bool has_takeoff{false};
+
+		// checkFixedWingLanding related variables
+		bool landing_valid{false};
+		int do_land_start_index{-1};
+		int landing_approach_index{-1};
+		mission_item_s mission_item_previous = {};
+
+		// checkHorizontalDistanceToFirstWaypoint variables
+		bool first_waypoint_found{false};
+		double first_waypoint_lat{(double)NAN};
+		double first_waypoint_lon{(double)NAN};
+
+		// checkDistancesBetweenWaypoints variables
+		double last_lat{(double)NAN};
+		double last_lon{(double)NAN};
+		int last_cmd{-1};
+
+		bool anyCheckFailed() const
+		{
+			return mission_validity_failed || takeoff_failed || land_pattern_validity_failed ||
+			       distance_first_waypoint_failed || distance_between_waypoints_failed ||
+			       fixed_wing_land_approach_failed || takeoff_land_available_failed ||
+			       items_fit_to_vehicle_type_failed;
+		}
+
+		bool operator==(const State &other) const;
+		bool operator!=(const State &other) const { return !(*this == other); }
+	};
+
 	/**
 	 * @brief Run validity checks for mission item
 	 *
@@ -77,13 +127,13 @@ public:
 	*/
 	bool someCheckFailed()
 	{
-		return _takeoff_failed ||
-		       _distance_first_waypoint_failed ||
-		       _distance_between_waypoints_failed ||
-		       _land_pattern_validity_failed ||
-		       _fixed_wing_land_approach_failed ||
-		       _mission_validity_failed ||
-		       _takeoff_land_available_failed;
+		return _state.takeoff_failed ||
+		       _state.distance_first_waypoint_failed ||
+		       _state.distance_between_waypoints_failed ||
+		       _state.land_pattern_validity_failed ||
+		       _state.fixed_wing_land_approach_failed ||
+		       _state.mission_validity_failed ||
+		       _state.takeoff_land_available_failed;
 	}
 
 	/**
@@ -91,6 +141,18 @@ public:
 	*/
 	void reset();
 
+	/**
+	 * @brief Update the vehicle state and parameters the checks depend on
+	 *
+	 * processNextItem() does this at the first item, call it before resuming a check with setState().
+	 *
+	 * @return Hash over this data, a saved state is only valid with the same hash
+	*/
+	uint32_t updateContext();
+
+	const State &getState() const { return _state; }
+	void setState(const State &state) { _state = state; }
+
 private:
 	orb_advert_t *_mavlink_log_pub{nullptr};
 
@@ -113,38 +175,8 @@ private:
 	matrix::Vector2d _current_position_lat_lon = matrix::Vector2d((double)NAN, (double)NAN);
 	VehicleType _vehicle_type{VehicleType::RotaryWing};
 
-	// internal flags to keep track of which checks failed
-	bool _mission_validity_failed{false};
-	bool _takeoff_failed{false};
-	bool _land_pattern_validity_failed{false};
-	bool _distance_first_waypoint_failed{false};
-	bool _distance_between_waypoints_failed{false};
-	bool _fixed_wing_land_approach_failed{false};
-	bool _takeoff_land_available_failed{false};
-	bool _items_fit_to_vehicle_type_failed{false};
-
-	// internal checkTakeoff related variables
-	bool _found_item_with_position{false};
-	bool _has_vtol_takeoff{false};
-	bool _has_takeoff{false};
-
-	// internal checkFixedWingLanding related variables
-	bool _landing_valid{false};
-	int _do_land_start_index{-1};
-	int _landing_approach_index{-1};
-	mission_item_s _mission_item_previous = {};
-
-	// internal checkHorizontalDistanceToFirstWaypoint variables
-	bool _first_waypoint_found{false};
-
-	// internal checkDistancesBetweenWaypoints variables
-	double _last_lat{(double)NAN};
-	double _last_lon{(double)NAN};
-	int _last_cmd{-1};
+	State _state{};
 
-	/**
-	 * @brief Update data from external topics, e.g home position
-	*/
 	void updateData();
 
 	// methods which are called for each mission item
@@ -183,14 +215,6 @@ private:
 	*/
 	bool checkLandPatternValidity(mission_item_s &mission_item, const int current_index, const int last_index);
 
-	/**
-	 * @brief Check distance to first waypoint from current vehicle position (if available).
-	 *
-	 * @param mission_item The current mission item
-	 * @return False if the check failed.
-	*/
-	bool checkHorizontalDistanceToFirstWaypoint(mission_item_s &mission_item);
-
 	/**
 	 * @brief Check distances between waypoints
 	 *
@@ -209,6 +233,13 @@ private:
 	bool checkFixedWindLandApproach(mission_item_s &mission_item, const int current_index);
 
 	// methods which are called once at the end
+	/**
+	 * @brief Check distance to first waypoint from current vehicle position (if available).
+	 *
+	 * @return False if the check failed.
+	*/
+	bool checkHorizontalDistanceToFirstWaypoint();
+
 	/**
 	 * @brief Check if takeoff/landing are available according to MIS_TKO_LAND_REQ parameter
 	 *
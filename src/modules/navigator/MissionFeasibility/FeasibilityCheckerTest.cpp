@@ -484,3 +484,48 @@ TEST_F(FeasibilityCheckerTest, check_takeoff_land_requirements)
 	checker.processNextItem(mission_item, 0, 1);
 	ASSERT_EQ(checker.someCheckFailed(), false);
 }
+
+TEST_F(FeasibilityCheckerTest, resume_from_state)
+{
+	// GIVEN: MIS_DIST_1WP set to 500m and a mission whose first waypoint is 501m away from the current position
+	TestFeasibilityChecker checker;
+	checker.publishLanded(true);
+	checker.publishHomePosition(0, 0, 0.f);
+	checker.publishCurrentPosition(0, 0);
+	param_t param = param_handle(px4::params::MIS_DIST_1WP);
+	float max_dist = 500.0f;
+	param_set(param, &max_dist);
+	checker.paramsChanged();
+
+	mission_item_s mission_items[3] = {};
+	double lat_new, lon_new;
+
+	for (int i = 0; i < 3; ++i) {
+		waypoint_from_heading_and_distance(0, 0, 0, 501 + i * 10, &lat_new, &lon_new);
+		mission_items[i].nav_cmd = NAV_CMD_WAYPOINT;
+		mission_items[i].lat = lat_new;
+		mission_items[i].lon = lon_new;
+		mission_items[i].altitude = 10.f;
+		mission_items[i].altitude_is_relative = true;
+	}
+
+	checker.processNextItem(mission_items[0], 0, 3);
+	const FeasibilityChecker::State state_after_first_item = checker.getState();
+	checker.processNextItem(mission_items[1], 1, 3);
+	checker.processNextItem(mission_items[2], 2, 3);
+	ASSERT_EQ(checker.someCheckFailed(), true);
+	const FeasibilityChecker::State state_after_mission = checker.getState();
+
+	// WHEN: another checker resumes the check after the first item
+	TestFeasibilityChecker resumed_checker;
+	resumed_checker.paramsChanged();
+	resumed_checker.updateContext();
+	resumed_checker.setState(state_after_first_item);
+	ASSERT_EQ(resumed_checker.someCheckFailed(), false);
+	resumed_checker.processNextItem(mission_items[1], 1, 3);
+	resumed_checker.processNextItem(mission_items[2], 2, 3);
+
+	// THEN: it ends in the same state, including the distance check to the first waypoint
+	ASSERT_EQ(resumed_checker.someCheckFailed(), true);
+	ASSERT_TRUE(resumed_checker.getState() == state_after_mission);
+}
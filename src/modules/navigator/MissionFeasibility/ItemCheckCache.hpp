@@ -0,0 +1,185 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ItemCheckCache.hpp
+ *
+ * Cache of per mission item results of the expensive geometric feasibility checks
+ * (geofence containment). Items are identified by a hash over their content, so
+ * re-checking a mission after a partial upload only has to re-evaluate the items
+ * that actually changed.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../navigation.h"
+
+class ItemCheckCache
+{
+public:
+	enum class Result : uint8_t {
+		Unknown = 0,
+		Passed,
+		Failed,
+	};
+
+	ItemCheckCache() = default;
+	~ItemCheckCache() { delete[] _entries; }
+
+	ItemCheckCache(const ItemCheckCache &) = delete;
+	ItemCheckCache &operator=(const ItemCheckCache &) = delete;
+
+	/**
+	 * @brief Resize the cache. Entries of indices that still exist are kept.
+	 *
+	 * @param size Number of mission items
+	 * @return False if the allocation failed, the cache is empty then.
+	 */
+	bool resize(int size)
+	{
+		if (size == _size) {
+			return true;
+		}
+
+		Entry *entries = nullptr;
+
+		if (size > 0) {
+			entries = new Entry[size] {};
+
+			if (entries == nullptr) {
+				size = 0;
+
+			} else if (_entries != nullptr) {
+				memcpy(entries, _entries, sizeof(Entry) * (size < _size ? size : _size));
+			}
+		}
+
+		delete[] _entries;
+		_entries = entries;
+		_size = size;
+		return _entries != nullptr || size == 0;
+	}
+
+	/**
+	 * @brief Set the context the cached results depend on (geofence, home position).
+	 * All entries are dropped if the context changed.
+	 */
+	void setContext(uint32_t context)
+	{
+		if (context != _context) {
+			invalidate();
+			_context = context;
+		}
+	}
+
+	void invalidate()
+	{
+		if (_entries != nullptr) {
+			memset(_entries, 0, sizeof(Entry) * _size);
+		}
+	}
+
+	/**
+	 * @brief Look up the cached result of an item
+	 *
+	 * @param index Index of the mission item
+	 * @param hash Hash of the mission item, see itemHash()
+	 * @return Result::Unknown if the item changed or was never checked
+	 */
+	Result lookup(int index, uint32_t hash)
+	{
+		if (index < 0 || index >= _size || _entries[index].hash != hash) {
+			++_misses;
+			return Result::Unknown;
+		}
+
+		if (_entries[index].result == Result::Unknown) {
+			++_misses;
+
+		} else {
+			++_hits;
+		}
+
+		return _entries[index].result;
+	}
+
+	void store(int index, uint32_t hash, Result result)
+	{
+		if (index >= 0 && index < _size) {
+			_entries[index].hash = hash;
+			_entries[index].result = result;
+		}
+	}
+
+	int size() const { return _size; }
+	uint32_t hits() const { return _hits; }
+	uint32_t misses() const { return _misses; }
+
+	static uint32_t itemHash(const mission_item_s &mission_item)
+	{
+		return hash(&mission_item, sizeof(mission_item));
+	}
+
+	/**
+	 * @brief 32 bit FNV-1a hash
+	 */
+	static uint32_t hash(const void *data, size_t length, uint32_t seed = 2166136261u)
+	{
+		const uint8_t *bytes = static_cast<const uint8_t *>(data);
+		uint32_t h = seed;
+
+		for (size_t i = 0; i < length; ++i) {
+			h ^= bytes[i];
+			h *= 16777619u;
+		}
+
+		return h;
+	}
+
+private:
+	struct Entry {
+		uint32_t hash;
+		Result result;
+	};
+
+	Entry *_entries{nullptr};
+	int _size{0};
+	uint32_t _context{0};
+	uint32_t _hits{0};
+	uint32_t _misses{0};
+};
@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include "ItemCheckCache.hpp"
+
+// to run: make tests TESTFILTER=ItemCheckCache
+
+static constexpr int kMissionSize = 2000;
+
+static mission_item_s makeWaypoint(int index)
+{
+	mission_item_s mission_item{};
+	mission_item.nav_cmd = NAV_CMD_WAYPOINT;
+	mission_item.lat = 47.39 + index * 1e-5;
+	mission_item.lon = 8.54 + index * 1e-5;
+	mission_item.altitude = 50.f;
+	mission_item.altitude_is_relative = true;
+	return mission_item;
+}
+
+TEST(ItemCheckCacheTest, store_and_lookup)
+{
+	ItemCheckCache cache;
+	ASSERT_TRUE(cache.resize(3));
+
+	const mission_item_s item = makeWaypoint(0);
+	const uint32_t hash = ItemCheckCache::itemHash(item);
+
+	EXPECT_EQ(cache.lookup(0, hash), ItemCheckCache::Result::Unknown);
+
+	cache.store(0, hash, ItemCheckCache::Result::Failed);
+	EXPECT_EQ(cache.lookup(0, hash), ItemCheckCache::Result::Failed);
+
+	// a different item at the same index is not served from the cache
+	mission_item_s changed_item = item;
+	changed_item.altitude = 60.f;
+	EXPECT_EQ(cache.lookup(0, ItemCheckCache::itemHash(changed_item)), ItemCheckCache::Result::Unknown);
+
+	// out of range indices are ignored
+	cache.store(3, hash, ItemCheckCache::Result::Passed);
+	EXPECT_EQ(cache.lookup(3, hash), ItemCheckCache::Result::Unknown);
+	EXPECT_EQ(cache.lookup(-1, hash), ItemCheckCache::Result::Unknown);
+}
+
+TEST(ItemCheckCacheTest, context_change_invalidates)
+{
+	ItemCheckCache cache;
+	cache.setContext(1);
+	ASSERT_TRUE(cache.resize(1));
+
+	const uint32_t hash = ItemCheckCache::itemHash(makeWaypoint(0));
+	cache.store(0, hash, ItemCheckCache::Result::Passed);
+
+	cache.setContext(1);
+	EXPECT_EQ(cache.lookup(0, hash), ItemCheckCache::Result::Passed);
+
+	cache.setContext(2);
+	EXPECT_EQ(cache.lookup(0, hash), ItemCheckCache::Result::Unknown);
+}
+
+TEST(ItemCheckCacheTest, resize_keeps_entries)
+{
+	ItemCheckCache cache;
+	ASSERT_TRUE(cache.resize(2));
+
+	const uint32_t hash0 = ItemCheckCache::itemHash(makeWaypoint(0));
+	const uint32_t hash1 = ItemCheckCache::itemHash(makeWaypoint(1));
+	cache.store(0, hash0, ItemCheckCache::Result::Passed);
+	cache.store(1, hash1, ItemCheckCache::Result::Passed);
+
+	// appending items keeps the results of the existing ones
+	ASSERT_TRUE(cache.resize(4));
+	EXPECT_EQ(cache.size(), 4);
+	EXPECT_EQ(cache.lookup(0, hash0), ItemCheckCache::Result::Passed);
+	EXPECT_EQ(cache.lookup(1, hash1), ItemCheckCache::Result::Passed);
+
+	ASSERT_TRUE(cache.resize(1));
+	EXPECT_EQ(cache.lookup(0, hash0), ItemCheckCache::Result::Passed);
+
+	ASSERT_TRUE(cache.resize(0));
+	EXPECT_EQ(cache.lookup(0, hash0), ItemCheckCache::Result::Unknown);
+}
+
+TEST(ItemCheckCacheTest, incremental_recheck_2000_items)
+{
+	ItemCheckCache cache;
+	ASSERT_TRUE(cache.resize(kMissionSize));
+
+	mission_item_s *mission = new mission_item_s[kMissionSize];
+
+	for (int i = 0; i < kMissionSize; ++i) {
+		mission[i] = makeWaypoint(i);
+	}
+
+	// initial check: every item has to be evaluated
+	int evaluated = 0;
+
+	for (int i = 0; i < kMissionSize; ++i) {
+		const uint32_t hash = ItemCheckCache::itemHash(mission[i]);
+
+		if (cache.lookup(i, hash) == ItemCheckCache::Result::Unknown) {
+			cache.store(i, hash, ItemCheckCache::Result::Passed);
+			++evaluated;
+		}
+	}
+
+	EXPECT_EQ(evaluated, kMissionSize);
+
+	// modify a range of items, as a partial mission upload does
+	for (int i = 1000; i < 1010; ++i) {
+		mission[i].altitude += 10.f;
+	}
+
+	evaluated = 0;
+
+	for (int i = 0; i < kMissionSize; ++i) {
+		const uint32_t hash = ItemCheckCache::itemHash(mission[i]);
+
+		if (cache.lookup(i, hash) == ItemCheckCache::Result::Unknown) {
+			cache.store(i, hash, ItemCheckCache::Result::Passed);
+			++evaluated;
+		}
+	}
+
+	// only the changed items are evaluated again
+	EXPECT_EQ(evaluated, 10);
+	EXPECT_EQ(cache.hits(), (uint32_t)(kMissionSize - 10));
+
+	delete[] mission;
+}
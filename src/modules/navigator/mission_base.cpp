@@ -51,7 +51,7 @@ MissionBase::MissionBase(Navigator *navigator, int32_t dataman_cache_size_signed
 	ModuleParams(navigator),
 	_dataman_cache_size_signed(dataman_cache_size_signed)
 {
-	_dataman_cache.resize(abs(dataman_cache_size_signed));
+	_dataman_cache.resize(abs(dataman_cache_size_signed) + DATAMAN_CACHE_PREFETCH_SIZE);
 
 	// Reset _mission here, and listen on changes on the uorb topic instead of initialize from dataman.
 	_mission.mission_dataman_id = DM_KEY_WAYPOINTS_OFFBOARD_0;
@@ -68,6 +68,11 @@ MissionBase::MissionBase(Navigator *navigator, int32_t dataman_cache_size_signed
 	_mission_pub.advertise();
 }
 
+MissionBase::~MissionBase()
+{
+	perf_free(_item_transition_perf);
+}
+
 void
 MissionBase::updateDatamanCache()
 {
@@ -83,9 +88,56 @@ MissionBase::updateDatamanCache()
 		}
 
 		_load_mission_index = _mission.current_seq;
+		_prefetch_pending = _dataman_cache_size_signed > 0;
 	}
 
 	_dataman_cache.update();
+
+	if (_prefetch_pending && !_dataman_cache.isLoading()) {
+		_prefetch_pending = false;
+		prefetchDatamanCache();
+	}
+}
+
+void
+MissionBase::prefetchDatamanCache()
+{
+	const dm_item_t mission_dataman_id = static_cast<dm_item_t>(_mission.mission_dataman_id);
+	const int32_t start_index = math::constrain(_mission.current_seq, INT32_C(0), int32_t(_mission.count) - 1);
+	const int32_t end_index = math::min(start_index + _dataman_cache_size_signed, int32_t(_mission.count));
+	int32_t num_prefetched = 0;
+
+	for (int32_t index = start_index; index < end_index && num_prefetched < DATAMAN_CACHE_PREFETCH_SIZE; ++index) {
+		mission_item_s mission_item;
+
+		// only look at cached items, they have just been loaded
+		if (!_dataman_cache.loadWait(mission_dataman_id, index, reinterpret_cast<uint8_t *>(&mission_item),
+					     sizeof(mission_item_s))) {
+			continue;
+		}
+
+		if ((mission_item.nav_cmd == NAV_CMD_DO_JUMP)
+		    && (mission_item.do_jump_current_count < mission_item.do_jump_repeat_count)
+		    && (mission_item.do_jump_mission_index >= 0)
+		    && (mission_item.do_jump_mission_index < int32_t(_mission.count))) {
+
+			if (_dataman_cache.load(mission_dataman_id, mission_item.do_jump_mission_index)) {
+				++num_prefetched;
+			}
+		}
+	}
+
+	// The landing sequence can be started at any time, e.g. by a mission RTL
+	if ((_mission.land_start_index > _mission.current_seq) && (_mission.land_start_index >= end_index)) {
+		const int32_t land_end_index = math::min(_mission.land_start_index + 2, int32_t(_mission.count));
+
+		for (int32_t index = _mission.land_start_index; index < land_end_index
+		     && num_prefetched < DATAMAN_CACHE_PREFETCH_SIZE; ++index) {
+			if (_dataman_cache.load(mission_dataman_id, index)) {
+				++num_prefetched;
+			}
+		}
+	}
 }
 
 void MissionBase::updateMavlinkMission()
@@ -167,6 +219,10 @@ MissionBase::on_inactive()
 		_mission_checked = true;
 		check_mission_valid();
 		_is_current_planned_mission_item_valid = isMissionValid();
+
+	} else if (_mission_feasibility_checker.isRunning()) {
+		updateMissionFeasibility();
+		_is_current_planned_mission_item_valid = isMissionValid();
 	}
 
 	if (_vehicle_status_sub.get().arming_state != vehicle_status_s::ARMING_STATE_ARMED) {
@@ -262,6 +318,13 @@ MissionBase::on_active()
 		_is_current_planned_mission_item_valid = isMissionValid();
 		update_mission();
 		set_mission_items();
+
+	} else if (_mission_feasibility_checker.isRunning()) {
+		// complete a check that was started in the background while inactive
+		updateMissionFeasibility(_mission.count);
+		_is_current_planned_mission_item_valid = isMissionValid();
+		update_mission();
+		set_mission_items();
 	}
 
 	// check if heading alignment is necessary, and add it to the current mission item if necessary
@@ -315,8 +378,10 @@ MissionBase::on_active()
 
 		if (_mission_item.autocontinue) {
 			/* switch to next waypoint if 'autocontinue' flag set */
+			perf_begin(_item_transition_perf);
 			advance_mission();
 			set_mission_items();
+			perf_end(_item_transition_perf);
 		}
 	}
 
@@ -709,19 +774,53 @@ MissionBase::check_mission_valid(bool forced)
 		_navigator->get_mission_result()->geofence_id = _mission.geofence_id;
 		_navigator->get_mission_result()->home_position_counter = _navigator->get_home_position()->update_count;
 
-		MissionFeasibilityChecker missionFeasibilityChecker(_navigator, _dataman_client);
-		_navigator->get_mission_result()->valid = missionFeasibilityChecker.checkMissionFeasible(_mission);
-		_navigator->get_mission_result()->seq_total = _mission.count;
-		_navigator->get_mission_result()->seq_reached = -1;
-		_navigator->get_mission_result()->failure = false;
+		// Large missions are checked over multiple cycles while inactive to not stall the navigator loop
+		if (!_mission_feasibility_checker.start(_mission)) {
+			// trivial failure, e.g. empty mission or no home position
+			publishMissionFeasibilityResult();
 
-		set_mission_result();
+		} else if (forced || isActive()) {
+			updateMissionFeasibility(_mission.count);
 
-		// only warn if the check failed on merit
-		if ((!_navigator->get_mission_result()->valid) && _mission.count > 0U) {
-			PX4_WARN("mission check failed");
+		} else {
+			updateMissionFeasibility();
 		}
+	}
+}
+
+void
+MissionBase::updateMissionFeasibility(int max_items)
+{
+	if (!_mission_feasibility_checker.isRunning()) {
+		return;
+	}
+
+	if (_mission_feasibility_checker.run(max_items)) {
+		publishMissionFeasibilityResult();
+
+	} else {
+		// report progress, the mission is not valid until the check completed
+		_navigator->get_mission_result()->valid = false;
+		_navigator->get_mission_result()->seq_total = _mission.count;
+		_navigator->get_mission_result()->seq_checked = _mission_feasibility_checker.progress();
+		set_mission_result();
+	}
+}
+
+void
+MissionBase::publishMissionFeasibilityResult()
+{
+	_navigator->get_mission_result()->valid = _mission_feasibility_checker.result();
+	_navigator->get_mission_result()->seq_total = _mission.count;
+	_navigator->get_mission_result()->seq_checked = _mission_feasibility_checker.progress();
+	_navigator->get_mission_result()->seq_reached = -1;
+	_navigator->get_mission_result()->failure = false;
+
+	set_mission_result();
 
+	// only warn if the check failed on merit
+	if ((!_navigator->get_mission_result()->valid) && _mission.count > 0U) {
+		PX4_WARN("mission check failed");
 	}
 }
 
@@ -43,6 +43,7 @@
 #include <drivers/drv_hrt.h>
 #include <px4_platform_common/module_params.h>
 #include <dataman_client/DatamanClient.hpp>
+#include <lib/perf/perf_counter.h>
 #include <uORB/topics/geofence_status.h>
 #include <uORB/topics/mission.h>
 #include <uORB/topics/navigator_mission_item.h>
@@ -56,6 +57,7 @@
 #include <uORB/Publication.hpp>
 
 #include "mission_block.h"
+#include "mission_feasibility_checker.h"
 #include "navigation.h"
 
 using namespace time_literals;
@@ -66,7 +68,7 @@ class MissionBase : public MissionBlock, public ModuleParams
 {
 public:
 	MissionBase(Navigator *navigator, int32_t dataman_cache_size_signed);
-	~MissionBase() override = default;
+	~MissionBase() override;
 
 	virtual void on_inactive() override;
 	virtual void on_inactivation() override;
@@ -221,6 +223,12 @@ protected:
 	 */
 	void check_mission_valid(bool forced = false);
 
+	/**
+	 * @brief Advance a mission feasibility check that is running in the background
+	 * @param[in] max_items maximum number of mission items to check in this call.
+	 */
+	void updateMissionFeasibility(int max_items = MISSION_FEASIBILITY_ITEMS_PER_CYCLE);
+
 	/**
 	 * On mission update
 	 * Change behaviour after external mission update.
@@ -330,10 +338,12 @@ protected:
 	int _inactivation_index{-1}; // index of mission item at which the mission was paused. Used to resume survey missions at previous waypoint to not lose images.
 
 	int32_t _load_mission_index{-1}; /**< Mission inted of loaded mission items in dataman cache*/
+	bool _prefetch_pending{false}; /**< Flag indicating that jump targets and landing items have to be prefetched once the cache is loaded*/
 	int32_t _dataman_cache_size_signed; /**< Size of the dataman cache. A negativ value indicates that previous mission items should be loaded, a positiv value the next mission items*/
 
 	DatamanCache _dataman_cache{"mission_dm_cache_miss", 10}; /**< Dataman cache of mission items*/
 	DatamanClient	&_dataman_client = _dataman_cache.client(); /**< Dataman client*/
+	MissionFeasibilityChecker _mission_feasibility_checker{_navigator, _dataman_client}; /**< Mission feasibility checker, keeps per item results between checks*/
 
 	uORB::Subscription _mission_sub{ORB_ID(mission)};	/**< mission subscription*/
 	uORB::SubscriptionData<vehicle_land_detected_s> _land_detected_sub{ORB_ID(vehicle_land_detected)};	/**< vehicle land detected subscription */
@@ -341,17 +351,40 @@ protected:
 	uORB::SubscriptionData<vehicle_global_position_s> _global_pos_sub{ORB_ID(vehicle_global_position)};	/**< global position subscription */
 	uORB::Publication<navigator_mission_item_s> _navigator_mission_item_pub{ORB_ID::navigator_mission_item}; /**< Navigator mission item publication*/
 	uORB::Publication<mission_s> _mission_pub{ORB_ID(mission)}; /**< Mission publication*/
+
+	perf_counter_t _item_transition_perf{perf_alloc(PC_ELAPSED, "mission_item_transition")}; /**< Time to switch to the next mission item*/
 private:
 	/**
 	 * @brief Maximum number of jump mission items iterations
 	 *
 	 */
 	static constexpr uint16_t MAX_JUMP_ITERATION{10u};
+	/**
+	 * @brief Maximum number of mission items checked per navigator cycle while the mission is inactive
+	 *
+	 */
+	static constexpr int MISSION_FEASIBILITY_ITEMS_PER_CYCLE{50};
+	/**
+	 * @brief Publish the result of a completed mission feasibility check
+	 *
+	 */
+	void publishMissionFeasibilityResult();
+	/**
+	 * @brief Number of dataman cache entries reserved for prefetched DO_JUMP targets and landing items
+	 *
+	 */
+	static constexpr int32_t DATAMAN_CACHE_PREFETCH_SIZE{4};
 	/**
 	 * @brief Update Dataman cache
 	 *
 	 */
 	virtual void updateDatamanCache();
+	/**
+	 * @brief Prefetch the items the mission can continue with apart from the next ones:
+	 * the targets of DO_JUMP items in the cached range and the start of the landing sequence.
+	 *
+	 */
+	void prefetchDatamanCache();
 	/**
 	 * @brief Update mission subscription
 	 *
@@ -56,12 +56,31 @@
 bool
 MissionFeasibilityChecker::checkMissionFeasible(const mission_s &mission)
 {
+	if (start(mission)) {
+		run(mission.count);
+	}
+
+	return _result;
+}
+
+bool
+MissionFeasibilityChecker::start(const mission_s &mission)
+{
+	_mission = mission;
+	_next_index = 0;
+	_items_read = 0;
+	_item_checks_aborted = false;
+	_geofence_failed = false;
+	_result = false;
+	_state = State::Done;
+
 	// Reset warning flag
 	_navigator->get_mission_result()->warning = false;
 
 	// first check if we have a valid position
-	const bool home_valid = _navigator->home_global_position_valid();
+	_home_valid = _navigator->home_global_position_valid();
 	const bool home_alt_valid = _navigator->home_alt_valid();
+	_home_alt = _navigator->get_home_position()->alt;
 
 	// trivial case: A mission with length zero cannot be valid
 	if ((int)mission.count <= 0) {
@@ -74,82 +93,265 @@ MissionFeasibilityChecker::checkMissionFeasible(const mission_s &mission)
 		return false;
 	}
 
-	bool failed = false;
+	if (_navigator->get_geofence().isHomeRequired() && !_home_valid) {
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
+		events::send(events::ID("navigator_mis_geofence_no_home"), {events::Log::Error, events::LogInternal::Info},
+			     "Geofence requires a valid home position");
+		_geofence_failed = true;
+	}
+
+	// Cached geofence results are only valid for the same geofence, home position and fence limits
+	const home_position_s &home = *_navigator->get_home_position();
+	const float gf_max_hor_dist = _navigator->get_geofence().getMaxHorDistanceHome();
+	const float gf_max_ver_dist = _navigator->get_geofence().getMaxVerDistanceHome();
+
+	uint32_t context = ItemCheckCache::hash(&mission.geofence_id, sizeof(mission.geofence_id));
+	context = ItemCheckCache::hash(&home.lat, sizeof(home.lat), context);
+	context = ItemCheckCache::hash(&home.lon, sizeof(home.lon), context);
+	context = ItemCheckCache::hash(&home.alt, sizeof(home.alt), context);
+	context = ItemCheckCache::hash(&_home_valid, sizeof(_home_valid), context);
+	context = ItemCheckCache::hash(&gf_max_hor_dist, sizeof(gf_max_hor_dist), context);
+	context = ItemCheckCache::hash(&gf_max_ver_dist, sizeof(gf_max_ver_dist), context);
+
+	_geofence_cache.setContext(context);
+	_geofence_cache.resize(mission.count);
+
+	// Saved checker states additionally depend on the parameters, vehicle and home used by the item checks
+	const uint32_t checker_context = _feasibility_checker.updateContext();
+	context = ItemCheckCache::hash(&checker_context, sizeof(checker_context), context);
+
+	restoreCheckpoint(mission, context);
+
+	_state = State::Running;
+	return true;
+}
+
+bool
+MissionFeasibilityChecker::run(int max_items)
+{
+	if (_state != State::Running) {
+		return true;
+	}
+
+	const bool check_geofence = _navigator->get_geofence().valid();
+	bool all_checks_failed = false;
 
-	for (size_t i = 0; i < mission.count; i++) {
+	for (int checked = 0; checked < max_items && _next_index < (int)_mission.count && !all_checks_failed; ++checked) {
+		const int i = _next_index;
 		struct mission_item_s missionitem = {};
 
-		bool success = _dataman_client.readSync((dm_item_t)mission.mission_dataman_id, i,
+		if (i == (int)_mission.count - 1) {
+			_last_item_checkpoint.state = _feasibility_checker.getState();
+			_last_item_checkpoint.valid = stateIsClean();
+		}
+
+		bool success = _dataman_client.readSync((dm_item_t)_mission.mission_dataman_id, i,
 							reinterpret_cast<uint8_t *>(&missionitem),
 							sizeof(mission_item_s));
+		++_items_read;
 
 		if (!success) {
-			_navigator->get_mission_result()->warning = true;
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
+			_checked_mission_complete = false;
+			_state = State::Done;
+			_result = false;
+			_navigator->get_mission_result()->warning = true;
+			return true;
+		}
+
+		if (!_item_checks_aborted && !_feasibility_checker.processNextItem(missionitem, i, _mission.count)) {
+			// fatal error, the remaining items are only checked against the geofence
+			_item_checks_aborted = true;
+		}
+
+		if (!_geofence_failed && check_geofence && !checkItemAgainstGeofence(missionitem, i)) {
+			_geofence_failed = true;
 		}
 
-		if (!_feasibility_checker.processNextItem(missionitem, i, mission.count)) {
-			failed = true;
-			break;
+		++_next_index;
+
+		if (_next_index % CHECKPOINT_INTERVAL == 0 && _next_index < (int)_mission.count) {
+			saveCheckpoint(_next_index);
 		}
 
+		all_checks_failed = _item_checks_aborted && (_geofence_failed || !check_geofence);
 	}
 
-	failed |= _feasibility_checker.someCheckFailed();
+	if (all_checks_failed || _next_index >= (int)_mission.count) {
+		finish();
+		return true;
+	}
 
-	failed |= !checkMissionAgainstGeofence(mission, _navigator->get_home_position()->alt, home_valid);
+	return false;
+}
+
+void
+MissionFeasibilityChecker::finish()
+{
+	const bool failed = _item_checks_aborted || _geofence_failed || _feasibility_checker.someCheckFailed();
 
 	_navigator->get_mission_result()->warning = failed;
 
-	return !failed;
+	_result = !failed;
+	_state = State::Done;
+
+	// the checkpoints after an aborted check can be from the previous mission
+	_checked_mission_complete = _next_index >= (int)_mission.count;
 }
 
 bool
-MissionFeasibilityChecker::checkMissionAgainstGeofence(const mission_s &mission, float home_alt, bool home_valid)
+MissionFeasibilityChecker::stateIsClean() const
 {
-	if (_navigator->get_geofence().isHomeRequired() && !home_valid) {
-		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
-		events::send(events::ID("navigator_mis_geofence_no_home"), {events::Log::Error, events::LogInternal::Info},
-			     "Geofence requires a valid home position");
-		return false;
+	return !_item_checks_aborted && !_geofence_failed && !_feasibility_checker.getState().anyCheckFailed();
+}
+
+void
+MissionFeasibilityChecker::resizeCheckpoints(int size)
+{
+	if (size == _num_checkpoints) {
+		return;
 	}
 
-	/* Check if all mission items are inside the geofence (if we have a valid geofence) */
-	if (_navigator->get_geofence().valid()) {
-		for (size_t i = 0; i < mission.count; i++) {
-			struct mission_item_s missionitem = {};
+	Checkpoint *checkpoints = nullptr;
 
-			bool success = _dataman_client.readSync((dm_item_t)mission.mission_dataman_id, i,
-								reinterpret_cast<uint8_t *>(&missionitem),
-								sizeof(mission_item_s));
+	if (size > 0) {
+		checkpoints = new Checkpoint[size] {};
 
-			if (!success) {
-				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-				return false;
-			}
+		if (checkpoints == nullptr) {
+			size = 0;
 
-			if (missionitem.altitude_is_relative && !home_valid) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
-				events::send(events::ID("navigator_mis_geofence_no_home2"), {events::Log::Error, events::LogInternal::Info},
-					     "Geofence requires a valid home position");
-				return false;
+		} else {
+			for (int i = 0; i < math::min(size, _num_checkpoints); ++i) {
+				checkpoints[i] = _checkpoints[i];
 			}
+		}
+	}
+
+	delete[] _checkpoints;
+	_checkpoints = checkpoints;
+	_num_checkpoints = size;
+}
+
+void
+MissionFeasibilityChecker::restoreCheckpoint(const mission_s &mission, uint32_t context)
+{
+	const int count = mission.count;
+	const int last_index = count - 1;
 
-			// Geofence function checks against home altitude amsl
-			missionitem.altitude = missionitem.altitude_is_relative ? missionitem.altitude + home_alt : missionitem.altitude;
+	// items [0, changed_start) and [_changed_end, count) are the same as in the last complete check
+	int changed_start = 0;
+	_changed_end = count;
 
-			if (MissionBlock::item_contains_position(missionitem) && !_navigator->get_geofence().checkPointAgainstAllGeofences(
-				    missionitem.lat, missionitem.lon, missionitem.altitude)) {
+	if (_checked_mission_complete && context == _checkpoint_context) {
+		if (mission.mission_id == _checked_mission_id) {
+			changed_start = count;
+			_changed_end = 0;
 
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %zu\t", i + 1);
-				events::send<int16_t>(events::ID("navigator_mis_geofence_violation"), {events::Log::Error, events::LogInternal::Info},
-						      "Geofence violation for waypoint {1}",
-						      i + 1);
-				return false;
+		} else if (mission.changed_from_mission_id != 0 && mission.changed_from_mission_id == _checked_mission_id) {
+			changed_start = math::min((int)mission.changed_start_index, count);
+			_changed_end = math::min((int)mission.changed_end_index, count);
+
+			if (changed_start >= _changed_end) {
+				changed_start = count;
+				_changed_end = 0;
 			}
 		}
 	}
 
+	_last_item_checkpoint_usable = _last_item_checkpoint.valid && changed_start > 0 && count == _checked_count;
+
+	if (!_last_item_checkpoint_usable) {
+		_last_item_checkpoint.valid = false;
+	}
+
+	// The states after the changed items are kept to detect when the check gets back to the same state,
+	// they are overwritten on the way there
+	resizeCheckpoints(last_index / CHECKPOINT_INTERVAL);
+
+	if (changed_start == 0) {
+		for (int i = 0; i < _num_checkpoints; ++i) {
+			_checkpoints[i].valid = false;
+		}
+	}
+
+	_checked_mission_id = mission.mission_id;
+	_checked_count = count;
+	_checkpoint_context = context;
+	_checked_mission_complete = false;
+
+	if (_last_item_checkpoint_usable && changed_start >= last_index) {
+		_feasibility_checker.setState(_last_item_checkpoint.state);
+		_next_index = last_index;
+		return;
+	}
+
+	// the last item is always checked, its checks use the current position
+	const int resume_limit = math::min(changed_start, last_index);
+
+	for (int i = resume_limit / CHECKPOINT_INTERVAL - 1; i >= 0; --i) {
+		if (_checkpoints[i].valid) {
+			_feasibility_checker.setState(_checkpoints[i].state);
+			_next_index = (i + 1) * CHECKPOINT_INTERVAL;
+			return;
+		}
+	}
+
+	// nothing to resume from, processNextItem() resets the checker at the first item
+}
+
+void
+MissionFeasibilityChecker::saveCheckpoint(int index)
+{
+	Checkpoint &checkpoint = _checkpoints[index / CHECKPOINT_INTERVAL - 1];
+	const bool clean = stateIsClean();
+
+	if (clean && index >= _changed_end && _last_item_checkpoint_usable && checkpoint.valid
+	    && checkpoint.state == _feasibility_checker.getState()) {
+		// The remaining items are unchanged and the checks got to the same state as in the last check,
+		// so they would end up in the same state before the last item again
+		_feasibility_checker.setState(_last_item_checkpoint.state);
+		_next_index = (int)_mission.count - 1;
+		return;
+	}
+
+	checkpoint.state = _feasibility_checker.getState();
+	checkpoint.valid = clean;
+}
+
+bool
+MissionFeasibilityChecker::checkItemAgainstGeofence(mission_item_s &missionitem, int index)
+{
+	if (missionitem.altitude_is_relative && !_home_valid) {
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position\t");
+		events::send(events::ID("navigator_mis_geofence_no_home2"), {events::Log::Error, events::LogInternal::Info},
+			     "Geofence requires a valid home position");
+		return false;
+	}
+
+	if (!MissionBlock::item_contains_position(missionitem)) {
+		return true;
+	}
+
+	const uint32_t item_hash = ItemCheckCache::itemHash(missionitem);
+	ItemCheckCache::Result result = _geofence_cache.lookup(index, item_hash);
+
+	if (result == ItemCheckCache::Result::Unknown) {
+		// Geofence function checks against home altitude amsl
+		const float altitude = missionitem.altitude_is_relative ? missionitem.altitude + _home_alt : missionitem.altitude;
+
+		result = _navigator->get_geofence().checkPointAgainstAllGeofences(missionitem.lat, missionitem.lon, altitude) ?
+			 ItemCheckCache::Result::Passed : ItemCheckCache::Result::Failed;
+
+		_geofence_cache.store(index, item_hash, result);
+	}
+
+	if (result == ItemCheckCache::Result::Failed) {
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %zu\t", (size_t)index + 1);
+		events::send<int16_t>(events::ID("navigator_mis_geofence_violation"), {events::Log::Error, events::LogInternal::Info},
+				      "Geofence violation for waypoint {1}",
+				      index + 1);
+		return false;
+	}
+
 	return true;
 }
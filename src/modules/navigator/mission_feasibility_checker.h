@@ -46,6 +46,7 @@
 #include <uORB/topics/mission.h>
 #include <px4_platform_common/module_params.h>
 #include "MissionFeasibility/FeasibilityChecker.hpp"
+#include "MissionFeasibility/ItemCheckCache.hpp"
 
 class Navigator;
 
@@ -55,8 +56,52 @@ private:
 	Navigator *_navigator{nullptr};
 	DatamanClient &_dataman_client;
 	FeasibilityChecker _feasibility_checker;
+	ItemCheckCache _geofence_cache;
 
-	bool checkMissionAgainstGeofence(const mission_s &mission, float home_alt, bool home_valid);
+	enum class State {
+		Idle,
+		Running,
+		Done
+	};
+
+	State _state{State::Idle};
+	mission_s _mission{};
+	int _next_index{0};
+	int _items_read{0};
+	bool _item_checks_aborted{false};
+	bool _geofence_failed{false};
+	bool _result{false};
+	bool _home_valid{false};
+	float _home_alt{NAN};
+
+	/*
+	 * Checker state after a number of items, a check is resumed from there if the items before did not change.
+	 * Only states without failed checks are saved, so no failure message is skipped when resuming.
+	 */
+	struct Checkpoint {
+		FeasibilityChecker::State state;
+		bool valid;
+	};
+
+	static constexpr int CHECKPOINT_INTERVAL{50};
+
+	Checkpoint *_checkpoints{nullptr}; ///< checker state after every CHECKPOINT_INTERVAL items
+	int _num_checkpoints{0};
+	Checkpoint _last_item_checkpoint{}; ///< checker state before the last item
+	bool _last_item_checkpoint_usable{false};
+	uint32_t _checkpoint_context{0};
+	uint32_t _checked_mission_id{0};
+	int _checked_count{0};
+	bool _checked_mission_complete{false}; ///< the checkpoints are from a complete check of _checked_mission_id
+	int _changed_end{0}; ///< items from this index on are the same as in the last complete check
+
+	bool checkItemAgainstGeofence(mission_item_s &mission_item, int index);
+	void finish();
+
+	void resizeCheckpoints(int size);
+	void restoreCheckpoint(const mission_s &mission, uint32_t context);
+	void saveCheckpoint(int index);
+	bool stateIsClean() const;
 
 public:
 	MissionFeasibilityChecker(Navigator *navigator, DatamanClient &dataman_client) :
@@ -67,13 +112,44 @@ public:
 	{
 
 	}
-	~MissionFeasibilityChecker() = default;
+	~MissionFeasibilityChecker() { delete[] _checkpoints; }
 
 	MissionFeasibilityChecker(const MissionFeasibilityChecker &) = delete;
 	MissionFeasibilityChecker &operator=(const MissionFeasibilityChecker &) = delete;
 
 	/*
-	 * Returns true if mission is feasible and false otherwise
+	 * Returns true if mission is feasible and false otherwise.
+	 * Runs the complete check at once, aborting a check that is in progress.
 	 */
 	bool checkMissionFeasible(const mission_s &mission);
+
+	/*
+	 * Start an incremental check of the mission, which is then advanced by run().
+	 * If the mission only differs from the last checked one in the item range given by the mission
+	 * topic, the check resumes from the last saved state before the changed items.
+	 * Returns false if the check is already complete (e.g. empty mission).
+	 */
+	bool start(const mission_s &mission);
+
+	/*
+	 * Check up to max_items mission items of the check started with start().
+	 * Returns true once the check is complete, the result is then available from result().
+	 */
+	bool run(int max_items);
+
+	bool isRunning() const { return _state == State::Running; }
+	bool result() const { return _result; }
+
+	/*
+	 * Number of mission items checked so far in the current check
+	 */
+	int progress() const { return _next_index; }
+
+	/*
+	 * Number of mission items read from the dataman in the current check. Items that did not change since
+	 * the last check are skipped.
+	 */
+	int itemsRead() const { return _items_read; }
+
+	const ItemCheckCache &geofenceCache() const { return _geofence_cache; }
 };
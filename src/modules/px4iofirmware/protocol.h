@@ -77,7 +77,7 @@
 
 #define REG_TO_BOOL(_reg) 	((bool)(_reg))
 
-#define PX4IO_PROTOCOL_VERSION		5
+#define PX4IO_PROTOCOL_VERSION		6
 
 /* maximum allowable sizes on this protocol version */
 #define PX4IO_PROTOCOL_MAX_CONTROL_COUNT	8	/**< The protocol does not support more than set here, individual units might support less - see PX4IO_P_CONFIG_CONTROL_COUNT */
@@ -233,6 +233,7 @@ struct IOPacket {
 
 #define PKT_CODE_READ		0x00	/* FMU->IO read transaction */
 #define PKT_CODE_WRITE		0x40	/* FMU->IO write transaction */
+#define PKT_CODE_MULTI		0x80	/* FMU->IO multi-page transaction */
 #define PKT_CODE_SUCCESS	0x00	/* IO->FMU success reply */
 #define PKT_CODE_CORRUPT	0x40	/* IO->FMU bad packet reply */
 #define PKT_CODE_ERROR		0x80	/* IO->FMU register op error reply */
@@ -240,6 +241,20 @@ struct IOPacket {
 #define PKT_CODE_MASK		0xc0
 #define PKT_COUNT_MASK		0x3f
 
+/*
+ * Multi-page transactions carry a list of register operations in regs[],
+ * page and offset of the packet header are unused. Each operation starts
+ * with two registers: PKT_MULTI_ADDRESS(page, offset) and the register
+ * count, with PKT_MULTI_WRITE set for writes. Writes are followed by their
+ * values. The reply carries the values of all reads, in request order.
+ *
+ * Operations are applied in order; IO stops at the first failing one and
+ * replies with PKT_CODE_ERROR.
+ */
+#define PKT_MULTI_WRITE		0x8000
+#define PKT_MULTI_COUNT_MASK	0x00ff
+#define PKT_MULTI_ADDRESS(_page, _offset)	((uint16_t)(((_page) << 8) | (_offset)))
+
 #define PKT_COUNT(_p)	((_p).count_code & PKT_COUNT_MASK)
 #define PKT_CODE(_p)	((_p).count_code & PKT_CODE_MASK)
 #define PKT_SIZE(_p)	((size_t)((uint8_t *)&((_p).regs[PKT_COUNT(_p)]) - ((uint8_t *)&(_p))))
@@ -55,6 +55,8 @@
 //#define DEBUG
 #include "px4io.h"
 
+#include <lib/px4io_transaction/PX4IOTransaction.hpp>
+
 #if defined(PX4IO_PERF)
 # include <perf/perf_counter.h>
 
@@ -70,6 +72,7 @@ static perf_counter_t	pc_crcerr;
 #endif
 
 static void		rx_handle_packet(void);
+static int		rx_handle_multi(void);
 static void		rx_dma_callback(DMA_HANDLE handle, uint8_t status, void *arg);
 static DMA_HANDLE	tx_dma;
 static DMA_HANDLE	rx_dma;
@@ -79,6 +82,9 @@ static void		dma_reset(void);
 
 static struct IOPacket	dma_packet;
 
+/* request copy for multi-page transactions, the reply is assembled in dma_packet */
+static uint16_t		multi_request[PKT_MAX_REGS];
+
 /* serial register accessors */
 #define REG(_x)		(*(volatile uint32_t *)(PX4FMU_SERIAL_BASE + _x))
 #define rSR		REG(STM32_USART_SR_OFFSET)
@@ -225,12 +231,47 @@ rx_handle_packet(void)
 		return;
 	}
 
+	if (PKT_CODE(dma_packet) == PKT_CODE_MULTI) {
+
+		/* batch of reads and writes - reply with all read registers */
+		int count = rx_handle_multi();
+
+		if (count < 0) {
+#if defined(PX4IO_PERF)
+			perf_count(pc_regerr);
+#endif
+
+			dma_packet.count_code = PKT_CODE_ERROR;
+
+		} else {
+			dma_packet.count_code = count | PKT_CODE_SUCCESS;
+		}
+
+		return;
+	}
+
 	/* send a bad-packet error reply */
 	dma_packet.count_code = PKT_CODE_CORRUPT;
 	dma_packet.page = 0xff;
 	dma_packet.offset = 0xfe;
 }
 
+static int
+rx_handle_multi(void)
+{
+	/* the reply overwrites the request as it is assembled, so work from a copy */
+	const unsigned request_count = PKT_COUNT(dma_packet);
+
+	if (request_count > PKT_MAX_REGS) {
+		return -1;
+	}
+
+	memcpy(multi_request, (const void *)&dma_packet.regs[0], request_count * 2);
+
+	return px4io::apply(multi_request, request_count, (uint16_t *)&dma_packet.regs[0], PKT_MAX_REGS,
+			    registers_get, registers_set);
+}
+
 static void
 rx_dma_callback(DMA_HANDLE handle, uint8_t status, void *arg)
 {
@@ -47,11 +47,13 @@
 #include <px4_platform_common/time.h>
 #include <px4_platform_common/shutdown.h>
 #include <lib/parameters/param.h>
+#include <mathlib/math/Limits.hpp>
 #include <uORB/uORBMessageFields.hpp>
 
 #include <cstring>
 #include <float.h>
 #include <fstream>
+#include <inttypes.h>
 #include <iostream>
 #include <math.h>
 #include <time.h>
@@ -298,7 +300,7 @@ Replay::readFileDefinitions(std::ifstream &file)
 			break;
 
 		case (int)ULogMessageType::ADD_LOGGED_MSG:
-			_data_section_start = file.tellg() - (streamoff)ULOG_MSG_HEADER_LEN;
+			_data_section_start = (size_t)(streamoff)file.tellg() - ULOG_MSG_HEADER_LEN;
 			return true;
 
 		case (int)ULogMessageType::INFO: //skip
@@ -356,9 +358,10 @@ Replay::readFlagBits(std::ifstream &file, uint16_t msg_size)
 		memcpy(appended_offsets, message + 16, sizeof(appended_offsets));
 
 		if (appended_offsets[0] > 0) {
-			// the appended data is currently only used for hardfault dumps, so it's safe to ignore it.
+			// the appended data contains the log index and hardfault dumps, so it's safe to ignore it for publishing.
 			PX4_INFO("Log contains appended data. Replay will ignore this data");
 			_read_until_file_position = appended_offsets[0];
+			_appended_data_offset = appended_offsets[0];
 		}
 	}
 
@@ -419,27 +422,23 @@ string Replay::getOrbFields(const orb_metadata *meta)
 }
 
 bool
-Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
+Replay::readAndAddSubscription(size_t message_pos)
 {
-	_read_buffer.reserve(msg_size + 1);
-	uint8_t *message = _read_buffer.data();
-	streampos this_message_pos = file.tellg() - (streamoff)ULOG_MSG_HEADER_LEN;
-	file.read((char *)message, msg_size);
-	message[msg_size] = 0;
+	const uint16_t msg_size = _index.header(message_pos).msg_size;
+	const uint8_t *message = _index.payload(message_pos);
 
-	if (!file) {
+	if (msg_size < 4) {
 		return false;
 	}
 
-	if (file.tellg() <= _subscription_file_pos) { //already read this subscription
+	uint8_t multi_id = *(uint8_t *)message;
+	uint16_t msg_id = ((uint16_t)message[1]) | (((uint16_t)message[2]) << 8);
+	string topic_name((char *)message + 3, strnlen((char *)message + 3, msg_size - 3));
+
+	if (!_topics.empty() && _topics.find(topic_name) == _topics.end()) {
 		return true;
 	}
 
-	_subscription_file_pos = file.tellg();
-
-	uint8_t multi_id = *(uint8_t *)message;
-	uint16_t msg_id = ((uint16_t)message[1]) | (((uint16_t)message[2]) << 8);
-	string topic_name((char *)message + 3);
 	const orb_metadata *orb_meta = findTopic(topic_name);
 
 	if (!orb_meta) {
@@ -544,37 +543,112 @@ Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
 		return true;
 	}
 
-	//find first data message (and the timestamp)
-	streampos cur_pos = file.tellg();
-	subscription->next_read_pos = this_message_pos; //this will be skipped
+	//the first data message is searched after indexing, starting from here
+	subscription->next_read_pos = message_pos;
 
-	if (!nextDataMessage(file, *subscription, msg_id)) {
-		delete subscription;
-		return false;
+	//add subscription
+	if (_subscriptions.size() <= msg_id) {
+		_subscriptions.resize(msg_id + 1);
 	}
 
-	file.seekg(cur_pos);
+	_subscriptions[msg_id] = subscription;
 
-	if (!subscription->orb_meta) {
-		//no message found. This is not a fatal error
-		delete subscription;
-		return true;
+	return true;
+}
+
+bool
+Replay::indexFileAndAddSubscriptions()
+{
+	if (!_index.open(_replay_file)) {
+		return false;
 	}
 
-	PX4_DEBUG("adding subscription for %s (msg_id %i)", subscription->orb_meta->o_name, msg_id);
+	_range_start_time = _range_start > 0 ? _file_start_time + _range_start : 0;
+	_range_end_time = _range_end > 0 ? _file_start_time + _range_end : UINT64_MAX;
 
-	//add subscription
-	if (_subscriptions.size() <= msg_id) {
-		_subscriptions.resize(msg_id + 1);
+	size_t index_start = _data_section_start;
+	int64_t index_end = _read_until_file_position;
+
+	// with a time range or topic selection, use the index appended by the logger to skip the rest of the file
+	const bool use_appended_index = (_range_start > 0 || _range_end > 0 || !_topics.empty())
+					&& _appended_data_offset > 0 && _index.readAppendedIndex(_appended_data_offset);
+
+	if (use_appended_index) {
+		std::vector<uint16_t> msg_ids;
+
+		for (const ulog_index_entry_s &entry : _index.appendedIndex()) {
+			if (entry.msg_type == (int)ULogMessageType::ADD_LOGGED_MSG && entry.offset >= _data_section_start) {
+				if (!readAndAddSubscription(entry.offset)) {
+					return false;
+				}
+
+				if (entry.msg_id < _subscriptions.size() && _subscriptions[entry.msg_id]) {
+					msg_ids.push_back(entry.msg_id);
+				}
+			}
+		}
+
+		size_t range_start = index_start;
+		size_t range_end = _read_until_file_position;
+
+		if (_index.findAppendedIndexRange(msg_ids, _range_start_time, _range_end_time, range_start, range_end)) {
+			index_start = math::max(index_start, range_start);
+			index_end = math::min(index_end, (int64_t)range_end);
+		}
+
+		// apply the parameter changes from before the range
+		for (const ulog_index_entry_s &entry : _index.appendedIndex()) {
+			if (entry.msg_type == (int)ULogMessageType::PARAMETER && entry.offset < index_start) {
+				readAndApplyParameter(_index.payload(entry.offset), _index.header(entry.offset).msg_size);
+			}
+		}
+
+		PX4_INFO("Using log index, reading file range %zu - %" PRId64, index_start, index_end);
 	}
 
-	_subscriptions[msg_id] = subscription;
+	_index.build(index_start, index_end);
 
-	onSubscriptionAdded(*_subscriptions[msg_id], msg_id);
+	if (!use_appended_index) {
+		for (size_t message_pos : _index.subscriptionMessages()) {
+			if (!readAndAddSubscription(message_pos)) {
+				return false;
+			}
+		}
+	}
+
+	findFirstDataMessages();
 
 	return true;
 }
 
+void
+Replay::findFirstDataMessages()
+{
+	for (size_t msg_id = 0; msg_id < _subscriptions.size(); ++msg_id) {
+		Subscription *subscription = _subscriptions[msg_id];
+
+		if (!subscription) {
+			continue;
+		}
+
+		do {
+			nextDataMessage(*subscription, msg_id);
+		} while (subscription->orb_meta && subscription->next_timestamp < _range_start_time);
+
+		if (!subscription->orb_meta) {
+			//no message found. This is not a fatal error
+			delete subscription->compat;
+			delete subscription;
+			_subscriptions[msg_id] = nullptr;
+			continue;
+		}
+
+		PX4_DEBUG("adding subscription for %s (msg_id %i)", subscription->orb_meta->o_name, (int)msg_id);
+
+		onSubscriptionAdded(*subscription, msg_id);
+	}
+}
+
 bool
 Replay::findFieldOffset(const string &format, const string &field_name, int &offset, int &field_size)
 {
@@ -606,37 +680,27 @@ Replay::findFieldOffset(const string &format, const string &field_name, int &off
 	return false;
 }
 
-bool
-Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position)
+void
+Replay::readAndHandleAdditionalMessages(size_t end_position)
 {
-	ulog_message_header_s message_header;
+	const std::vector<size_t> &additional_messages = _index.additionalMessages();
 
-	while (file.tellg() < end_position) {
-		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	while (_next_additional_message < additional_messages.size() &&
+	       additional_messages[_next_additional_message] < end_position) {
 
-		if (!file) {
-			return false;
-		}
+		const size_t message_pos = additional_messages[_next_additional_message++];
+		const ulog_message_header_s message_header = _index.header(message_pos);
 
 		switch (message_header.msg_type) {
 		case (int)ULogMessageType::PARAMETER:
-			if (!readAndApplyParameter(file, message_header.msg_size)) {
-				return false;
-			}
-
+			readAndApplyParameter(_index.payload(message_pos), message_header.msg_size);
 			break;
 
 		case (int)ULogMessageType::DROPOUT:
-			readDropout(file, message_header.msg_size);
-			break;
-
-		default: //skip all others
-			file.seekg(message_header.msg_size, ios::cur);
+			readDropout(_index.payload(message_pos), message_header.msg_size);
 			break;
 		}
 	}
-
-	return true;
 }
 
 bool
@@ -650,7 +714,18 @@ Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
 		return false;
 	}
 
+	return readAndApplyParameter(message, msg_size);
+}
+
+bool
+Replay::readAndApplyParameter(const uint8_t *message, uint16_t msg_size)
+{
 	uint8_t key_len = message[0];
+
+	if (1 + key_len > msg_size) {
+		return false;
+	}
+
 	string key((char *)message + 1, key_len);
 
 	size_t pos = key.find(' ');
@@ -682,100 +757,49 @@ Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
 	return true;
 }
 
-bool
-Replay::readDropout(std::ifstream &file, uint16_t msg_size)
+void
+Replay::readDropout(const uint8_t *message, uint16_t msg_size)
 {
-	uint16_t duration;
-	file.read((char *)&duration, sizeof(duration));
+	uint16_t duration = 0;
+
+	if (msg_size >= sizeof(duration)) {
+		memcpy(&duration, message, sizeof(duration));
+	}
 
 	PX4_ERR("Dropout in replayed log, %i ms", (int)duration);
-	return file.good();
 }
 
-bool
-Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id)
+void
+Replay::nextDataMessage(Subscription &subscription, int msg_id)
 {
-	ulog_message_header_s message_header;
-	file.seekg(subscription.next_read_pos);
-	//ignore the first message (it's data we already read)
-	file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	const std::vector<size_t> &data_messages = _index.dataMessages(msg_id);
 
-	if (file) {
-		file.seekg(message_header.msg_size, ios::cur);
+	//ignore the messages up to the current one (it's data we already read)
+	while (subscription.next_index < data_messages.size() &&
+	       data_messages[subscription.next_index] <= subscription.next_read_pos) {
+		++subscription.next_index;
 	}
 
-	uint16_t file_msg_id;
-	bool done = false;
-
-	while (file && !done) {
-		streampos cur_pos = file.tellg();
-		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
-
-		if (!file) {
-			break;
-		}
-
-		if (((streamoff)cur_pos) + ULOG_MSG_HEADER_LEN + message_header.msg_size > _read_until_file_position) {
-			file.setstate(std::ios::eofbit);
-			break;
-		}
-
-		switch (message_header.msg_type) {
-		case (int)ULogMessageType::ADD_LOGGED_MSG:
-			readAndAddSubscription(file, message_header.msg_size);
-			break;
+	while (subscription.next_index < data_messages.size()) {
+		const size_t message_pos = data_messages[subscription.next_index];
+		const ulog_message_header_s message_header = _index.header(message_pos);
 
-		case (int)ULogMessageType::DATA:
-			file.read((char *)&file_msg_id, sizeof(file_msg_id));
-
-			if (file) {
-				if (msg_id == file_msg_id) {
-					if (message_header.msg_size == subscription.orb_meta->o_size_no_padding + 2) {
-						subscription.next_read_pos = cur_pos;
-						file.seekg(subscription.timestamp_offset, ios::cur);
-						file.read((char *)&subscription.next_timestamp, sizeof(subscription.next_timestamp));
-						done = true;
-
-					} else { //sanity check failed!
-						PX4_ERR("data message %s has wrong size %i (expected %i). Skipping",
-							subscription.orb_meta->o_name, message_header.msg_size,
-							subscription.orb_meta->o_size_no_padding + 2);
-						file.seekg(message_header.msg_size - sizeof(file_msg_id), ios::cur);
-					}
-
-				} else { //not the one we are looking for
-					file.seekg(message_header.msg_size - sizeof(file_msg_id), ios::cur);
-				}
-			}
-
-			break;
-
-		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
-		case (int)ULogMessageType::PARAMETER:
-		case (int)ULogMessageType::DROPOUT:
-		case (int)ULogMessageType::INFO:
-		case (int)ULogMessageType::INFO_MULTIPLE:
-		case (int)ULogMessageType::SYNC:
-		case (int)ULogMessageType::LOGGING:
-		case (int)ULogMessageType::PARAMETER_DEFAULT:
-			file.seekg(message_header.msg_size, ios::cur);
-			break;
-
-		default:
-			//this really should not happen
-			PX4_ERR("unknown log message type %i, size %i (offset %i)",
-				(int)message_header.msg_type, (int)message_header.msg_size, (int)file.tellg());
-			file.seekg(message_header.msg_size, ios::cur);
-			break;
+		if (message_header.msg_size == subscription.orb_meta->o_size_no_padding + 2) {
+			subscription.next_read_pos = message_pos;
+			memcpy(&subscription.next_timestamp, _index.payload(message_pos) + 2 + subscription.timestamp_offset,
+			       sizeof(subscription.next_timestamp));
+			return;
 		}
-	}
 
-	if (file.eof()) { //no more data messages for this subscription
-		subscription.orb_meta = nullptr;
-		file.clear();
+		//sanity check failed!
+		PX4_ERR("data message %s has wrong size %i (expected %i). Skipping",
+			subscription.orb_meta->o_name, message_header.msg_size,
+			subscription.orb_meta->o_size_no_padding + 2);
+		++subscription.next_index;
 	}
 
-	return file.good();
+	//no more data messages for this subscription
+	subscription.orb_meta = nullptr;
 }
 
 const orb_metadata *
@@ -904,62 +928,59 @@ Replay::run()
 
 	PX4_INFO("Replay in progress...");
 
-	ulog_message_header_s message_header;
-	replay_file.seekg(_data_section_start);
-
-	//we know the next message must be an ADD_LOGGED_MSG
-	replay_file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+	const hrt_abstime index_start_time = hrt_absolute_time();
 
-	if (!readAndAddSubscription(replay_file, message_header.msg_size)) {
-		PX4_ERR("Failed to read subscription");
+	if (!indexFileAndAddSubscriptions()) {
+		PX4_ERR("Failed to index replay file");
 		return;
 	}
 
+	PX4_INFO("Indexed %zu messages in %.3lf s", _index.numMessages(),
+		 (double)hrt_elapsed_time(&index_start_time) / 1.e6);
+
 	const uint64_t timestamp_offset = getTimestampOffset();
 	uint32_t nr_published_messages = 0;
-	streampos last_additional_message_pos = _data_section_start;
 
-	while (!should_exit() && replay_file) {
+	//Messages from different subscriptions don't need to be in chronological order,
+	//so the next message of each subscription is kept in a queue ordered by timestamp
+	PendingMessageQueue pending_messages;
 
-		//Find the next message to publish. Messages from different subscriptions don't need
-		//to be in chronological order, so we need to check all subscriptions
-		uint64_t next_file_time = 0;
-		int next_msg_id = -1;
-		bool first_time = true;
+	for (size_t i = 0; i < _subscriptions.size(); ++i) {
+		queueNextMessage(pending_messages, i);
+	}
 
-		for (size_t i = 0; i < _subscriptions.size(); ++i) {
-			const Subscription *subscription = _subscriptions[i];
+	while (!should_exit() && !pending_messages.empty()) {
 
-			if (!subscription) {
-				continue;
-			}
+		const PendingMessage next = pending_messages.top();
+		pending_messages.pop();
 
-			if (subscription->orb_meta && !subscription->ignored) {
-				if (first_time || subscription->next_timestamp < next_file_time) {
-					first_time = false;
-					next_msg_id = (int)i;
-					next_file_time = subscription->next_timestamp;
-				}
-			}
+		Subscription &sub = *_subscriptions[next.msg_id];
+
+		if (!sub.orb_meta) {
+			continue;
 		}
 
-		if (next_msg_id == -1) {
-			break; //no active subscription anymore. We're done.
+		if (sub.next_index != next.index) {
+			//the subscription was advanced outside of the main loop (e.g. by handleTopicUpdate())
+			queueNextMessage(pending_messages, next.msg_id);
+			continue;
 		}
 
-		Subscription &sub = *_subscriptions[next_msg_id];
+		const uint64_t next_file_time = sub.next_timestamp;
 
 		if (next_file_time == 0 || next_file_time < _file_start_time) {
 			//someone didn't set the timestamp properly. Consider the message invalid
-			nextDataMessage(replay_file, sub, next_msg_id);
+			nextDataMessage(sub, next.msg_id);
+			queueNextMessage(pending_messages, next.msg_id);
 			continue;
 		}
 
-		//handle additional messages between last and next published data
-		replay_file.seekg(last_additional_message_pos);
-		streampos next_additional_message_pos = sub.next_read_pos;
-		readAndHandleAdditionalMessages(replay_file, next_additional_message_pos);
-		last_additional_message_pos = next_additional_message_pos;
+		if (next_file_time > _range_end_time) {
+			break; //all remaining messages are after the time range
+		}
+
+		//handle additional messages up to the next published data
+		readAndHandleAdditionalMessages(sub.next_read_pos);
 
 		// Perform scheduled parameter changes
 		while (_next_param_change < _dynamic_parameter_schedule.size() &&
@@ -975,14 +996,15 @@ Replay::run()
 		const uint64_t publish_timestamp = handleTopicDelay(next_file_time, timestamp_offset);
 
 		// It's time to publish
-		readTopicDataToBuffer(sub, replay_file);
+		readTopicDataToBuffer(sub);
 		memcpy(_read_buffer.data() + sub.timestamp_offset, &publish_timestamp, sizeof(uint64_t)); //adjust the timestamp
 
-		if (handleTopicUpdate(sub, _read_buffer.data(), replay_file)) {
+		if (handleTopicUpdate(sub, _read_buffer.data())) {
 			++nr_published_messages;
 		}
 
-		nextDataMessage(replay_file, sub, next_msg_id);
+		nextDataMessage(sub, next.msg_id);
+		queueNextMessage(pending_messages, next.msg_id);
 
 		// TODO: output status (eg. every sec), including total duration...
 	}
@@ -1010,6 +1032,8 @@ Replay::run()
 
 	onExitMainLoop();
 
+	_index.close();
+
 	if (!should_exit()) {
 		replay_file.close();
 		px4_shutdown_request();
@@ -1026,17 +1050,26 @@ Replay::run()
 }
 
 void
-Replay::readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_file)
+Replay::queueNextMessage(PendingMessageQueue &queue, uint16_t msg_id) const
+{
+	const Subscription *subscription = _subscriptions[msg_id];
+
+	if (subscription && subscription->orb_meta && !subscription->ignored) {
+		queue.push(PendingMessage{subscription->next_timestamp, msg_id, subscription->next_index});
+	}
+}
+
+void
+Replay::readTopicDataToBuffer(const Subscription &sub)
 {
 	const size_t msg_read_size = sub.orb_meta->o_size_no_padding;
 	const size_t msg_write_size = sub.orb_meta->o_size;
 	_read_buffer.reserve(msg_write_size);
-	replay_file.seekg(sub.next_read_pos + (streamoff)(ULOG_MSG_HEADER_LEN + 2)); //skip header & msg id
-	replay_file.read((char *)_read_buffer.data(), msg_read_size);
+	memcpy(_read_buffer.data(), _index.payload(sub.next_read_pos) + 2, msg_read_size); //skip header & msg id
 }
 
 bool
-Replay::handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file)
+Replay::handleTopicUpdate(Subscription &sub, void *data)
 {
 	return publishTopic(sub, data);
 }
@@ -1193,6 +1226,28 @@ Replay::applyParams(bool quiet)
 	return ret;
 }
 
+void
+Replay::setTimeRange(uint64_t start_time, uint64_t end_time)
+{
+	_range_start = start_time;
+	_range_end = end_time;
+}
+
+void
+Replay::setTopics(const char *topics)
+{
+	_topics.clear();
+
+	std::stringstream topic_list(topics);
+	std::string topic;
+
+	while (std::getline(topic_list, topic, ',')) {
+		if (!topic.empty()) {
+			_topics.insert(topic);
+		}
+	}
+}
+
 Replay *
 Replay::instantiate(int argc, char *argv[])
 {
@@ -1209,6 +1264,22 @@ Replay::instantiate(int argc, char *argv[])
 		instance = new Replay();
 	}
 
+	if (instance) {
+		const char *range_start = getenv(replay::ENV_START);
+		const char *range_end = getenv(replay::ENV_END);
+
+		if (range_start || range_end) {
+			instance->setTimeRange(range_start ? (uint64_t)(atof(range_start) * 1e6) : 0,
+					       range_end ? (uint64_t)(atof(range_end) * 1e6) : 0);
+		}
+
+		const char *topics = getenv(replay::ENV_TOPICS);
+
+		if (topics) {
+			instance->setTopics(topics);
+		}
+	}
+
 	return instance;
 }
 
@@ -1235,6 +1306,13 @@ The module is typically used together with uORB publisher rules, to specify whic
 The replay module will just publish all messages that are found in the log. It also applies the parameters from
 the log.
 
+Optionally, the replay can be restricted with the following environment variables:
+- `replay_start`, `replay_end`: time range to replay, in seconds since the start of the log.
+- `replay_topics`: comma-separated list of the topics to replay.
+
+If the log contains the index appended by the logger (`SDLOG_INDEX`), only the part of the file
+covering the selection is read.
+
 The replay procedure is documented on the [System-wide Replay](https://docs.px4.io/main/en/debug/system_wide_replay.html)
 page.
 )DESCR_STR");
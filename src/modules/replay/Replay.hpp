@@ -36,11 +36,13 @@
 #include <algorithm>
 #include <fstream>
 #include <map>
+#include <queue>
 #include <vector>
 #include <set>
 #include <string>
 
 #include "definitions.hpp"
+#include "ULogIndex.hpp"
 
 #include <px4_platform_common/module.h>
 #include <uORB/topics/uORBTopics.hpp>
@@ -52,8 +54,9 @@ namespace px4
 /**
  * @class Replay
  * Parses an ULog file and replays it in 'real-time'. The timestamp of each replayed message is offset
- * to match the starting time of replay. It keeps a stream for each subscription to find the next message
- * to replay. This is necessary because data messages from different subscriptions don't need to be in
+ * to match the starting time of replay. The log is memory-mapped and indexed once, and each subscription
+ * keeps a cursor into the index to find its next message to replay. The subscriptions are merged by
+ * timestamp, which is necessary because data messages from different subscriptions don't need to be in
  * monotonic increasing order.
  */
 class Replay : public ModuleBase<Replay>
@@ -94,6 +97,21 @@ public:
 
 	static bool isSetup() { return _replay_file; }
 
+	/**
+	 * Only replay the messages within a time range of the log. If the logger appended an index to the log
+	 * (SDLOG_INDEX), only the part of the file covering the range is read.
+	 * @param start_time start [us], relative to the start of the log
+	 * @param end_time end [us], relative to the start of the log (0 = until the end)
+	 */
+	void setTimeRange(uint64_t start_time, uint64_t end_time);
+
+	/**
+	 * Only replay a subset of the logged topics. If the logger appended an index to the log,
+	 * only the part of the file containing these topics is read.
+	 * @param topics comma-separated list of topic names
+	 */
+	void setTopics(const char *topics);
+
 protected:
 
 	/**
@@ -135,7 +153,8 @@ protected:
 
 		bool ignored = false; ///< if true, it will not be considered for publication in the main loop
 
-		std::streampos next_read_pos;
+		size_t next_read_pos; ///< file offset of the next message
+		size_t next_index = 0; ///< position of the next message in the data message index
 		uint64_t next_timestamp; ///< timestamp of the file
 
 		CompatBase *compat = nullptr;
@@ -190,22 +209,19 @@ protected:
 	 * handle the publication of a topic update
 	 * @return true if published, false otherwise
 	 */
-	virtual bool handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file);
+	virtual bool handleTopicUpdate(Subscription &sub, void *data);
 
 	/**
 	 * read a topic from the file (offset given by the subscription) into _read_buffer
 	 */
-	void readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_file);
+	void readTopicDataToBuffer(const Subscription &sub);
 
 	/**
 	 * Find next data message for this subscription, starting with the stored file offset.
 	 * Skip the first message, and if found, read the timestamp and store the new file offset.
-	 * This also takes care of new subscriptions and parameter updates. When reaching EOF,
-	 * the subscription is set to invalid.
-	 * File seek position is arbitrary after this call.
-	 * @return false on file error
+	 * When reaching the end of the file, the subscription is set to invalid.
 	 */
-	bool nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id);
+	void nextDataMessage(Subscription &subscription, int msg_id);
 
 	virtual uint64_t getTimestampOffset()
 	{
@@ -222,6 +238,12 @@ protected:
 private:
 	std::set<std::string> _overridden_params;
 
+	std::set<std::string> _topics; ///< topics to replay (all if empty)
+	uint64_t _range_start{0}; ///< [us] relative to the file start
+	uint64_t _range_end{0}; ///< [us] relative to the file start, 0 = until the end
+	uint64_t _range_start_time{0}; ///< absolute log timestamp
+	uint64_t _range_end_time{UINT64_MAX}; ///< absolute log timestamp
+
 	struct ParameterChangeEvent {
 		uint64_t timestamp;
 		std::string parameter_name;
@@ -242,12 +264,13 @@ private:
 
 	uint64_t _file_start_time;
 	uint64_t _replay_start_time;
-	std::streampos _data_section_start; ///< first ADD_LOGGED_MSG message
+	size_t _data_section_start; ///< first ADD_LOGGED_MSG message
 
-	/** keep track of file position to avoid adding a subscription multiple times. */
-	std::streampos _subscription_file_pos = 0;
+	ULogIndex _index;
+	size_t _next_additional_message{0}; ///< next entry of _index.additionalMessages() to handle
 
 	int64_t _read_until_file_position = 1ULL << 60; ///< read limit if log contains appended data
+	size_t _appended_data_offset{0}; ///< start of the appended data (e.g. the log index), 0 if none
 
 	float _accumulated_delay{0.f};
 
@@ -262,7 +285,20 @@ private:
 
 	///file parsing methods. They return false, when further parsing should be aborted.
 	bool readFormat(std::ifstream &file, uint16_t msg_size);
-	bool readAndAddSubscription(std::ifstream &file, uint16_t msg_size);
+	bool readAndAddSubscription(size_t message_pos);
+
+	/**
+	 * Index the data section (or only the part of it needed for the configured time range and topics)
+	 * and add the subscriptions.
+	 * @return false on error
+	 */
+	bool indexFileAndAddSubscriptions();
+
+	/**
+	 * Find the first data message of all subscriptions within the time range, and remove the subscriptions
+	 * without data.
+	 */
+	void findFirstDataMessages();
 	bool readFlagBits(std::ifstream &file, uint16_t msg_size);
 
 	/**
@@ -273,14 +309,31 @@ private:
 	bool readDefinitionsAndApplyParams(std::ifstream &file);
 
 	/**
-	 * Read and handle additional messages starting at current file position, while position < end_position.
+	 * Handle the additional messages that were not handled yet, while position < end_position.
 	 * This handles dropout and parameter update messages.
 	 * We need to handle these separately, because they have no timestamp. We look at the file position instead.
-	 * @return false on file error
 	 */
-	bool readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position);
-	bool readDropout(std::ifstream &file, uint16_t msg_size);
+	void readAndHandleAdditionalMessages(size_t end_position);
+	void readDropout(const uint8_t *message, uint16_t msg_size);
 	bool readAndApplyParameter(std::ifstream &file, uint16_t msg_size);
+	bool readAndApplyParameter(const uint8_t *message, uint16_t msg_size);
+
+	/** next message to publish in the main loop, ordered by timestamp and then by msg_id */
+	struct PendingMessage {
+		uint64_t timestamp;
+		uint16_t msg_id;
+		size_t index; ///< Subscription::next_index when queued, to detect entries that became stale
+
+		bool operator>(const PendingMessage &other) const
+		{
+			return timestamp > other.timestamp || (timestamp == other.timestamp && msg_id > other.msg_id);
+		}
+	};
+
+	using PendingMessageQueue = std::priority_queue<PendingMessage, std::vector<PendingMessage>, std::greater<PendingMessage>>;
+
+	/** queue the next message of a subscription, if it has one and takes part in the main loop */
+	void queueNextMessage(PendingMessageQueue &queue, uint16_t msg_id) const;
 
 	static const orb_metadata *findTopic(const std::string &name);
 
@@ -0,0 +1,294 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "ULogIndex.hpp"
+
+#include <mathlib/math/Limits.hpp>
+#include <px4_platform_common/log.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace px4
+{
+
+const std::vector<size_t> ULogIndex::_no_messages;
+
+ULogIndex::~ULogIndex()
+{
+	close();
+}
+
+bool
+ULogIndex::open(const char *file_name)
+{
+	close();
+
+	int fd = ::open(file_name, O_RDONLY);
+
+	if (fd < 0) {
+		PX4_ERR("failed to open %s", file_name);
+		return false;
+	}
+
+	struct stat file_stat;
+
+	if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
+
+	void *data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd); // the mapping stays valid
+
+	if (data == MAP_FAILED) {
+		PX4_ERR("failed to map %s", file_name);
+		return false;
+	}
+
+	_data = (uint8_t *)data;
+	_size = file_stat.st_size;
+
+	return true;
+}
+
+void
+ULogIndex::build(size_t start_offset, int64_t end_offset)
+{
+	_num_messages = 0;
+	_subscription_messages.clear();
+	_additional_messages.clear();
+	_data_messages.clear();
+
+	size_t end = _size;
+
+	if (end_offset >= 0 && (uint64_t)end_offset < end) {
+		end = end_offset;
+	}
+
+	// the range is read front to back exactly once here
+	madvise(_data, _size, MADV_SEQUENTIAL);
+
+	size_t pos = start_offset;
+
+	while (pos + ULOG_MSG_HEADER_LEN <= end) {
+		const ulog_message_header_s message_header = header(pos);
+		const size_t next_pos = pos + ULOG_MSG_HEADER_LEN + message_header.msg_size;
+
+		if (next_pos > end) {
+			break;
+		}
+
+		switch (message_header.msg_type) {
+		case (int)ULogMessageType::ADD_LOGGED_MSG:
+			_subscription_messages.push_back(pos);
+			break;
+
+		case (int)ULogMessageType::DATA:
+			if (message_header.msg_size >= sizeof(uint16_t)) {
+				const uint8_t *message = payload(pos);
+				const uint16_t msg_id = ((uint16_t)message[0]) | (((uint16_t)message[1]) << 8);
+
+				if (msg_id >= _data_messages.size()) {
+					_data_messages.resize(msg_id + 1);
+				}
+
+				_data_messages[msg_id].push_back(pos);
+			}
+
+			break;
+
+		case (int)ULogMessageType::PARAMETER:
+		case (int)ULogMessageType::DROPOUT:
+			_additional_messages.push_back(pos);
+			break;
+
+		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
+		case (int)ULogMessageType::INFO:
+		case (int)ULogMessageType::INFO_MULTIPLE:
+		case (int)ULogMessageType::SYNC:
+		case (int)ULogMessageType::LOGGING:
+		case (int)ULogMessageType::LOGGING_TAGGED:
+		case (int)ULogMessageType::PARAMETER_DEFAULT:
+			break;
+
+		default:
+			//this really should not happen
+			PX4_ERR("unknown log message type %i, size %i (offset %i)",
+				(int)message_header.msg_type, (int)message_header.msg_size, (int)pos);
+			break;
+		}
+
+		++_num_messages;
+		pos = next_pos;
+	}
+
+	// replay then jumps between the topics
+	madvise(_data, _size, MADV_NORMAL);
+}
+
+bool
+ULogIndex::readAppendedIndex(size_t appended_data_offset)
+{
+	_appended_index.clear();
+
+	static constexpr char key_type[] = "uint8_t[";
+	static constexpr char key_name[] = "] " ULOG_INDEX_KEY;
+	const size_t key_type_len = strlen(key_type);
+	const size_t key_name_len = strlen(key_name);
+
+	size_t pos = appended_data_offset;
+
+	// the appended data can contain other messages as well (e.g. hardfault logs)
+	while (pos + ULOG_MSG_HEADER_LEN <= _size) {
+		const ulog_message_header_s message_header = header(pos);
+		const size_t next_pos = pos + ULOG_MSG_HEADER_LEN + message_header.msg_size;
+
+		if (next_pos > _size) {
+			break;
+		}
+
+		if (message_header.msg_type == (int)ULogMessageType::INFO_MULTIPLE && message_header.msg_size >= 2) {
+			const uint8_t *message = payload(pos);
+			const size_t key_len = message[1];
+			const char *key = (const char *)message + 2;
+
+			if (2 + key_len <= message_header.msg_size && key_len > key_type_len + key_name_len
+			    && strncmp(key, key_type, key_type_len) == 0
+			    && strncmp(key + key_len - key_name_len, key_name, key_name_len) == 0) {
+
+				const size_t value_len = message_header.msg_size - 2 - key_len;
+				const size_t num_entries = value_len / sizeof(ulog_index_entry_s);
+				const size_t prev_size = _appended_index.size();
+				_appended_index.resize(prev_size + num_entries);
+				memcpy(_appended_index.data() + prev_size, message + 2 + key_len, num_entries * sizeof(ulog_index_entry_s));
+			}
+		}
+
+		pos = next_pos;
+	}
+
+	return !_appended_index.empty();
+}
+
+bool
+ULogIndex::findAppendedIndexRange(const std::vector<uint16_t> &msg_ids, uint64_t start_time, uint64_t end_time,
+				  size_t &start_offset, size_t &end_offset) const
+{
+	static constexpr size_t offset_invalid = SIZE_MAX;
+
+	uint16_t max_msg_id = 0;
+
+	for (uint16_t msg_id : msg_ids) {
+		max_msg_id = math::max(max_msg_id, msg_id);
+	}
+
+	std::vector<bool> selected(max_msg_id + 1, false);
+
+	for (uint16_t msg_id : msg_ids) {
+		selected[msg_id] = true;
+	}
+
+	// per topic: last sample at or before start_time (or the first one), and the first sample after end_time.
+	// The data messages of a topic are written in timestamp order, so this bounds all messages within the range.
+	std::vector<size_t> topic_start(max_msg_id + 1, offset_invalid);
+	std::vector<size_t> topic_end(max_msg_id + 1, offset_invalid);
+
+	for (const ulog_index_entry_s &entry : _appended_index) {
+		if (entry.msg_type != (int)ULogMessageType::DATA || entry.msg_id > max_msg_id || !selected[entry.msg_id]) {
+			continue;
+		}
+
+		if (topic_start[entry.msg_id] == offset_invalid || entry.timestamp <= start_time) {
+			topic_start[entry.msg_id] = entry.offset;
+		}
+
+		if (topic_end[entry.msg_id] == offset_invalid && entry.timestamp > end_time) {
+			topic_end[entry.msg_id] = entry.offset;
+		}
+	}
+
+	bool found = false;
+	bool until_end = false;
+	size_t range_start = offset_invalid;
+	size_t range_end = 0;
+
+	for (size_t msg_id = 0; msg_id <= max_msg_id; ++msg_id) {
+		if (topic_start[msg_id] == offset_invalid) {
+			continue;
+		}
+
+		found = true;
+		range_start = math::min(range_start, topic_start[msg_id]);
+
+		if (topic_end[msg_id] == offset_invalid) {
+			until_end = true;
+
+		} else {
+			range_end = math::max(range_end, topic_end[msg_id]);
+		}
+	}
+
+	if (!found) {
+		return false;
+	}
+
+	start_offset = range_start;
+
+	if (!until_end) {
+		end_offset = range_end;
+	}
+
+	return true;
+}
+
+void
+ULogIndex::close()
+{
+	if (_data) {
+		munmap(_data, _size);
+		_data = nullptr;
+	}
+
+	_size = 0;
+	_num_messages = 0;
+	_subscription_messages.clear();
+	_additional_messages.clear();
+	_data_messages.clear();
+	_appended_index.clear();
+}
+
+} //namespace px4
@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <logger/messages.h>
+
+namespace px4
+{
+
+/**
+ * @class ULogIndex
+ * Memory-maps an ULog file and indexes (a range of) its data section in a single pass.
+ * For each message id it stores the file offsets of the data messages, so that
+ * a subscription can step to its next message without scanning over the messages
+ * of all the other topics. Subscription, parameter and dropout messages are
+ * indexed separately, as they need to be handled by file position.
+ * If the logger appended its index to the file (@see ulog_index_entry_s), it can be
+ * used to only index the part of the file that covers a time range.
+ */
+class ULogIndex
+{
+public:
+	ULogIndex() = default;
+	~ULogIndex();
+
+	ULogIndex(const ULogIndex &) = delete;
+	ULogIndex &operator=(const ULogIndex &) = delete;
+
+	/**
+	 * Map a file into memory
+	 * @return true on success
+	 */
+	bool open(const char *file_name);
+
+	void close();
+
+	/**
+	 * Build the index for a range of the file, replacing the previous one.
+	 * @param start_offset file offset of the first message to index
+	 * @param end_offset indexing stops at this offset
+	 */
+	void build(size_t start_offset, int64_t end_offset);
+
+	/**
+	 * Read the index appended by the logger
+	 * @param appended_data_offset file offset of the appended data
+	 * @return true if an index was found
+	 */
+	bool readAppendedIndex(size_t appended_data_offset);
+
+	/** entries of the index appended by the logger, in file order */
+	const std::vector<ulog_index_entry_s> &appendedIndex() const { return _appended_index; }
+
+	/**
+	 * Find the range of the file containing all data messages of a set of topics within a time range,
+	 * using the appended index.
+	 * @param msg_ids topics to consider
+	 * @param start_time absolute log timestamp [us]
+	 * @param end_time absolute log timestamp [us]
+	 * @param start_offset returned file offset where to start indexing
+	 * @param end_offset returned file offset where to stop indexing (unchanged if the range extends to the end)
+	 * @return false if the appended index has no data for any of the topics
+	 */
+	bool findAppendedIndexRange(const std::vector<uint16_t> &msg_ids, uint64_t start_time, uint64_t end_time,
+				    size_t &start_offset, size_t &end_offset) const;
+
+	/** header of the message at a given (indexed) file offset */
+	ulog_message_header_s header(size_t offset) const
+	{
+		ulog_message_header_s message_header;
+		memcpy(&message_header, _data + offset, ULOG_MSG_HEADER_LEN);
+		return message_header;
+	}
+
+	/** message content following the header at a given (indexed) file offset */
+	const uint8_t *payload(size_t offset) const { return _data + offset + ULOG_MSG_HEADER_LEN; }
+
+	/** offsets of all ADD_LOGGED_MSG messages, in file order */
+	const std::vector<size_t> &subscriptionMessages() const { return _subscription_messages; }
+
+	/** offsets of all PARAMETER and DROPOUT messages, in file order */
+	const std::vector<size_t> &additionalMessages() const { return _additional_messages; }
+
+	/** offsets of all DATA messages for a message id, in file order */
+	const std::vector<size_t> &dataMessages(uint16_t msg_id) const
+	{
+		return msg_id < _data_messages.size() ? _data_messages[msg_id] : _no_messages;
+	}
+
+	size_t numMessages() const { return _num_messages; }
+
+private:
+	uint8_t *_data{nullptr};
+	size_t _size{0};
+	size_t _num_messages{0};
+
+	std::vector<size_t> _subscription_messages;
+	std::vector<size_t> _additional_messages;
+	std::vector<std::vector<size_t>> _data_messages; ///< indexed by msg_id
+	std::vector<ulog_index_entry_s> _appended_index;
+
+	static const std::vector<size_t> _no_messages;
+};
+
+} //namespace px4
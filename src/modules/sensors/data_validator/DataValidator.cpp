@@ -44,14 +44,21 @@
 #include <px4_platform_common/log.h>
 #include <drivers/drv_hrt.h>
 
-void DataValidator::put(uint64_t timestamp, float val, uint32_t error_count_in, uint8_t priority_in)
+bool DataValidator::put(uint64_t timestamp, float val, uint32_t error_count_in, uint8_t priority_in)
 {
 	float data[dimensions] = {val};  // sets the first value and all others to 0
-	put(timestamp, data, error_count_in, priority_in);
+	return put(timestamp, data, error_count_in, priority_in);
 }
 
-void DataValidator::put(uint64_t timestamp, const float val[dimensions], uint32_t error_count_in, uint8_t priority_in)
+bool DataValidator::put(uint64_t timestamp, const float val[dimensions], uint32_t error_count_in, uint8_t priority_in)
 {
+	// snapshot of everything confidence() depends on, apart from the timeout
+	const bool no_data_prev = (_time_last == 0);
+	const uint32_t error_count_prev = _error_count;
+	const int error_density_prev = _error_density;
+	const uint8_t priority_prev = _priority;
+	const bool stale_prev = (_value_equal_count > _value_equal_count_threshold);
+
 	_event_count++;
 
 	if (error_count_in > _error_count) {
@@ -77,7 +84,6 @@ void DataValidator::put(uint64_t timestamp, const float val[dimensions], uint32_
 				float delta_val = lp_val - _mean[i];
 				_mean[i] += delta_val / _event_count;
 				_M2[i] += delta_val * (lp_val - _mean[i]);
-				_rms[i] = sqrtf(_M2[i] / (_event_count - 1));
 
 				if (fabsf(_value[i] - val[i]) < 0.000001f) {
 					_value_equal_count++;
@@ -95,6 +101,23 @@ void DataValidator::put(uint64_t timestamp, const float val[dimensions], uint32_
 	}
 
 	_time_last = timestamp;
+
+	return no_data_prev
+	       || (_error_count != error_count_prev)
+	       || (_error_density != error_density_prev)
+	       || (_priority != priority_prev)
+	       || ((_value_equal_count > _value_equal_count_threshold) != stale_prev);
+}
+
+float *DataValidator::rms()
+{
+	if (_event_count > 1) {
+		for (unsigned i = 0; i < dimensions; i++) {
+			_rms[i] = sqrtf(_M2[i] / (_event_count - 1));
+		}
+	}
+
+	return _rms;
 }
 
 float DataValidator::confidence(uint64_t timestamp)
@@ -150,6 +173,6 @@ void DataValidator::print()
 
 	for (unsigned i = 0; i < dimensions; i++) {
 		PX4_INFO_RAW("\tval: %8.4f, lp: %8.4f mean dev: %8.4f RMS: %8.4f conf: %8.4f\n", (double)_value[i],
-			     (double)_lp[i], (double)_mean[i], (double)_rms[i], (double)confidence(hrt_absolute_time()));
+			     (double)_lp[i], (double)_mean[i], (double)rms()[i], (double)confidence(hrt_absolute_time()));
 	}
 }
@@ -56,15 +56,17 @@ public:
 	 * Put an item into the validator.
 	 *
 	 * @param val		Item to put
+	 * @return		true if the inputs of confidence() other than the timeout changed
 	 */
-	void put(uint64_t timestamp, float val, uint32_t error_count, uint8_t priority);
+	bool put(uint64_t timestamp, float val, uint32_t error_count, uint8_t priority);
 
 	/**
 	 * Put a 3D item into the validator.
 	 *
 	 * @param val		Item to put
+	 * @return		true if the inputs of confidence() other than the timeout changed
 	 */
-	void put(uint64_t timestamp, const float val[dimensions], uint32_t error_count, uint8_t priority);
+	bool put(uint64_t timestamp, const float val[dimensions], uint32_t error_count, uint8_t priority);
 
 	/**
 	 * Get the next sibling in the group
@@ -103,6 +105,12 @@ public:
 	 */
 	bool used() const { return (_time_last > 0); }
 
+	/**
+	 * Get the timestamp of the last item
+	 * @return		the timestamp, zero if no data was received yet
+	 */
+	uint64_t time_last() const { return _time_last; }
+
 	/**
 	 * Get the priority of this validator
 	 * @return		the stored priority
@@ -122,9 +130,9 @@ public:
 
 	/**
 	 * Get the RMS values of this validator
-	 * @return		the stored RMS
+	 * @return		the RMS, evaluated from the running variance on request
 	 */
-	float *rms() { return _rms; }
+	float *rms();
 
 	/**
 	 * Print the validator value
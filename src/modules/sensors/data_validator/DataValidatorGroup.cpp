@@ -92,6 +92,7 @@ DataValidator *DataValidatorGroup::add_new_validator()
 	_last->setSibling(validator);
 	_last = validator;
 	_last->set_timeout(_timeout_interval_us);
+	_vote_valid = false;
 	return _last;
 }
 
@@ -106,6 +107,7 @@ void DataValidatorGroup::set_timeout(uint32_t timeout_interval_us)
 	}
 
 	_timeout_interval_us = timeout_interval_us;
+	_vote_valid = false;
 }
 
 void DataValidatorGroup::set_equal_value_threshold(uint32_t threshold)
@@ -117,6 +119,8 @@ void DataValidatorGroup::set_equal_value_threshold(uint32_t threshold)
 		next->set_equal_value_threshold(threshold);
 		next = next->sibling();
 	}
+
+	_vote_valid = false;
 }
 
 void DataValidatorGroup::put(unsigned index, uint64_t timestamp, const float val[3], uint32_t error_count,
@@ -128,7 +132,13 @@ void DataValidatorGroup::put(unsigned index, uint64_t timestamp, const float val
 
 	while (next != nullptr) {
 		if (i == index) {
-			next->put(timestamp, val, error_count, priority);
+			// a validator that had timed out at the last vote can recover with this sample
+			const bool timed_out = next->used() && (_vote_timestamp > next->time_last() + next->get_timeout());
+
+			if (next->put(timestamp, val, error_count, priority) || timed_out) {
+				_vote_valid = false;
+			}
+
 			break;
 		}
 
@@ -139,6 +149,11 @@ void DataValidatorGroup::put(unsigned index, uint64_t timestamp, const float val
 
 float *DataValidatorGroup::get_best(uint64_t timestamp, int *index)
 {
+	// nothing the vote depends on changed since the last stable vote, it would select the same sensor again
+	if (_vote_valid && (timestamp <= _vote_valid_until)) {
+		*index = _curr_best;
+		return (_best) ? _best->value() : nullptr;
+	}
 
 	DataValidator *next = _first;
 
@@ -176,9 +191,17 @@ float *DataValidatorGroup::get_best(uint64_t timestamp, int *index)
 	i = 0;
 	next = _first;
 
+	uint64_t vote_valid_until = UINT64_MAX;
+
 	while (next != nullptr) {
 		float confidence = next->confidence(timestamp);
 
+		const uint64_t timeout = next->time_last() + next->get_timeout();
+
+		if (next->used() && (timestamp <= timeout) && (timeout < vote_valid_until)) {
+			vote_valid_until = timeout;
+		}
+
 		/*
 		 * Switch if:
 		 * 1) the confidence is higher and priority is equal or higher
@@ -198,9 +221,17 @@ float *DataValidatorGroup::get_best(uint64_t timestamp, int *index)
 		i++;
 	}
 
+	_best = best;
+	_vote_timestamp = timestamp;
+	_vote_valid_until = vote_valid_until;
+	_vote_valid = true;
+
 	/* the current best sensor is not matching the previous best sensor,
 	 * or the only sensor went bad */
 	if (max_index != _curr_best || ((max_confidence < FLT_EPSILON) && (_curr_best >= 0))) {
+		// the vote changed or counts failsafes, evaluate it again on the next call
+		_vote_valid = false;
+
 		bool true_failsafe = true;
 
 		/* check whether the switch was a failsafe or preferring a higher priority sensor */
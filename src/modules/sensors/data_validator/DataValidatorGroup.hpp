@@ -72,6 +72,11 @@ public:
 	/**
 	 * Get the best data triplet of the group
 	 *
+	 * The vote is only re-evaluated if a validator reported a change of its confidence
+	 * inputs since the last stable vote or if one of them can have timed out meanwhile,
+	 * otherwise the previous result is returned. Data must therefore be added through
+	 * put() of the group and not directly to the validators.
+	 *
 	 * @return		pointer to the array of best values
 	 */
 	float *get_best(uint64_t timestamp, int *index);
@@ -144,6 +149,11 @@ private:
 
 	unsigned _toggle_count{0}; /**< number of back and forth switches between two sensors */
 
+	DataValidator *_best{nullptr}; /**< validator selected by the last vote */
+	uint64_t _vote_timestamp{0};   /**< timestamp of the last evaluated vote */
+	uint64_t _vote_valid_until{0}; /**< the first validator not timed out at the last vote times out after this time */
+	bool _vote_valid{false};       /**< the last vote was stable and no validator changed since */
+
 	static constexpr float MIN_REGULAR_CONFIDENCE = 0.9f;
 
 	/* we don't want this class to be copied */
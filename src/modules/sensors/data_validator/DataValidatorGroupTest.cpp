@@ -0,0 +1,174 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the DataValidatorGroup vote
+ * Run this test only using make tests TESTFILTER=DataValidatorGroup
+ */
+
+#include <gtest/gtest.h>
+
+#include "DataValidatorGroup.hpp"
+
+class DataValidatorGroupTest : public ::testing::Test
+{
+public:
+	// deterministic pseudo-random sample in [0, 1]
+	float random()
+	{
+		_seed = _seed * 1664525u + 1013904223u;
+		return static_cast<float>(_seed >> 8) / static_cast<float>(1u << 24);
+	}
+
+	void putRandom(DataValidatorGroup &group, unsigned index, uint64_t timestamp, uint8_t priority)
+	{
+		float data[DataValidator::dimensions];
+
+		for (unsigned axis = 0; axis < DataValidator::dimensions; axis++) {
+			data[axis] = random();
+		}
+
+		group.put(index, timestamp, data, 0, priority);
+	}
+
+	static constexpr uint64_t START_TIME_US = 1000000;
+	static constexpr uint32_t TIMEOUT_US = 20000;
+	static constexpr uint64_t SAMPLE_INTERVAL_US = 1000;
+
+private:
+	uint32_t _seed{1};
+};
+
+TEST_F(DataValidatorGroupTest, cachedVoteMatchesFullEvaluation)
+{
+	// GIVEN: 4 IMUs voted with the cached vote and with a vote that is fully evaluated on every call
+	static constexpr unsigned NUM_IMUS = 4;
+	DataValidatorGroup group(NUM_IMUS);
+	DataValidatorGroup group_reference(NUM_IMUS);
+	group.set_timeout(TIMEOUT_US);
+	group_reference.set_timeout(TIMEOUT_US);
+
+	for (int cycle = 0; cycle < 3000; cycle++) {
+		const uint64_t timestamp = START_TIME_US + cycle * SAMPLE_INTERVAL_US;
+
+		// WHEN: the IMUs get errors, time out, get stuck and change priority
+		for (unsigned imu = 0; imu < NUM_IMUS; imu++) {
+			// IMU 1 stops publishing for a while
+			if ((imu == 1) && (cycle >= 1000) && (cycle < 1500)) {
+				continue;
+			}
+
+			float data[DataValidator::dimensions];
+
+			for (unsigned axis = 0; axis < DataValidator::dimensions; axis++) {
+				// IMU 2 gets stuck on a constant value
+				data[axis] = ((imu == 2) && (cycle >= 2000)) ? 1.f : random();
+			}
+
+			// IMU 0 reports a burst of errors
+			const uint32_t error_count = ((imu == 0) && (cycle >= 500)) ? (uint32_t)((cycle < 550) ? (cycle - 500) : 50) : 0;
+
+			// IMU 3 becomes the highest priority
+			const uint8_t priority = ((imu == 3) && (cycle >= 2500)) ? 100 : (uint8_t)(90 - 10 * imu);
+
+			group.put(imu, timestamp, data, error_count, priority);
+			group_reference.put(imu, timestamp, data, error_count, priority);
+		}
+
+		int best_index = -1;
+		int best_index_reference = -1;
+		float *best = group.get_best(timestamp, &best_index);
+
+		// reconfiguring invalidates the cached vote and forces a full evaluation
+		group_reference.set_timeout(TIMEOUT_US);
+		float *best_reference = group_reference.get_best(timestamp, &best_index_reference);
+
+		// THEN: both votes select the same sensor and count the same failovers
+		ASSERT_EQ(best_index, best_index_reference) << "cycle " << cycle;
+		ASSERT_EQ(best == nullptr, best_reference == nullptr) << "cycle " << cycle;
+
+		if (best != nullptr) {
+			EXPECT_EQ(best[0], best_reference[0]) << "cycle " << cycle;
+		}
+
+		EXPECT_EQ(group.failover_count(), group_reference.failover_count()) << "cycle " << cycle;
+		EXPECT_EQ(group.failover_index(), group_reference.failover_index()) << "cycle " << cycle;
+
+		for (unsigned imu = 0; imu < NUM_IMUS; imu++) {
+			EXPECT_EQ(group.get_sensor_state(imu), group_reference.get_sensor_state(imu)) << "cycle " << cycle << " imu " << imu;
+		}
+	}
+
+	// the scenario has to trigger failovers for the comparison to be meaningful
+	EXPECT_GT(group.failover_count(), 0u);
+}
+
+TEST_F(DataValidatorGroupTest, timeoutWithoutNewData)
+{
+	// GIVEN: two sensors, the first one with the higher priority is selected
+	DataValidatorGroup group(2);
+	group.set_timeout(TIMEOUT_US);
+
+	uint64_t timestamp = START_TIME_US;
+	int best_index = -1;
+
+	for (int cycle = 0; cycle < 100; cycle++) {
+		timestamp += SAMPLE_INTERVAL_US;
+		putRandom(group, 0, timestamp, 100);
+		putRandom(group, 1, timestamp, 50);
+		group.get_best(timestamp, &best_index);
+	}
+
+	EXPECT_EQ(best_index, 0);
+
+	// WHEN: only the second sensor keeps publishing
+	const uint64_t last_sample_0 = timestamp;
+
+	for (int cycle = 0; cycle < 100; cycle++) {
+		timestamp += SAMPLE_INTERVAL_US;
+		putRandom(group, 1, timestamp, 50);
+		group.get_best(timestamp, &best_index);
+
+		// THEN: the first sensor stays selected until it times out, even though none of its inputs changed
+		if (timestamp <= last_sample_0 + TIMEOUT_US) {
+			EXPECT_EQ(best_index, 0) << "cycle " << cycle;
+
+		} else {
+			EXPECT_EQ(best_index, 1) << "cycle " << cycle;
+		}
+	}
+
+	EXPECT_EQ(group.failover_count(), 1u);
+	EXPECT_EQ(group.failover_index(), 0);
+}
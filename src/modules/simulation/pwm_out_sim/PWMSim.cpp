@@ -50,6 +50,7 @@ PWMSim::PWMSim(bool hil_mode_enabled) :
 	_mixing_output.setAllMaxValues(PWM_SIM_PWM_MAX_MAGIC);
 
 	_mixing_output.setIgnoreLockdown(hil_mode_enabled);
+	_mixing_output.setOutputContinuationAllowed(true);
 }
 
 PWMSim::~PWMSim()
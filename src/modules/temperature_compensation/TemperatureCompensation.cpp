@@ -297,6 +297,7 @@ int TemperatureCompensation::parameters_update()
 	 */
 	_gyro_data.reset_temperature();
 	_accel_data.reset_temperature();
+	_mag_data.reset_temperature();
 	_baro_data.reset_temperature();
 
 	return ret;
@@ -411,7 +412,11 @@ int TemperatureCompensation::set_sensor_id(uint32_t device_id, int topic_instanc
 {
 	for (int i = 0; i < sensor_count_max; ++i) {
 		if (device_id == (uint32_t)sensor_cal_data[i].ID) {
-			sensor_data.device_mapping[topic_instance] = i;
+			if (sensor_data.device_mapping[topic_instance] != i) {
+				sensor_data.device_mapping[topic_instance] = i;
+				sensor_data.offsets_temperature[topic_instance] = NAN;
+			}
+
 			return i;
 		}
 	}
@@ -433,8 +438,12 @@ int TemperatureCompensation::update_offsets_accel(int topic_instance, float temp
 		return -1;
 	}
 
-	// Calculate and update the offsets
-	calc_thermal_offsets_3D(_parameters.accel_cal_data[mapping], temperature, offsets);
+	// Calculate and update the offsets, the polynomial is only re-evaluated once the temperature left the cached band
+	if (_accel_data.refresh_offsets(topic_instance, temperature)) {
+		calc_thermal_offsets_3D(_parameters.accel_cal_data[mapping], temperature, _accel_data.offsets[topic_instance]);
+	}
+
+	memcpy(offsets, _accel_data.offsets[topic_instance], sizeof(_accel_data.offsets[topic_instance]));
 
 	// Check if temperature delta is large enough to warrant a new publication
 	if (fabsf(temperature - _accel_data.last_temperature[topic_instance]) > 1.0f) {
@@ -459,8 +468,12 @@ int TemperatureCompensation::update_offsets_gyro(int topic_instance, float tempe
 		return -1;
 	}
 
-	// Calculate and update the offsets
-	calc_thermal_offsets_3D(_parameters.gyro_cal_data[mapping], temperature, offsets);
+	// Calculate and update the offsets, the polynomial is only re-evaluated once the temperature left the cached band
+	if (_gyro_data.refresh_offsets(topic_instance, temperature)) {
+		calc_thermal_offsets_3D(_parameters.gyro_cal_data[mapping], temperature, _gyro_data.offsets[topic_instance]);
+	}
+
+	memcpy(offsets, _gyro_data.offsets[topic_instance], sizeof(_gyro_data.offsets[topic_instance]));
 
 	// Check if temperature delta is large enough to warrant a new publication
 	if (fabsf(temperature - _gyro_data.last_temperature[topic_instance]) > 1.0f) {
@@ -485,8 +498,12 @@ int TemperatureCompensation::update_offsets_mag(int topic_instance, float temper
 		return -1;
 	}
 
-	// Calculate and update the offsets
-	calc_thermal_offsets_3D(_parameters.mag_cal_data[mapping], temperature, offsets);
+	// Calculate and update the offsets, the polynomial is only re-evaluated once the temperature left the cached band
+	if (_mag_data.refresh_offsets(topic_instance, temperature)) {
+		calc_thermal_offsets_3D(_parameters.mag_cal_data[mapping], temperature, _mag_data.offsets[topic_instance]);
+	}
+
+	memcpy(offsets, _mag_data.offsets[topic_instance], sizeof(_mag_data.offsets[topic_instance]));
 
 	// Check if temperature delta is large enough to warrant a new publication
 	if (fabsf(temperature - _mag_data.last_temperature[topic_instance]) > 1.0f) {
@@ -511,8 +528,12 @@ int TemperatureCompensation::update_offsets_baro(int topic_instance, float tempe
 		return -1;
 	}
 
-	// Calculate and update the offsets
-	calc_thermal_offsets_1D(_parameters.baro_cal_data[mapping], temperature, *offsets);
+	// Calculate and update the offsets, the polynomial is only re-evaluated once the temperature left the cached band
+	if (_baro_data.refresh_offsets(topic_instance, temperature)) {
+		calc_thermal_offsets_1D(_parameters.baro_cal_data[mapping], temperature, _baro_data.offsets[topic_instance][0]);
+	}
+
+	*offsets = _baro_data.offsets[topic_instance][0];
 
 	// Check if temperature delta is large enough to warrant a new publication
 	if (fabsf(temperature - _baro_data.last_temperature[topic_instance]) > 1.0f) {
@@ -537,6 +558,9 @@ void TemperatureCompensation::print_status()
 				PX4_INFO("  using device ID %" PRId32 " for topic instance %i", _parameters.accel_cal_data[mapping].ID, i);
 			}
 		}
+
+		PX4_INFO("  offset evaluations: %" PRIu32 ", cached: %" PRIu32, _accel_data.offsets_evaluated,
+			 _accel_data.offsets_cached);
 	}
 
 	PX4_INFO(" gyro: enabled: %" PRId32, _parameters.gyro_tc_enable);
@@ -549,6 +573,9 @@ void TemperatureCompensation::print_status()
 				PX4_INFO("  using device ID %" PRId32 " for topic instance %i", _parameters.gyro_cal_data[mapping].ID, i);
 			}
 		}
+
+		PX4_INFO("  offset evaluations: %" PRIu32 ", cached: %" PRIu32, _gyro_data.offsets_evaluated,
+			 _gyro_data.offsets_cached);
 	}
 
 	PX4_INFO(" mag: enabled: %" PRId32, _parameters.mag_tc_enable);
@@ -561,6 +588,9 @@ void TemperatureCompensation::print_status()
 				PX4_INFO("  using device ID %" PRId32 " for topic instance %i", _parameters.mag_cal_data[mapping].ID, i);
 			}
 		}
+
+		PX4_INFO("  offset evaluations: %" PRIu32 ", cached: %" PRIu32, _mag_data.offsets_evaluated,
+			 _mag_data.offsets_cached);
 	}
 
 	PX4_INFO(" baro: enabled: %" PRId32, _parameters.baro_tc_enable);
@@ -573,6 +603,9 @@ void TemperatureCompensation::print_status()
 				PX4_INFO("  using device ID %" PRId32 " for topic instance %i", _parameters.baro_cal_data[mapping].ID, i);
 			}
 		}
+
+		PX4_INFO("  offset evaluations: %" PRIu32 ", cached: %" PRIu32, _baro_data.offsets_evaluated,
+			 _baro_data.offsets_cached);
 	}
 }
 
@@ -260,6 +260,9 @@ private:
 	Parameters _parameters;
 
 
+	// temperature band around the last evaluation within which the cached offsets are reused (deg C)
+	static constexpr float OFFSETS_TEMPERATURE_BAND = 0.1f;
+
 	struct PerSensorData {
 
 		PerSensorData()
@@ -267,6 +270,7 @@ private:
 			for (int i = 0; i < SENSOR_COUNT_MAX; ++i) {
 				device_mapping[i] = 255;
 				last_temperature[i] = -100.0f;
+				offsets_temperature[i] = NAN;
 			}
 		}
 
@@ -274,11 +278,34 @@ private:
 		{
 			for (int i = 0; i < SENSOR_COUNT_MAX; ++i) {
 				last_temperature[i] = -100.0f;
+				offsets_temperature[i] = NAN;
+			}
+		}
+
+		/**
+		 * Check whether the cached offsets of a topic instance need to be re-evaluated
+		 * @return true if the temperature left the band of the cached offsets (the caller then updates them)
+		 */
+		bool refresh_offsets(int topic_instance, float temperature)
+		{
+			if (fabsf(temperature - offsets_temperature[topic_instance]) < OFFSETS_TEMPERATURE_BAND) {
+				offsets_cached++;
+				return false;
 			}
+
+			offsets_temperature[topic_instance] = temperature;
+			offsets_evaluated++;
+			return true;
 		}
 
 		uint8_t device_mapping[SENSOR_COUNT_MAX] {}; /// map a topic instance to the parameters index
 		float last_temperature[SENSOR_COUNT_MAX] {};
+
+		float offsets[SENSOR_COUNT_MAX][3] {}; /// cached offsets per topic instance
+		float offsets_temperature[SENSOR_COUNT_MAX] {}; /// temperature the cached offsets were evaluated at (NAN: invalid)
+
+		uint32_t offsets_evaluated{0};
+		uint32_t offsets_cached{0};
 	};
 
 	PerSensorData _accel_data;
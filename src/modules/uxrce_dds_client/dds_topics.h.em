@@ -39,6 +39,10 @@ static constexpr int max_topic_size = 512;
 static_assert(sizeof(@(pub['simple_base_type'])_s) <= max_topic_size, "topic too large, increase max_topic_size");
 @[    end for]@
 
+// XRCE framing overhead, used to decide when a batched best-effort frame is full
+static constexpr uint32_t xrce_frame_header_size = 8;      // session header incl. client key
+static constexpr uint32_t xrce_submessage_header_size = 8; // submessage header + WRITE_DATA object request
+
 struct SendSubscription {
 	const struct orb_metadata *orb_meta;
 	uxrObjectId data_writer;
@@ -46,6 +50,7 @@ struct SendSubscription {
 	const char* topic;
 	uint32_t topic_size;
 	UcdrSerializeMethod ucdr_serialize_method;
+	uint32_t interval_ms; ///< uORB update interval, 0 for UXRCE_DEFAULT_POLL_RATE
 };
 
 // Subscribers for messages to send
@@ -58,6 +63,7 @@ struct SendTopicsSubs {
 			  "@(pub['topic'])",
 			  ucdr_topic_size_@(pub['simple_base_type'])(),
 			  &ucdr_serialize_@(pub['simple_base_type']),
+			  @(pub['interval_ms']),
 			},
 @[    end for]@
 	};
@@ -65,9 +71,14 @@ struct SendTopicsSubs {
 	px4_pollfd_struct_t fds[@(len(publications))] {};
 
 	uint32_t num_payload_sent{};
+	uint32_t num_frames_sent{};
+
+	// topics are published to shared memory only (see ShmUorbPublisher), not to the Agent
+	bool shm_only{false};
 
 	void init();
-	void update(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId best_effort_stream_id, uxrObjectId participant_id, const char *client_namespace);
+	void update(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId best_effort_stream_id, uxrObjectId participant_id, const char *client_namespace,
+		    bool batched = false, uint32_t mtu = 0);
 	void reset();
 };
 
@@ -75,27 +86,38 @@ void SendTopicsSubs::init() {
 	for (unsigned idx = 0; idx < sizeof(send_subscriptions)/sizeof(send_subscriptions[0]); ++idx) {
 		fds[idx].fd = orb_subscribe(send_subscriptions[idx].orb_meta);
 		fds[idx].events = POLLIN;
-		orb_set_interval(fds[idx].fd, UXRCE_DEFAULT_POLL_RATE);
+		const uint32_t interval_ms = send_subscriptions[idx].interval_ms;
+		orb_set_interval(fds[idx].fd, interval_ms > 0 ? interval_ms : UXRCE_DEFAULT_POLL_RATE);
 	}
 }
 
 void SendTopicsSubs::reset() {
 	num_payload_sent = 0;
+	num_frames_sent = 0;
 	for (unsigned idx = 0; idx < sizeof(send_subscriptions)/sizeof(send_subscriptions[0]); ++idx) {
 		send_subscriptions[idx].data_writer = uxr_object_id(0, UXR_INVALID_ID);
 	}
 };
 
-void SendTopicsSubs::update(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId best_effort_stream_id, uxrObjectId participant_id, const char *client_namespace)
+void SendTopicsSubs::update(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId best_effort_stream_id, uxrObjectId participant_id, const char *client_namespace,
+			    bool batched, uint32_t mtu)
 {
 	int64_t time_offset_us = session->time_offset / 1000; // ns -> us
 
 	alignas(sizeof(uint64_t)) char topic_data[max_topic_size];
 
+	// bytes currently queued in the best-effort output stream (batched mode only)
+	uint32_t frame_size = 0;
+
 	for (unsigned idx = 0; idx < sizeof(send_subscriptions)/sizeof(send_subscriptions[0]); ++idx) {
 		if (fds[idx].revents & POLLIN) {
 			// Topic updated, copy data and send
 			orb_copy(send_subscriptions[idx].orb_meta, fds[idx].fd, &topic_data);
+
+			if (shm_only) {
+				continue;
+			}
+
 			if (send_subscriptions[idx].data_writer.id == UXR_INVALID_ID) {
 				// data writer not created yet
 				create_data_writer(session, reliable_out_stream_id, participant_id, static_cast<ORB_ID>(send_subscriptions[idx].orb_meta->o_id), client_namespace, send_subscriptions[idx].topic,
@@ -106,12 +128,33 @@ void SendTopicsSubs::update(uxrSession *session, uxrStreamId reliable_out_stream
 
 				ucdrBuffer ub;
 				uint32_t topic_size = send_subscriptions[idx].topic_size;
+
+				// submessages are 4 byte aligned within the frame
+				const uint32_t submessage_size = xrce_submessage_header_size + ((topic_size + 3u) & ~3u);
+
+				if (batched && frame_size > 0 && (frame_size + submessage_size > mtu)) {
+					// frame full, send what we have and start a new one
+					uxr_flash_output_streams(session);
+					++num_frames_sent;
+					frame_size = 0;
+				}
+
 				if (uxr_prepare_output_stream(session, best_effort_stream_id, send_subscriptions[idx].data_writer, &ub, topic_size) != UXR_INVALID_REQUEST_ID) {
 					send_subscriptions[idx].ucdr_serialize_method(&topic_data, ub, time_offset_us);
-					// TODO: fill up the MTU and then flush, which reduces the packet overhead
-					uxr_flash_output_streams(session);
 					num_payload_sent += topic_size;
 
+					if (batched) {
+						if (frame_size == 0) {
+							frame_size = xrce_frame_header_size;
+						}
+
+						frame_size += submessage_size;
+
+					} else {
+						uxr_flash_output_streams(session);
+						++num_frames_sent;
+					}
+
 				} else {
 					//PX4_ERR("Error uxr_prepare_output_stream UXR_INVALID_REQUEST_ID %s", send_subscriptions[idx].subscription.get_topic()->o_name);
 				}
@@ -122,6 +165,11 @@ void SendTopicsSubs::update(uxrSession *session, uxrStreamId reliable_out_stream
 
 		}
 	}
+
+	if (frame_size > 0) {
+		// the remaining partial frame is sent by the following uxr_run_session_timeout()
+		++num_frames_sent;
+	}
 }
 
 // Publishers for received messages
@@ -103,6 +103,12 @@ pubs_not_empty = msg_map['publications'] is not None
 if pubs_not_empty:
     for p in msg_map['publications']:
         process_message_type(p)
+        # optional 'rate_limit' [Hz] -> uORB subscription interval [ms] (uint32_t), 0 uses the default poll rate
+        rate_limit = p.get('rate_limit', None)
+        if rate_limit is not None and float(rate_limit) > 0:
+            p['interval_ms'] = min(0xFFFFFFFF, max(1, int(round(1000. / float(rate_limit)))))
+        else:
+            p['interval_ms'] = 0
 
 merged_em_globals['publications'] = msg_map['publications'] if pubs_not_empty else []
 
@@ -148,6 +148,7 @@ bool UxrceddsClient::init()
 
 			_comm = &_transport_serial->comm;
 			_fd = fd;
+			_mtu = UXR_CONFIG_SERIAL_TRANSPORT_MTU;
 
 			return true;
 		}
@@ -172,6 +173,7 @@ bool UxrceddsClient::init()
 
 			_comm = &_transport_udp->comm;
 			_fd = _transport_udp->platform.poll_fd.fd;
+			_mtu = UXR_CONFIG_UDP_TRANSPORT_MTU;
 
 			return true;
 
@@ -214,6 +216,9 @@ void UxrceddsClient::deinit()
 UxrceddsClient::~UxrceddsClient()
 {
 	delete _subs;
+#if defined(__PX4_POSIX)
+	delete _shm_publisher;
+#endif
 	delete _pubs;
 
 	delete_repliers();
@@ -340,6 +345,25 @@ void UxrceddsClient::run()
 		return;
 	}
 
+#if defined(__PX4_POSIX)
+
+	if (_param_uxrce_dds_shm.get() > 0) {
+		// published from the work queue, independent of the Agent session
+		_shm_publisher = new ShmUorbPublisher("uxrce_dds");
+
+		if (_shm_publisher) {
+			for (const auto &sub : _subs->send_subscriptions) {
+				_shm_publisher->add(sub.orb_meta, sub.interval_ms > 0 ? sub.interval_ms : UXRCE_DEFAULT_POLL_RATE);
+			}
+
+			_shm_publisher->start();
+		}
+
+		_subs->shm_only = (_param_uxrce_dds_shm.get() == 2);
+	}
+
+#endif
+
 	while (!should_exit()) {
 
 		while (!should_exit() && !_comm) {
@@ -351,6 +375,7 @@ void UxrceddsClient::run()
 
 		_participant_config = static_cast<ParticipantConfig>(_param_uxrce_dds_ptcfg.get());
 		_synchronize_timestamps = (_param_uxrce_dds_synct.get() > 0);
+		_batch_output = (_param_uxrce_dds_batch.get() > 0);
 
 		bool got_response = false;
 
@@ -513,6 +538,7 @@ void UxrceddsClient::run()
 		bool had_ping_reply = false;
 		uint32_t last_num_payload_sent{};
 		uint32_t last_num_payload_received{};
+		uint32_t last_num_frames_sent{};
 		int poll_error_counter = 0;
 
 		_subs->init();
@@ -537,7 +563,7 @@ void UxrceddsClient::run()
 
 			/* Handle the poll results */
 			if (poll > 0) {
-				_subs->update(&session, reliable_out, best_effort_out, participant_id, _client_namespace);
+				_subs->update(&session, reliable_out, best_effort_out, participant_id, _client_namespace, _batch_output, _mtu);
 
 			} else {
 				if (poll < 0) {
@@ -551,7 +577,7 @@ void UxrceddsClient::run()
 				}
 			}
 
-			// run session with 0 timeout (non-blocking)
+			// run session with 0 timeout (non-blocking), this also flushes any batched output
 			uxr_run_session_timeout(&session, 0);
 
 			// check if there are available replies
@@ -593,8 +619,10 @@ void UxrceddsClient::run()
 				float dt = (now - last_status_update) / 1e6f;
 				_last_payload_tx_rate = (_subs->num_payload_sent - last_num_payload_sent) / dt;
 				_last_payload_rx_rate = (_pubs->num_payload_received - last_num_payload_received) / dt;
+				_last_frame_tx_rate = (_subs->num_frames_sent - last_num_frames_sent) / dt;
 				last_num_payload_sent = _subs->num_payload_sent;
 				last_num_payload_received = _pubs->num_payload_received;
+				last_num_frames_sent = _subs->num_frames_sent;
 				last_status_update = now;
 			}
 
@@ -636,7 +664,8 @@ void UxrceddsClient::run()
 
 		uxr_delete_session_retries(&session, _connected ? 1 : 0);
 		_last_payload_tx_rate = 0;
-		_last_payload_tx_rate = 0;
+		_last_payload_rx_rate = 0;
+		_last_frame_tx_rate = 0;
 		_subs->reset();
 		_timesync.reset_filter();
 	}
@@ -865,6 +894,7 @@ int UxrceddsClient::print_status()
 	if (_connected) {
 		PX4_INFO("Payload tx:          %i B/s", _last_payload_tx_rate);
 		PX4_INFO("Payload rx:          %i B/s", _last_payload_rx_rate);
+		PX4_INFO("Frames tx:           %i 1/s%s", _last_frame_tx_rate, _batch_output ? " (batched)" : "");
 	}
 
 	PX4_INFO("timesync converged: %s", _timesync.sync_converged() ? "true" : "false");
@@ -872,6 +902,14 @@ int UxrceddsClient::print_status()
 	perf_print_counter(_loop_perf);
 	perf_print_counter(_loop_interval_perf);
 
+#if defined(__PX4_POSIX)
+
+	if (_shm_publisher) {
+		_shm_publisher->print_status();
+	}
+
+#endif
+
 	return 0;
 }
 
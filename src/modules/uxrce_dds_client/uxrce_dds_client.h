@@ -46,6 +46,10 @@
 
 #include <lib/perf/perf_counter.h>
 
+#if defined(__PX4_POSIX)
+#include <lib/shm_transport/ShmUorbPublisher.hpp>
+#endif
+
 #if defined(CONFIG_NET) || defined(__PX4_POSIX)
 # define UXRCE_DDS_CLIENT_UDP 1
 #endif
@@ -144,6 +148,9 @@ private:
 
 	bool _synchronize_timestamps;
 
+	bool _batch_output{false};
+	uint32_t _mtu{UXR_CONFIG_SERIAL_TRANSPORT_MTU}; ///< transport MTU, limits the size of batched frames
+
 	// max port characters (5+'\0')
 	static const uint8_t PORT_MAX_LENGTH = 6;
 
@@ -159,6 +166,10 @@ private:
 	SendTopicsSubs *_subs{nullptr};
 	RcvTopicsPubs *_pubs{nullptr};
 
+#if defined(__PX4_POSIX)
+	ShmUorbPublisher *_shm_publisher {nullptr};
+#endif
+
 	SrvBase *_repliers[MAX_NUM_REPLIERS];
 	uint8_t _num_of_repliers{0};
 
@@ -167,6 +178,7 @@ private:
 
 	int _last_payload_tx_rate{}; ///< in B/s
 	int _last_payload_rx_rate{}; ///< in B/s
+	int _last_frame_tx_rate{}; ///< in frames/s
 	bool _connected{false};
 
 	bool _timesync_converged{false};
@@ -181,6 +193,8 @@ private:
 		(ParamInt<px4::params::UXRCE_DDS_KEY>) _param_uxrce_key,
 		(ParamInt<px4::params::UXRCE_DDS_PTCFG>) _param_uxrce_dds_ptcfg,
 		(ParamInt<px4::params::UXRCE_DDS_SYNCC>) _param_uxrce_dds_syncc,
-		(ParamInt<px4::params::UXRCE_DDS_SYNCT>) _param_uxrce_dds_synct
+		(ParamInt<px4::params::UXRCE_DDS_SYNCT>) _param_uxrce_dds_synct,
+		(ParamInt<px4::params::UXRCE_DDS_BATCH>) _param_uxrce_dds_batch,
+		(ParamInt<px4::params::UXRCE_DDS_SHM>) _param_uxrce_dds_shm
 	)
 };
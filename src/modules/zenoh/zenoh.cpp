@@ -41,6 +41,7 @@
 #include <drivers/drv_hrt.h>
 #include <ctype.h>
 #include <string.h>
+#include <uORB/topics/uORBTopics.hpp>
 
 #include <zenoh-pico.h>
 
@@ -64,8 +65,48 @@ ZENOH::ZENOH():
 
 ZENOH::~ZENOH()
 {
+#if defined(__PX4_POSIX)
+	delete _shm_publisher;
+#endif
+}
+
+#if defined(__PX4_POSIX)
+void ZENOH::setupSharedMemory(Zenoh_Config &z_config)
+{
+	_shm_publisher = new ShmUorbPublisher("zenoh");
+
+	if (_shm_publisher == nullptr) {
+		PX4_ERR("alloc failed");
+		return;
+	}
+
+	char topic[TOPIC_INFO_SIZE];
+	char type[TOPIC_INFO_SIZE];
+
+	while (z_config.getPublisherMapping(topic, type) > 0) {
+		const struct orb_metadata *meta = nullptr;
+
+		for (size_t i = 0; i < orb_topics_count(); i++) {
+			const struct orb_metadata *orb_meta = get_orb_meta((ORB_ID)i);
+
+			if (orb_meta != nullptr && strcmp(orb_meta->o_name, type) == 0) {
+				meta = orb_meta;
+				break;
+			}
+		}
+
+		if (meta == nullptr) {
+			PX4_WARN("shared memory: %s not found", type);
+
+		} else {
+			// keyed by the Zenoh topic, several mappings can publish the same message type
+			_shm_publisher->add(meta, 0, 0, topic);
+		}
+	}
 
+	_shm_publisher->start();
 }
+#endif
 
 void ZENOH::run()
 {
@@ -76,6 +117,17 @@ void ZENOH::run()
 
 	Zenoh_Config z_config;
 
+	bool shm_only = false;
+
+#if defined(__PX4_POSIX)
+
+	if (_param_zenoh_shm.get() > 0) {
+		setupSharedMemory(z_config);
+		shm_only = (_param_zenoh_shm.get() == 2);
+	}
+
+#endif
+
 	z_config.getNetworkConfig(mode, locator);
 
 	z_owned_config_t config = z_config_default();
@@ -93,6 +145,14 @@ void ZENOH::run()
 
 	if (!z_session_check(&s)) {
 		PX4_ERR("Unable to open session!");
+
+		if (shm_only) {
+			// keep publishing to shared memory
+			while (!should_exit()) {
+				sleep(2);
+			}
+		}
+
 		return;
 	}
 
@@ -128,7 +188,8 @@ void ZENOH::run()
 
 #ifdef Z_PUBLISH
 
-	_pub_count =  z_config.getPubCount();
+	// in shared memory only mode the topics are not published to the network
+	_pub_count = shm_only ? 0 : z_config.getPubCount();
 	_zenoh_publishers = (uORB_Zenoh_Publisher **)malloc(_pub_count * sizeof(uORB_Zenoh_Publisher *));
 	px4_pollfd_struct_t pfds[_pub_count];
 
@@ -255,6 +316,14 @@ int ZENOH::print_status()
 		_zenoh_subscribers[i]->print();
 	}
 
+#if defined(__PX4_POSIX)
+
+	if (_shm_publisher) {
+		_shm_publisher->print_status();
+	}
+
+#endif
+
 	return 0;
 }
 
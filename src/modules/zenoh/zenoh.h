@@ -49,6 +49,10 @@
 #include "publishers/uorb_publisher.hpp"
 #include "subscribers/uorb_subscriber.hpp"
 
+#if defined(__PX4_POSIX)
+#include <lib/shm_transport/ShmUorbPublisher.hpp>
+#endif
+
 class ZENOH : public ModuleBase<ZENOH>, public ModuleParams
 {
 public:
@@ -85,11 +89,21 @@ private:
 
 	Zenoh_Config _config;
 
-	int _pub_count;
-	uORB_Zenoh_Publisher **_zenoh_publishers;
-	int _sub_count;
-	Zenoh_Subscriber **_zenoh_subscribers;
+	int _pub_count{0};
+	uORB_Zenoh_Publisher **_zenoh_publishers{nullptr};
+	int _sub_count{0};
+	Zenoh_Subscriber **_zenoh_subscribers{nullptr};
+
+#if defined(__PX4_POSIX)
+	// Publish all configured topics to same-host shared memory, independent of the Zenoh session
+	void setupSharedMemory(Zenoh_Config &z_config);
+
+	ShmUorbPublisher *_shm_publisher{nullptr};
+#endif
 
+	DEFINE_PARAMETERS(
+		(ParamInt<px4::params::ZENOH_SHM>) _param_zenoh_shm
+	)
 };
 
 #endif //ZENOH_MODULE_H
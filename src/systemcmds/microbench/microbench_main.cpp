@@ -1,6 +1,6 @@
 /****************************************************************************
  *
- *  Copyright (C) 2015-2021 PX4 Development Team. All rights reserved.
+ *  Copyright (C) 2015-2024 PX4 Development Team. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
@@ -32,20 +32,52 @@
  ****************************************************************************/
 
 #include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/getopt.h>
 #include <px4_platform_common/log.h>
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <fcntl.h>
 #include <errno.h>
 
+#include <mathlib/mathlib.h>
+
+#include "microbench_report.hpp"
+
 __BEGIN_DECLS
 
 extern int test_microbench_atomic(int argc, char *argv[]);
+extern int test_microbench_dshot(int argc, char *argv[]);
+extern int test_microbench_filter(int argc, char *argv[]);
 extern int test_microbench_hrt(int argc, char *argv[]);
+extern int test_microbench_imu(int argc, char *argv[]);
 extern int test_microbench_math(int argc, char *argv[]);
 extern int test_microbench_matrix(int argc, char *argv[]);
+extern int test_microbench_param(int argc, char *argv[]);
+extern int test_microbench_sysid(int argc, char *argv[]);
 extern int test_microbench_uorb(int argc, char *argv[]);
+#if defined(CONFIG_MODULES_FLIGHT_MODE_MANAGER)
+extern int test_microbench_collision_prevention(int argc, char *argv[]);
+#endif // CONFIG_MODULES_FLIGHT_MODE_MANAGER
+#if defined(CONFIG_MODULES_CONTROL_ALLOCATOR)
+extern int test_microbench_control_allocation(int argc, char *argv[]);
+#endif // CONFIG_MODULES_CONTROL_ALLOCATOR
+#if defined(CONFIG_MODULES_EKF2)
+extern int test_microbench_ekf2(int argc, char *argv[]);
+#endif // CONFIG_MODULES_EKF2
+#if defined(CONFIG_MODULES_LOGGER)
+extern int test_microbench_logger(int argc, char *argv[]);
+#endif // CONFIG_MODULES_LOGGER
+#if defined(CONFIG_MODULES_NAVIGATOR)
+extern int test_microbench_mission(int argc, char *argv[]);
+#endif // CONFIG_MODULES_NAVIGATOR
+#if defined(CONFIG_MODULES_SIMULATION_PWM_OUT_SIM)
+extern int test_microbench_mixer(int argc, char *argv[]);
+#endif // CONFIG_MODULES_SIMULATION_PWM_OUT_SIM
+#if defined(__PX4_POSIX)
+extern int test_microbench_shm(int argc, char *argv[]);
+#endif // __PX4_POSIX
 
 __END_DECLS
 
@@ -64,12 +96,38 @@ const struct {
 	{"all",		microbench_all,		OPT_NOALLTEST},
 
 	{"microbench_atomic",	test_microbench_atomic,	0},
+	{"microbench_dshot",	test_microbench_dshot,	0},
+	{"microbench_filter",	test_microbench_filter,	0},
 	{"microbench_hrt",	test_microbench_hrt,	0},
+	{"microbench_imu",	test_microbench_imu,	0},
 	{"microbench_math",	test_microbench_math,	0},
 	{"microbench_matrix",	test_microbench_matrix,	0},
+	{"microbench_param",	test_microbench_param,	0},
+	{"microbench_sysid",	test_microbench_sysid,	0},
 	{"microbench_uorb",	test_microbench_uorb,	0},
+#if defined(CONFIG_MODULES_FLIGHT_MODE_MANAGER)
+	{"microbench_collision_prevention",	test_microbench_collision_prevention,	0},
+#endif // CONFIG_MODULES_FLIGHT_MODE_MANAGER
+#if defined(CONFIG_MODULES_CONTROL_ALLOCATOR)
+	{"microbench_control_allocation",	test_microbench_control_allocation,	0},
+#endif // CONFIG_MODULES_CONTROL_ALLOCATOR
+#if defined(CONFIG_MODULES_EKF2)
+	{"microbench_ekf2",	test_microbench_ekf2,	0},
+#endif // CONFIG_MODULES_EKF2
+#if defined(CONFIG_MODULES_LOGGER)
+	{"microbench_logger",	test_microbench_logger,	0},
+#endif // CONFIG_MODULES_LOGGER
+#if defined(CONFIG_MODULES_NAVIGATOR)
+	{"microbench_mission",	test_microbench_mission,	0},
+#endif // CONFIG_MODULES_NAVIGATOR
+#if defined(CONFIG_MODULES_SIMULATION_PWM_OUT_SIM)
+	{"microbench_mixer",	test_microbench_mixer,	0},
+#endif // CONFIG_MODULES_SIMULATION_PWM_OUT_SIM
+#if defined(__PX4_POSIX)
+	{"microbench_shm",	test_microbench_shm,	0},
+#endif // __PX4_POSIX
 
-	{"null",			nullptr, 		0}
+	{nullptr,			nullptr, 		0}
 };
 
 #define NMICROBENCHMARKS (sizeof(microbenchmarks) / sizeof(microbenchmarks[0]))
@@ -110,6 +168,8 @@ static int microbench_runner(unsigned option)
 			printf("\n  [%s] \t\tSTARTING TEST\n", microbenchmarks[i].name);
 			fflush(stdout);
 
+			microbench::set_suite(microbenchmarks[i].name);
+
 			/* Execute test */
 			if (microbenchmarks[i].fn(1, args) != 0) {
 				fprintf(stderr, "  [%s] \t\tFAIL\n", microbenchmarks[i].name);
@@ -139,19 +199,101 @@ static int microbench_runner(unsigned option)
 		}
 	}
 
-	return 0;
+	return (failcount == 0) ? 0 : -1;
+}
+
+static void usage()
+{
+	PX4_INFO("usage: microbench [-r <runs>] [-j <json file>] [-b <baseline json file>] [-t <tolerance %%>] [-w] <test>");
+	PX4_INFO("  -r: number of runs, the median of all runs is reported (default 3)");
+	PX4_INFO("  -j: write the results as JSON");
+	PX4_INFO("  -b: compare the results against a baseline written with -j, regressions fail the run");
+	PX4_INFO("  -t: default allowed increase of the time per benchmark over the baseline in %% (default 25)");
+	PX4_INFO("  -w: only warn about regressions, for machines other than the one that recorded the baseline");
+	PX4_INFO("'microbench help' for a list of tests");
 }
 
 extern "C" __EXPORT int microbench_main(int argc, char *argv[])
 {
-	if (argc < 2) {
-		PX4_WARN("missing test name - 'microbench help' for a list of tests");
+	const char *json_path = nullptr;
+	const char *baseline_path = nullptr;
+	float tolerance = 0.25f;
+	int runs = 3;
+	bool regressions_fail = true;
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "b:j:r:t:w", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'b':
+			baseline_path = myoptarg;
+			break;
+
+		case 'j':
+			json_path = myoptarg;
+			break;
+
+		case 'r':
+			runs = math::constrain((int)strtol(myoptarg, nullptr, 0), 1, microbench::MAX_RUNS);
+			break;
+
+		case 't':
+			tolerance = strtof(myoptarg, nullptr) / 100.f;
+			break;
+
+		case 'w':
+			regressions_fail = false;
+			break;
+
+		default:
+			usage();
+			return 1;
+		}
+	}
+
+	if (myoptind >= argc) {
+		PX4_WARN("missing test name");
+		usage();
 		return 1;
 	}
 
+	const char *test_name = argv[myoptind];
+
 	for (size_t i = 0; microbenchmarks[i].name; i++) {
-		if (!strcmp(microbenchmarks[i].name, argv[1])) {
-			if (microbenchmarks[i].fn(argc - 1, argv + 1) == 0) {
+		if (!strcmp(microbenchmarks[i].name, test_name)) {
+			microbench::clear();
+			bool passed = true;
+
+			for (int run = 0; run < runs; run++) {
+				microbench::set_run(run);
+				microbench::set_suite(microbenchmarks[i].name);
+
+				if (microbenchmarks[i].fn(argc - myoptind, argv + myoptind) != 0) {
+					passed = false;
+				}
+			}
+
+			if (json_path && !microbench::write_json(json_path)) {
+				passed = false;
+			}
+
+			// a missing baseline is not an error, the first run records it
+			if (baseline_path) {
+				const int regressions = microbench::compare_baseline(baseline_path, tolerance);
+
+				if (regressions > 0) {
+					if (regressions_fail) {
+						passed = false;
+
+					} else {
+						PX4_WARN("%d regressions against %s, not failing the run (-w)", regressions, baseline_path);
+					}
+				}
+			}
+
+			if (passed) {
 				PX4_INFO("%s PASSED", microbenchmarks[i].name);
 				return 0;
 
@@ -162,6 +304,6 @@ extern "C" __EXPORT int microbench_main(int argc, char *argv[])
 		}
 	}
 
-	PX4_WARN("no test called '%s' - 'microbench help' for a list of tests", argv[1]);
+	PX4_WARN("no test called '%s' - 'microbench help' for a list of tests", test_name);
 	return 1;
 }
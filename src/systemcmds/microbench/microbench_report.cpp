@@ -0,0 +1,293 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file microbench_report.cpp
+ */
+
+#include "microbench_report.hpp"
+
+#include <mathlib/mathlib.h>
+#include <px4_platform_common/log.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace microbench
+{
+
+static constexpr int MAX_RESULTS = 160;
+static constexpr int MAX_NAME_LENGTH = 80;
+
+struct result_s {
+	const char *suite;
+	const char *name;
+	uint64_t events;
+	unsigned ops_per_event;
+	float mean_us[MAX_RUNS];
+	int runs;
+};
+
+static result_s results[MAX_RESULTS] {};
+static int num_results = 0;
+static const char *current_suite = "";
+static int current_run = 0;
+
+void set_suite(const char *suite)
+{
+	current_suite = suite;
+}
+
+void set_run(int run)
+{
+	current_run = run;
+}
+
+void report(const char *name, perf_counter_t perf, unsigned ops_per_event)
+{
+	result_s *result = nullptr;
+
+	// add the sample to the benchmark of the same name without a sample of the current run yet,
+	// so benchmarks reported twice per run stay separate
+	for (int i = 0; i < num_results; i++) {
+		if ((results[i].runs == current_run) && (strcmp(results[i].suite, current_suite) == 0)
+		    && (strcmp(results[i].name, name) == 0)) {
+			result = &results[i];
+			break;
+		}
+	}
+
+	if (result == nullptr) {
+		if (num_results >= MAX_RESULTS) {
+			PX4_WARN("too many results, dropping %s", name);
+			return;
+		}
+
+		result = &results[num_results++];
+		result->suite = current_suite;
+		result->name = name;
+		result->runs = 0;
+	}
+
+	if (result->runs >= MAX_RUNS) {
+		return;
+	}
+
+	result->events = perf_event_count(perf);
+	result->ops_per_event = (ops_per_event > 0) ? ops_per_event : 1;
+	result->mean_us[result->runs++] = perf_mean(perf) * 1e6f; // perf_mean() is in seconds
+}
+
+void clear()
+{
+	num_results = 0;
+	current_run = 0;
+}
+
+static int compare_float(const void *a, const void *b)
+{
+	const float fa = *(const float *)a;
+	const float fb = *(const float *)b;
+	return (fa > fb) - (fa < fb);
+}
+
+// median, minimum and maximum of the mean time per event over all runs
+static void statistics(const result_s &result, float &median, float &min, float &max)
+{
+	float sorted[MAX_RUNS];
+	memcpy(sorted, result.mean_us, result.runs * sizeof(float));
+	qsort(sorted, result.runs, sizeof(float), compare_float);
+
+	if (result.runs % 2 == 1) {
+		median = sorted[result.runs / 2];
+
+	} else {
+		median = 0.5f * (sorted[result.runs / 2 - 1] + sorted[result.runs / 2]);
+	}
+
+	min = sorted[0];
+	max = sorted[result.runs - 1];
+}
+
+bool write_json(const char *path)
+{
+	FILE *file = fopen(path, "w");
+
+	if (file == nullptr) {
+		PX4_ERR("failed to open %s", path);
+		return false;
+	}
+
+	fprintf(file, "{\n\t\"results\": [\n");
+
+	for (int i = 0; i < num_results; i++) {
+		const result_s &result = results[i];
+		float median;
+		float min;
+		float max;
+		statistics(result, median, min, max);
+
+		fprintf(file, "\t\t{\"suite\": \"%s\", \"name\": \"%s\", \"events\": %llu, \"runs\": %d, "
+			"\"mean_us\": %.3f, \"min_us\": %.3f, \"max_us\": %.3f, \"ns_per_op\": %.3f}%s\n",
+			result.suite, result.name, (unsigned long long)result.events, result.runs,
+			(double)median, (double)min, (double)max,
+			(double)(median * 1000.f / result.ops_per_event), (i < num_results - 1) ? "," : "");
+	}
+
+	fprintf(file, "\t]\n}\n");
+
+	const bool success = (ferror(file) == 0);
+	fclose(file);
+
+	if (success) {
+		PX4_INFO("%d results written to %s", num_results, path);
+	}
+
+	return success;
+}
+
+// copy the string value of "key": "value" from a line written by write_json()
+static bool parse_string(const char *line, const char *key, char *value, size_t length)
+{
+	const char *start = strstr(line, key);
+
+	if (start == nullptr) {
+		return false;
+	}
+
+	start = strchr(start + strlen(key), '"');
+
+	if (start == nullptr) {
+		return false;
+	}
+
+	start++;
+	const char *end = strchr(start, '"');
+
+	if ((end == nullptr) || ((size_t)(end - start) >= length)) {
+		return false;
+	}
+
+	memcpy(value, start, end - start);
+	value[end - start] = '\0';
+	return true;
+}
+
+// parse the number value of "key": value from a line written by write_json()
+static bool parse_number(const char *line, const char *key, float &value)
+{
+	const char *start = strstr(line, key);
+
+	if (start == nullptr) {
+		return false;
+	}
+
+	char *end = nullptr;
+	value = strtof(start + strlen(key), &end);
+	return end != start + strlen(key);
+}
+
+int compare_baseline(const char *path, float tolerance)
+{
+	FILE *file = fopen(path, "r");
+
+	if (file == nullptr) {
+		PX4_WARN("no baseline %s", path);
+		return -1;
+	}
+
+	int regressions = 0;
+	int compared = 0;
+	char line[384];
+
+	while (fgets(line, sizeof(line), file) != nullptr) {
+		char suite[MAX_NAME_LENGTH];
+		char name[MAX_NAME_LENGTH];
+		float baseline_us;
+
+		if (!parse_string(line, "\"suite\":", suite, sizeof(suite))
+		    || !parse_string(line, "\"name\":", name, sizeof(name))
+		    || !parse_number(line, "\"mean_us\":", baseline_us)) {
+			continue;
+		}
+
+		float allowed = tolerance;
+		float configured_tolerance;
+		float baseline_min_us;
+		float baseline_max_us;
+
+		if (parse_number(line, "\"tolerance\":", configured_tolerance)) {
+			allowed = configured_tolerance;
+
+		} else if (parse_number(line, "\"min_us\":", baseline_min_us)
+		    && parse_number(line, "\"max_us\":", baseline_max_us)
+		    && (baseline_us > 0.f)) {
+			// a single outlier run must not disable the check, limit the tolerance to 100%
+			allowed = math::constrain(2.f * (baseline_max_us - baseline_min_us) / baseline_us, tolerance, math::max(tolerance, 1.f));
+		}
+
+		for (int i = 0; i < num_results; i++) {
+			const result_s &result = results[i];
+
+			if ((strcmp(result.suite, suite) != 0) || (strcmp(result.name, name) != 0)) {
+				continue;
+			}
+
+			compared++;
+
+			float median;
+			float min;
+			float max;
+			statistics(result, median, min, max);
+
+			// the elapsed time is measured with a resolution of 1 us
+			if (median > baseline_us * (1.f + allowed) + 1.f) {
+				PX4_ERR("REGRESSION [%s] %s: %.3f us (baseline %.3f us, tolerance %.0f%%)", suite, name,
+					(double)median, (double)baseline_us, (double)(allowed * 100.f));
+				regressions++;
+			}
+
+			break;
+		}
+	}
+
+	fclose(file);
+
+	PX4_INFO("compared %d of %d results against %s, %d regressions", compared, num_results, path, regressions);
+
+	return regressions;
+}
+
+} // namespace microbench
@@ -0,0 +1,97 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file microbench_report.hpp
+ * Collects the microbenchmark results of repeated runs, writes their medians as JSON
+ * and compares them against a baseline recorded with a previous run.
+ */
+
+#pragma once
+
+#include <perf/perf_counter.h>
+
+namespace microbench
+{
+
+static constexpr int MAX_RUNS = 9; ///< maximum number of runs of which the results are kept
+
+/**
+ * Set the name of the microbenchmark the following results belong to.
+ */
+void set_suite(const char *suite);
+
+/**
+ * Set the index of the current run, starting at 0. Results reported during run n are
+ * added as the n-th sample of the benchmark, runs beyond MAX_RUNS are ignored.
+ */
+void set_run(int run);
+
+/**
+ * Record the result of a single benchmark.
+ *
+ * @param name		benchmark name (string literal, it is not copied)
+ * @param perf		PC_ELAPSED counter of the benchmark, one event per timed block
+ * @param ops_per_event	number of operations timed by each perf event
+ */
+void report(const char *name, perf_counter_t perf, unsigned ops_per_event);
+
+/**
+ * Drop all recorded results.
+ */
+void clear();
+
+/**
+ * Write the recorded results as JSON, one line per benchmark with the median, minimum
+ * and maximum of the mean time per event over all runs.
+ *
+ * @return true on success
+ */
+bool write_json(const char *path);
+
+/**
+ * Compare the recorded results against a JSON file written by write_json().
+ * A result is a regression if its median time per event exceeds the baseline median by
+ * more than the tolerance, plus one timer tick.
+ *
+ * The tolerance of a benchmark is taken from its "tolerance" entry in the baseline if
+ * there is one, otherwise it is twice the relative spread (max - min) / median the benchmark
+ * showed when the baseline was recorded, at least the default tolerance and at most 100%.
+ *
+ * @param tolerance	default allowed relative increase (0.25 = 25%)
+ * @return number of regressions, -1 if the baseline can't be read
+ */
+int compare_baseline(const char *path, float tolerance);
+
+} // namespace microbench
@@ -38,6 +38,8 @@
 
 #include <unit_test.h>
 
+#include "microbench_report.hpp"
+
 #include <time.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -69,6 +71,7 @@ namespace MicroBenchAtomic
 			reset(); \
 		} \
 		perf_print_counter(p); \
+		microbench::report(name, p, 1); \
 		perf_free(p); \
 	} while (0)
 
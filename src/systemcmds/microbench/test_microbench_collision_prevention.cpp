@@ -0,0 +1,191 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_collision_prevention.cpp
+ * Tests for the microbench collision prevention map fusion and setpoint constraint.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/collision_prevention/CollisionPrevention.hpp>
+
+namespace MicroBenchCollisionPrevention
+{
+
+#define PERF(name, op, count) do { \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			px4_usleep(1000); \
+			perf_begin(p); \
+			for (int i = 0; i < (count); i++) { \
+				op; \
+			} \
+			perf_end(p); \
+		} \
+		perf_print_counter(p); \
+		microbench::report(name, p, (count)); \
+		perf_free(p); \
+	} while (0)
+
+// collision prevention on a frozen clock, so that the map never goes stale and no loiter command is sent
+class FrozenTimeCollisionPrevention : public CollisionPrevention
+{
+public:
+	FrozenTimeCollisionPrevention() : CollisionPrevention(nullptr) {}
+
+	void setTime(hrt_abstime time)
+	{
+		_time = time;
+		_obstacle_map_body_frame.timestamp = time;
+	}
+
+	// same as an obstacle_distance message received in _updateObstacleMap()
+	void addObstacleSensorData(const obstacle_distance_s &obstacle, const matrix::Quatf &vehicle_attitude)
+	{
+		_obstacle_map_body_frame.max_distance = math::max(_obstacle_map_body_frame.max_distance, obstacle.max_distance);
+		_obstacle_map_body_frame.min_distance = math::min(_obstacle_map_body_frame.min_distance, obstacle.min_distance);
+		_addObstacleSensorData(obstacle, vehicle_attitude);
+	}
+
+protected:
+	hrt_abstime getTime() override { return _time; }
+	hrt_abstime getElapsedTime(const hrt_abstime *ptr) override { return _time - *ptr; }
+
+private:
+	hrt_abstime _time{0};
+};
+
+class MicroBenchCollisionPrevention : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_collision_prevention();
+
+	void reset();
+
+	// deterministic pseudo-random distance in [1 m, 6 m]
+	uint16_t distance();
+
+	// fuse one scan of each lidar into the map
+	void fuse_scans();
+
+	// constrain one velocity setpoint against the map
+	void constrain_setpoint();
+
+	static constexpr int NUM_LIDARS = 3;
+
+	FrozenTimeCollisionPrevention cp;
+	obstacle_distance_s scans[NUM_LIDARS] {};
+	matrix::Quatf attitude{};
+	uint32_t seed{1};
+	volatile float setpoint_sink{0.f};
+};
+
+bool MicroBenchCollisionPrevention::run_tests()
+{
+	ut_run_test(time_collision_prevention);
+
+	return (_tests_failed == 0);
+}
+
+uint16_t MicroBenchCollisionPrevention::distance()
+{
+	seed = seed * 1664525u + 1013904223u;
+	return 100 + (seed >> 8) % 500;
+}
+
+void MicroBenchCollisionPrevention::reset()
+{
+	seed = 1;
+	cp.setTime(hrt_absolute_time());
+
+	// slightly yawed vehicle
+	attitude = matrix::Quatf(matrix::Eulerf(0.f, 0.f, 0.3f));
+
+	// 360 degree lidars with 72 bins, one of them north aligned
+	for (int lidar = 0; lidar < NUM_LIDARS; lidar++) {
+		obstacle_distance_s &scan = scans[lidar];
+		scan.frame = (lidar == 0) ? obstacle_distance_s::MAV_FRAME_LOCAL_NED : obstacle_distance_s::MAV_FRAME_BODY_FRD;
+		scan.increment = 5.f;
+		scan.angle_offset = 2.5f * lidar;
+		scan.min_distance = 20;
+		scan.max_distance = 2000;
+
+		for (int i = 0; i < 72; i++) {
+			scan.distances[i] = distance();
+		}
+	}
+}
+
+void MicroBenchCollisionPrevention::fuse_scans()
+{
+	for (int lidar = 0; lidar < NUM_LIDARS; lidar++) {
+		cp.addObstacleSensorData(scans[lidar], attitude);
+	}
+}
+
+void MicroBenchCollisionPrevention::constrain_setpoint()
+{
+	matrix::Vector2f setpoint(2.f, 1.f);
+	cp.modifySetpoint(setpoint, 3.f, matrix::Vector2f(0.f, 0.f), matrix::Vector2f(1.f, 0.5f));
+	setpoint_sink = setpoint(0);
+}
+
+ut_declare_test_c(test_microbench_collision_prevention, MicroBenchCollisionPrevention)
+
+bool MicroBenchCollisionPrevention::time_collision_prevention()
+{
+	reset();
+
+	PERF("CollisionPrevention fuse 3x 72 bin scans (100 ops)", fuse_scans(), 100);
+
+	// the constraint pass publishes collision_constraints and obstacle_distance_fused
+	PERF("CollisionPrevention modifySetpoint 36 bins (1000 ops)", constrain_setpoint(), 1000);
+
+	return true;
+}
+
+} // namespace MicroBenchCollisionPrevention
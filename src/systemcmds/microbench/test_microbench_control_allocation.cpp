@@ -0,0 +1,193 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_control_allocation.cpp
+ * Tests for the microbench control allocation.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <ControlAllocationPseudoInverse.hpp>
+#include <ControlAllocationSequentialDesaturation.hpp>
+
+namespace MicroBenchControlAllocation
+{
+
+#define PERF(name, op, count) do { \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			px4_usleep(1000); \
+			perf_begin(p); \
+			for (int i = 0; i < (count); i++) { \
+				op; \
+			} \
+			perf_end(p); \
+		} \
+		perf_print_counter(p); \
+		microbench::report(name, p, (count)); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchControlAllocation : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_pseudo_inverse();
+	bool time_sequential_desaturation();
+
+	void reset();
+
+	void allocate(ControlAllocation &allocation);
+	void update_effectiveness(ControlAllocation &allocation);
+
+	static constexpr int NUM_ROTORS = 8;
+
+	using ActuatorVector = ControlAllocation::ActuatorVector;
+
+	matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> effectiveness;
+	matrix::Vector<float, ControlAllocation::NUM_AXES> control_sp;
+
+	ControlAllocationPseudoInverse pseudo_inverse;
+	ControlAllocationSequentialDesaturation sequential_desaturation;
+
+	float actuator_out{0.f};
+};
+
+bool MicroBenchControlAllocation::run_tests()
+{
+	ut_run_test(time_pseudo_inverse);
+	ut_run_test(time_sequential_desaturation);
+
+	return (_tests_failed == 0);
+}
+
+template<typename T>
+T random(T min, T max)
+{
+	const T scale = rand() / (T) RAND_MAX; /* [0, 1.0] */
+	return min + scale * (max - min);      /* [min, max] */
+}
+
+void MicroBenchControlAllocation::reset()
+{
+	srand(time(nullptr));
+
+	// octocopter X, alternating spin direction
+	effectiveness.setZero();
+
+	for (int i = 0; i < NUM_ROTORS; i++) {
+		const float angle = (2.f * i + 1.f) * M_PI_F / NUM_ROTORS;
+		const matrix::Vector3f position(cosf(angle), sinf(angle), 0.f);
+		const matrix::Vector3f axis(0.f, 0.f, -1.f);
+		const float km = (i % 2 == 0) ? 0.05f : -0.05f;
+
+		const matrix::Vector3f thrust = axis;
+		const matrix::Vector3f moment = position.cross(axis) - km * axis;
+
+		for (int j = 0; j < 3; j++) {
+			effectiveness(j, i) = moment(j);
+			effectiveness(j + 3, i) = thrust(j);
+		}
+	}
+
+	// a saturating setpoint to exercise the desaturation
+	control_sp(0) = random(-1.f, 1.f);
+	control_sp(1) = random(-1.f, 1.f);
+	control_sp(2) = random(-0.5f, 0.5f);
+	control_sp(3) = 0.f;
+	control_sp(4) = 0.f;
+	control_sp(5) = random(-1.f, -0.5f);
+
+	ActuatorVector actuator_min;
+	ActuatorVector actuator_max;
+	actuator_max.setAll(1.f);
+
+	ControlAllocation *allocations[] {&pseudo_inverse, &sequential_desaturation};
+
+	for (ControlAllocation *allocation : allocations) {
+		allocation->setActuatorMin(actuator_min);
+		allocation->setActuatorMax(actuator_max);
+		update_effectiveness(*allocation);
+		allocation->allocate();
+	}
+}
+
+void MicroBenchControlAllocation::allocate(ControlAllocation &allocation)
+{
+	allocation.setControlSetpoint(control_sp);
+	allocation.allocate();
+	allocation.clipActuatorSetpoint();
+	actuator_out = allocation.getActuatorSetpoint()(0);
+}
+
+void MicroBenchControlAllocation::update_effectiveness(ControlAllocation &allocation)
+{
+	// triggers the pseudo inverse and normalization update with the next allocation
+	const ActuatorVector actuator_trim;
+	const ActuatorVector linearization_point;
+	allocation.setEffectivenessMatrix(effectiveness, actuator_trim, linearization_point, NUM_ROTORS, true);
+}
+
+ut_declare_test_c(test_microbench_control_allocation, MicroBenchControlAllocation)
+
+bool MicroBenchControlAllocation::time_pseudo_inverse()
+{
+	PERF("ControlAllocationPseudoInverse allocate 8 rotors (100 ops)", allocate(pseudo_inverse), 100);
+	PERF("ControlAllocationPseudoInverse update effectiveness 8 rotors (10 ops)",
+	     update_effectiveness(pseudo_inverse); allocate(pseudo_inverse), 10);
+	return true;
+}
+
+bool MicroBenchControlAllocation::time_sequential_desaturation()
+{
+	PERF("ControlAllocationSequentialDesaturation allocate 8 rotors (100 ops)", allocate(sequential_desaturation), 100);
+	return true;
+}
+
+} // namespace MicroBenchControlAllocation
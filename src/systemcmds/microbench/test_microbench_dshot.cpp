@@ -0,0 +1,130 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_dshot.cpp
+ * Microbenchmark bidirectional DShot response decoding.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/bdshot/bdshot_decode.h>
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+#endif
+
+namespace MicroBenchDShot
+{
+
+#ifdef __PX4_NUTTX
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			px4_usleep(1000); \
+			lock(); \
+			perf_begin(p); \
+			for (int i = 0; i < (count); i++) { \
+				op; \
+			} \
+			perf_end(p); \
+			unlock(); \
+		} \
+		perf_print_counter(p); \
+		microbench::report(name, p, (count)); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchDShot : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_bdshot_decode();
+
+	static constexpr unsigned NUM_CHANNELS = 8;
+
+	// responses as captured for different motor speeds, one of them with a bit error
+	const uint32_t raw[NUM_CHANNELS] {0xad6ae, 0x22994, 0x1729c, 0x75272, 0x32ad2, 0x22994, 0x1729c ^ 0x80, 0x75272};
+
+	uint16_t erpm[NUM_CHANNELS] {};
+	bdshot_decode_stats_t stats[NUM_CHANNELS] {};
+
+	volatile int value{0};
+	volatile uint32_t mask{0};
+};
+
+bool MicroBenchDShot::run_tests()
+{
+	ut_run_test(time_bdshot_decode);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_microbench_dshot, MicroBenchDShot)
+
+bool MicroBenchDShot::time_bdshot_decode()
+{
+	PERF("bdshot decode frame (1k ops)", value = bdshot_decode_frame(raw[i % NUM_CHANNELS]), 1000);
+	PERF("bdshot decode 8 channels (100 ops)", mask = bdshot_decode_erpm_batch(raw, 0xff, NUM_CHANNELS, erpm, stats), 100);
+
+	return true;
+}
+
+} // namespace MicroBenchDShot
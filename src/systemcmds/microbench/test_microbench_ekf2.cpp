@@ -0,0 +1,319 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_ekf2.cpp
+ * Tests for the microbench EKF2 predict and fusion steps, its delayed time horizon buffers
+ * and the magnetic field lookups.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/world_magnetic_model/geo_mag_declination.h>
+#include <modules/ekf2/EKF/ekf.h>
+
+namespace MicroBenchEKF2
+{
+
+#define PERF(name, op, count) do { \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			px4_usleep(1000); \
+			perf_begin(p); \
+			for (int i = 0; i < (count); i++) { \
+				op; \
+			} \
+			perf_end(p); \
+		} \
+		perf_print_counter(p); \
+		microbench::report(name, p, (count)); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchEKF2 : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_ekf2_predict();
+	bool time_ekf2_fusion();
+	bool time_ekf2_ring_buffer();
+	bool time_ekf2_magnetic_field();
+#if defined(CONFIG_EKF2_GNSS)
+	bool time_ekf2_yaw_estimator();
+#endif // CONFIG_EKF2_GNSS
+
+	bool reset();
+
+	// push a sample at the current time and pop the one at the delayed time horizon
+	void push_pop(RingBuffer<imuSample> &buffer);
+
+	// magnetic field at a position moving east by about 1 m per call
+	void lookup_magnetic_field();
+	void lookup_magnetic_field_tile();
+
+#if defined(CONFIG_EKF2_GNSS)
+	// one IMU sample of a level vehicle manoeuvring in the horizontal plane, 5 Hz velocity observations
+	void update_yaw_estimator();
+#endif // CONFIG_EKF2_GNSS
+
+	// simulated IMU at 1 kHz, one EKF update period per call
+	void update(bool aiding);
+
+	static constexpr uint64_t IMU_INTERVAL_US = 1000;
+	static constexpr int IMU_SAMPLES_PER_UPDATE = 10;
+
+	// long buffers as used with a large EKF2_DELAY_MAX
+	static constexpr uint8_t BUFFER_LENGTH = 200;
+	static constexpr uint64_t BUFFER_INTERVAL_US = 500;
+	static constexpr uint64_t BUFFER_DELAY_US = 90000;
+
+	Ekf *ekf{nullptr};
+	uint64_t time_us{0};
+	uint64_t buffer_time_us{0};
+
+	MagneticFieldTile mag_tile;
+	float mag_lon{0.f};
+	volatile float mag_sink{0.f};
+
+#if defined(CONFIG_EKF2_GNSS)
+	static constexpr float GSF_DT = 0.004f;
+
+	EKFGSF_yaw gsf;
+	matrix::Vector2f gsf_vel_NE{};
+	float gsf_time_s{0.f};
+	int gsf_samples{0};
+#endif // CONFIG_EKF2_GNSS
+};
+
+bool MicroBenchEKF2::run_tests()
+{
+	ekf = new Ekf();
+
+	if ((ekf == nullptr) || !reset()) {
+		delete ekf;
+		ekf = nullptr;
+		return false;
+	}
+
+	ut_run_test(time_ekf2_predict);
+	ut_run_test(time_ekf2_fusion);
+	ut_run_test(time_ekf2_ring_buffer);
+	ut_run_test(time_ekf2_magnetic_field);
+#if defined(CONFIG_EKF2_GNSS)
+	ut_run_test(time_ekf2_yaw_estimator);
+#endif // CONFIG_EKF2_GNSS
+
+	delete ekf;
+	ekf = nullptr;
+
+	return (_tests_failed == 0);
+}
+
+bool MicroBenchEKF2::reset()
+{
+	time_us = 0;
+
+	if (!ekf->init(time_us)) {
+		return false;
+	}
+
+	ekf->set_in_air_status(false);
+	ekf->set_vehicle_at_rest(true);
+
+	// let the filter align and start fusing
+	for (int i = 0; i < 1000; i++) {
+		update(true);
+	}
+
+	return ekf->attitude_valid();
+}
+
+void MicroBenchEKF2::update(bool aiding)
+{
+	for (int i = 0; i < IMU_SAMPLES_PER_UPDATE; i++) {
+		time_us += IMU_INTERVAL_US;
+
+		imuSample imu_sample{};
+		imu_sample.time_us = time_us;
+		imu_sample.delta_ang_dt = IMU_INTERVAL_US * 1e-6f;
+		imu_sample.delta_vel_dt = IMU_INTERVAL_US * 1e-6f;
+		imu_sample.delta_vel = matrix::Vector3f(0.f, 0.f, -CONSTANTS_ONE_G) * imu_sample.delta_vel_dt;
+		ekf->setIMUData(imu_sample);
+
+		ekf->update();
+	}
+
+	if (aiding) {
+#if defined(CONFIG_EKF2_BAROMETER)
+		ekf->setBaroData(baroSample{time_us, 0.f});
+#endif // CONFIG_EKF2_BAROMETER
+
+#if defined(CONFIG_EKF2_MAGNETOMETER)
+		ekf->setMagData(magSample{time_us, matrix::Vector3f(0.2f, 0.f, 0.4f)});
+#endif // CONFIG_EKF2_MAGNETOMETER
+	}
+}
+
+void MicroBenchEKF2::push_pop(RingBuffer<imuSample> &buffer)
+{
+	buffer_time_us += BUFFER_INTERVAL_US;
+
+	imuSample sample{};
+	sample.time_us = buffer_time_us;
+	buffer.push(sample);
+
+	buffer.pop_first_older_than(buffer_time_us - BUFFER_DELAY_US, &sample);
+}
+
+void MicroBenchEKF2::lookup_magnetic_field()
+{
+	mag_lon += 1e-5f;
+	mag_sink = get_mag_declination_radians(47.39f, mag_lon) + get_mag_inclination_radians(47.39f, mag_lon)
+		   + get_mag_strength_gauss(47.39f, mag_lon);
+}
+
+void MicroBenchEKF2::lookup_magnetic_field_tile()
+{
+	mag_lon += 1e-5f;
+	const MagneticField field = mag_tile.lookup(47.39f, mag_lon);
+	mag_sink = field.declination + field.inclination + field.strength;
+}
+
+#if defined(CONFIG_EKF2_GNSS)
+void MicroBenchEKF2::update_yaw_estimator()
+{
+	gsf_time_s += GSF_DT;
+
+	const matrix::Vector3f accel_NED{2.f * cosf(2.f * gsf_time_s), 2.f * sinf(1.4f * gsf_time_s), 0.f};
+	const matrix::Vector3f delta_vel = (accel_NED - matrix::Vector3f(0.f, 0.f, CONSTANTS_ONE_G)) * GSF_DT;
+	gsf.predict(matrix::Vector3f(), GSF_DT, delta_vel, GSF_DT, true);
+
+	gsf_vel_NE += matrix::Vector2f(accel_NED(0), accel_NED(1)) * GSF_DT;
+
+	if (++gsf_samples % 50 == 0) {
+		gsf.fuseVelocity(gsf_vel_NE, 0.3f, true);
+	}
+}
+#endif // CONFIG_EKF2_GNSS
+
+ut_declare_test_c(test_microbench_ekf2, MicroBenchEKF2)
+
+bool MicroBenchEKF2::time_ekf2_predict()
+{
+	PERF("ekf2 update, 10 IMU samples without aiding (100 ops)", update(false), 100);
+	return true;
+}
+
+bool MicroBenchEKF2::time_ekf2_fusion()
+{
+	PERF("ekf2 update, 10 IMU samples with baro and mag fusion (100 ops)", update(true), 100);
+	return true;
+}
+
+bool MicroBenchEKF2::time_ekf2_ring_buffer()
+{
+	RingBuffer<imuSample> buffer_sorted(BUFFER_LENGTH);
+	RingBuffer<imuSample> buffer_unsorted(BUFFER_LENGTH);
+
+	if (!buffer_sorted.valid() || !buffer_unsorted.valid()) {
+		return false;
+	}
+
+	// a sample pushed out of time order makes the buffer fall back to the linear search
+	imuSample sample{};
+	sample.time_us = 2000;
+	buffer_unsorted.push(sample);
+	sample.time_us = 1000;
+	buffer_unsorted.push(sample);
+
+	buffer_time_us = 1000000;
+
+	for (int i = 0; i < BUFFER_LENGTH; i++) {
+		buffer_time_us += BUFFER_INTERVAL_US;
+		sample.time_us = buffer_time_us;
+		buffer_sorted.push(sample);
+		buffer_unsorted.push(sample);
+	}
+
+	const uint64_t start_time_us = buffer_time_us;
+
+	PERF("RingBuffer 200 samples push and pop, bisection (100 ops)", push_pop(buffer_sorted), 100);
+
+	buffer_time_us = start_time_us;
+	PERF("RingBuffer 200 samples push and pop, linear search (100 ops)", push_pop(buffer_unsorted), 100);
+
+	return true;
+}
+
+bool MicroBenchEKF2::time_ekf2_magnetic_field()
+{
+	mag_lon = 8.54f;
+	PERF("magnetic field, individual lookups (100 ops)", lookup_magnetic_field(), 100);
+
+	mag_lon = 8.54f;
+	PERF("magnetic field, MagneticFieldTile lookup (100 ops)", lookup_magnetic_field_tile(), 100);
+
+	// the position stays in one cell of the lookup table
+	return mag_tile.loads() == 1;
+}
+
+#if defined(CONFIG_EKF2_GNSS)
+bool MicroBenchEKF2::time_ekf2_yaw_estimator()
+{
+	// let the model bank converge first
+	for (int i = 0; i < 5000; i++) {
+		update_yaw_estimator();
+	}
+
+	if (!gsf.isActive()) {
+		return false;
+	}
+
+	PERF("EKF-GSF yaw estimator IMU sample with 5 Hz velocity fusion (100 ops)", update_yaw_estimator(), 100);
+	return true;
+}
+#endif // CONFIG_EKF2_GNSS
+
+} // namespace MicroBenchEKF2
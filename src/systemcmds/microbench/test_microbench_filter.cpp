@@ -0,0 +1,214 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_filter.cpp
+ * Tests for the microbench filter library.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/mathlib/math/filter/AlphaFilter.hpp>
+#include <lib/mathlib/math/filter/LowPassFilter2p.hpp>
+#include <lib/mathlib/math/filter/NotchFilter.hpp>
+#include <lib/matrix/matrix/math.hpp>
+
+namespace MicroBenchFilter
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			px4_usleep(1000); \
+			lock(); \
+			perf_begin(p); \
+			for (int i = 0; i < (count); i++) { \
+				op; \
+			} \
+			perf_end(p); \
+			unlock(); \
+		} \
+		perf_print_counter(p); \
+		microbench::report(name, p, (count)); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchFilter : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_low_pass_filter();
+	bool time_notch_filter();
+	bool time_notch_filter_bank();
+	bool time_alpha_filter();
+
+	void reset();
+
+	float apply_notch_bank(float sample);
+
+	static constexpr float SAMPLE_FREQ = 8000.f;
+	static constexpr int FIFO_SAMPLES = 32;
+	static constexpr int NOTCH_BANK_SIZE = 12; // 4 ESCs with 3 harmonics each
+
+	math::LowPassFilter2p<float> lpf{SAMPLE_FREQ, 30.f};
+	math::LowPassFilter2p<matrix::Vector3f> lpf_vector{SAMPLE_FREQ, 30.f};
+	math::NotchFilter<float> notch;
+	math::NotchFilter<float> notch_bank[3][NOTCH_BANK_SIZE];
+	AlphaFilter<matrix::Vector3f> alpha_vector;
+
+	float fifo[FIFO_SAMPLES];
+
+	volatile float f32;
+	volatile float f32_out;
+
+	matrix::Vector3f v3;
+	matrix::Vector3f v3_out;
+};
+
+bool MicroBenchFilter::run_tests()
+{
+	ut_run_test(time_low_pass_filter);
+	ut_run_test(time_notch_filter);
+	ut_run_test(time_notch_filter_bank);
+	ut_run_test(time_alpha_filter);
+
+	return (_tests_failed == 0);
+}
+
+template<typename T>
+T random(T min, T max)
+{
+	const T scale = rand() / (T) RAND_MAX; /* [0, 1.0] */
+	return min + scale * (max - min);      /* [min, max] */
+}
+
+void MicroBenchFilter::reset()
+{
+	srand(time(nullptr));
+
+	// initialize with random data, representative of a gyro in rad/s
+	f32 = random(-3.f, 3.f);
+	f32_out = random(-3.f, 3.f);
+
+	v3 = matrix::Vector3f(random(-3.f, 3.f), random(-3.f, 3.f), random(-3.f, 3.f));
+
+	for (int i = 0; i < FIFO_SAMPLES; i++) {
+		fifo[i] = random(-3.f, 3.f);
+	}
+
+	notch.setParameters(SAMPLE_FREQ, 100.f, 20.f);
+
+	for (int axis = 0; axis < 3; axis++) {
+		for (int i = 0; i < NOTCH_BANK_SIZE; i++) {
+			notch_bank[axis][i].setParameters(SAMPLE_FREQ, 80.f + 40.f * i, 15.f);
+		}
+	}
+
+	alpha_vector.setCutoffFreq(SAMPLE_FREQ, 10.f);
+}
+
+float MicroBenchFilter::apply_notch_bank(float sample)
+{
+	for (int axis = 0; axis < 3; axis++) {
+		for (int i = 0; i < NOTCH_BANK_SIZE; i++) {
+			sample = notch_bank[axis][i].apply(sample);
+		}
+	}
+
+	return sample;
+}
+
+ut_declare_test_c(test_microbench_filter, MicroBenchFilter)
+
+bool MicroBenchFilter::time_low_pass_filter()
+{
+	PERF("LowPassFilter2p float apply (1k ops)", f32_out = lpf.apply((float)f32), 1000);
+	PERF("LowPassFilter2p Vector3f apply (1k ops)", v3_out = lpf_vector.apply(v3), 1000);
+	PERF("LowPassFilter2p float applyArray 32 samples (100 ops)", lpf.applyArray(fifo, FIFO_SAMPLES), 100);
+	return true;
+}
+
+bool MicroBenchFilter::time_notch_filter()
+{
+	PERF("NotchFilter float apply (1k ops)", f32_out = notch.apply((float)f32), 1000);
+	PERF("NotchFilter float applyArray 32 samples (100 ops)", notch.applyArray(fifo, FIFO_SAMPLES), 100);
+	return true;
+}
+
+bool MicroBenchFilter::time_notch_filter_bank()
+{
+	PERF("NotchFilter bank 3 axes x 12 notches (100 ops)", f32_out = apply_notch_bank(f32), 100);
+	return true;
+}
+
+bool MicroBenchFilter::time_alpha_filter()
+{
+	PERF("AlphaFilter Vector3f update (1k ops)", v3_out = alpha_vector.update(v3), 1000);
+	return true;
+}
+
+} // namespace MicroBenchFilter
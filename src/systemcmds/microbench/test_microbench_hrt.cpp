@@ -38,6 +38,8 @@
 
 #include <unit_test.h>
 
+#include "microbench_report.hpp"
+
 #include <time.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -47,6 +49,8 @@
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/micro_hal.h>
 
+using namespace time_literals;
+
 namespace MicroBenchHRT
 {
 
@@ -83,6 +87,7 @@ void unlock()
 			reset(); \
 		} \
 		perf_print_counter(p); \
+		microbench::report(name, p, 1); \
 		perf_free(p); \
 	} while (0)
 
@@ -94,6 +99,7 @@ public:
 private:
 
 	bool time_px4_hrt();
+	bool time_px4_hrt_callout();
 
 	void reset();
 
@@ -118,6 +124,7 @@ private:
 bool MicroBenchHRT::run_tests()
 {
 	ut_run_test(time_px4_hrt);
+	ut_run_test(time_px4_hrt_callout);
 
 	return (_tests_failed == 0);
 }
@@ -148,4 +155,54 @@ bool MicroBenchHRT::time_px4_hrt()
 	return true;
 }
 
+bool MicroBenchHRT::time_px4_hrt_callout()
+{
+	// schedule and cancel cost with a populated callout queue
+	static constexpr int QUEUED = 1000;
+	static constexpr hrt_abstime FAR_FUTURE = 3600_s;
+
+	hrt_call *queued = new hrt_call[QUEUED];
+
+	if (queued == nullptr) {
+		return false;
+	}
+
+	for (int i = 0; i < QUEUED; i++) {
+		hrt_call_init(&queued[i]);
+		hrt_call_after(&queued[i], FAR_FUTURE + i, nullptr, nullptr);
+	}
+
+	hrt_call call;
+	hrt_call_init(&call);
+
+	// lands in the middle of the queue
+	PERF("hrt_call_after() 1000 queued", hrt_call_after(&call, FAR_FUTURE + QUEUED / 2, nullptr, nullptr), 1000);
+	hrt_cancel(&call);
+
+	// cancel needs the entry re-queued before every sample, so time it outside of PERF()
+	perf_counter_t p = perf_alloc(PC_ELAPSED, "hrt_cancel() 1000 queued");
+
+	for (int i = 0; i < 1000; i++) {
+		hrt_call_after(&call, FAR_FUTURE + QUEUED / 2, nullptr, nullptr);
+		px4_usleep(1);
+		lock();
+		perf_begin(p);
+		hrt_cancel(&call);
+		perf_end(p);
+		unlock();
+	}
+
+	perf_print_counter(p);
+	microbench::report("hrt_cancel() 1000 queued", p, 1);
+	perf_free(p);
+
+	for (int i = 0; i < QUEUED; i++) {
+		hrt_cancel(&queued[i]);
+	}
+
+	delete[] queued;
+
+	return true;
+}
+
 } // namespace MicroBenchHRT
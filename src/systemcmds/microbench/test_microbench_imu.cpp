@@ -0,0 +1,164 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_imu.cpp
+ * Tests for the microbench IMU driver FIFO processing in PX4Gyroscope and PX4Accelerometer.
+ * A FIFO block of 10 samples, as read at 8 kHz raw rate, is rotated, integrated and published.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <drivers/drv_sensor.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/drivers/accelerometer/PX4Accelerometer.hpp>
+#include <lib/drivers/device/Device.hpp>
+#include <lib/drivers/gyroscope/PX4Gyroscope.hpp>
+
+namespace MicroBenchIMU
+{
+
+#define PERF(name, op, count) do { \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			px4_usleep(1000); \
+			perf_begin(p); \
+			for (int i = 0; i < (count); i++) { \
+				op; \
+			} \
+			perf_end(p); \
+		} \
+		perf_print_counter(p); \
+		microbench::report(name, p, (count)); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchIMU : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_gyro_fifo();
+	bool time_accel_fifo();
+
+	template<typename Sensor, typename Fifo>
+	void time_fifo(const char *name, enum Rotation rotation, Fifo &fifo);
+
+	template<typename Fifo>
+	void fill(Fifo &fifo);
+
+	static constexpr uint8_t FIFO_SAMPLES = 10;
+
+	// 8 kHz raw rate
+	static constexpr float FIFO_DT_US = 125.f;
+};
+
+bool MicroBenchIMU::run_tests()
+{
+	ut_run_test(time_gyro_fifo);
+	ut_run_test(time_accel_fifo);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_microbench_imu, MicroBenchIMU)
+
+template<typename Fifo>
+void MicroBenchIMU::fill(Fifo &fifo)
+{
+	fifo.timestamp_sample = hrt_absolute_time();
+	fifo.dt = FIFO_DT_US;
+	fifo.samples = FIFO_SAMPLES;
+
+	for (int i = 0; i < FIFO_SAMPLES; i++) {
+		fifo.x[i] = 100 + 37 * i;
+		fifo.y[i] = -2000 + 11 * i;
+		fifo.z[i] = 4096 - 23 * i;
+	}
+}
+
+template<typename Sensor, typename Fifo>
+void MicroBenchIMU::time_fifo(const char *name, enum Rotation rotation, Fifo &fifo)
+{
+	// a simulated device on an unused address, so it doesn't replace a real sensor's calibration
+	device::Device::DeviceId device_id{};
+	device_id.devid_s.bus_type = device::Device::DeviceBusType::DeviceBusType_SIMULATION;
+	device_id.devid_s.bus = 0;
+	device_id.devid_s.address = 0xFF;
+	device_id.devid_s.devtype = DRV_IMU_DEVTYPE_SIM;
+
+	Sensor sensor{device_id.devid, rotation};
+	sensor.set_scale(1.f / 16.f);
+
+	fill(fifo);
+	const Fifo input = fifo;
+
+	// updateFIFO() rotates in place, every block starts from the same raw samples
+	PERF(name, fifo = input; sensor.updateFIFO(fifo), 100);
+}
+
+bool MicroBenchIMU::time_gyro_fifo()
+{
+	sensor_gyro_fifo_s fifo{};
+
+	time_fifo<PX4Gyroscope>("PX4Gyroscope updateFIFO, 10 samples, no rotation (100 ops)", ROTATION_NONE, fifo);
+	time_fifo<PX4Gyroscope>("PX4Gyroscope updateFIFO, 10 samples, yaw 90 (100 ops)", ROTATION_YAW_90, fifo);
+	time_fifo<PX4Gyroscope>("PX4Gyroscope updateFIFO, 10 samples, roll 90 pitch 68 yaw 293 (100 ops)",
+				ROTATION_ROLL_90_PITCH_68_YAW_293, fifo);
+
+	return true;
+}
+
+bool MicroBenchIMU::time_accel_fifo()
+{
+	sensor_accel_fifo_s fifo{};
+
+	time_fifo<PX4Accelerometer>("PX4Accelerometer updateFIFO, 10 samples, no rotation (100 ops)", ROTATION_NONE, fifo);
+	time_fifo<PX4Accelerometer>("PX4Accelerometer updateFIFO, 10 samples, yaw 90 (100 ops)", ROTATION_YAW_90, fifo);
+	time_fifo<PX4Accelerometer>("PX4Accelerometer updateFIFO, 10 samples, roll 90 pitch 68 yaw 293 (100 ops)",
+				    ROTATION_ROLL_90_PITCH_68_YAW_293, fifo);
+
+	return true;
+}
+
+} // namespace MicroBenchIMU
@@ -0,0 +1,168 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_logger.cpp
+ * Tests for the microbench logger write path, from a message to the file writer buffer.
+ * The messages are written to a temporary log file that is removed afterwards.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <string.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <modules/logger/log_writer_file.h>
+#include <modules/logger/messages.h>
+
+using namespace px4::logger;
+
+namespace MicroBenchLogger
+{
+
+#define PERF(name, op, count) do { \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			wait_for_writer(); \
+			perf_begin(p); \
+			for (int i = 0; i < (count); i++) { \
+				op; \
+			} \
+			perf_end(p); \
+		} \
+		perf_print_counter(p); \
+		microbench::report(name, p, (count)); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchLogger : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_logger_write();
+
+	// wait until the writer thread emptied the buffer, so that no message is dropped
+	void wait_for_writer();
+
+	void write(size_t size);
+
+	static constexpr size_t BUFFER_SIZE = 32 * 1024;
+	static constexpr char FILENAME[] = PX4_STORAGEDIR "/microbench.ulg";
+
+	LogWriterFile *writer{nullptr};
+
+	uint8_t message[sizeof(ulog_message_data_s) + 256] {};
+};
+
+bool MicroBenchLogger::run_tests()
+{
+	writer = new LogWriterFile(BUFFER_SIZE);
+
+	if ((writer == nullptr) || !writer->init() || (writer->thread_start() != 0)) {
+		delete writer;
+		writer = nullptr;
+		return false;
+	}
+
+	if (writer->start_log(LogType::Full, FILENAME)) {
+		ut_run_test(time_logger_write);
+
+		writer->stop_log(LogType::Full);
+
+	} else {
+		_tests_failed++;
+	}
+
+	writer->thread_stop();
+	delete writer;
+	writer = nullptr;
+
+	unlink(FILENAME);
+
+	return (_tests_failed == 0);
+}
+
+void MicroBenchLogger::wait_for_writer()
+{
+	for (int i = 0; i < 100; i++) {
+		writer->lock();
+		const size_t fill_count = writer->get_buffer_fill_count(LogType::Full);
+		writer->unlock();
+
+		if (fill_count == 0) {
+			break;
+		}
+
+		writer->notify();
+		px4_usleep(1000);
+	}
+}
+
+void MicroBenchLogger::write(size_t size)
+{
+	// the same sequence as the logger uses for a subscribed topic, with a header followed by the data
+	const size_t msg_size = sizeof(ulog_message_data_s) + size;
+	const uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
+	const uint16_t write_msg_id = 0;
+
+	message[0] = (uint8_t)write_msg_size;
+	message[1] = (uint8_t)(write_msg_size >> 8);
+	message[2] = static_cast<uint8_t>(ULogMessageType::DATA);
+	message[3] = (uint8_t)write_msg_id;
+	message[4] = (uint8_t)(write_msg_id >> 8);
+
+	writer->lock();
+	writer->write_message(LogType::Full, message, msg_size);
+	writer->unlock();
+}
+
+ut_declare_test_c(test_microbench_logger, MicroBenchLogger)
+
+bool MicroBenchLogger::time_logger_write()
+{
+	PERF("logger write 64 byte message (100 ops)", write(64), 100);
+	PERF("logger write 256 byte message (100 ops)", write(256), 100);
+	return true;
+}
+
+} // namespace MicroBenchLogger
@@ -0,0 +1,227 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_microbench_mission.cpp
+ * Tests for the microbench background mission feasibility check.
+ * A survey mission is stored in the inactive mission slot of the dataman and checked by
+ * MissionFeasibilityChecker, from scratch, after one item changed and without changes.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <dataman_client/DatamanClient.hpp>
+#include <lib/mathlib/mathlib.h>
+#include <modules/navigator/mission_feasibility_checker.h>
+#include <modules/navigator/navigator.h>
+#include <uORB/Subscription.hpp>
+#include <uORB/topics/mission.h>
+#include <uORB/topics/vehicle_global_position.h>
+
+namespace MicroBenchMission
+{
+
+#define PERF(name, op, count) do { \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			px4_usleep(1000); \
+			perf_begin(p); \
+			for (int i = 0; i < (count); i++) { \
+				op; \
+			} \
+			perf_end(p); \
+		} \
+		perf_print_counter(p); \
+		microbench::report(name, p, (count)); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchMission : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_full_check();
+	bool time_changed_item_check();
+	bool time_unchanged_check();
+
+	bool write_mission();
+	bool check();
+
+	// the same size as a large survey, limited by the dataman on small boards
+	static constexpr int MISSION_SIZE = math::min(2000, NUM_MISSIONS_SUPPORTED);
+
+	Navigator *_navigator{nullptr};
+	MissionFeasibilityChecker *_checker{nullptr};
+	DatamanClient _dataman_client{};
+	mission_s _mission{};
+};
+
+bool MicroBenchMission::run_tests()
+{
+	_navigator = new Navigator();
+	bool setup_done = _navigator != nullptr;
+
+	if (setup_done) {
+		_checker = new MissionFeasibilityChecker(_navigator, _dataman_client);
+		setup_done = _checker != nullptr && write_mission();
+	}
+
+	if (setup_done) {
+		ut_run_test(time_full_check);
+		ut_run_test(time_changed_item_check);
+		ut_run_test(time_unchanged_check);
+
+	} else {
+		PX4_ERR("mission setup failed");
+		_tests_failed++;
+	}
+
+	delete _checker;
+	delete _navigator;
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_microbench_mission, MicroBenchMission)
+
+bool MicroBenchMission::write_mission()
+{
+	// start at the current position so the first waypoint is close enough, the navigator home is only used by the checker
+	double lat = 47.3977;
+	double lon = 8.5456;
+	float alt = 488.f;
+
+	uORB::Subscription global_position_sub{ORB_ID(vehicle_global_position)};
+	vehicle_global_position_s global_position;
+
+	if (global_position_sub.copy(&global_position) && PX4_ISFINITE(global_position.lat)
+	    && PX4_ISFINITE(global_position.lon)) {
+		lat = global_position.lat;
+		lon = global_position.lon;
+		alt = global_position.alt;
+	}
+
+	home_position_s &home = *_navigator->get_home_position();
+	home.lat = lat;
+	home.lon = lon;
+	home.alt = alt;
+	home.valid_alt = true;
+	home.valid_hpos = true;
+
+	// don't touch the mission that is currently in use
+	uORB::Subscription mission_sub{ORB_ID(mission)};
+	mission_s active_mission{};
+	mission_sub.copy(&active_mission);
+
+	_mission.mission_dataman_id = (active_mission.mission_dataman_id == DM_KEY_WAYPOINTS_OFFBOARD_0) ?
+				      DM_KEY_WAYPOINTS_OFFBOARD_1 : DM_KEY_WAYPOINTS_OFFBOARD_0;
+	_mission.count = MISSION_SIZE;
+	_mission.mission_id = 1;
+
+	for (int i = 0; i < MISSION_SIZE; i++) {
+		mission_item_s mission_item{};
+		mission_item.nav_cmd = (i == 0) ? NAV_CMD_TAKEOFF : ((i == MISSION_SIZE - 1) ? NAV_CMD_LAND : NAV_CMD_WAYPOINT);
+		mission_item.lat = lat + (i % 40) * 1e-4;
+		mission_item.lon = lon + (i / 40) * 1e-4;
+		mission_item.altitude = 20.f;
+		mission_item.altitude_is_relative = true;
+		mission_item.autocontinue = true;
+
+		if (!_dataman_client.writeSync((dm_item_t)_mission.mission_dataman_id, i, reinterpret_cast<uint8_t *>(&mission_item),
+					       sizeof(mission_item_s))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool MicroBenchMission::check()
+{
+	if (_checker->start(_mission)) {
+		_checker->run(_mission.count);
+	}
+
+	return _checker->result();
+}
+
+bool MicroBenchMission::time_full_check()
+{
+	// a new mission without a known relation to the last checked one, every item is read and checked
+	PERF("MissionFeasibilityChecker run, full check (1 op)",
+	     _mission.mission_id++; _mission.changed_from_mission_id = 0; check(), 1);
+
+	ut_assert("mission feasible", _checker->result());
+	ut_compare("items read", _checker->itemsRead(), MISSION_SIZE);
+
+	return true;
+}
+
+bool MicroBenchMission::time_changed_item_check()
+{
+	// a mission upload that only changed the item in the middle, as reported by mavlink
+	PERF("MissionFeasibilityChecker run, one changed item (1 op)",
+	     _mission.changed_from_mission_id = _mission.mission_id++;
+	     _mission.changed_start_index = MISSION_SIZE / 2;
+	     _mission.changed_end_index = MISSION_SIZE / 2 + 1;
+	     check(), 1);
+
+	ut_assert("mission feasible", _checker->result());
+	ut_assert("only the items after the change are read", _checker->itemsRead() < MISSION_SIZE / 4);
+
+	return true;
+}
+
+bool MicroBenchMission::time_unchanged_check()
+{
+	// a recheck of the same mission, e.g. after a mission topic update, only the last item is checked
+	PERF("MissionFeasibilityChecker run, unchanged mission (1 op)", check(), 1);
+
+	ut_assert("mission feasible", _checker->result());
+	ut_compare("items read", _checker->itemsRead(), 1);
+
+	return true;
+}
+
+} // namespace MicroBenchMission
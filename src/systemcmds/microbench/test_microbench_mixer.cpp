@@ -0,0 +1,163 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_mixer.cpp
+ * Tests for the microbench mixer module output update.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/mixer_module/mixer_module.hpp>
+#include <parameters/param.h>
+
+#if defined(CONFIG_ARCH_BOARD_PX4_SITL)
+#define PARAM_PREFIX "PWM_MAIN"
+#else
+#define PARAM_PREFIX "HIL_ACT"
+#endif
+
+namespace MicroBenchMixer
+{
+
+#define PERF(name, op, count) do { \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			px4_usleep(1000); \
+			perf_begin(p); \
+			for (int i = 0; i < (count); i++) { \
+				op; \
+			} \
+			perf_end(p); \
+		} \
+		perf_print_counter(p); \
+		microbench::report(name, p, (count)); \
+		perf_free(p); \
+	} while (0)
+
+class OutputModule : public OutputModuleInterface
+{
+public:
+	OutputModule() : OutputModuleInterface("microbench_mixer", px4::wq_configurations::hp_default) {}
+
+	void Run() override {}
+
+	bool updateOutputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs,
+			   unsigned num_control_groups_updated) override
+	{
+		return true;
+	}
+};
+
+class MicroBenchMixer : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_mixer_update();
+
+	static constexpr int NUM_OUTPUTS = math::min(16, (int)MixingOutput::MAX_ACTUATORS);
+
+	// 8 motors, 4 servos, gimbal, constant, gripper and RC passthrough
+	static constexpr OutputFunction FUNCTIONS[16] {
+		OutputFunction::Motor1, OutputFunction::Motor2, OutputFunction::Motor3, OutputFunction::Motor4,
+		OutputFunction::Motor5, OutputFunction::Motor6, OutputFunction::Motor7, OutputFunction::Motor8,
+		OutputFunction::Servo1, OutputFunction::Servo2, OutputFunction::Servo3, OutputFunction::Servo4,
+		OutputFunction::Gimbal_Roll, OutputFunction::Constant_Max, OutputFunction::Gripper, OutputFunction::RC_AUX1,
+	};
+
+	param_t function_params[NUM_OUTPUTS] {};
+	int32_t function_params_saved[NUM_OUTPUTS] {};
+};
+
+bool MicroBenchMixer::run_tests()
+{
+	// configure the output functions, restoring the user configuration afterwards
+	for (int i = 0; i < NUM_OUTPUTS; i++) {
+		char name[17];
+		snprintf(name, sizeof(name), "%s_FUNC%u", PARAM_PREFIX, i + 1);
+		function_params[i] = param_find(name);
+
+		if (function_params[i] == PARAM_INVALID) {
+			PX4_ERR("%s not found", name);
+			return false;
+		}
+
+		param_get(function_params[i], &function_params_saved[i]);
+
+		const int32_t function = (int32_t)FUNCTIONS[i];
+		param_set_no_notification(function_params[i], &function);
+	}
+
+	ut_run_test(time_mixer_update);
+
+	for (int i = 0; i < NUM_OUTPUTS; i++) {
+		param_set_no_notification(function_params[i], &function_params_saved[i]);
+	}
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_microbench_mixer, MicroBenchMixer)
+
+bool MicroBenchMixer::time_mixer_update()
+{
+	OutputModule output_module;
+	MixingOutput mixing_output{PARAM_PREFIX, NUM_OUTPUTS, output_module, MixingOutput::SchedulingPolicy::Disabled, false, false};
+	mixing_output.setAllDisarmedValues(900);
+	mixing_output.setAllFailsafeValues(800);
+	mixing_output.setAllMinValues(1000);
+	mixing_output.setAllMaxValues(2000);
+
+	// nothing is published and the outputs stay disarmed, a running output driver is not affected
+	mixing_output.updateSubscriptions(false);
+	mixing_output.update();
+
+	PERF("MixingOutput update, 16 outputs (100 ops)", mixing_output.update(), 100);
+
+	return true;
+}
+
+} // namespace MicroBenchMixer
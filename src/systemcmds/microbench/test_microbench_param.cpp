@@ -0,0 +1,153 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_param.cpp
+ * Tests for the microbench parameter lookup.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <string.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <parameters/param.h>
+
+namespace MicroBenchParam
+{
+
+// parameter access takes locks itself, the loops are not run with interrupts disabled
+#define PERF(name, op, count) do { \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			px4_usleep(1000); \
+			perf_begin(p); \
+			for (int i = 0; i < (count); i++) { \
+				op; \
+			} \
+			perf_end(p); \
+		} \
+		perf_print_counter(p); \
+		microbench::report(name, p, (count)); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchParam : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_param_find();
+	bool time_param_get();
+
+	bool reset();
+
+	static constexpr size_t NAME_LENGTH = 17; // 16 characters + null termination
+
+	char name_first[NAME_LENGTH] {};
+	char name_middle[NAME_LENGTH] {};
+	char name_last[NAME_LENGTH] {};
+
+	param_t handle{PARAM_INVALID};
+
+	float value{0.f};
+
+	volatile param_t handle_out{PARAM_INVALID};
+	volatile int ret_out{0};
+};
+
+bool MicroBenchParam::run_tests()
+{
+	if (!reset()) {
+		return false;
+	}
+
+	ut_run_test(time_param_find);
+	ut_run_test(time_param_get);
+
+	return (_tests_failed == 0);
+}
+
+bool MicroBenchParam::reset()
+{
+	const unsigned count = param_count();
+
+	if (count == 0) {
+		return false;
+	}
+
+	// the parameters are sorted by name, look up names spread across the table
+	strncpy(name_first, param_name(param_for_index(0)), NAME_LENGTH - 1);
+	strncpy(name_middle, param_name(param_for_index(count / 2)), NAME_LENGTH - 1);
+	strncpy(name_last, param_name(param_for_index(count - 1)), NAME_LENGTH - 1);
+
+	// first float parameter from the middle of the table
+	for (unsigned i = count / 2; i < count; i++) {
+		if (param_type(param_for_index(i)) == PARAM_TYPE_FLOAT) {
+			handle = param_for_index(i);
+			break;
+		}
+	}
+
+	return (handle != PARAM_INVALID);
+}
+
+ut_declare_test_c(test_microbench_param, MicroBenchParam)
+
+bool MicroBenchParam::time_param_find()
+{
+	PERF("param_find_no_notification first (100 ops)", handle_out = param_find_no_notification(name_first), 100);
+	PERF("param_find_no_notification middle (100 ops)", handle_out = param_find_no_notification(name_middle), 100);
+	PERF("param_find_no_notification last (100 ops)", handle_out = param_find_no_notification(name_last), 100);
+	PERF("param_find_no_notification unknown (100 ops)", handle_out = param_find_no_notification("MICROBENCH_X"), 100);
+	PERF("param_find (100 ops)", handle_out = param_find(name_middle), 100);
+	return true;
+}
+
+bool MicroBenchParam::time_param_get()
+{
+	PERF("param_get float (1k ops)", ret_out = param_get(handle, &value), 1000);
+	PERF("param_get_index (1k ops)", ret_out = param_get_index(handle), 1000);
+	return true;
+}
+
+} // namespace MicroBenchParam
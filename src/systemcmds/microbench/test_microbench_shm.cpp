@@ -0,0 +1,311 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_shm.cpp
+ * Tests for the microbench shared memory transport, compared against a UDP loopback socket.
+ * A reader thread consumes the messages while at most WINDOW of them are in flight.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <ShmTransport.hpp>
+
+using namespace time_literals;
+
+namespace MicroBenchShm
+{
+
+struct TestMessage {
+	uint64_t timestamp;
+	uint32_t counter;
+	float data[9];
+	uint32_t checksum;
+};
+
+class Channel
+{
+public:
+	virtual ~Channel() = default;
+
+	virtual bool send(const TestMessage &msg) = 0;
+
+	// returns false if no message arrived within a short time
+	virtual bool receive(TestMessage &msg) = 0;
+};
+
+class ShmChannel : public Channel
+{
+public:
+	bool init()
+	{
+		return _writer.init(0, "microbench", "shm_transport_bench", sizeof(TestMessage), 0, 64)
+		       && _reader.init(0, "microbench", "shm_transport_bench", 0, false);
+	}
+
+	bool send(const TestMessage &msg) override { return _writer.publish(&msg, sizeof(msg), msg.timestamp); }
+
+	bool receive(TestMessage &msg) override
+	{
+		if (_reader.read(&msg, sizeof(msg)) == sizeof(msg)) {
+			return true;
+		}
+
+		sched_yield();
+		return false;
+	}
+
+private:
+	ShmTopicWriter _writer{};
+	ShmTopicReader _reader{};
+};
+
+class UdpChannel : public Channel
+{
+public:
+	~UdpChannel() override
+	{
+		if (_fd >= 0) {
+			close(_fd);
+		}
+	}
+
+	bool init()
+	{
+		_fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+		if (_fd < 0) {
+			return false;
+		}
+
+		_addr.sin_family = AF_INET;
+		_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		_addr.sin_port = 0;
+		socklen_t len = sizeof(_addr);
+
+		// a dropped datagram must not block the reader forever
+		timeval timeout{0, 10000};
+
+		return (bind(_fd, (sockaddr *)&_addr, sizeof(_addr)) == 0)
+		       && (getsockname(_fd, (sockaddr *)&_addr, &len) == 0)
+		       && (setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0);
+	}
+
+	bool send(const TestMessage &msg) override
+	{
+		return sendto(_fd, &msg, sizeof(msg), 0, (sockaddr *)&_addr, sizeof(_addr)) == sizeof(msg);
+	}
+
+	bool receive(TestMessage &msg) override { return recv(_fd, &msg, sizeof(msg), 0) == sizeof(msg); }
+
+private:
+	int _fd{-1};
+	sockaddr_in _addr{};
+};
+
+class MicroBenchShm : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_shm_transport();
+	bool time_udp_loopback();
+
+	bool time_channel(Channel &channel, const char *name_throughput, const char *name_latency);
+
+	static void *reader_trampoline(void *arg);
+	void reader_run();
+
+	static constexpr int NUM_MESSAGES = 1000;
+	static constexpr int WINDOW = 32;
+
+	// give up waiting for in-flight messages after this time and count them as lost
+	static constexpr hrt_abstime RECEIVE_TIMEOUT_US = 100_ms;
+
+	Channel *_channel{nullptr};
+	perf_counter_t _latency_perf{nullptr};
+
+	px4::atomic<int> _received{0};
+	px4::atomic<hrt_abstime> _last_receive{0};
+	px4::atomic_bool _stop{false};
+};
+
+bool MicroBenchShm::run_tests()
+{
+	ut_run_test(time_shm_transport);
+	ut_run_test(time_udp_loopback);
+
+	return (_tests_failed == 0);
+}
+
+void *MicroBenchShm::reader_trampoline(void *arg)
+{
+	static_cast<MicroBenchShm *>(arg)->reader_run();
+	return nullptr;
+}
+
+void MicroBenchShm::reader_run()
+{
+	TestMessage msg{};
+
+	while (!_stop.load()) {
+		if (_channel->receive(msg)) {
+			const hrt_abstime now = hrt_absolute_time();
+			perf_set_elapsed(_latency_perf, now - msg.timestamp);
+			_last_receive.store(now);
+			_received.fetch_add(1);
+		}
+	}
+}
+
+bool MicroBenchShm::time_channel(Channel &channel, const char *name_throughput, const char *name_latency)
+{
+	perf_counter_t throughput_perf = perf_alloc(PC_ELAPSED, name_throughput);
+	_latency_perf = perf_alloc(PC_ELAPSED, name_latency);
+	_channel = &channel;
+	_stop.store(false);
+
+	pthread_t reader;
+
+	if (pthread_create(&reader, nullptr, &MicroBenchShm::reader_trampoline, this) != 0) {
+		perf_free(throughput_perf);
+		perf_free(_latency_perf);
+		return false;
+	}
+
+	int lost = 0;
+
+	for (int rep = 0; rep < 10; rep++) {
+		px4_usleep(1000);
+		_received.store(0);
+
+		TestMessage msg{};
+		int dropped = 0;
+		const hrt_abstime start = hrt_absolute_time();
+
+		for (int i = 0; i < NUM_MESSAGES; i++) {
+			const hrt_abstime wait_start = hrt_absolute_time();
+
+			while (i - _received.load() - dropped >= WINDOW) {
+				if (hrt_elapsed_time(&wait_start) > RECEIVE_TIMEOUT_US) {
+					// nothing arrived for too long, the messages in flight are lost
+					dropped = i - _received.load();
+					break;
+				}
+
+				sched_yield();
+			}
+
+			msg.timestamp = hrt_absolute_time();
+			msg.counter = i;
+			msg.checksum = i ^ 0xA5A5A5A5;
+			channel.send(msg);
+		}
+
+		const hrt_abstime wait_start = hrt_absolute_time();
+
+		while ((_received.load() < NUM_MESSAGES) && (hrt_elapsed_time(&wait_start) < RECEIVE_TIMEOUT_US)) {
+			sched_yield();
+		}
+
+		lost += NUM_MESSAGES - _received.load();
+
+		if (_received.load() > 0) {
+			perf_set_elapsed(throughput_perf, _last_receive.load() - start);
+		}
+	}
+
+	_stop.store(true);
+	pthread_join(reader, nullptr);
+
+	perf_print_counter(throughput_perf);
+	microbench::report(name_throughput, throughput_perf, NUM_MESSAGES);
+	perf_print_counter(_latency_perf);
+	microbench::report(name_latency, _latency_perf, 1);
+
+	if (lost > 0) {
+		PX4_WARN("%s: %d of %d messages lost", name_throughput, lost, 10 * NUM_MESSAGES);
+	}
+
+	perf_free(throughput_perf);
+	perf_free(_latency_perf);
+	_latency_perf = nullptr;
+	_channel = nullptr;
+
+	return true;
+}
+
+bool MicroBenchShm::time_shm_transport()
+{
+	ShmChannel channel;
+
+	if (!channel.init()) {
+		PX4_ERR("shared memory segment init failed");
+		return false;
+	}
+
+	return time_channel(channel, "shm transport: 1000 msgs", "shm transport: latency");
+}
+
+bool MicroBenchShm::time_udp_loopback()
+{
+	UdpChannel channel;
+
+	if (!channel.init()) {
+		PX4_ERR("UDP loopback socket init failed");
+		return false;
+	}
+
+	return time_channel(channel, "udp loopback: 1000 msgs", "udp loopback: latency");
+}
+
+ut_declare_test_c(test_microbench_shm, MicroBenchShm)
+
+} // namespace MicroBenchShm
@@ -0,0 +1,177 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2024 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_sysid.cpp
+ * Tests for the microbench system identification (ARX RLS) library.
+ */
+
+#include <unit_test.h>
+
+#include "microbench_report.hpp"
+
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <lib/system_identification/arx_rls.hpp>
+#include <lib/system_identification/arx_rls_batch.hpp>
+
+namespace MicroBenchSysId
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int rep = 0; rep < 10; rep++) { \
+			px4_usleep(1000); \
+			lock(); \
+			perf_begin(p); \
+			for (int i = 0; i < (count); i++) { \
+				op; \
+			} \
+			perf_end(p); \
+			unlock(); \
+		} \
+		perf_print_counter(p); \
+		microbench::report(name, p, (count)); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchSysId : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_arx_rls();
+
+	void reset();
+
+	// update of all 3 axes, one dense filter per axis or one batched filter
+	void update_dense();
+	void update_batch();
+
+	float excitation();
+
+	static constexpr int NB_SAMPLES = 64;
+
+	ArxRls<2, 2, 1> rls[3];
+	ArxRlsBatch<2, 2, 1, 3> rls_batch;
+
+	matrix::Vector3f u[NB_SAMPLES];
+	matrix::Vector3f y[NB_SAMPLES];
+	int sample{0};
+
+	uint32_t seed{42};
+};
+
+bool MicroBenchSysId::run_tests()
+{
+	ut_run_test(time_arx_rls);
+
+	return (_tests_failed == 0);
+}
+
+// deterministic pseudo-random excitation in [-1, 1]
+float MicroBenchSysId::excitation()
+{
+	seed = seed * 1664525u + 1013904223u;
+	return static_cast<float>(seed >> 8) / static_cast<float>(1u << 23) - 1.f;
+}
+
+void MicroBenchSysId::reset()
+{
+	seed = 42;
+	sample = 0;
+
+	for (int i = 0; i < NB_SAMPLES; i++) {
+		u[i] = matrix::Vector3f(excitation(), excitation(), excitation());
+		y[i] = matrix::Vector3f(excitation(), excitation(), excitation());
+	}
+
+	for (int axis = 0; axis < 3; axis++) {
+		rls[axis].reset();
+	}
+
+	rls_batch.reset();
+}
+
+void MicroBenchSysId::update_dense()
+{
+	for (int axis = 0; axis < 3; axis++) {
+		rls[axis].update(u[sample](axis), y[sample](axis));
+	}
+
+	sample = (sample + 1) % NB_SAMPLES;
+}
+
+void MicroBenchSysId::update_batch()
+{
+	rls_batch.update(u[sample], y[sample]);
+	sample = (sample + 1) % NB_SAMPLES;
+}
+
+ut_declare_test_c(test_microbench_sysid, MicroBenchSysId)
+
+bool MicroBenchSysId::time_arx_rls()
+{
+	PERF("ArxRls<2, 2, 1> update 3 axes (100 ops)", update_dense(), 100);
+	PERF("ArxRlsBatch<2, 2, 1, 3> update (100 ops)", update_batch(), 100);
+	return true;
+}
+
+} // namespace MicroBenchSysId
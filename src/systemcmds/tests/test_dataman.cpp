@@ -45,6 +45,7 @@
 #include <pthread.h>
 
 #include "dataman_client/DatamanClient.hpp"
+#include <lib/mathlib/mathlib.h>
 
 class DatamanTest : public UnitTest
 {
@@ -87,9 +88,11 @@ private:
 	bool testAsyncMutipleClients();
 	bool testAsyncWriteReadAllItemsMaxSize();
 	bool testAsyncClearAll();
+	bool testAsyncReadBatch();
 
 	//Cache
 	bool testCache();
+	bool testCacheMissionExecution();
 
 	//This will reset the items but it will not restore the compact key.
 	bool testResetItems();
@@ -1070,6 +1073,178 @@ DatamanTest::testCache()
 	return true;
 }
 
+bool
+DatamanTest::testAsyncReadBatch()
+{
+	dm_item_t item = DM_KEY_WAYPOINTS_OFFBOARD_0;
+	uint32_t first_index = 20;
+	uint8_t buffers[DM_READ_BATCH_MAX_ITEMS][DM_MAX_DATA_SIZE] {};
+	uint8_t *buffer_pointers[DM_READ_BATCH_MAX_ITEMS];
+
+	for (uint32_t i = 0; i < DM_READ_BATCH_MAX_ITEMS; ++i) {
+		memset(_buffer_write, 50 + i, sizeof(_buffer_write));
+
+		if (!_dataman_client1.writeSync(item, first_index + i, _buffer_write, sizeof(_buffer_write))) {
+			return false;
+		}
+
+		buffer_pointers[i] = buffers[i];
+	}
+
+	// a batch larger than supported is rejected
+	if (_dataman_client1.readBatchAsync(item, first_index, DM_READ_BATCH_MAX_ITEMS + 1, buffer_pointers,
+					    sizeof(_buffer_read))) {
+		PX4_ERR("readBatchAsync unexpectedly succeeded");
+		return false;
+	}
+
+	if (!_dataman_client1.readBatchAsync(item, first_index, DM_READ_BATCH_MAX_ITEMS, buffer_pointers,
+					     sizeof(_buffer_read))) {
+		return false;
+	}
+
+	hrt_abstime start_time = hrt_absolute_time();
+
+	while (!_dataman_client1.lastOperationCompleted(_response_success)) {
+
+		px4_usleep(1_ms);
+		_dataman_client1.update();
+
+		if (hrt_elapsed_time(&start_time) > 2_s) {
+			PX4_ERR("Test timeout!");
+			return false;
+		}
+	}
+
+	if (!_response_success) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < DM_READ_BATCH_MAX_ITEMS; ++i) {
+		for (uint32_t j = 0; j < DM_MAX_DATA_SIZE; ++j) {
+			if (buffers[i][j] != 50 + i) {
+				PX4_ERR("Wrong data recived %" PRIu8" , expected %" PRIu32, buffers[i][j], 50 + i);
+				return false;
+			}
+		}
+	}
+
+	// reading beyond the last index fails the batch, the indices before it are still read
+	if (!_dataman_client1.readBatchAsync(DM_KEY_SAFE_POINTS_0, DM_KEY_SAFE_POINTS_MAX - 1, 2, buffer_pointers,
+					     g_per_item_size[DM_KEY_SAFE_POINTS_0])) {
+		return false;
+	}
+
+	start_time = hrt_absolute_time();
+
+	while (!_dataman_client1.lastOperationCompleted(_response_success)) {
+
+		px4_usleep(1_ms);
+		_dataman_client1.update();
+
+		if (hrt_elapsed_time(&start_time) > 2_s) {
+			PX4_ERR("Test timeout!");
+			return false;
+		}
+	}
+
+	if (_response_success) {
+		PX4_ERR("readBatchAsync beyond the last index unexpectedly succeeded");
+		return false;
+	}
+
+	if (_dataman_client1.lastBatchReadMask() != 0x1) {
+		PX4_ERR("Wrong batch read mask %" PRIx32 ", expected 1", _dataman_client1.lastBatchReadMask());
+		return false;
+	}
+
+	return true;
+}
+
+bool
+DatamanTest::testCacheMissionExecution()
+{
+	// Step through a mission like navigator does: load a window of the next items and use them
+	// a few cycles later. Once the first window is loaded, every item is requested window_size - 1
+	// steps before it is used, so a linear walk must not miss the cache.
+	static constexpr uint32_t num_mission_items = 60;
+	static constexpr uint32_t window_size = 10;
+
+	dm_item_t item = DM_KEY_WAYPOINTS_OFFBOARD_0;
+	uint32_t uniq_number = 7;
+
+	for (uint32_t index = 0; index < num_mission_items; ++index) {
+		memset(_buffer_write, index + uniq_number, sizeof(_buffer_write));
+
+		if (!_dataman_client1.writeSync(item, index, _buffer_write, sizeof(_buffer_write))) {
+			return false;
+		}
+	}
+
+	DatamanCache cache{"test_dm_cache_mission_miss", window_size};
+	uint32_t num_misses = 0;
+	hrt_abstime max_transition_time = 0;
+
+	for (uint32_t index = 0; index < window_size; ++index) {
+		cache.load(item, index);
+	}
+
+	hrt_abstime start_time = hrt_absolute_time();
+
+	while (!cache.loadWait(item, window_size - 1, _buffer_read, sizeof(_buffer_read))) {
+		px4_usleep(1_ms);
+		cache.update();
+
+		if (hrt_elapsed_time(&start_time) > 2_s) {
+			PX4_ERR("Timeout loading the first window");
+			return false;
+		}
+	}
+
+	start_time = hrt_absolute_time();
+
+	for (uint32_t current = 0; current < num_mission_items; ++current) {
+
+		for (uint32_t index = current; index < math::min(current + window_size, num_mission_items); ++index) {
+			cache.load(item, index);
+		}
+
+		// items are used after a few cycles of the navigator loop
+		for (int cycle = 0; cycle < 3; ++cycle) {
+			px4_usleep(1_ms);
+			cache.update();
+		}
+
+		const hrt_abstime transition_start = hrt_absolute_time();
+
+		if (!cache.loadWait(item, current, _buffer_read, sizeof(_buffer_read))) {
+			++num_misses;
+
+			if (!cache.loadWait(item, current, _buffer_read, sizeof(_buffer_read), 100_ms)) {
+				PX4_ERR("Failed loadWait at index %" PRIu32, current);
+				return false;
+			}
+		}
+
+		max_transition_time = math::max(max_transition_time, hrt_elapsed_time(&transition_start));
+
+		if (_buffer_read[0] != current + uniq_number) {
+			PX4_ERR("Wrong data recived %" PRIu8" , expected %" PRIu32, _buffer_read[0], current + uniq_number);
+			return false;
+		}
+	}
+
+	PX4_INFO("%" PRIu32 " items: %" PRIu32 " cache misses, max transition %" PRIu64 " us, total %" PRIu64 " us",
+		 num_mission_items, num_misses, max_transition_time, hrt_elapsed_time(&start_time));
+
+	if (num_misses > 0) {
+		PX4_ERR("%" PRIu32 " cache misses walking the mission, expected none", num_misses);
+		return false;
+	}
+
+	return true;
+}
+
 bool
 DatamanTest::testResetItems()
 {
@@ -1139,8 +1314,10 @@ bool DatamanTest::run_tests()
 	ut_run_test(testAsyncMutipleClients);
 	ut_run_test(testAsyncWriteReadAllItemsMaxSize);
 	ut_run_test(testAsyncClearAll);
+	ut_run_test(testAsyncReadBatch);
 
 	ut_run_test(testCache);
+	ut_run_test(testCacheMissionExecution);
 
 	ut_run_test(testResetItems);
 